@@ -0,0 +1,188 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_asof.h
+ * @brief As-of join of sorted timestamp columns.
+ *
+ * For every row of a left column (e.g. trades), an as-of join finds the
+ * latest row of a right column (e.g. quotes) at or before it: the last right
+ * row whose time is <= the left time.  Optionally the match must be within a
+ * tolerance of the left time, and must carry the same key (e.g. the same
+ * instrument), in which case the join runs as many independent as-of joins as
+ * there are keys, interleaved in time.
+ *
+ * Both columns are mu_time_column_t views, sorted by time.  The join is one
+ * merge pass: the right cursor gallops (exponential then binary search) to the
+ * end of the rows at or before each left row, so a right column much denser
+ * than the left is skipped in logarithmic steps rather than scanned.  Keyed
+ * joins instead scatter each skipped block into a table of the latest right
+ * row per key, which costs one store per right row.
+ *
+ * mu_asof_run_parallel() splits the left column into contiguous partitions
+ * joined on separate threads.  Each partition only sees the right rows that
+ * arrive during it; a keyed row whose key has not yet appeared there is
+ * resolved afterwards from the per-key tables of the partitions before it.
+ *
+ * Results are right row numbers (relative to the right column's offset), so
+ * the caller gathers whatever payload columns it needs.  Null left rows
+ * match nothing and null right rows are never matched.
+ *
+ * This module requires a POSIX platform (pthreads, and mu_time_rel_t in
+ * nanoseconds).
+ */
+
+#ifndef _MU_ASOF_H_
+#define _MU_ASOF_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_time_column.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_ASOF_MAX_PARTS
+#define MU_ASOF_MAX_PARTS 64 ///< Most partitions of a parallel join
+#endif
+
+#ifndef MU_ASOF_MIN_PART_ROWS
+#define MU_ASOF_MIN_PART_ROWS 65536 ///< Fewest left rows worth a thread
+#endif
+
+#define MU_ASOF_NONE SIZE_MAX ///< Match of a left row with no match
+
+#define MU_ASOF_UNBOUNDED INT64_MAX ///< Tolerance that accepts any age
+
+/**
+ * @brief An as-of join.  Treat the fields as private.
+ */
+typedef struct {
+    const mu_time_column_t *left;
+    const mu_time_column_t *right;
+    const uint32_t *left_keys;  ///< Key per left row, or NULL
+    const uint32_t *right_keys; ///< Key per right row, or NULL
+    size_t n_keys;              ///< Keys are in [0, n_keys)
+    mu_time_rel_t tolerance;    ///< Greatest accepted left - right time
+} mu_asof_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize an unkeyed join with unbounded tolerance.
+ *
+ * @param join The join to initialize.
+ * @param left The column to find matches for.  Values, null rows included,
+ * must be nondecreasing.
+ * @param right The column to match against, sorted likewise.  Among right rows
+ * with equal times, the last one is the latest.
+ */
+void mu_asof_init(mu_asof_t *join, const mu_time_column_t *left,
+                  const mu_time_column_t *right);
+
+/**
+ * @brief Only match right rows at most `tolerance` before the left row.
+ *
+ * A tolerance of 0 only accepts exact matches; MU_ASOF_UNBOUNDED (the
+ * default) accepts any.
+ */
+void mu_asof_set_tolerance(mu_asof_t *join, mu_time_rel_t tolerance);
+
+/**
+ * @brief Only match right rows with the same key as the left row.
+ *
+ * Keys are small integers, such as dictionary indexes.  Both key arrays are
+ * given together; passing NULL for both makes the join unkeyed again.
+ *
+ * @param join The join.
+ * @param left_keys One key per left row, each less than n_keys.
+ * @param right_keys One key per right row, each less than n_keys.
+ * @param n_keys The number of distinct keys.
+ * @return false, leaving the join unchanged, if only one key array is given
+ * or n_keys is 0.
+ */
+bool mu_asof_set_keys(mu_asof_t *join, const uint32_t *left_keys,
+                      const uint32_t *right_keys, size_t n_keys);
+
+/**
+ * @brief Return the number of scratch entries a join needs.
+ *
+ * @param join The join.
+ * @param n_threads The thread count that will be passed to
+ * mu_asof_run_parallel(), or 1 for mu_asof_run().
+ * @return n_keys per partition for a join with more than one key, else 0.
+ */
+size_t mu_asof_scratch_size(const mu_asof_t *join, size_t n_threads);
+
+/**
+ * @brief Join on the calling thread.
+ *
+ * @param join The join.
+ * @param match Receives, per left row, the matching right row or
+ * MU_ASOF_NONE.
+ * @param scratch mu_asof_scratch_size(join, 1) entries, or NULL if none.
+ * @return The number of left rows matched.
+ */
+size_t mu_asof_run(const mu_asof_t *join, size_t *match, size_t *scratch);
+
+/**
+ * @brief Join in partitions on up to `n_threads` threads.
+ *
+ * The calling thread joins the first partition.  Inputs too small to be worth
+ * it use fewer threads, down to one; if a thread cannot be started, its
+ * partition is joined on the calling thread instead.  Results are identical to
+ * mu_asof_run().
+ *
+ * @param join The join.
+ * @param match Receives, per left row, the matching right row or
+ * MU_ASOF_NONE.
+ * @param scratch mu_asof_scratch_size(join, n_threads) entries, or NULL if
+ * none.
+ * @param n_threads The most threads to use, including the caller's.
+ * @return The number of left rows matched.
+ */
+size_t mu_asof_run_parallel(const mu_asof_t *join, size_t *match,
+                            size_t *scratch, size_t n_threads);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_ASOF_H_ */
@@ -0,0 +1,273 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_budget.h
+ * @brief Time budgets for cooperative tasks, with round-robin slicing.
+ *
+ * A long-running callback takes a mu_budget_t and polls
+ * mu_budget_exhausted() in its inner loop, returning to its caller once the
+ * budget is spent.  The poll must be cheap enough to call every iteration, so
+ * it is usually a decrement and a branch: the clock is read only once every
+ * `stride` calls.  Each slice starts with a stride of 1, and every clock read
+ * resizes the stride from the cost per poll it measured, so that the clock
+ * is read about 1 << MU_BUDGET_CHECKS_SHIFT times per slice whatever the
+ * cost of the loop body.  The stride at most doubles per read, so a budget
+ * is noticed spent within about two check intervals even if the body slows.
+ *
+ * The clock is either mu_time_now() or a mu_coarse_clock_t: a cached time
+ * the event loop or a tick interrupt refreshes, which costs only a load to
+ * read.  A coarse budget ends at the first refresh at or after its deadline.
+ *
+ * mu_budget_rr_t runs a queue of tasks round-robin, each for its own slice,
+ * requeueing those with work left and recording tasks that overrun their
+ * slice, which are the ones starving the others.
+ *
+ * Budgets and schedulers are not thread-safe; each belongs to one loop.
+ */
+
+#ifndef _MU_BUDGET_H_
+#define _MU_BUDGET_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_BUDGET_CHECKS_SHIFT
+#define MU_BUDGET_CHECKS_SHIFT 4 ///< Aim for 16 clock reads per slice
+#endif
+
+#ifndef MU_BUDGET_STRIDE_MAX
+#define MU_BUDGET_STRIDE_MAX 4096 ///< Most polls between clock reads
+#endif
+
+/**
+ * @brief A cached clock.  Refresh it with mu_coarse_clock_update() from the
+ * thread that reads it, or from an interrupt where mu_time_abs_t is a single
+ * word.
+ */
+typedef struct {
+    volatile mu_time_abs_t now;
+} mu_coarse_clock_t;
+
+/**
+ * @brief A time budget.  Treat the fields as private.
+ */
+typedef struct {
+    const mu_coarse_clock_t *coarse; ///< Clock, or NULL for mu_time_now()
+    mu_time_abs_t start;             ///< When the budget started
+    mu_time_abs_t deadline;          ///< When it is spent
+    mu_time_abs_t checked;           ///< Last clock read
+    mu_time_rel_t slice;             ///< Length of the budget
+    uint32_t countdown;              ///< Polls left until the next read
+    uint32_t stride;                 ///< Polls between clock reads
+} mu_budget_t;
+
+struct mu_budget_task;
+
+/**
+ * @brief A task body.  Do work until the budget is exhausted.
+ *
+ * @return true if work remains and the task should run again.
+ */
+typedef bool (*mu_budget_fn)(struct mu_budget_task *task,
+                             mu_budget_t *budget);
+
+/**
+ * @brief A round-robin task.  Treat the fields as private.
+ */
+typedef struct mu_budget_task {
+    struct mu_budget_task *next;
+    mu_budget_fn fn;
+    void *arg;
+    mu_time_rel_t slice;       ///< Budget per run
+    mu_time_rel_t max_overrun; ///< Longest run past the slice
+    uint32_t runs;             ///< Times run
+    uint32_t overruns;         ///< Runs that ended past the slice
+    bool queued;
+} mu_budget_task_t;
+
+/**
+ * @brief A round-robin scheduler.  Treat the fields as private.
+ */
+typedef struct {
+    mu_budget_t budget; ///< Restarted for each run
+    mu_budget_task_t *head;
+    mu_budget_task_t *tail;
+    mu_time_rel_t tolerance; ///< Overrun not counted as one
+} mu_budget_rr_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Refresh a coarse clock from mu_time_now().
+ */
+static inline void mu_coarse_clock_update(mu_coarse_clock_t *clock) {
+    clock->now = mu_time_now();
+}
+
+/**
+ * @brief Set a coarse clock to a given time, e.g. a tick count.
+ */
+static inline void mu_coarse_clock_set(mu_coarse_clock_t *clock,
+                                       mu_time_abs_t now) {
+    clock->now = now;
+}
+
+/**
+ * @brief Initialize a budget.  It starts out exhausted.
+ *
+ * @param budget The budget.
+ * @param coarse The clock to read, or NULL for mu_time_now().
+ */
+void mu_budget_init(mu_budget_t *budget, const mu_coarse_clock_t *coarse);
+
+/**
+ * @brief Start a budget of `slice` from now.
+ */
+void mu_budget_start(mu_budget_t *budget, mu_time_rel_t slice);
+
+/**
+ * @brief Read the clock and report whether the budget is spent.
+ *
+ * mu_budget_exhausted() calls this every `stride` polls; call it directly
+ * before work too coarse to be worth starting late.
+ */
+bool mu_budget_check(mu_budget_t *budget);
+
+/**
+ * @brief Report whether the budget is spent, reading the clock only once
+ * every `stride` calls.
+ */
+static inline bool mu_budget_exhausted(mu_budget_t *budget) {
+    if (budget->countdown > 1) {
+        budget->countdown -= 1;
+        return false;
+    }
+    return mu_budget_check(budget);
+}
+
+/**
+ * @brief Return the time since the budget started, as of the last clock read.
+ */
+mu_time_rel_t mu_budget_elapsed(const mu_budget_t *budget);
+
+/**
+ * @brief Return the time left, as of the last clock read.  Negative once the
+ * budget is overrun.
+ */
+mu_time_rel_t mu_budget_remaining(const mu_budget_t *budget);
+
+/**
+ * @brief Return the current number of polls between clock reads.
+ */
+uint32_t mu_budget_stride(const mu_budget_t *budget);
+
+/**
+ * @brief Initialize a round-robin scheduler.
+ *
+ * @param rr The scheduler.
+ * @param coarse The clock to read, or NULL for mu_time_now().
+ * @param tolerance How far past its slice a task may run before the run
+ * counts as an overrun.
+ */
+void mu_budget_rr_init(mu_budget_rr_t *rr, const mu_coarse_clock_t *coarse,
+                       mu_time_rel_t tolerance);
+
+/**
+ * @brief Initialize a task.
+ *
+ * @param task The task.
+ * @param fn The task body.
+ * @param arg Passed through, see mu_budget_task_arg().
+ * @param slice The budget for each run.
+ */
+void mu_budget_task_init(mu_budget_task_t *task, mu_budget_fn fn, void *arg,
+                         mu_time_rel_t slice);
+
+/**
+ * @brief Queue a task at the tail.  Does nothing if it is already queued.
+ */
+void mu_budget_rr_add(mu_budget_rr_t *rr, mu_budget_task_t *task);
+
+/**
+ * @brief Remove a task from the queue.  Does nothing if it is not queued.
+ */
+void mu_budget_rr_remove(mu_budget_rr_t *rr, mu_budget_task_t *task);
+
+/**
+ * @brief Run the task at the head for its slice, requeueing it at the tail
+ * if it has work left.
+ *
+ * @return The task run, or NULL if none was queued.
+ */
+mu_budget_task_t *mu_budget_rr_run(mu_budget_rr_t *rr);
+
+/**
+ * @brief Return true if no task is queued.
+ */
+bool mu_budget_rr_is_empty(const mu_budget_rr_t *rr);
+
+/**
+ * @brief Return the argument given to mu_budget_task_init().
+ */
+void *mu_budget_task_arg(const mu_budget_task_t *task);
+
+/**
+ * @brief Return how many times a task has run.
+ */
+uint32_t mu_budget_task_runs(const mu_budget_task_t *task);
+
+/**
+ * @brief Return how many runs ended later than the slice plus tolerance.
+ */
+uint32_t mu_budget_task_overruns(const mu_budget_task_t *task);
+
+/**
+ * @brief Return the longest time a run went past its slice.
+ */
+mu_time_rel_t mu_budget_task_max_overrun(const mu_budget_task_t *task);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_BUDGET_H_ */
@@ -0,0 +1,184 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_cadence.h
+ * @brief Gap, duplicate and period-change detection over timestamp streams.
+ *
+ * A sensor stream should arrive at a fixed period.  mu_cadence_t looks at
+ * the interval between consecutive timestamps and describes the stream as a
+ * sequence of runs:
+ *
+ * - REGULAR: intervals within `tolerance` of the current period
+ * - GAP: longer intervals -- samples went missing
+ * - IRREGULAR: intervals shorter than the period but not duplicates
+ * - DUPLICATE: intervals of at most `tolerance`, i.e. repeated samples
+ * - BACKWARD: negative intervals, i.e. out-of-order samples
+ *
+ * An interval that does not fit the period becomes a candidate.  If the next
+ * `confirm - 1` intervals agree with it, the period has changed: the
+ * candidates open a REGULAR run at the new period.  Otherwise they are
+ * reported as a GAP or IRREGULAR run.  With no nominal period the first
+ * confirmed period is learned the same way.
+ *
+ * Timestamps, periods and tolerances share one unit, usually nanoseconds as
+ * in mu_time_column_t.  mu_cadence_push() takes one sample at a time;
+ * mu_cadence_scan() takes a sorted array and skips through regular stretches
+ * in blocks, with a branch-free test the compiler vectorizes, so a clean
+ * stream is scanned at close to memory speed.  Both may be mixed and resumed.
+ */
+
+#ifndef _MU_CADENCE_H_
+#define _MU_CADENCE_H_
+
+// *****************************************************************************
+// Includes
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_CADENCE_MAX_EMIT 2 ///< Most runs one sample can complete
+
+#ifndef MU_CADENCE_BLOCK
+#define MU_CADENCE_BLOCK 64 ///< Intervals tested at once by mu_cadence_scan()
+#endif
+
+typedef enum {
+    MU_CADENCE_REGULAR,
+    MU_CADENCE_GAP,
+    MU_CADENCE_IRREGULAR,
+    MU_CADENCE_DUPLICATE,
+    MU_CADENCE_BACKWARD,
+} mu_cadence_kind_t;
+
+/**
+ * @brief A run of intervals of one kind.
+ */
+typedef struct {
+    int64_t start;  ///< Timestamp of the run's first sample
+    int64_t span;   ///< Last sample's timestamp minus start
+    int64_t period; ///< The period in force (0 if none yet)
+    uint64_t first; ///< Index of the run's first sample in the stream
+    uint32_t count; ///< Intervals in the run; it has count + 1 samples
+    uint8_t kind;   ///< A mu_cadence_kind_t
+} mu_cadence_run_t;
+
+/**
+ * @brief A detector.  Treat the fields as private.
+ */
+typedef struct {
+    int64_t period;    ///< Current period, or 0 until learned
+    int64_t tolerance;     ///< In force for the current period
+    int64_t max_tolerance; ///< As configured
+    uint32_t confirm;  ///< Agreeing intervals that establish a period
+    uint64_t samples;  ///< Samples seen
+    int64_t last;      ///< Latest timestamp
+    mu_cadence_run_t run;       ///< Open run, if count > 0
+    mu_cadence_run_t candidate; ///< Unconfirmed intervals, if count > 0
+} mu_cadence_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a detector.
+ *
+ * @param det The detector.
+ * @param period The nominal period, or 0 to learn it.
+ * @param tolerance How far an interval may stray from the period and still be
+ * regular; also the largest interval taken as a duplicate.  Kept below
+ * half of whatever the period is.
+ * @param confirm How many agreeing intervals establish a new period, at
+ * least 1.
+ */
+void mu_cadence_init(mu_cadence_t *det, int64_t period, int64_t tolerance,
+                     uint32_t confirm);
+
+/**
+ * @brief Feed one timestamp.
+ *
+ * @param det The detector.
+ * @param t The timestamp.
+ * @param runs Receives the runs this sample completed.
+ * @return The number of runs written, at most MU_CADENCE_MAX_EMIT.
+ */
+size_t mu_cadence_push(mu_cadence_t *det, int64_t t,
+                       mu_cadence_run_t runs[MU_CADENCE_MAX_EMIT]);
+
+/**
+ * @brief Feed an array of timestamps.
+ *
+ * @param det The detector.
+ * @param t The timestamps, normally sorted.
+ * @param n The number of timestamps.
+ * @param runs Receives the runs completed.
+ * @param max Capacity of `runs`, at least MU_CADENCE_MAX_EMIT.
+ * @param consumed Receives the number of timestamps used; less than `n` if
+ * `runs` filled up, in which case call again with the rest.
+ * @return The number of runs written.
+ */
+size_t mu_cadence_scan(mu_cadence_t *det, const int64_t *t, size_t n,
+                       mu_cadence_run_t *runs, size_t max, size_t *consumed);
+
+/**
+ * @brief Complete the open run, at the end of a stream.
+ *
+ * Unconfirmed candidates are reported as GAP or IRREGULAR.  The detector then
+ * continues from the last sample.
+ *
+ * @return The number of runs written, at most MU_CADENCE_MAX_EMIT.
+ */
+size_t mu_cadence_flush(mu_cadence_t *det,
+                        mu_cadence_run_t runs[MU_CADENCE_MAX_EMIT]);
+
+/**
+ * @brief Return the current period, or 0 if none is known yet.
+ */
+int64_t mu_cadence_period(const mu_cadence_t *det);
+
+/**
+ * @brief Estimate the samples missing from a GAP run, by rounding each
+ * interval to whole periods.
+ */
+uint64_t mu_cadence_missing(const mu_cadence_run_t *run);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_CADENCE_H_ */
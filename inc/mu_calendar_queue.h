@@ -0,0 +1,171 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_calendar_queue.h
+ * @brief Calendar queue: a time-ordered priority queue for event simulation.
+ *
+ * Events keyed by mu_time_abs_t are hashed into an array of buckets, each
+ * covering `width` of time, which wraps around like the days of a calendar
+ * year.  Each bucket holds a short sorted list, so enqueue and dequeue are O(1)
+ * amortized when the width is close to the typical spacing of events, instead
+ * of the O(log n) of a binary heap.
+ *
+ * The queue tunes itself: the bucket count doubles or halves as the queue
+ * grows or shrinks (within the caller's bucket array), and the width is
+ * re-estimated from the observed gaps between dequeued events whenever
+ * dequeues step over too many empty buckets or enqueues walk too long a list.
+ *
+ * Events with equal times are dequeued in the order they were enqueued.
+ * Events are intrusive (a mu_calendar_event_t embedded in the caller's own
+ * structure) and the queue never allocates.  A queue belongs to one thread.
+ */
+
+#ifndef _MU_CALENDAR_QUEUE_H_
+#define _MU_CALENDAR_QUEUE_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_CALENDAR_QUEUE_MIN_BUCKETS 4
+
+/**
+ * @brief A queued event.  Treat the fields as private.
+ */
+typedef struct mu_calendar_event {
+    struct mu_calendar_event *next;
+    mu_time_rel_t key; ///< Event time relative to the queue origin
+} mu_calendar_event_t;
+
+/**
+ * @brief A calendar queue.
+ */
+typedef struct {
+    mu_calendar_event_t **buckets; ///< Caller's bucket array
+    size_t capacity;               ///< Length of the bucket array
+    size_t nbuckets;               ///< Buckets in use, a power of two
+    size_t count;                  ///< Queued events
+    mu_time_abs_t origin;          ///< Time of key 0
+    mu_time_rel_t width;           ///< Time covered by one bucket
+    int64_t cursor;                ///< Virtual bucket of the earliest event
+    int64_t top;                   ///< End of the cursor's virtual bucket
+    mu_time_rel_t last_key;        ///< Key of the last dequeued event
+    int64_t gap_avg;               ///< Average dequeue gap (fixed point)
+    uint32_t gap_samples;          ///< Gaps folded into gap_avg (saturating)
+    uint32_t ops;                  ///< Operations in the current cost window
+    uint32_t cost;                 ///< Steps taken in the current cost window
+    uint32_t resizes;              ///< Rebuilds so far
+} mu_calendar_queue_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a calendar queue.
+ *
+ * @param q The queue to initialize.
+ * @param buckets Storage for the bucket heads.
+ * @param capacity The number of buckets in `buckets`.  The queue uses the
+ * largest power of two that fits; about half the peak number of queued events
+ * is plenty.
+ * @param now The initial simulation time.
+ * @param width Initial bucket width, or 0 to start with 1 mSec.  The queue
+ * adapts it either way.
+ * @return false if capacity is 0.
+ */
+bool mu_calendar_queue_init(mu_calendar_queue_t *q,
+                            mu_calendar_event_t **buckets, size_t capacity,
+                            mu_time_abs_t now, mu_time_rel_t width);
+
+/**
+ * @brief Queue an event.
+ *
+ * Times earlier than the last dequeued event are allowed; such an event is
+ * simply next.
+ */
+void mu_calendar_queue_enqueue(mu_calendar_queue_t *q, mu_calendar_event_t *ev,
+                               mu_time_abs_t time);
+
+/**
+ * @brief Remove and return the earliest event, or NULL if the queue is empty.
+ */
+mu_calendar_event_t *mu_calendar_queue_dequeue(mu_calendar_queue_t *q);
+
+/**
+ * @brief Return the earliest event without removing it, or NULL.
+ */
+mu_calendar_event_t *mu_calendar_queue_peek(mu_calendar_queue_t *q);
+
+/**
+ * @brief Remove a queued event.
+ *
+ * @return false if the event was not in the queue.
+ */
+bool mu_calendar_queue_remove(mu_calendar_queue_t *q, mu_calendar_event_t *ev);
+
+/**
+ * @brief Return the time at which a queued (or just dequeued) event was
+ * scheduled.
+ */
+mu_time_abs_t mu_calendar_queue_event_time(const mu_calendar_queue_t *q,
+                                           const mu_calendar_event_t *ev);
+
+/**
+ * @brief Return the number of queued events.
+ */
+size_t mu_calendar_queue_count(const mu_calendar_queue_t *q);
+
+/**
+ * @brief Return the current bucket width.
+ */
+mu_time_rel_t mu_calendar_queue_width(const mu_calendar_queue_t *q);
+
+/**
+ * @brief Return the number of buckets in use.
+ */
+size_t mu_calendar_queue_buckets(const mu_calendar_queue_t *q);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_CALENDAR_QUEUE_H_ */
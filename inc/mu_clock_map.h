@@ -0,0 +1,153 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_clock_map.h
+ * @brief Estimate the mapping from device ticks onto host time.
+ *
+ * A gateway pairs each timestamp reported by an attached device (a wrapping
+ * 32-bit tick counter, e.g. the SAMD21's 1 mSec RTC) with the host time at
+ * which it was received.  Transport delay is never negative, so every sample
+ * lies on or above the true device-to-host line.  The clock map keeps the
+ * lower convex hull of recent samples (Andrew's monotone chain, amortized O(1)
+ * per sample in a fixed-size ring) and takes its offset and skew from the hull
+ * edge spanning the middle of the window.  Samples that were delayed in
+ * transit simply never make it onto the hull.
+ *
+ * Converting a device tick is one fixed-point multiply-add (see
+ * mu_timebase_map_apply()) followed by mu_time_offset().
+ */
+
+#ifndef _MU_CLOCK_MAP_H_
+#define _MU_CLOCK_MAP_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_timebase.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_CLOCK_MAP_HULL_CAPACITY
+#define MU_CLOCK_MAP_HULL_CAPACITY 32 ///< Lower hull vertices retained
+#endif
+
+#ifndef MU_CLOCK_MAP_MAX_SKEW_PPB
+#define MU_CLOCK_MAP_MAX_SKEW_PPB 1000000 ///< Estimates beyond +/-1000 ppm are clamped
+#endif
+
+/**
+ * @brief A vertex of the lower hull.
+ */
+typedef struct {
+    int64_t dev;  ///< Device ticks relative to the device origin
+    int64_t host; ///< Host time relative to the host origin, in mu_time_rel_t
+} mu_clock_map_point_t;
+
+/**
+ * @brief Device-to-host clock map.
+ */
+typedef struct {
+    uint32_t device_hz;        ///< Nominal device tick rate
+    uint32_t sample_count;     ///< Samples offered since init or reset
+    uint64_t last_dev;         ///< Last device tick, extended to 64 bits
+    uint64_t dev_origin;       ///< Extended device ticks of the first sample
+    mu_time_abs_t host_origin; ///< Host time of the first sample
+    mu_clock_map_point_t hull[MU_CLOCK_MAP_HULL_CAPACITY];
+    size_t hull_head;          ///< Index of the oldest hull vertex
+    size_t hull_len;           ///< Number of hull vertices
+    mu_timebase_map_t map;     ///< Current estimate: extended ticks -> host rel
+} mu_clock_map_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a clock map.
+ *
+ * @param cm The clock map to initialize.
+ * @param device_hz The nominal device tick rate.
+ */
+void mu_clock_map_init(mu_clock_map_t *cm, uint32_t device_hz);
+
+/**
+ * @brief Discard all samples, e.g. after the device resets its counter.
+ */
+void mu_clock_map_reset(mu_clock_map_t *cm);
+
+/**
+ * @brief Add a paired (device ticks, host receive time) sample and update the
+ * estimate.
+ *
+ * Samples must arrive in device order and within 2^31 ticks of each other.
+ * Samples that do not advance the device counter are ignored.
+ */
+void mu_clock_map_add_sample(mu_clock_map_t *cm, uint32_t device_ticks,
+                             mu_time_abs_t host_time);
+
+/**
+ * @brief Return true once at least one sample has been added.
+ */
+bool mu_clock_map_is_valid(const mu_clock_map_t *cm);
+
+/**
+ * @brief Convert device ticks to host time using the current estimate.
+ *
+ * The ticks must be within 2^31 ticks of the most recent sample.
+ */
+mu_time_abs_t mu_clock_map_to_host(const mu_clock_map_t *cm,
+                                   uint32_t device_ticks);
+
+/**
+ * @brief Return the estimated device clock error in parts per billion.
+ *
+ * Positive values mean the device runs fast.
+ */
+int32_t mu_clock_map_skew_ppb(const mu_clock_map_t *cm);
+
+/**
+ * @brief Return the number of vertices on the lower hull.
+ */
+size_t mu_clock_map_hull_size(const mu_clock_map_t *cm);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_CLOCK_MAP_H_ */
@@ -0,0 +1,219 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_cron.h
+ * @brief Cron expressions compiled to bitsets, and a recurring-job scheduler
+ * on a timer wheel.
+ *
+ * mu_cron_compile() turns a five-field cron expression
+ *
+ *     minute hour day-of-month month day-of-week
+ *
+ * into one bitset per field.  Fields take `*`, values, ranges `a-b`, steps
+ * (`*`, `a` or `a-b` followed by `/n`) and comma-separated lists; months and
+ * weekdays also take three-letter names, and weekday 7 is Sunday.  The
+ * macros @yearly, @annually, @monthly, @weekly, @daily, @midnight and @hourly
+ * stand for their usual expansions.  As in Vixie cron, when either day
+ * field starts with `*` a day must match both; only when both are restricted
+ * does a day matching either one match.
+ *
+ * Finding the next occurrence never steps minute by minute: each field is
+ * resolved with a find-first-set on its bitset shifted past the current
+ * value, and the day field is the day-of-month set combined with the
+ * weekday set rotated onto that month.  A search costs a handful of bit
+ * operations per month it has to skip.
+ *
+ * Expressions are evaluated in local time through a mu_time_bucket_zone_t.
+ * A local time skipped by a forward UTC offset change runs as if the old
+ * offset still held, i.e. one gap later (02:30 becomes 03:30), as mktime()
+ * normalizes it; a local time repeated by a backward change runs once, at
+ * its first occurrence, for jobs run by a mu_cron_sched_t.
+ *
+ * mu_cron_sched_t runs jobs on a mu_timer_wheel_t: each job is one intrusive
+ * timer armed for its next occurrence and re-armed when it fires, so tens of
+ * thousands of schedules cost nothing between firings.  A wheel with a
+ * resolution of a second or more suits it.
+ *
+ * This module requires a POSIX platform (see mu_time_bucket.h).
+ */
+
+#ifndef _MU_CRON_H_
+#define _MU_CRON_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_time_bucket.h"
+#include "mu_timer_wheel.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_CRON_SEARCH_MONTHS
+#define MU_CRON_SEARCH_MONTHS 120 ///< Horizon; Feb 29 can be 8 years off
+#endif
+
+/**
+ * @brief A compiled cron expression.  Treat the fields as private.
+ */
+typedef struct {
+    uint64_t minutes;  ///< Bits 0..59
+    uint32_t hours;    ///< Bits 0..23
+    uint32_t days;     ///< Bits 1..31
+    uint16_t months;   ///< Bits 1..12
+    uint8_t weekdays;  ///< Bits 0..6, Sunday is 0
+    bool any_day;      ///< Day-of-month field started with `*`
+    bool any_weekday;  ///< Day-of-week field started with `*`
+} mu_cron_t;
+
+struct mu_cron_job;
+
+/**
+ * @brief Job callback.
+ *
+ * @param job The job.  It may be stopped from within.
+ * @param when The occurrence being run.
+ * @param arg The argument given to mu_cron_job_init().
+ */
+typedef void (*mu_cron_fn)(struct mu_cron_job *job, mu_time_abs_t when,
+                           void *arg);
+
+/**
+ * @brief A scheduler.  Treat the fields as private.
+ */
+typedef struct {
+    mu_timer_wheel_t *wheel;
+    mu_time_bucket_zone_t *zone;
+} mu_cron_sched_t;
+
+/**
+ * @brief A recurring job.  Treat the fields as private.
+ */
+typedef struct mu_cron_job {
+    mu_timer_t timer;
+    const mu_cron_t *cron;
+    mu_cron_sched_t *sched;
+    mu_cron_fn fn;
+    void *arg;
+    mu_time_abs_t next; ///< Next occurrence, while running
+    int64_t last_local; ///< Local second of the last occurrence run
+} mu_cron_job_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Compile a cron expression.
+ *
+ * @return false if the expression is malformed.
+ */
+bool mu_cron_compile(mu_cron_t *cron, const char *expr);
+
+/**
+ * @brief Return true if a local time (seconds since 1970-01-01 00:00 local)
+ * falls in a matching minute.
+ */
+bool mu_cron_matches_local(const mu_cron_t *cron, int64_t local);
+
+/**
+ * @brief Find the first matching minute strictly after a local time.
+ *
+ * @param cron The expression.
+ * @param after Local seconds since 1970-01-01 00:00 local.
+ * @param next Receives the local second the matching minute starts.
+ * @return false if nothing matches within MU_CRON_SEARCH_MONTHS (e.g.
+ * "0 0 30 2 *").
+ */
+bool mu_cron_next_local(const mu_cron_t *cron, int64_t after, int64_t *next);
+
+/**
+ * @brief Find the first occurrence strictly after a time.
+ *
+ * @param cron The expression.
+ * @param zone The time zone the expression is read in.
+ * @param after The time to search from.
+ * @param next Receives the occurrence.
+ * @return false if nothing matches within MU_CRON_SEARCH_MONTHS.
+ */
+bool mu_cron_next(const mu_cron_t *cron, mu_time_bucket_zone_t *zone,
+                  mu_time_abs_t after, mu_time_abs_t *next);
+
+/**
+ * @brief Initialize a scheduler.
+ *
+ * @param sched The scheduler.
+ * @param wheel The timer wheel its jobs run on.
+ * @param zone The time zone expressions are read in.
+ */
+void mu_cron_sched_init(mu_cron_sched_t *sched, mu_timer_wheel_t *wheel,
+                        mu_time_bucket_zone_t *zone);
+
+/**
+ * @brief Initialize a job.  The expression must outlive it.
+ */
+void mu_cron_job_init(mu_cron_job_t *job, const mu_cron_t *cron, mu_cron_fn fn,
+                      void *arg);
+
+/**
+ * @brief Start a job, arming it for its first occurrence after `now`.
+ *
+ * @return false if the expression never matches.
+ */
+bool mu_cron_job_start(mu_cron_sched_t *sched, mu_cron_job_t *job,
+                       mu_time_abs_t now);
+
+/**
+ * @brief Stop a job.
+ */
+void mu_cron_job_stop(mu_cron_job_t *job);
+
+/**
+ * @brief Return true if a job is armed.
+ */
+bool mu_cron_job_is_running(const mu_cron_job_t *job);
+
+/**
+ * @brief Return a running job's next occurrence.
+ */
+mu_time_abs_t mu_cron_job_next(const mu_cron_job_t *job);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_CRON_H_ */
@@ -0,0 +1,195 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_duration_sketch.h
+ * @brief Mergeable relative-error quantile sketch for mu_time_rel_t durations.
+ *
+ * A DDSketch-style sketch: durations are counted in logarithmic buckets whose
+ * width is a fixed fraction of their value, so any quantile is reported within
+ * a bounded relative error regardless of the distribution.  The bucket index
+ * comes from the position of the leading one bit plus the next
+ * MU_DURATION_SKETCH_SUB_BITS bits (no log() call), which gives a relative
+ * error of at most 2^-(MU_DURATION_SKETCH_SUB_BITS + 1), about 1.6% with the
+ * default of 5.
+ *
+ * Counts live in a contiguous window of caller-provided bins that follows the
+ * populated range.  When the range outgrows the window, the lowest buckets are
+ * collapsed into one, preserving the accuracy of the upper (tail) quantiles.
+ * Sketches with the same configuration merge by adding bins, and serialize to
+ * a few bytes per populated bucket.
+ */
+
+#ifndef _MU_DURATION_SKETCH_H_
+#define _MU_DURATION_SKETCH_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_DURATION_SKETCH_SUB_BITS
+#define MU_DURATION_SKETCH_SUB_BITS 5 ///< Buckets per octave = 2^SUB_BITS
+#endif
+
+/**
+ * @brief A duration sketch.
+ */
+typedef struct {
+    uint32_t *bins;     ///< Caller-provided bin storage
+    uint16_t max_bins;  ///< Size of bins[]
+    uint16_t span;      ///< Bins in use
+    uint16_t offset;    ///< Bucket index of bins[0]
+    uint16_t collapsed; ///< Non-zero once low buckets have been collapsed
+    uint64_t count;     ///< Durations recorded
+    int64_t sum;        ///< Sum of recorded durations
+    mu_time_rel_t min;  ///< Smallest recorded duration
+    mu_time_rel_t max;  ///< Largest recorded duration
+} mu_duration_sketch_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize an empty sketch.
+ *
+ * @param sketch The sketch to initialize.
+ * @param bins Storage for the bucket counts.
+ * @param max_bins Number of entries in bins[].  Each octave of range covered
+ * without collapsing needs 2^MU_DURATION_SKETCH_SUB_BITS bins.
+ */
+void mu_duration_sketch_init(mu_duration_sketch_t *sketch, uint32_t *bins,
+                             uint16_t max_bins);
+
+/**
+ * @brief Discard all recorded durations.
+ */
+void mu_duration_sketch_clear(mu_duration_sketch_t *sketch);
+
+/**
+ * @brief Record one duration.  Negative durations are recorded as zero.
+ */
+void mu_duration_sketch_record(mu_duration_sketch_t *sketch,
+                               mu_time_rel_t duration);
+
+/**
+ * @brief Record a duration `n` times.
+ */
+void mu_duration_sketch_record_n(mu_duration_sketch_t *sketch,
+                                 mu_time_rel_t duration, uint32_t n);
+
+/**
+ * @brief Return the number of recorded durations.
+ */
+uint64_t mu_duration_sketch_count(const mu_duration_sketch_t *sketch);
+
+/**
+ * @brief Return the sum of recorded durations.
+ */
+int64_t mu_duration_sketch_sum(const mu_duration_sketch_t *sketch);
+
+/**
+ * @brief Return the smallest recorded duration (0 if empty).
+ */
+mu_time_rel_t mu_duration_sketch_min(const mu_duration_sketch_t *sketch);
+
+/**
+ * @brief Return the largest recorded duration (0 if empty).
+ */
+mu_time_rel_t mu_duration_sketch_max(const mu_duration_sketch_t *sketch);
+
+/**
+ * @brief Estimate a quantile.
+ *
+ * @param sketch The sketch.
+ * @param q The quantile, 0.0 to 1.0.
+ * @return The estimated duration (0 if empty).
+ */
+mu_time_rel_t mu_duration_sketch_quantile(const mu_duration_sketch_t *sketch,
+                                          float q);
+
+/**
+ * @brief Estimate several quantiles in one pass over the bins.
+ *
+ * @param sketch The sketch.
+ * @param qs Quantiles in ascending order, 0.0 to 1.0.
+ * @param n Number of quantiles.
+ * @param out Receives one estimate per quantile.
+ */
+void mu_duration_sketch_quantiles(const mu_duration_sketch_t *sketch,
+                                  const float *qs, size_t n,
+                                  mu_time_rel_t *out);
+
+/**
+ * @brief Return the guaranteed relative error of quantile estimates.
+ */
+float mu_duration_sketch_relative_error(void);
+
+/**
+ * @brief Add the contents of `src` to `dst`.
+ */
+void mu_duration_sketch_merge(mu_duration_sketch_t *dst,
+                              const mu_duration_sketch_t *src);
+
+/**
+ * @brief Serialize a sketch into a compact byte string.
+ *
+ * @param sketch The sketch.
+ * @param buf The output buffer.
+ * @param size The size of the output buffer.
+ * @return The number of bytes written, or 0 if buf is too small.
+ */
+size_t mu_duration_sketch_serialize(const mu_duration_sketch_t *sketch,
+                                    uint8_t *buf, size_t size);
+
+/**
+ * @brief Replace a sketch's contents with a serialized sketch.
+ *
+ * @return false if the data is malformed, was produced with a different
+ * MU_DURATION_SKETCH_SUB_BITS, or needs more bins than the sketch has.
+ */
+bool mu_duration_sketch_deserialize(mu_duration_sketch_t *sketch,
+                                    const uint8_t *buf, size_t len);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_DURATION_SKETCH_H_ */
@@ -0,0 +1,152 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_fire_queue.h
+ * @brief Wait-free hand-off of timer fires from signal handlers and ISRs to
+ * the main loop.
+ *
+ * A hardware timer interrupt or a POSIX timer signal should do as little as
+ * possible: note that something fired and return.  A mu_fire_t is such a
+ * note.  It is attached to one mu_fire_queue_t, and mu_fire_post() marks it
+ * pending from any context -- a signal handler, an ISR, or another thread --
+ * in two atomic read-modify-writes, with no loop, lock or allocation.  The
+ * queue's owner calls mu_fire_queue_drain() from ordinary context, which runs
+ * each pending entry's callback once with the number of posts since the last
+ * drain, so a burst of posts to one entry coalesces instead of overflowing.
+ *
+ * Pending entries are found through a bitmap, so a drain costs one atomic
+ * exchange per 32 attached entries plus one per entry fired, and delivers
+ * entries in attachment order.
+ *
+ * mu_fire_post() and mu_fire_queue_is_pending() are the only functions safe
+ * in signal or interrupt context.  They require lock-free 32-bit atomics
+ * (ATOMIC_INT_LOCK_FREE == 2); on cores without exclusive loads and stores,
+ * such as the Cortex-M0+, the toolchain's atomics must mask interrupts.
+ */
+
+#ifndef _MU_FIRE_QUEUE_H_
+#define _MU_FIRE_QUEUE_H_
+
+// *****************************************************************************
+// Includes
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_FIRE_QUEUE_CAPACITY
+#define MU_FIRE_QUEUE_CAPACITY 64 ///< Entries per queue
+#endif
+
+#define MU_FIRE_QUEUE_WORDS ((MU_FIRE_QUEUE_CAPACITY + 31) / 32)
+
+struct mu_fire;
+
+/**
+ * @brief Fire callback, run by mu_fire_queue_drain().
+ *
+ * @param fire The entry.
+ * @param posts Posts since the entry last fired, at least 1.
+ * @param arg The entry's argument.
+ */
+typedef void (*mu_fire_fn)(struct mu_fire *fire, uint32_t posts, void *arg);
+
+/**
+ * @brief A fire queue entry.  Treat the fields as private.
+ */
+typedef struct mu_fire {
+    atomic_uint posts; ///< Posts not yet drained
+    mu_fire_fn fn;
+    void *arg;
+    uint16_t index;    ///< Bit in the queue's pending map
+} mu_fire_t;
+
+/**
+ * @brief A fire queue.  Treat the fields as private.
+ */
+typedef struct {
+    mu_fire_t *entries[MU_FIRE_QUEUE_CAPACITY];
+    atomic_uint pending[MU_FIRE_QUEUE_WORDS]; ///< One bit per entry
+    size_t count;                             ///< Attached entries
+} mu_fire_queue_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize an empty fire queue.
+ */
+void mu_fire_queue_init(mu_fire_queue_t *q);
+
+/**
+ * @brief Initialize an entry and attach it to a queue.
+ *
+ * Not signal-safe: attach entries before enabling the handlers that post them.
+ *
+ * @return false if the queue already holds MU_FIRE_QUEUE_CAPACITY entries.
+ */
+bool mu_fire_queue_attach(mu_fire_queue_t *q, mu_fire_t *fire, mu_fire_fn fn,
+                          void *arg);
+
+/**
+ * @brief Mark an entry pending.  Wait-free; safe in signal and interrupt
+ * context and from any thread.
+ */
+void mu_fire_post(mu_fire_queue_t *q, mu_fire_t *fire);
+
+/**
+ * @brief Return true if any entry is pending.  Wait-free.
+ */
+bool mu_fire_queue_is_pending(mu_fire_queue_t *q);
+
+/**
+ * @brief Run the callback of every pending entry.  Owner only.
+ *
+ * Posts that arrive during the drain are delivered by it or by the next one,
+ * never lost.  Callbacks may post again.
+ *
+ * @return The number of callbacks run.
+ */
+size_t mu_fire_queue_drain(mu_fire_queue_t *q);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_FIRE_QUEUE_H_ */
@@ -0,0 +1,215 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_openmetrics.h
+ * @brief OpenMetrics text exposition of mu_time structures.
+ *
+ * Register the structures to expose (duration sketches, timer wheels, clock
+ * maps, or a gauge callback) once, each with a metric name and a preformatted
+ * label set.  A scrape then renders the text format straight from the live
+ * structures into the caller's buffer: no copying into another metrics
+ * library, no allocation, no locks.  Rendering is incremental -- a cursor
+ * records where the previous buffer ended, so a large exposition can be
+ * streamed out through a small socket buffer.
+ *
+ * The exporter only reads the registered structures.  It never blocks the
+ * threads that update them, but a structure updated during a scrape may be
+ * rendered partly before and partly after the update.
+ *
+ * Durations are rendered in seconds, the OpenMetrics base unit.
+ */
+
+#ifndef _MU_OPENMETRICS_H_
+#define _MU_OPENMETRICS_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_clock_map.h"
+#include "mu_duration_sketch.h"
+#include "mu_time.h"
+#include "mu_timer_wheel.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_OPENMETRICS_NAME_MAX
+#define MU_OPENMETRICS_NAME_MAX 64 ///< Longest metric name, including NUL
+#endif
+
+#ifndef MU_OPENMETRICS_LABELS_MAX
+#define MU_OPENMETRICS_LABELS_MAX 128 ///< Longest label set, including NUL
+#endif
+
+/**
+ * @brief Buffers passed to mu_openmetrics_render() must hold at least one
+ * line of this many bytes.
+ */
+#define MU_OPENMETRICS_LINE_MAX                                                \
+    (MU_OPENMETRICS_NAME_MAX + MU_OPENMETRICS_LABELS_MAX + 96)
+
+/**
+ * @brief Quantiles rendered for each duration sketch.
+ */
+#define MU_OPENMETRICS_QUANTILES {0.5f, 0.9f, 0.99f, 0.999f}
+#define MU_OPENMETRICS_QUANTILE_COUNT 4
+
+typedef enum {
+    MU_OPENMETRICS_SKETCH,      ///< summary: quantiles, _sum, _count
+    MU_OPENMETRICS_TIMER_WHEEL, ///< _pending per level, activity counters
+    MU_OPENMETRICS_CLOCK_MAP,   ///< _skew_ppb, _hull_vertices, _samples
+    MU_OPENMETRICS_GAUGE_FN,    ///< gauge read through a callback
+} mu_openmetrics_kind_t;
+
+/**
+ * @brief Gauge callback for MU_OPENMETRICS_GAUGE_FN series.
+ */
+typedef int64_t (*mu_openmetrics_gauge_fn)(void *arg);
+
+/**
+ * @brief A registered series.  Treat the fields as private.
+ */
+typedef struct {
+    mu_openmetrics_kind_t kind;
+    const void *source;
+    mu_openmetrics_gauge_fn gauge_fn;
+    uint8_t name_len;
+    uint8_t labels_len;
+    char name[MU_OPENMETRICS_NAME_MAX];
+    char labels[MU_OPENMETRICS_LABELS_MAX];
+} mu_openmetrics_series_t;
+
+/**
+ * @brief An exporter: a table of series kept grouped by metric family.
+ */
+typedef struct {
+    mu_openmetrics_series_t *series;
+    size_t capacity;
+    size_t count;
+} mu_openmetrics_t;
+
+/**
+ * @brief Position within a rendering.  Treat the fields as private.
+ */
+typedef struct {
+    size_t group;     ///< First series of the current family group
+    size_t group_end; ///< One past the last series of the group
+    size_t member;    ///< Current series
+    uint8_t family;   ///< Family within the series kind
+    uint8_t line;     ///< Line within the series
+    uint8_t state;
+    mu_time_rel_t quantiles[MU_OPENMETRICS_QUANTILE_COUNT];
+} mu_openmetrics_cursor_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize an exporter over caller-provided series storage.
+ */
+void mu_openmetrics_init(mu_openmetrics_t *exporter,
+                         mu_openmetrics_series_t *storage, size_t capacity);
+
+/**
+ * @brief Expose a duration sketch as a summary.
+ *
+ * @param exporter The exporter.
+ * @param name The metric name, e.g. "http_request_duration_seconds".
+ * @param labels Preformatted label set without braces, e.g.
+ * `endpoint="/api",method="GET"`, or "" for none.  Values must already be
+ * escaped.
+ * @param sketch The sketch.  It must outlive its registration.
+ * @return false if the exporter is full or a string is too long.
+ */
+bool mu_openmetrics_add_sketch(mu_openmetrics_t *exporter, const char *name,
+                               const char *labels,
+                               const mu_duration_sketch_t *sketch);
+
+/**
+ * @brief Expose a timer wheel's per-level occupancy and activity counters.
+ *
+ * Register the wheel's lag sketch (if any) with mu_openmetrics_add_sketch().
+ */
+bool mu_openmetrics_add_timer_wheel(mu_openmetrics_t *exporter,
+                                    const char *name, const char *labels,
+                                    const mu_timer_wheel_t *wheel);
+
+/**
+ * @brief Expose a clock map's calibration state.
+ */
+bool mu_openmetrics_add_clock_map(mu_openmetrics_t *exporter, const char *name,
+                                  const char *labels, const mu_clock_map_t *cm);
+
+/**
+ * @brief Expose a gauge read through a callback at render time.
+ */
+bool mu_openmetrics_add_gauge(mu_openmetrics_t *exporter, const char *name,
+                              const char *labels, mu_openmetrics_gauge_fn fn,
+                              void *arg);
+
+/**
+ * @brief Start a new rendering.
+ */
+void mu_openmetrics_cursor_init(mu_openmetrics_cursor_t *cursor);
+
+/**
+ * @brief Render as many whole lines as fit into a buffer.
+ *
+ * Call repeatedly with the same cursor until mu_openmetrics_is_done().
+ * The output is not NUL terminated.
+ *
+ * @param exporter The exporter.
+ * @param cursor The rendering position, advanced past the lines written.
+ * @param buf The output buffer, at least MU_OPENMETRICS_LINE_MAX bytes.
+ * @param size The size of the output buffer.
+ * @return The number of bytes written.
+ */
+size_t mu_openmetrics_render(const mu_openmetrics_t *exporter,
+                             mu_openmetrics_cursor_t *cursor, char *buf,
+                             size_t size);
+
+/**
+ * @brief Return true once the final "# EOF" line has been rendered.
+ */
+bool mu_openmetrics_is_done(const mu_openmetrics_cursor_t *cursor);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_OPENMETRICS_H_ */
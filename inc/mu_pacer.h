@@ -0,0 +1,197 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_pacer.h
+ * @brief Packet pacing: per-flow send times at fixed rates, released in
+ * batches from a microsecond timer wheel.
+ *
+ * Each flow has a rate in bytes per second, held as a 32.32 fixed-point
+ * number of nanoseconds per byte, so accounting for a sent packet is a couple
+ * of integer multiplies and the sub-nanosecond remainder carries over to the
+ * next packet: a flow never drifts from its rate however many packets it
+ * sends.
+ *
+ * A flow with a packet ready is scheduled.  If its next send time has come it
+ * is due at once, otherwise it waits on a mu_timer_wheel_t with 1 uSec ticks.
+ * mu_pacer_poll() advances the wheel and hands back up to a batch of due
+ * flows in the order they became due; the sender transmits one packet for
+ * each, reports it with mu_pacer_sent() and schedules the flow again if it
+ * has more to send.
+ *
+ * A flow that falls behind (a late poll, a sender stall) may catch up by at
+ * most the pacer's max_lag, so a stall never turns into a line-rate burst.
+ * A pacer belongs to one thread.
+ */
+
+#ifndef _MU_PACER_H_
+#define _MU_PACER_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_timer_wheel.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_PACER_RESOLUTION 1000 ///< Wheel tick, 1 uSec in mu_time_rel_t
+
+/**
+ * @brief A paced flow, embedded in the caller's flow state.  Treat the fields
+ * as private.
+ */
+typedef struct mu_pacer_flow {
+    mu_timer_t timer;               ///< Must stay first
+    struct mu_pacer_flow *next_due; ///< Link in the due list
+    mu_time_abs_t next_send;        ///< Earliest time of the next packet
+    uint64_t rate;                  ///< Bytes per second, 0 for unpaced
+    uint64_t ns_per_byte;           ///< Integer part of 1e9 / rate
+    uint32_t ns_per_byte_frac;      ///< Fractional part, Q0.32
+    uint32_t carry;                 ///< Fractional nSec owed, Q0.32
+    uint64_t packets;               ///< Packets sent
+    uint64_t bytes;                 ///< Bytes sent
+    void *arg;                      ///< Caller's context
+    uint8_t state;
+} mu_pacer_flow_t;
+
+/**
+ * @brief A pacer.  Treat the fields as private.
+ */
+typedef struct {
+    mu_timer_wheel_t wheel;
+    mu_pacer_flow_t *due_head;
+    mu_pacer_flow_t *due_tail;
+    size_t due_count;
+    mu_time_rel_t max_lag;
+} mu_pacer_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a pacer.
+ *
+ * @param p The pacer.
+ * @param now The current time.
+ * @param max_lag How far behind schedule a flow may fall and still catch up.
+ */
+void mu_pacer_init(mu_pacer_t *p, mu_time_abs_t now, mu_time_rel_t max_lag);
+
+/**
+ * @brief Initialize a flow, idle and ready to send at once.
+ *
+ * @param flow The flow.
+ * @param rate Bytes per second, or 0 for no pacing.
+ * @param now The current time.
+ * @param arg Caller's context, returned by mu_pacer_flow_arg().
+ */
+void mu_pacer_flow_init(mu_pacer_flow_t *flow, uint64_t rate,
+                        mu_time_abs_t now, void *arg);
+
+/**
+ * @brief Change a flow's rate.  Applies from the next packet sent.
+ */
+void mu_pacer_set_rate(mu_pacer_flow_t *flow, uint64_t rate);
+
+/**
+ * @brief Mark a flow as having a packet ready.  No effect if it is already
+ * scheduled.
+ */
+void mu_pacer_schedule(mu_pacer_t *p, mu_pacer_flow_t *flow, mu_time_abs_t now);
+
+/**
+ * @brief Remove a flow from the pacer, e.g. when it closes.
+ */
+void mu_pacer_unschedule(mu_pacer_t *p, mu_pacer_flow_t *flow);
+
+/**
+ * @brief Collect due flows.
+ *
+ * @param p The pacer.
+ * @param now The current time.
+ * @param batch Receives up to `max` due flows, oldest first.  Flows beyond
+ * `max` remain due for the next call.
+ * @param max Capacity of `batch`.
+ * @return The number of flows written to `batch`.
+ */
+size_t mu_pacer_poll(mu_pacer_t *p, mu_time_abs_t now,
+                     mu_pacer_flow_t **batch, size_t max);
+
+/**
+ * @brief Account for a packet sent on a flow and compute its next send time.
+ *
+ * @param p The pacer.
+ * @param flow The flow, as returned by mu_pacer_poll().
+ * @param bytes The packet's size on the wire.
+ * @param now The time it was sent.
+ */
+void mu_pacer_sent(mu_pacer_t *p, mu_pacer_flow_t *flow, uint32_t bytes,
+                   mu_time_abs_t now);
+
+/**
+ * @brief Return the time the flow may next send.
+ */
+mu_time_abs_t mu_pacer_next_send(const mu_pacer_flow_t *flow);
+
+/**
+ * @brief Return the flow's context.
+ */
+void *mu_pacer_flow_arg(const mu_pacer_flow_t *flow);
+
+/**
+ * @brief Find when mu_pacer_poll() next has work.
+ *
+ * @param p The pacer.
+ * @param now The current time, reported if flows are already due.
+ * @param when Receives the time.
+ * @return false if no flow is scheduled.
+ */
+bool mu_pacer_next_deadline(const mu_pacer_t *p, mu_time_abs_t now,
+                            mu_time_abs_t *when);
+
+/**
+ * @brief Return the number of flows due but not yet collected.
+ */
+size_t mu_pacer_due(const mu_pacer_t *p);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_PACER_H_ */
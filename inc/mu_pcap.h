@@ -0,0 +1,280 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_pcap.h
+ * @brief Streaming reader and writer for pcap / pcapng capture files with
+ * time-range seeking (POSIX hosts).
+ *
+ * The reader maps the whole file with mmap() and hands out records that
+ * point straight into the mapping, so reading allocates nothing per record.
+ * It accepts classic pcap in either byte order with microsecond
+ * (0xa1b2c3d4) or nanosecond (0xa1b23c4d) timestamps, and pcapng Enhanced
+ * Packet Blocks, honoring each interface's if_tsresol and if_tsoffset.  Other
+ * pcapng blocks (including Simple Packet Blocks, which carry no timestamp) are
+ * skipped.  Record timestamps are returned as mu_time_abs_t.
+ *
+ * The writer produces nanosecond pcap through a large stdio buffer.
+ *
+ * A sidecar index makes time-range queries cheap.  Every `stride` records it
+ * stores the file offset and the latest timestamp of all earlier records.
+ * That running maximum never decreases even if capture times do, so a binary
+ * search finds an offset before which no record can be in the range.  The
+ * index is a flat file of little-endian (int64 nanoseconds, uint64 offset)
+ * pairs after an 8-byte magic, and is memory-mapped in turn.
+ */
+
+#ifndef _MU_PCAP_H_
+#define _MU_PCAP_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_PCAP_MAGIC_MICROS 0xa1b2c3d4
+#define MU_PCAP_MAGIC_NANOS 0xa1b23c4d
+
+// pcapng interfaces tracked per section
+#define MU_PCAP_MAX_INTERFACES 16
+
+// Records between sidecar index entries, by default
+#define MU_PCAP_INDEX_STRIDE 1024
+
+// stdio buffer of the writer
+#define MU_PCAP_WRITE_BUFFER (1 << 20)
+
+typedef enum {
+    MU_PCAP_FORMAT_PCAP,
+    MU_PCAP_FORMAT_PCAPNG,
+} mu_pcap_format_t;
+
+/**
+ * @brief A record.  `data` points into the reader's mapping and stays valid
+ * until the reader is closed.
+ */
+typedef struct {
+    mu_time_abs_t time;
+    const uint8_t *data;
+    uint32_t caplen;    ///< Bytes captured (at data)
+    uint32_t origlen;   ///< Bytes on the wire
+    uint32_t interface; ///< pcapng interface, 0 for pcap
+    uint64_t offset;    ///< File offset of the record
+} mu_pcap_record_t;
+
+/**
+ * @brief A pcapng interface: timestamp units and offset.
+ */
+typedef struct {
+    uint16_t linktype;
+    uint8_t tsresol;     ///< if_tsresol: bit 7 set = 2^-n, else 10^-n
+    int64_t tsoffset_ns; ///< if_tsoffset, in nanoseconds
+} mu_pcap_interface_t;
+
+/**
+ * @brief A reader.  Treat the fields as private.
+ */
+typedef struct {
+    const uint8_t *base;
+    size_t size;
+    size_t pos;       ///< Offset of the next record or block
+    size_t scanned;   ///< pcapng: blocks before this have been seen
+    bool mapped;      ///< base came from mmap()
+    bool swap;        ///< File byte order differs from the host's
+    bool nanos;       ///< pcap: nanosecond timestamps
+    bool malformed;   ///< Reading stopped at a bad record
+    mu_pcap_format_t format;
+    uint32_t linktype;
+    uint32_t n_interfaces;
+    mu_pcap_interface_t interfaces[MU_PCAP_MAX_INTERFACES];
+} mu_pcap_reader_t;
+
+/**
+ * @brief A writer.  Treat the fields as private.
+ */
+typedef struct {
+    FILE *file;
+    FILE *index;       ///< Sidecar index, or NULL
+    char *buffer;
+    uint64_t offset;   ///< Bytes written so far
+    uint64_t records;
+    uint32_t stride;
+    uint32_t snaplen;
+    int64_t max_ns;    ///< Latest timestamp written
+} mu_pcap_writer_t;
+
+/**
+ * @brief A memory-mapped sidecar index.
+ */
+typedef struct {
+    const uint8_t *base;
+    size_t size;
+    size_t count;      ///< Entries
+} mu_pcap_index_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Open and map a pcap or pcapng file.
+ *
+ * @return false if the file cannot be mapped or has no valid header.
+ */
+bool mu_pcap_reader_open(mu_pcap_reader_t *reader, const char *path);
+
+/**
+ * @brief Read a capture already in memory.  The buffer must outlive the
+ * reader.
+ */
+bool mu_pcap_reader_init_buffer(mu_pcap_reader_t *reader, const void *data,
+                                size_t size);
+
+/**
+ * @brief Unmap the file.
+ */
+void mu_pcap_reader_close(mu_pcap_reader_t *reader);
+
+/**
+ * @brief Read the next record.
+ *
+ * @return false at the end of the file or at a malformed record (see
+ * mu_pcap_reader_is_malformed()).
+ */
+bool mu_pcap_reader_next(mu_pcap_reader_t *reader, mu_pcap_record_t *record);
+
+/**
+ * @brief Return true if reading stopped at a malformed or truncated record.
+ */
+bool mu_pcap_reader_is_malformed(const mu_pcap_reader_t *reader);
+
+/**
+ * @brief Return the file format.
+ */
+mu_pcap_format_t mu_pcap_reader_format(const mu_pcap_reader_t *reader);
+
+/**
+ * @brief Return the link type of a pcap file or of a pcapng interface.
+ */
+uint32_t mu_pcap_reader_linktype(const mu_pcap_reader_t *reader,
+                                 uint32_t interface);
+
+/**
+ * @brief Continue reading at a record offset from mu_pcap_record_t or an
+ * index.
+ */
+void mu_pcap_reader_seek(mu_pcap_reader_t *reader, uint64_t offset);
+
+/**
+ * @brief Return to the first record.
+ */
+void mu_pcap_reader_rewind(mu_pcap_reader_t *reader);
+
+/**
+ * @brief Create a nanosecond pcap file.
+ *
+ * @param writer The writer.
+ * @param path The capture file.
+ * @param linktype The LINKTYPE_ value of every record.
+ * @param snaplen The capture length limit; longer records are truncated.
+ * @param index_path Sidecar index file to write alongside, or NULL.
+ * @param stride Records per index entry, or 0 for MU_PCAP_INDEX_STRIDE.
+ * @return false if a file cannot be created.
+ */
+bool mu_pcap_writer_open(mu_pcap_writer_t *writer, const char *path,
+                         uint32_t linktype, uint32_t snaplen,
+                         const char *index_path, uint32_t stride);
+
+/**
+ * @brief Append a record.
+ *
+ * @param writer The writer.
+ * @param time The capture time.
+ * @param data The captured bytes.
+ * @param length The original length; at most snaplen bytes are stored.
+ * @return false on a write error.
+ */
+bool mu_pcap_writer_write(mu_pcap_writer_t *writer, mu_time_abs_t time,
+                          const void *data, uint32_t length);
+
+/**
+ * @brief Flush and close the capture and its index.
+ *
+ * @return false if a write failed.
+ */
+bool mu_pcap_writer_close(mu_pcap_writer_t *writer);
+
+/**
+ * @brief Write a sidecar index for an existing capture.
+ *
+ * @param reader The capture; it is rewound afterwards.
+ * @param path The index file.
+ * @param stride Records per entry, or 0 for MU_PCAP_INDEX_STRIDE.
+ * @return false on a write error.
+ */
+bool mu_pcap_index_build(mu_pcap_reader_t *reader, const char *path,
+                         uint32_t stride);
+
+/**
+ * @brief Map a sidecar index.
+ */
+bool mu_pcap_index_open(mu_pcap_index_t *index, const char *path);
+
+/**
+ * @brief Unmap a sidecar index.
+ */
+void mu_pcap_index_close(mu_pcap_index_t *index);
+
+/**
+ * @brief Position a reader so that every record before it is earlier than
+ * `start`, skipping as much of the file as the index allows.
+ *
+ * Records are then read with mu_pcap_reader_next() until the caller's range
+ * ends.  Records out of time order remain possible after the seek point.
+ */
+void mu_pcap_reader_seek_time(mu_pcap_reader_t *reader,
+                              const mu_pcap_index_t *index,
+                              mu_time_abs_t start);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_PCAP_H_ */
@@ -0,0 +1,277 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_pdes.h
+ * @brief Conservative parallel discrete-event simulation on mu_time virtual
+ * time (POSIX hosts).
+ *
+ * A simulation is split into logical processes (LPs).  Each LP has its own
+ * virtual clock, a mu_calendar_queue_t of pending events, a handler, and a
+ * declared lookahead: the least delay between the time it processes an event
+ * and the time of any event it sends to another LP.
+ *
+ * LPs are spread round-robin over worker threads, which advance in
+ * synchronous windows.  At the start of each window every worker reports the
+ * earliest (next event time + lookahead) among its LPs; the minimum over all
+ * workers bounds the time of any message still to be sent, so every event
+ * before it can be processed in parallel without rollback.  Events for LPs on
+ * other workers travel through lock-free single-producer rings, one per pair
+ * of workers, and are delivered when the window closes.
+ *
+ * Event blocks come from the sending worker's mu_pool_t and are returned to
+ * it from the receiving worker with mu_pool_free_remote().  For a fixed
+ * number of workers a run is deterministic, including the order of events
+ * with equal times.
+ */
+
+#ifndef _MU_PDES_H_
+#define _MU_PDES_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_calendar_queue.h"
+#include "mu_pool.h"
+#include "mu_time.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+// Capacity of each worker-to-worker ring; overflow spills to a list
+#define MU_PDES_RING_CAPACITY 1024
+
+// Calendar buckets per LP
+#define MU_PDES_LP_BUCKETS 4096
+
+// Event blocks per slab of a worker's pool
+#define MU_PDES_SLAB_EVENTS 1024
+
+struct mu_pdes;
+struct mu_pdes_lp;
+
+/**
+ * @brief An event.  The caller's payload follows the header; see
+ * mu_pdes_event_payload().
+ */
+typedef struct mu_pdes_event {
+    mu_calendar_event_t entry; ///< Calendar or spill list linkage
+    mu_pool_t *pool;           ///< Pool the block came from
+    mu_time_abs_t time;        ///< Delivery time
+    uint32_t dst;              ///< Destination LP
+} mu_pdes_event_t;
+
+/**
+ * @brief Event handler.  The event is released after the handler returns.
+ */
+typedef void (*mu_pdes_handler_fn)(struct mu_pdes_lp *lp, mu_pdes_event_t *ev,
+                                   void *ctx);
+
+/**
+ * @brief A logical process.  Treat the fields as private.
+ */
+typedef struct mu_pdes_lp {
+    struct mu_pdes *sim;
+    mu_calendar_queue_t queue;
+    mu_calendar_event_t **buckets;
+    mu_time_abs_t now;        ///< Time of the event being processed
+    mu_time_rel_t lookahead;  ///< Least delay of events sent to other LPs
+    mu_pdes_handler_fn fn;
+    void *ctx;
+    uint32_t id;
+    uint32_t worker;
+} mu_pdes_lp_t;
+
+/**
+ * @brief Single-producer, single-consumer ring between two workers.
+ */
+typedef struct {
+    mu_pdes_event_t **slots;
+    atomic_size_t head;       ///< Next slot to read (consumer)
+    atomic_size_t tail;       ///< Next slot to write (producer)
+    mu_calendar_event_t *spill; ///< Overflow, in send order (producer)
+    mu_calendar_event_t **spill_tail;
+} mu_pdes_ring_t;
+
+/**
+ * @brief A worker thread and the LPs it owns.  Treat the fields as private.
+ */
+typedef struct {
+    struct mu_pdes *sim;
+    mu_pool_t pool;
+    mu_pdes_ring_t *outbound; ///< One ring per destination worker
+    uint32_t index;
+    bool sense;               ///< Barrier sense
+    bool has_next;            ///< Any LP has a pending event
+    mu_time_abs_t next;       ///< Earliest pending event
+    mu_time_abs_t bound;      ///< Earliest next event + lookahead
+    uint64_t events;          ///< Events processed
+    uint64_t remote;          ///< Events sent to other workers
+} mu_pdes_worker_t;
+
+/**
+ * @brief Run statistics.
+ */
+typedef struct {
+    uint64_t events;  ///< Events processed
+    uint64_t remote;  ///< Events exchanged between workers
+    uint64_t windows; ///< Synchronization windows
+} mu_pdes_stats_t;
+
+/**
+ * @brief A simulation.
+ */
+typedef struct mu_pdes {
+    mu_pdes_lp_t *lps;
+    size_t n_lps;
+    mu_pdes_worker_t *workers;
+    size_t n_workers;
+    mu_time_abs_t until;
+    uint64_t windows;
+    atomic_int start;         ///< Thread gate: 0 wait, 1 run, -1 exit
+    atomic_size_t barrier_count;
+    atomic_bool barrier_sense;
+} mu_pdes_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Create a simulation.
+ *
+ * @param sim The simulation to initialize.
+ * @param n_lps The number of logical processes.
+ * @param n_workers The number of worker threads, including the caller's.
+ * @param payload_size Bytes of caller payload carried by each event.
+ * @param start Initial virtual time of every LP.
+ * @return false if memory could not be allocated.
+ */
+bool mu_pdes_init(mu_pdes_t *sim, size_t n_lps, size_t n_workers,
+                  size_t payload_size, mu_time_abs_t start);
+
+/**
+ * @brief Release a simulation and every event still queued.
+ */
+void mu_pdes_destroy(mu_pdes_t *sim);
+
+/**
+ * @brief Set an LP's handler and lookahead.
+ *
+ * @param sim The simulation.
+ * @param lp The LP index.
+ * @param fn The handler for its events.
+ * @param ctx Passed to the handler.
+ * @param lookahead Least delay of any event it sends to another LP.  Larger
+ * lookahead means wider windows and more parallelism; zero is allowed, but
+ * then each window only covers a single instant.
+ */
+void mu_pdes_lp_configure(mu_pdes_t *sim, size_t lp, mu_pdes_handler_fn fn,
+                          void *ctx, mu_time_rel_t lookahead);
+
+/**
+ * @brief Queue an initial event before mu_pdes_run().
+ *
+ * @return The event, whose payload may be filled in, or NULL if out of
+ * memory.
+ */
+mu_pdes_event_t *mu_pdes_schedule(mu_pdes_t *sim, size_t lp,
+                                  mu_time_abs_t time);
+
+/**
+ * @brief Run until every remaining event is at or after `until`.
+ *
+ * The calling thread serves as the first worker.  May be called again with a
+ * later time to continue.
+ *
+ * @return false if the worker threads could not be started.
+ */
+bool mu_pdes_run(mu_pdes_t *sim, mu_time_abs_t until);
+
+/**
+ * @brief Sum the statistics of every worker.  Not during mu_pdes_run().
+ */
+void mu_pdes_get_stats(const mu_pdes_t *sim, mu_pdes_stats_t *stats);
+
+/**
+ * @brief Allocate an event from a handler.
+ *
+ * @return The event, or NULL if out of memory.
+ */
+mu_pdes_event_t *mu_pdes_alloc(mu_pdes_lp_t *lp);
+
+/**
+ * @brief Send an event from a handler.
+ *
+ * An LP may send to itself with any non-negative delay.  Events for other LPs
+ * must be at least the sender's lookahead after mu_pdes_now().
+ *
+ * @param lp The sending LP.
+ * @param ev An event from mu_pdes_alloc().
+ * @param dst The destination LP index.
+ * @param time The delivery time.
+ * @return false (and the event still belongs to the caller) if the time
+ * violates the lookahead or is in the past.
+ */
+bool mu_pdes_send(mu_pdes_lp_t *lp, mu_pdes_event_t *ev, size_t dst,
+                  mu_time_abs_t time);
+
+/**
+ * @brief Release an unsent event.
+ */
+void mu_pdes_free(mu_pdes_lp_t *lp, mu_pdes_event_t *ev);
+
+/**
+ * @brief Return the virtual time of the event being processed.
+ */
+mu_time_abs_t mu_pdes_now(const mu_pdes_lp_t *lp);
+
+/**
+ * @brief Return an LP's index.
+ */
+size_t mu_pdes_lp_id(const mu_pdes_lp_t *lp);
+
+/**
+ * @brief Return the caller payload of an event.
+ */
+void *mu_pdes_event_payload(mu_pdes_event_t *ev);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_PDES_H_ */
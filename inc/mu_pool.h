@@ -0,0 +1,196 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_pool.h
+ * @brief Fixed-size block pool with a cross-thread return queue.
+ *
+ * A pool hands out equally sized blocks from one or more slabs of storage.
+ * Each pool has a single owner (a thread, or the main loop on a
+ * microcontroller) which allocates and frees through a plain free list, so
+ * the common path is a couple of pointer moves.  Blocks freed by any other
+ * thread (or an ISR) go onto a lock-free return stack that the owner reclaims
+ * in one atomic exchange when its free list runs dry.
+ *
+ * Storage is always provided by the caller: a static array on targets without
+ * a heap, or slabs from malloc() on hosts.  When MU_POOL_USE_MALLOC is
+ * defined, mu_pool_init_dynamic() creates a pool that grows by one slab at a
+ * time.
+ */
+
+#ifndef _MU_POOL_H_
+#define _MU_POOL_H_
+
+// *****************************************************************************
+// Includes
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#if (defined(__linux__) || defined(__APPLE__)) && !defined(MU_POOL_NO_MALLOC)
+#define MU_POOL_USE_MALLOC
+#endif
+
+/**
+ * @brief A free block, overlaid on the block's storage.
+ */
+typedef struct mu_pool_block {
+    struct mu_pool_block *next;
+} mu_pool_block_t;
+
+/**
+ * @brief Pool usage statistics.
+ */
+typedef struct {
+    size_t block_size;       ///< Bytes per block (after alignment)
+    size_t capacity;         ///< Blocks across all slabs
+    size_t in_use;           ///< Blocks currently allocated
+    size_t high_water;       ///< Maximum of in_use since init
+    size_t slabs;            ///< Slabs added
+    uint64_t allocs;         ///< Successful allocations
+    uint64_t alloc_failures; ///< Allocations refused (pool exhausted)
+    uint64_t remote_frees;   ///< Blocks returned through the return queue
+} mu_pool_stats_t;
+
+/**
+ * @brief A block pool.
+ */
+typedef struct {
+    mu_pool_block_t *free_list;        ///< Owner-only free list
+    _Atomic(mu_pool_block_t *) remote; ///< Blocks freed by other threads
+    atomic_uint_fast64_t remote_frees; ///< Updated by other threads
+    size_t block_size;
+    size_t capacity;
+    size_t in_use;
+    size_t high_water;
+    size_t slabs;
+    uint64_t allocs;
+    uint64_t alloc_failures;
+    size_t slab_blocks; ///< Blocks per slab for dynamic pools, 0 if static
+    void *slab_list;    ///< Slabs allocated by the pool itself
+} mu_pool_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Round a requested size up to the pool's block granularity.
+ *
+ * Use this to size static storage: `block_count * mu_pool_block_size(sz)`.
+ */
+size_t mu_pool_block_size(size_t requested);
+
+/**
+ * @brief Initialize a pool over caller-provided storage.
+ *
+ * @param pool The pool to initialize.
+ * @param block_size Size of each block in bytes.
+ * @param storage Storage for the blocks, aligned for any object type.
+ * @param storage_size Size of the storage in bytes.
+ */
+void mu_pool_init(mu_pool_t *pool, size_t block_size, void *storage,
+                  size_t storage_size);
+
+/**
+ * @brief Add another slab of caller-provided storage to a pool.
+ *
+ * Must be called by the owner.
+ */
+void mu_pool_add_slab(mu_pool_t *pool, void *storage, size_t storage_size);
+
+#ifdef MU_POOL_USE_MALLOC
+/**
+ * @brief Initialize a pool that grows by malloc()ing slabs as needed.
+ *
+ * @param pool The pool to initialize.
+ * @param block_size Size of each block in bytes.
+ * @param slab_blocks Blocks per slab.
+ */
+void mu_pool_init_dynamic(mu_pool_t *pool, size_t block_size,
+                          size_t slab_blocks);
+
+/**
+ * @brief Release slabs allocated by a dynamic pool.
+ *
+ * All blocks become invalid.  Static storage is not touched.
+ */
+void mu_pool_destroy(mu_pool_t *pool);
+#endif
+
+/**
+ * @brief Allocate a block.  Owner only.
+ *
+ * @return A block of at least block_size bytes, or NULL if the pool is
+ * exhausted (and cannot grow).
+ */
+void *mu_pool_alloc(mu_pool_t *pool);
+
+/**
+ * @brief Return a block allocated from this pool.  Owner only.
+ */
+void mu_pool_free(mu_pool_t *pool, void *block);
+
+/**
+ * @brief Return a block from a thread (or ISR) that does not own the pool.
+ *
+ * Lock-free; the owner reclaims the block on a later allocation.
+ */
+void mu_pool_free_remote(mu_pool_t *pool, void *block);
+
+/**
+ * @brief Move blocks from the return queue onto the free list.  Owner only.
+ *
+ * mu_pool_alloc() does this automatically when the free list is empty.
+ *
+ * @return The number of blocks reclaimed.
+ */
+size_t mu_pool_reclaim(mu_pool_t *pool);
+
+/**
+ * @brief Take a snapshot of the pool's statistics.  Owner only.
+ *
+ * Blocks still sitting in the return queue are counted as in use.
+ */
+void mu_pool_get_stats(const mu_pool_t *pool, mu_pool_stats_t *stats);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_POOL_H_ */
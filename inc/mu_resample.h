@@ -0,0 +1,190 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_resample.h
+ * @brief Resampling of irregular time series onto a regular grid.
+ *
+ * A mu_resampler_t walks sorted (timestamp, value) samples and the grid
+ * origin + k * step together in one merge pass, producing one value per grid
+ * point by one of:
+ *
+ * - LAST: the latest sample at or before the grid point
+ * - LINEAR: interpolation between the samples bracketing the grid point,
+ *   with a Q16 fixed-point weight
+ * - MEAN, MIN, MAX, SUM, COUNT: an aggregate of the samples in the window
+ *   (g - window, g], where window <= step
+ *
+ * Values are int32 (fixed-point readings), timestamps int64 in the unit of
+ * the grid, usually nanoseconds as in mu_time_column_t.  A grid point with
+ * no value -- no sample yet, an empty window, or a gap longer than `max_gap`
+ * -- is written as 0 with its bit clear in an LSB-first validity bitmap, as
+ * in Arrow.
+ *
+ * Input is streamed: samples arrive in chunks of any size, and a grid point
+ * is written once a later sample shows nothing more can change it.  When the
+ * samples are denser than the grid, the pass gallops over them instead of
+ * stepping, and aggregates reduce each window's samples with plain loops that
+ * the compiler vectorizes.
+ */
+
+#ifndef _MU_RESAMPLE_H_
+#define _MU_RESAMPLE_H_
+
+// *****************************************************************************
+// Includes
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+typedef enum {
+    MU_RESAMPLE_LAST,
+    MU_RESAMPLE_LINEAR,
+    MU_RESAMPLE_MEAN,
+    MU_RESAMPLE_MIN,
+    MU_RESAMPLE_MAX,
+    MU_RESAMPLE_SUM,
+    MU_RESAMPLE_COUNT,
+} mu_resample_method_t;
+
+/**
+ * @brief A resampler.  Treat the fields as private.
+ */
+typedef struct {
+    mu_resample_method_t method;
+    int64_t next;     ///< Timestamp of the next grid point to write
+    int64_t step;
+    int64_t window;   ///< Aggregate window, <= step
+    int64_t max_gap;  ///< Longest gap bridged, or 0 for any
+    uint64_t written; ///< Grid points written
+    uint64_t count;   ///< Grid points in all, or 0 for unbounded
+    bool has_prev;
+    int64_t prev_t;   ///< Latest sample consumed
+    int32_t prev_v;
+    int64_t sum;      ///< Aggregate of the window of `next`
+    int32_t min;
+    int32_t max;
+    uint32_t n;
+} mu_resampler_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a resampler.
+ *
+ * @param r The resampler.
+ * @param method How a grid point's value is formed.
+ * @param origin The first grid point.
+ * @param step The grid spacing, > 0.
+ * @param count The number of grid points, or 0 for an unbounded grid.
+ */
+void mu_resampler_init(mu_resampler_t *r, mu_resample_method_t method,
+                       int64_t origin, int64_t step, uint64_t count);
+
+/**
+ * @brief Set the aggregate window, clamped to (0, step].  Default: step.
+ */
+void mu_resampler_set_window(mu_resampler_t *r, int64_t window);
+
+/**
+ * @brief Set the longest gap between samples that LAST and LINEAR bridge;
+ * grid points across a longer one are missing.  Default 0: any gap.
+ */
+void mu_resampler_set_max_gap(mu_resampler_t *r, int64_t max_gap);
+
+/**
+ * @brief Feed a chunk of samples.
+ *
+ * @param r The resampler.
+ * @param t Timestamps, sorted, continuing from earlier chunks.
+ * @param v Values.
+ * @param n Number of samples.
+ * @param out Receives the values of completed grid points.
+ * @param valid Receives their validity, bit k for out[k], or NULL.
+ * @param max Capacity of `out`.
+ * @param consumed Receives the number of samples used; less than `n` if `out`
+ * filled up, in which case call again with the rest.
+ * @return The number of grid points written.
+ */
+size_t mu_resampler_push(mu_resampler_t *r, const int64_t *t, const int32_t *v,
+                         size_t n, int32_t *out, uint8_t *valid, size_t max,
+                         size_t *consumed);
+
+/**
+ * @brief Declare the input complete up to `end` and write the grid points
+ * before it.
+ *
+ * LAST carries the latest value forward (within `max_gap`); LINEAR has no
+ * sample to interpolate toward, so only a grid point on the latest sample
+ * has a value.
+ *
+ * @return The number of grid points written; call again while it is `max`.
+ */
+size_t mu_resampler_finish(mu_resampler_t *r, int64_t end, int32_t *out,
+                           uint8_t *valid, size_t max);
+
+/**
+ * @brief Resample a whole series onto a bounded grid in one call.
+ *
+ * @param r A resampler initialized with count > 0.
+ * @param out Room for `count` values.
+ * @param valid Room for `count` bits, or NULL.
+ * @return The number of grid points written, `count`.
+ */
+size_t mu_resampler_run(mu_resampler_t *r, const int64_t *t, const int32_t *v,
+                        size_t n, int32_t *out, uint8_t *valid);
+
+/**
+ * @brief Return the index of the next grid point to be written.
+ */
+uint64_t mu_resampler_position(const mu_resampler_t *r);
+
+/**
+ * @brief Interpolate between two values with a Q16 weight in [0, 65536].
+ */
+static inline int32_t mu_resample_lerp(int32_t v0, int32_t v1, uint32_t w) {
+    int64_t dv = (int64_t)v1 - v0;
+    return (int32_t)(v0 + ((dv * (int64_t)w + 0x8000) >> 16));
+}
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_RESAMPLE_H_ */
@@ -0,0 +1,267 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_sync.h
+ * @brief Mutex, condition variable, semaphore and futex waits that take
+ * mu_time_abs_t deadlines, with adaptive spin-before-block.
+ *
+ * Every timed wait here takes an absolute mu_time_abs_t deadline and passes
+ * it to the kernel on the clock behind mu_time_now() -- CLOCK_REALTIME on
+ * POSIX.  Condition variables are created with that clock, and futex waits
+ * use FUTEX_WAIT_BITSET | FUTEX_CLOCK_REALTIME, so no caller ever converts a
+ * deadline by hand or mixes clocks.  A deadline is honoured as given: a
+ * retry after EINTR or a spurious wakeup waits only for what is left.
+ *
+ * Locking a contended mutex or semaphore first spins for a time budget kept
+ * per object by a mu_spin_t.  Each acquisition feeds back what it observed:
+ * an acquisition while spinning pulls the budget toward twice the time spent,
+ * and a blocking wait that turned out shorter than MU_SPIN_MAX pulls it toward
+ * that wait, while longer blocks decay it.  Short critical sections thus end
+ * up served by spinning and long ones by sleeping, without tuning.
+ */
+
+#ifndef _MU_SYNC_H_
+#define _MU_SYNC_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_SPIN_DEFAULT 2000LL ///< Initial spin budget, 2 uSec
+#define MU_SPIN_MAX 50000LL    ///< Longest spin budget, 50 uSec
+
+/**
+ * @brief An adaptive spin budget.
+ */
+typedef struct {
+    atomic_int_fast64_t budget; ///< Current budget, mu_time_rel_t
+    mu_time_rel_t max;          ///< Ceiling on the budget
+} mu_spin_t;
+
+/**
+ * @brief A mutex with adaptive spinning.
+ */
+typedef struct {
+    pthread_mutex_t mutex;
+    mu_spin_t spin;
+} mu_mutex_t;
+
+/**
+ * @brief A condition variable on the mu_time clock.
+ */
+typedef struct {
+    pthread_cond_t cond;
+} mu_cond_t;
+
+/**
+ * @brief A counting semaphore with adaptive spinning.
+ */
+typedef struct {
+    sem_t sem;
+    mu_spin_t spin;
+} mu_sem_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a spin budget.
+ *
+ * @param spin The budget.
+ * @param initial Starting budget, at most MU_SPIN_MAX, or negative for the
+ * default: MU_SPIN_DEFAULT, or never spinning on a uniprocessor, where the
+ * holder cannot run while we spin.
+ */
+void mu_spin_init(mu_spin_t *spin, mu_time_rel_t initial);
+
+/**
+ * @brief Return the current spin budget.
+ */
+mu_time_rel_t mu_spin_budget(const mu_spin_t *spin);
+
+/**
+ * @brief Feed one observed wait back into a spin budget.
+ *
+ * The waits in this module call this themselves; it is public for callers
+ * that spin before blocking on something else, such as a file descriptor.
+ *
+ * @param spin The budget.
+ * @param waited How long the wait took, from the first failed attempt.
+ * @param blocked false if spinning succeeded, true if the wait had to block.
+ */
+void mu_spin_update(mu_spin_t *spin, mu_time_rel_t waited, bool blocked);
+
+/**
+ * @brief Initialize a mutex.  Returns 0 or an errno value.
+ */
+int mu_mutex_init(mu_mutex_t *m);
+
+/**
+ * @brief Destroy a mutex.
+ */
+void mu_mutex_destroy(mu_mutex_t *m);
+
+/**
+ * @brief Lock a mutex, spinning before blocking.
+ */
+void mu_mutex_lock(mu_mutex_t *m);
+
+/**
+ * @brief Lock a mutex unless that would block.
+ *
+ * @return true if the mutex was acquired.
+ */
+bool mu_mutex_trylock(mu_mutex_t *m);
+
+/**
+ * @brief Lock a mutex, giving up at a deadline.
+ *
+ * @return true if the mutex was acquired, false if the deadline passed.
+ */
+bool mu_mutex_timedlock(mu_mutex_t *m, mu_time_abs_t deadline);
+
+/**
+ * @brief Unlock a mutex.
+ */
+void mu_mutex_unlock(mu_mutex_t *m);
+
+/**
+ * @brief Initialize a condition variable.  Returns 0 or an errno value.
+ */
+int mu_cond_init(mu_cond_t *c);
+
+/**
+ * @brief Destroy a condition variable.
+ */
+void mu_cond_destroy(mu_cond_t *c);
+
+/**
+ * @brief Wait on a condition variable.  Wakeups may be spurious.
+ */
+void mu_cond_wait(mu_cond_t *c, mu_mutex_t *m);
+
+/**
+ * @brief Wait on a condition variable until a deadline.  Wakeups may be
+ * spurious.
+ *
+ * @return false if the deadline passed.
+ */
+bool mu_cond_timedwait(mu_cond_t *c, mu_mutex_t *m, mu_time_abs_t deadline);
+
+/**
+ * @brief Wake one waiter.
+ */
+void mu_cond_signal(mu_cond_t *c);
+
+/**
+ * @brief Wake all waiters.
+ */
+void mu_cond_broadcast(mu_cond_t *c);
+
+/**
+ * @brief Initialize a semaphore.  Returns 0 or an errno value.
+ */
+int mu_sem_init(mu_sem_t *s, unsigned value);
+
+/**
+ * @brief Destroy a semaphore.
+ */
+void mu_sem_destroy(mu_sem_t *s);
+
+/**
+ * @brief Increment a semaphore.  Async-signal-safe.
+ */
+void mu_sem_post(mu_sem_t *s);
+
+/**
+ * @brief Decrement a semaphore, spinning and then blocking while it is zero.
+ */
+void mu_sem_wait(mu_sem_t *s);
+
+/**
+ * @brief Decrement a semaphore if that would not block.
+ */
+bool mu_sem_trywait(mu_sem_t *s);
+
+/**
+ * @brief Decrement a semaphore, giving up at a deadline.
+ *
+ * @return false if the deadline passed.
+ */
+bool mu_sem_timedwait(mu_sem_t *s, mu_time_abs_t deadline);
+
+#if defined(__linux__)
+/**
+ * @brief Sleep while `*word == expected`, until woken or a deadline.
+ *
+ * @param word The futex word.
+ * @param expected The value to sleep on.
+ * @param deadline The deadline, or NULL to wait indefinitely.
+ * @return false if the deadline passed, or if the wait failed (errno is then
+ * neither ETIMEDOUT nor EINTR); true if woken, or if the word did not hold
+ * `expected` (callers re-check the word either way).
+ */
+bool mu_futex_wait(atomic_uint *word, unsigned expected,
+                   const mu_time_abs_t *deadline);
+
+/**
+ * @brief Spin while `*word == expected` for the budget, then mu_futex_wait().
+ * The budget adapts as for mutexes.
+ */
+bool mu_futex_await(atomic_uint *word, unsigned expected,
+                    const mu_time_abs_t *deadline, mu_spin_t *spin);
+
+/**
+ * @brief Wake up to `count` waiters on a futex word.
+ *
+ * @return The number woken.
+ */
+int mu_futex_wake(atomic_uint *word, int count);
+#endif
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_SYNC_H_ */
@@ -31,6 +31,17 @@
  *
  * Note that the user must provide "mu_time_impl.h" and a companion
  * "mu_time_impl.c" that defines the implentation of these functions.
+ *
+ * Signal and interrupt safety: mu_time_now(), mu_time_rel_max(),
+ * mu_time_offset(), mu_time_difference(), mu_time_is_before(),
+ * mu_time_is_after(), mu_time_rel_from_millis() and mu_time_rel_to_millis()
+ * may be called from a signal handler or an ISR.  They take no locks, touch no
+ * static state and do not allocate, so they are reentrant and complete in a
+ * bounded number of steps.  A platform implementation must keep them so (on
+ * POSIX, mu_time_now() is a single clock_gettime(), which is
+ * async-signal-safe).  The float conversions are excluded, since an ISR may
+ * not save FPU state, as is mu_time_init().  See mu_fire_queue.h for handing
+ * timer fires from that context to the main loop.
  */
 
 #ifndef _MU_TIME_H_
@@ -0,0 +1,146 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_time_bucket.h
+ * @brief Bulk mapping of absolute times to local calendar day / hour buckets.
+ *
+ * Calling localtime_r() per element is slow.  Within an interval where the
+ * local UTC offset is constant, a local bucket index is just an integer
+ * division by a constant (3600 or 86400) of the offset seconds.  This module
+ * caches a few such intervals (found once, by probing localtime_r() around a
+ * timestamp and bisecting to the exact transition second) and converts whole
+ * blocks of timestamps that fall inside one cached interval with a tight,
+ * branch-free 32-bit loop that the compiler vectorizes.  Sorted input almost
+ * always stays on that path; unsorted input that straddles a transition falls
+ * back to a per-element cache lookup.
+ *
+ * Bucket indexes count local days (or hours) since 1970-01-01 00:00 local
+ * time, so day 0 is the local calendar day of the Unix epoch.
+ *
+ * This module requires a POSIX platform (localtime_r() and tm_gmtoff).
+ */
+
+#ifndef _MU_TIME_BUCKET_H_
+#define _MU_TIME_BUCKET_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_TIME_BUCKET_CACHE_SIZE
+#define MU_TIME_BUCKET_CACHE_SIZE 4 ///< Constant-offset intervals kept per zone
+#endif
+
+/**
+ * @brief Bucket width.
+ */
+typedef enum {
+    MU_TIME_BUCKET_HOUR = 3600,
+    MU_TIME_BUCKET_DAY = 86400,
+} mu_time_bucket_unit_t;
+
+/**
+ * @brief A span of UTC seconds [start, end) with one local UTC offset.
+ */
+typedef struct {
+    int64_t start;      ///< First second of the interval
+    int64_t end;        ///< First second past the interval
+    int32_t utc_offset; ///< Seconds east of UTC
+} mu_time_bucket_interval_t;
+
+/**
+ * @brief Cached time zone state.  Not thread-safe; use one per thread.
+ */
+typedef struct {
+    bool is_utc;        ///< Bypass localtime_r(): a single infinite interval
+    mu_time_bucket_interval_t cache[MU_TIME_BUCKET_CACHE_SIZE];
+    size_t cached;      ///< Valid entries in cache[]
+    size_t victim;      ///< Next entry to replace
+    uint32_t refreshes; ///< Number of intervals computed with localtime_r()
+} mu_time_bucket_zone_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a zone that follows the process time zone (TZ).
+ *
+ * Call again after changing TZ to discard the cached intervals.
+ */
+void mu_time_bucket_zone_init(mu_time_bucket_zone_t *zone);
+
+/**
+ * @brief Initialize a zone fixed at UTC.
+ */
+void mu_time_bucket_zone_init_utc(mu_time_bucket_zone_t *zone);
+
+/**
+ * @brief Return the local UTC offset in seconds at the given UTC second.
+ */
+int32_t mu_time_bucket_utc_offset(mu_time_bucket_zone_t *zone, int64_t seconds);
+
+/**
+ * @brief Map absolute times to local bucket indexes.
+ *
+ * @param zone Cached zone state.
+ * @param times Absolute times, in any order.
+ * @param buckets Receives one bucket index per time.
+ * @param count Number of times.
+ * @param unit Bucket width.
+ */
+void mu_time_bucket(mu_time_bucket_zone_t *zone, const mu_time_abs_t *times,
+                    int32_t *buckets, size_t count, mu_time_bucket_unit_t unit);
+
+/**
+ * @brief Map UTC seconds since the Unix epoch to local bucket indexes.
+ *
+ * Same as mu_time_bucket() for callers that already hold integer seconds.
+ */
+void mu_time_bucket_seconds(mu_time_bucket_zone_t *zone, const int64_t *seconds,
+                            int32_t *buckets, size_t count,
+                            mu_time_bucket_unit_t unit);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_TIME_BUCKET_H_ */
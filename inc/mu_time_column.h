@@ -0,0 +1,274 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_time_column.h
+ * @brief Flat int64-nanosecond timestamp columns with Arrow validity bitmaps.
+ *
+ * A mu_time_column_t is a view over caller buffers laid out exactly as an
+ * Apache Arrow timestamp[ns] array: an int64 value per row (nanoseconds since
+ * the Unix epoch, as mu_time_posix_to_nanos()) and an optional LSB-first
+ * validity bitmap.  Bulk comparisons, differences, offsets and calendar
+ * bucketing run directly over those buffers, and a column can be exported to
+ * (or imported from) the Arrow C data interface without copying them.
+ *
+ * Values of null rows are unspecified and are computed on like any other row;
+ * element-wise results share the input's validity bitmap.
+ *
+ * This module requires a POSIX platform, where mu_time_rel_t is nanoseconds.
+ */
+
+#ifndef _MU_TIME_COLUMN_H_
+#define _MU_TIME_COLUMN_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_time_bucket.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+// The Arrow C data interface structures, verbatim from the Arrow
+// specification.  The guard lets them coexist with Arrow's own headers.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema *);
+    // Opaque producer-specific data
+    void *private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray *);
+    // Opaque producer-specific data
+    void *private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+/**
+ * @brief A timestamp column.  Row i is values[offset + i], valid when bit
+ * (offset + i) of validity is set or validity is NULL.
+ */
+typedef struct {
+    int64_t *values;   ///< Nanoseconds since the Unix epoch
+    uint8_t *validity; ///< LSB-first bitmap, or NULL if every row is valid
+    size_t offset;     ///< First row within values and validity
+    size_t length;     ///< Rows
+} mu_time_column_t;
+
+/**
+ * @brief Called when an exported array is released by its consumer.
+ */
+typedef void (*mu_time_column_release_fn)(void *ctx);
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a column over caller buffers.
+ *
+ * @param col The column to initialize.
+ * @param values At least `length` int64 nanosecond values.
+ * @param validity A bitmap of at least `length` bits, or NULL.
+ * @param length The number of rows.
+ */
+void mu_time_column_init(mu_time_column_t *col, int64_t *values,
+                         uint8_t *validity, size_t length);
+
+/**
+ * @brief Return true if a row is not null.
+ */
+static inline bool mu_time_column_is_valid(const mu_time_column_t *col,
+                                           size_t i) {
+    size_t bit = col->offset + i;
+    return col->validity == NULL || ((col->validity[bit >> 3] >> (bit & 7)) & 1);
+}
+
+/**
+ * @brief Return a row as a mu_time_abs_t.  The row must be valid.
+ */
+mu_time_abs_t mu_time_column_get(const mu_time_column_t *col, size_t i);
+
+/**
+ * @brief Store a time into a row and mark it valid.
+ */
+void mu_time_column_set(mu_time_column_t *col, size_t i, mu_time_abs_t t);
+
+/**
+ * @brief Mark a row null.  The column must have a validity bitmap.
+ */
+void mu_time_column_set_null(mu_time_column_t *col, size_t i);
+
+/**
+ * @brief Count null rows.
+ */
+size_t mu_time_column_null_count(const mu_time_column_t *col);
+
+/**
+ * @brief Set out bit i where row i is valid and before `t`.
+ *
+ * @param col The column.
+ * @param t The time to compare with.
+ * @param out A bitmap of at least `length` bits, starting at bit 0.
+ * @return The number of bits set.
+ */
+size_t mu_time_column_before(const mu_time_column_t *col, mu_time_abs_t t,
+                             uint8_t *out);
+
+/**
+ * @brief Set out bit i where row i is valid and after `t`.
+ *
+ * @return The number of bits set.
+ */
+size_t mu_time_column_after(const mu_time_column_t *col, mu_time_abs_t t,
+                            uint8_t *out);
+
+/**
+ * @brief Set out bit i where row i is valid and in [start, end).
+ *
+ * @return The number of bits set.
+ */
+size_t mu_time_column_in_range(const mu_time_column_t *col,
+                               mu_time_abs_t start, mu_time_abs_t end,
+                               uint8_t *out);
+
+/**
+ * @brief Compute mu_time_difference(ref, row) for every row.
+ *
+ * @param col The column.
+ * @param ref The reference time.
+ * @param out Receives `length` differences; null rows are unspecified.
+ */
+void mu_time_column_difference(const mu_time_column_t *col, mu_time_abs_t ref,
+                               mu_time_rel_t *out);
+
+/**
+ * @brief Compute mu_time_offset(row, delta) for every row.
+ *
+ * @param col The column.
+ * @param delta The offset.
+ * @param out Receives `length` values; may be the column's own rows
+ * (col->values + col->offset) to shift in place.
+ */
+void mu_time_column_offset(const mu_time_column_t *col, mu_time_rel_t delta,
+                           int64_t *out);
+
+/**
+ * @brief Map every row to a local day or hour bucket, as mu_time_bucket().
+ *
+ * @param col The column.
+ * @param zone The zone cache.
+ * @param buckets Receives `length` bucket indexes; null rows are unspecified.
+ * @param unit MU_TIME_BUCKET_HOUR or MU_TIME_BUCKET_DAY.
+ */
+void mu_time_column_bucket(const mu_time_column_t *col,
+                           mu_time_bucket_zone_t *zone, int32_t *buckets,
+                           mu_time_bucket_unit_t unit);
+
+/**
+ * @brief Find the earliest and latest valid rows.
+ *
+ * @return false if there are no valid rows.
+ */
+bool mu_time_column_min_max(const mu_time_column_t *col, mu_time_abs_t *min,
+                            mu_time_abs_t *max);
+
+/**
+ * @brief Export a column through the Arrow C data interface without copying.
+ *
+ * The schema is timestamp[ns] ("tsn:<timezone>").  The array's buffers point
+ * at the column's own values and validity, which must stay valid until the
+ * consumer releases the array.
+ *
+ * @param col The column.
+ * @param timezone An Olson name such as "UTC", or "" for a naive timestamp.
+ * @param on_release Called with `ctx` when the array is released, or NULL.
+ * @param ctx Passed to on_release.
+ * @param schema Receives the schema.
+ * @param array Receives the array.
+ * @return false if memory for the descriptors could not be allocated.
+ */
+bool mu_time_column_export(const mu_time_column_t *col, const char *timezone,
+                           mu_time_column_release_fn on_release, void *ctx,
+                           struct ArrowSchema *schema, struct ArrowArray *array);
+
+/**
+ * @brief View an Arrow timestamp[ns] array as a column without copying.
+ *
+ * The array keeps ownership of its buffers; release it only when the column
+ * is no longer used.
+ *
+ * @return false if the schema is not a timestamp in nanoseconds.
+ */
+bool mu_time_column_import(mu_time_column_t *col,
+                           const struct ArrowSchema *schema,
+                           const struct ArrowArray *array);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_TIME_COLUMN_H_ */
@@ -0,0 +1,188 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_time_range.h
+ * @brief Sets of half-open time ranges with linear-time set operations.
+ *
+ * A mu_time_range_set_t holds ranges [start, end) in caller storage, sorted by
+ * start, non-empty, and coalesced: no two ranges overlap or touch.  Union,
+ * intersection and difference of two sets are single merge passes over both,
+ * O(n + m), writing a third set whose capacity the caller sizes (n + m always
+ * suffices).  Coverage -- the total length, or the length inside a window --
+ * is a branch-free loop over the ranges that the compiler vectorizes.
+ *
+ * Bounds are int64 nanoseconds since the Unix epoch, as
+ * mu_time_posix_to_nanos(), so that the hot loops compare plain integers;
+ * the mu_time_abs_t entry points convert at the boundary.
+ *
+ * This module requires a POSIX platform, where mu_time_rel_t is nanoseconds.
+ */
+
+#ifndef _MU_TIME_RANGE_H_
+#define _MU_TIME_RANGE_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief A half-open range [start, end) of nanoseconds since the epoch.
+ */
+typedef struct {
+    int64_t start;
+    int64_t end;
+} mu_time_range_t;
+
+/**
+ * @brief A set of ranges.  Treat the fields as private.
+ */
+typedef struct {
+    mu_time_range_t *ranges; ///< Sorted and coalesced
+    size_t count;
+    size_t capacity;
+} mu_time_range_set_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize an empty set over caller storage.
+ */
+void mu_time_range_set_init(mu_time_range_set_t *set, mu_time_range_t *storage,
+                            size_t capacity);
+
+/**
+ * @brief Remove every range.
+ */
+void mu_time_range_set_clear(mu_time_range_set_t *set);
+
+/**
+ * @brief Return the number of ranges.
+ */
+size_t mu_time_range_set_count(const mu_time_range_set_t *set);
+
+/**
+ * @brief Return the ranges, sorted and coalesced.
+ */
+const mu_time_range_t *mu_time_range_set_ranges(const mu_time_range_set_t *set);
+
+/**
+ * @brief Add [start, end), merging it with the ranges it overlaps or touches.
+ *
+ * O(n) for the shift; to load many ranges, append and normalize instead.
+ *
+ * @return false if the set is full (it is then unchanged).  An empty range is
+ * ignored.
+ */
+bool mu_time_range_set_add(mu_time_range_set_t *set, mu_time_abs_t start,
+                           mu_time_abs_t end);
+
+/**
+ * @brief Add [start, end) in nanoseconds.  See mu_time_range_set_add().
+ */
+bool mu_time_range_set_add_nanos(mu_time_range_set_t *set, int64_t start,
+                                 int64_t end);
+
+/**
+ * @brief Append a range without ordering or merging it.  Call
+ * mu_time_range_set_normalize() before any other operation.
+ *
+ * @return false if the set is full.
+ */
+bool mu_time_range_set_append(mu_time_range_set_t *set, int64_t start,
+                              int64_t end);
+
+/**
+ * @brief Sort, drop empty ranges and coalesce, in O(n log n).
+ */
+void mu_time_range_set_normalize(mu_time_range_set_t *set);
+
+/**
+ * @brief Return true if a time falls in one of the ranges.  O(log n).
+ */
+bool mu_time_range_set_contains(const mu_time_range_set_t *set,
+                                mu_time_abs_t t);
+
+/**
+ * @brief Write the union of `a` and `b` to `out`.
+ *
+ * `out` must not be `a` or `b`.
+ *
+ * @return false if `out` ran out of capacity; it then holds a prefix of the
+ * result.
+ */
+bool mu_time_range_union(mu_time_range_set_t *out,
+                         const mu_time_range_set_t *a,
+                         const mu_time_range_set_t *b);
+
+/**
+ * @brief Write the intersection of `a` and `b` to `out`.  See
+ * mu_time_range_union().
+ */
+bool mu_time_range_intersection(mu_time_range_set_t *out,
+                                const mu_time_range_set_t *a,
+                                const mu_time_range_set_t *b);
+
+/**
+ * @brief Write `a` minus `b` to `out`.  See mu_time_range_union().
+ */
+bool mu_time_range_difference(mu_time_range_set_t *out,
+                              const mu_time_range_set_t *a,
+                              const mu_time_range_set_t *b);
+
+/**
+ * @brief Return the total length of the ranges.
+ */
+mu_time_rel_t mu_time_range_set_coverage(const mu_time_range_set_t *set);
+
+/**
+ * @brief Return the length of the ranges inside the window [start, end).
+ */
+mu_time_rel_t mu_time_range_set_coverage_within(const mu_time_range_set_t *set,
+                                                mu_time_abs_t start,
+                                                mu_time_abs_t end);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_TIME_RANGE_H_ */
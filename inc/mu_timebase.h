@@ -0,0 +1,256 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_timebase.h
+ * @brief Integer timebase families that coexist with the native mu_time_abs_t.
+ *
+ * mu_time.h binds mu_time_abs_t and mu_time_rel_t to exactly one platform
+ * clock.  A gateway that also handles timestamps from attached devices (for
+ * example 1 mSec SAMD21 RTC ticks) needs several timebases in one process.
+ *
+ * MU_TIMEBASE_DEFINE() generates a family of types and rollover-safe
+ * operations for an unsigned tick counter running at a fixed rate.  The
+ * generated functions mirror the mu_time.h API:
+ *
+ *     <name>_abs_t, <name>_rel_t
+ *     <name>_offset(), <name>_difference(), <name>_is_before(),
+ *     <name>_is_after(), <name>_rel_max(), <name>_rel_from_millis(),
+ *     <name>_rel_to_millis(), <name>_rel_from_nanos(), <name>_rel_to_nanos(),
+ *     <name>_rel_from_seconds(), <name>_rel_to_seconds()
+ *
+ * Conversion between timebases is explicit, through a mu_timebase_map_t: a
+ * Q32.32 fixed-point scale plus a pair of reference points, so mapping a tick
+ * costs one multiply and one add.  The scale may include a drift correction,
+ * which is how device ticks are placed onto host time.
+ */
+
+#ifndef _MU_TIMEBASE_H_
+#define _MU_TIMEBASE_H_
+
+// *****************************************************************************
+// Includes
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_TIMEBASE_NANOS_PER_SECOND 1000000000LL
+
+/**
+ * @brief Generate a timebase family.
+ *
+ * @param name Prefix for the generated types and functions.
+ * @param abs_type An unsigned integer type holding absolute ticks.
+ * @param rel_type The signed integer type of the same width.
+ * @param ticks_per_second Tick rate, at most 1000000000.
+ */
+#define MU_TIMEBASE_DEFINE(name, abs_type, rel_type, ticks_per_second)         \
+    typedef abs_type name##_abs_t;                                             \
+    typedef rel_type name##_rel_t;                                             \
+                                                                               \
+    static inline abs_type name##_offset(abs_type base, rel_type delta) {      \
+        return (abs_type)(base + (abs_type)delta);                             \
+    }                                                                          \
+                                                                               \
+    static inline rel_type name##_difference(abs_type a, abs_type b) {         \
+        return (rel_type)(abs_type)(b - a);                                    \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_is_before(abs_type a, abs_type b) {              \
+        return name##_difference(a, b) > 0;                                    \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_is_after(abs_type a, abs_type b) {               \
+        return name##_difference(a, b) < 0;                                    \
+    }                                                                          \
+                                                                               \
+    static inline rel_type name##_rel_max(void) {                              \
+        return (rel_type)(((abs_type)-1) >> 1);                                \
+    }                                                                          \
+                                                                               \
+    static inline rel_type name##_rel_from_nanos(int64_t nanos) {              \
+        return (rel_type)mu_timebase_muldiv(nanos, (ticks_per_second),         \
+                                            MU_TIMEBASE_NANOS_PER_SECOND);     \
+    }                                                                          \
+                                                                               \
+    static inline int64_t name##_rel_to_nanos(rel_type tics) {                 \
+        return mu_timebase_muldiv(tics, MU_TIMEBASE_NANOS_PER_SECOND,          \
+                                  (ticks_per_second));                         \
+    }                                                                          \
+                                                                               \
+    static inline rel_type name##_rel_from_millis(int32_t milliseconds) {      \
+        return (rel_type)mu_timebase_muldiv(milliseconds, (ticks_per_second),  \
+                                            1000);                             \
+    }                                                                          \
+                                                                               \
+    static inline int32_t name##_rel_to_millis(rel_type tics) {                \
+        return (int32_t)mu_timebase_muldiv(tics, 1000, (ticks_per_second));    \
+    }                                                                          \
+                                                                               \
+    static inline rel_type name##_rel_from_seconds(float seconds) {            \
+        return (rel_type)(seconds * (float)(ticks_per_second));                \
+    }                                                                          \
+                                                                               \
+    static inline float name##_rel_to_seconds(rel_type tics) {                 \
+        return (float)tics / (float)(ticks_per_second);                        \
+    }
+
+/**
+ * @brief Linear mapping from one timebase onto another.
+ *
+ * dst = dst_origin + ((src - src_origin) * scale_q32) >> 32
+ *
+ * Source ticks are 64 bits wide; narrower counters that wrap must first be
+ * extended with mu_timebase_unwrap32().
+ */
+typedef struct {
+    uint64_t src_origin; ///< Source ticks at the reference point
+    uint64_t dst_origin; ///< Destination ticks at the reference point
+    uint64_t nominal_q32; ///< Nominal dst ticks per src tick (Q32.32)
+    uint64_t scale_q32;  ///< Drift-corrected dst ticks per src tick (Q32.32)
+} mu_timebase_map_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Compute (v * num) / den without overflowing for den <= 1e9 and
+ * num <= 1e9, truncating toward zero.
+ */
+static inline int64_t mu_timebase_muldiv(int64_t v, int64_t num, int64_t den) {
+    if (num % den == 0) {
+        return v * (num / den);
+    } else if (den % num == 0) {
+        return v / (den / num);
+    }
+    return (v / den) * num + ((v % den) * num) / den;
+}
+
+/**
+ * @brief Multiply a signed value by an unsigned Q32.32 fraction.
+ *
+ * The result is truncated toward zero so that positive and negative offsets
+ * from a reference point map symmetrically.
+ */
+static inline int64_t mu_timebase_mul_q32(int64_t v, uint64_t q32) {
+    uint64_t mag = (v < 0) ? (uint64_t)0 - (uint64_t)v : (uint64_t)v;
+    uint64_t r;
+#if defined(__SIZEOF_INT128__)
+    r = (uint64_t)(((unsigned __int128)mag * q32) >> 32);
+#else
+    uint64_t alo = mag & 0xffffffff, ahi = mag >> 32;
+    uint64_t blo = q32 & 0xffffffff, bhi = q32 >> 32;
+    r = ((ahi * bhi) << 32) + (ahi * blo) + (alo * bhi) + ((alo * blo) >> 32);
+#endif
+    return (v < 0) ? -(int64_t)r : (int64_t)r;
+}
+
+/**
+ * @brief Extend a wrapping 32-bit tick counter to 64 bits.
+ *
+ * Successive calls must be no more than 2^31 ticks apart.
+ *
+ * @param last The previously extended value, updated in place.  Initialize to
+ * the first raw tick value.
+ * @param ticks The raw 32-bit tick value.
+ * @return The extended 64-bit tick value.
+ */
+static inline uint64_t mu_timebase_unwrap32(uint64_t *last, uint32_t ticks) {
+    int32_t step = (int32_t)(ticks - (uint32_t)*last);
+    *last += (uint64_t)(int64_t)step;
+    return *last;
+}
+
+/**
+ * @brief Initialize a map between two timebases with a common reference point.
+ *
+ * @param map The map to initialize.
+ * @param src_hz Tick rate of the source timebase.
+ * @param dst_hz Tick rate of the destination timebase.
+ * @param src_origin Source ticks at the reference point.
+ * @param dst_origin Destination ticks at the same instant.
+ */
+void mu_timebase_map_init(mu_timebase_map_t *map, uint32_t src_hz,
+                          uint32_t dst_hz, uint64_t src_origin,
+                          uint64_t dst_origin);
+
+/**
+ * @brief Move the reference point without changing the scale.
+ */
+void mu_timebase_map_set_origin(mu_timebase_map_t *map, uint64_t src_origin,
+                                uint64_t dst_origin);
+
+/**
+ * @brief Apply a drift correction to the nominal scale.
+ *
+ * @param map The map to adjust.
+ * @param drift_ppb Source clock error in parts per billion.  A positive value
+ * means the source runs fast, so each source tick maps to less destination
+ * time.
+ */
+void mu_timebase_map_set_drift_ppb(mu_timebase_map_t *map, int32_t drift_ppb);
+
+/**
+ * @brief Map source ticks onto the destination timebase.
+ */
+static inline uint64_t mu_timebase_map_apply(const mu_timebase_map_t *map,
+                                             uint64_t src) {
+    int64_t delta = (int64_t)(src - map->src_origin);
+    return map->dst_origin + (uint64_t)mu_timebase_mul_q32(delta, map->scale_q32);
+}
+
+// *****************************************************************************
+// Predefined families
+
+/**
+ * @brief Nanoseconds since the Unix epoch, the host timebase on POSIX.
+ *
+ * See mu_time_posix_to_nanos() / mu_time_posix_from_nanos() for the bridge to
+ * the native mu_time_abs_t.
+ */
+MU_TIMEBASE_DEFINE(mu_tb_ns64, uint64_t, int64_t, 1000000000)
+
+/**
+ * @brief 1 mSec ticks in a wrapping 32-bit counter, as used by the SAMD21 RTC.
+ */
+MU_TIMEBASE_DEFINE(mu_tb_ms32, uint32_t, int32_t, 1000)
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_TIMEBASE_H_ */
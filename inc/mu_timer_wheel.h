@@ -0,0 +1,255 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_timer_wheel.h
+ * @brief Hierarchical timer wheel keyed by mu_time_abs_t deadlines.
+ *
+ * Deadlines are quantized to ticks of a fixed resolution measured from the
+ * wheel's origin.  Arming and cancelling a timer is O(1); advancing the wheel
+ * costs O(1) per elapsed tick plus the timers fired or cascaded.  Timers never
+ * fire early, and fire at most one tick late.
+ *
+ * Timers are intrusive (a mu_timer_t embedded in the caller's own structure)
+ * or, for fire-and-forget use, drawn from a mu_pool_t through
+ * mu_timer_wheel_schedule() and returned to it automatically.  A wheel and its
+ * pool belong to one thread; use one wheel per thread.
+ *
+ * Each wheel keeps its own activity counters (arms, fires, cancels,
+ * cascades) and per-level occupancy.  Only the owning thread writes them, so
+ * there is no contention between wheels, and any thread may read them with
+ * mu_timer_wheel_get_stats() -- e.g. to sum the shards of a service with
+ * mu_timer_wheel_stats_add().  An optional duration sketch records how late
+ * each timer fired, mu_time_difference(deadline, fired_at).
+ */
+
+#ifndef _MU_TIMER_WHEEL_H_
+#define _MU_TIMER_WHEEL_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_duration_sketch.h"
+#include "mu_pool.h"
+#include "mu_time.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_TIMER_WHEEL_SLOT_BITS 6
+#define MU_TIMER_WHEEL_SLOTS (1 << MU_TIMER_WHEEL_SLOT_BITS)
+#define MU_TIMER_WHEEL_LEVELS 4
+
+struct mu_timer;
+
+/**
+ * @brief Timer callback.  The timer may be re-armed from within.
+ */
+typedef void (*mu_timer_fn)(struct mu_timer *timer, void *arg);
+
+/**
+ * @brief A timer.  Treat the fields as private.
+ */
+typedef struct mu_timer {
+    struct mu_timer *next;
+    struct mu_timer *prev;
+    mu_time_abs_t deadline;
+    uint64_t expires;       ///< Deadline in wheel ticks (rounded up)
+    mu_timer_fn fn;
+    void *arg;
+    uint8_t level;
+    uint8_t slot;
+    uint8_t flags;
+} mu_timer_t;
+
+/**
+ * @brief A snapshot of a wheel's statistics.
+ */
+typedef struct {
+    uint64_t armed;     ///< Arms, including re-arms of pending timers
+    uint64_t fired;     ///< Timers fired
+    uint64_t cancelled; ///< Pending timers cancelled
+    uint64_t cascades;  ///< Higher-level slots pulled down
+    uint64_t cascaded;  ///< Timers moved by those cascades
+    uint64_t pending;   ///< Armed timers
+    uint64_t level_pending[MU_TIMER_WHEEL_LEVELS]; ///< Armed timers per level
+} mu_timer_wheel_stats_t;
+
+/**
+ * @brief A timer wheel.
+ */
+typedef struct {
+    mu_time_abs_t origin;      ///< Time of tick 0
+    mu_time_rel_t resolution;  ///< Duration of one tick
+    uint64_t next_tick;        ///< Next tick to process
+    size_t pending;            ///< Armed timers
+    mu_pool_t *pool;           ///< Node pool for mu_timer_wheel_schedule()
+    mu_duration_sketch_t *lag; ///< Optional late-fire lag sketch
+    mu_timer_t *slots[MU_TIMER_WHEEL_LEVELS][MU_TIMER_WHEEL_SLOTS];
+    mu_timer_t *firing;        ///< Due timers not yet fired by advance()
+    // Single-writer counters, readable from any thread
+    atomic_uint_fast64_t armed;
+    atomic_uint_fast64_t fired;
+    atomic_uint_fast64_t cancelled;
+    atomic_uint_fast64_t cascades;
+    atomic_uint_fast64_t cascaded;
+    atomic_uint_fast64_t level_pending[MU_TIMER_WHEEL_LEVELS];
+} mu_timer_wheel_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a timer wheel.
+ *
+ * @param wheel The wheel to initialize.
+ * @param now The current time; tick 0 of the wheel.
+ * @param resolution The duration of one tick.
+ * @param pool Pool of nodes of at least sizeof(mu_timer_t) bytes for
+ * mu_timer_wheel_schedule(), or NULL if only intrusive timers are used.
+ */
+void mu_timer_wheel_init(mu_timer_wheel_t *wheel, mu_time_abs_t now,
+                         mu_time_rel_t resolution, mu_pool_t *pool);
+
+/**
+ * @brief Initialize an intrusive timer.
+ */
+void mu_timer_init(mu_timer_t *timer, mu_timer_fn fn, void *arg);
+
+/**
+ * @brief Arm (or re-arm) a timer to fire at a deadline.
+ *
+ * A deadline in the past fires on the next tick.
+ */
+void mu_timer_wheel_arm(mu_timer_wheel_t *wheel, mu_timer_t *timer,
+                        mu_time_abs_t deadline);
+
+/**
+ * @brief Arm a pooled timer that is released after it fires.
+ *
+ * @return The timer (usable as a handle for mu_timer_wheel_cancel() until it
+ * fires), or NULL if the pool is exhausted.
+ */
+mu_timer_t *mu_timer_wheel_schedule(mu_timer_wheel_t *wheel,
+                                    mu_time_abs_t deadline, mu_timer_fn fn,
+                                    void *arg);
+
+/**
+ * @brief Cancel a timer.  Pooled timers are released.
+ *
+ * @return true if the timer was pending.
+ */
+bool mu_timer_wheel_cancel(mu_timer_wheel_t *wheel, mu_timer_t *timer);
+
+/**
+ * @brief Return true if the timer is armed.
+ */
+bool mu_timer_is_pending(const mu_timer_t *timer);
+
+/**
+ * @brief Return the timer's deadline.
+ */
+mu_time_abs_t mu_timer_deadline(const mu_timer_t *timer);
+
+/**
+ * @brief Fire every timer whose tick has been reached by `now`.
+ *
+ * @return The number of timers fired.
+ */
+size_t mu_timer_wheel_advance(mu_timer_wheel_t *wheel, mu_time_abs_t now);
+
+/**
+ * @brief Return the number of armed timers.
+ */
+size_t mu_timer_wheel_pending(const mu_timer_wheel_t *wheel);
+
+/**
+ * @brief Find the earliest armed deadline.
+ *
+ * @param wheel The wheel.
+ * @param deadline Receives the earliest deadline.
+ * @return false if no timer is armed.
+ */
+bool mu_timer_wheel_next_deadline(const mu_timer_wheel_t *wheel,
+                                  mu_time_abs_t *deadline);
+
+/**
+ * @brief Record late-fire lag of every fired timer into a sketch.
+ *
+ * @param wheel The wheel.
+ * @param lag The sketch, owned by the wheel's thread, or NULL to stop.
+ */
+void mu_timer_wheel_set_lag_sketch(mu_timer_wheel_t *wheel,
+                                   mu_duration_sketch_t *lag);
+
+/**
+ * @brief Take a snapshot of a wheel's counters.  Safe from any thread.
+ */
+void mu_timer_wheel_get_stats(const mu_timer_wheel_t *wheel,
+                              mu_timer_wheel_stats_t *stats);
+
+/**
+ * @brief Add one snapshot into another, to aggregate per-thread wheels.
+ */
+void mu_timer_wheel_stats_add(mu_timer_wheel_stats_t *dst,
+                              const mu_timer_wheel_stats_t *src);
+
+/**
+ * @brief Return the fraction of completed timers that were cancelled rather
+ * than fired, or 0 if none have completed.
+ */
+float mu_timer_wheel_stats_cancel_ratio(const mu_timer_wheel_stats_t *stats);
+
+/**
+ * @brief Count the armed timers in each slot of one level.  Owner only.
+ *
+ * This walks the slot lists, so it is meant for diagnostics rather than
+ * periodic scraping.
+ *
+ * @param wheel The wheel.
+ * @param level The level, 0 to MU_TIMER_WHEEL_LEVELS - 1.
+ * @param counts Receives MU_TIMER_WHEEL_SLOTS counts.
+ */
+void mu_timer_wheel_slot_occupancy(const mu_timer_wheel_t *wheel, int level,
+                                   uint32_t *counts);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_TIMER_WHEEL_H_ */
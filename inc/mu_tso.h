@@ -0,0 +1,168 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_tso.h
+ * @brief Timestamp oracle: strictly increasing 64-bit commit timestamps from
+ * mu_time_now(), durable across restarts.
+ *
+ * A timestamp is nanoseconds since the Unix epoch, so it doubles as a
+ * readable commit time.  Each allocation returns a range of `count`
+ * timestamps starting at max(now, last issued + 1), or below `now` if the
+ * high-water mark (below) has not caught up with the clock yet.  Ranges never
+ * overlap and later allocations get later ranges, even if the clock steps
+ * backwards.
+ * Allocation is a compare-and-swap on one counter, so any number of threads
+ * may share an oracle; a mu_tso_batch_t further amortizes it by reserving a
+ * block of timestamps per thread.
+ *
+ * The oracle never issues a timestamp at or above its high-water mark, and
+ * raises the mark (by the issue plus a window, default 3 seconds) durably
+ * before issuing past it.  The mark lives in two checksummed slots of a small
+ * file written alternately, so a torn write leaves the other slot intact.  In
+ * steady state that is one write and fdatasync() per window.  On restart the
+ * oracle resumes at max(now, mark), above anything issued before a crash.
+ */
+
+#ifndef _MU_TSO_H_
+#define _MU_TSO_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_TSO_DEFAULT_WINDOW 3000000000LL ///< 3 seconds
+
+/**
+ * @brief A timestamp oracle.  Treat the fields as private.
+ */
+typedef struct {
+    atomic_uint_fast64_t next;  ///< Next timestamp to issue
+    atomic_uint_fast64_t limit; ///< Durable high-water mark
+    pthread_mutex_t lock;       ///< Serializes raising the mark
+    int fd;                     ///< Mark file, or -1 if not persisted
+    uint64_t seq;               ///< Sequence of the last slot written
+    mu_time_rel_t window;       ///< Headroom added to each raise
+    atomic_uint_fast64_t persists; ///< Marks written
+} mu_tso_t;
+
+/**
+ * @brief A per-thread block of reserved timestamps.
+ */
+typedef struct {
+    uint64_t next;
+    uint64_t end;
+} mu_tso_batch_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Open an oracle, recovering its high-water mark.
+ *
+ * @param tso The oracle.
+ * @param path The mark file, or NULL for an oracle that is increasing only
+ * within this process.  An absent file is created, and its directory synced,
+ * before any mark is written to it.
+ * @param window Headroom added at each raise of the mark, or 0 for the
+ * default.  Larger windows mean fewer syncs, and a larger jump on restart.
+ * @return false on an I/O error, or with errno EINVAL if the file is not
+ * empty but holds no valid mark; errno is set either way.
+ */
+bool mu_tso_open(mu_tso_t *tso, const char *path, mu_time_rel_t window);
+
+/**
+ * @brief Close an oracle.
+ */
+void mu_tso_close(mu_tso_t *tso);
+
+/**
+ * @brief Allocate a range of timestamps.  Thread-safe.
+ *
+ * @param tso The oracle.
+ * @param count The number of timestamps, at least 1.
+ * @param first Receives the first; the range is [first, first + count).
+ * @return false if raising the mark failed, with errno set.
+ */
+bool mu_tso_alloc(mu_tso_t *tso, uint32_t count, uint64_t *first);
+
+/**
+ * @brief Allocate one timestamp.  Thread-safe.
+ */
+bool mu_tso_next(mu_tso_t *tso, uint64_t *ts);
+
+/**
+ * @brief Initialize an empty batch.
+ */
+void mu_tso_batch_init(mu_tso_batch_t *batch);
+
+/**
+ * @brief Take a timestamp from a batch, reserving another `refill` from the
+ * oracle when it runs out.
+ *
+ * Timestamps from one batch increase, and exceed every timestamp issued
+ * before the block was reserved; batches of different threads interleave.
+ */
+bool mu_tso_batch_next(mu_tso_t *tso, mu_tso_batch_t *batch, uint32_t refill,
+                       uint64_t *ts);
+
+/**
+ * @brief Return the durable high-water mark.
+ */
+uint64_t mu_tso_high_water(mu_tso_t *tso);
+
+/**
+ * @brief Return the number of times the mark has been written.
+ */
+uint64_t mu_tso_persists(mu_tso_t *tso);
+
+/**
+ * @brief Convert a timestamp to the time it was issued (or later, if issued
+ * faster than the clock ticks).
+ */
+mu_time_abs_t mu_tso_to_time(uint64_t ts);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_TSO_H_ */
@@ -0,0 +1,191 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_uring_time.h
+ * @brief io_uring timeouts from mu_time_abs_t deadlines, and a multiplexer
+ * that serves many deadlines with one kernel timeout (Linux).
+ *
+ * The prep helpers fill a raw struct io_uring_sqe, so they work with liburing
+ * or a hand-rolled ring alike.  Deadlines are passed to the kernel as absolute
+ * CLOCK_REALTIME times (IORING_TIMEOUT_ABS | IORING_TIMEOUT_REALTIME, Linux
+ * 5.15 and later), the clock behind mu_time_now() on POSIX, so a deadline
+ * computed once never drifts however late the SQE is submitted.
+ *
+ * The kernel timespec is read when the SQE is consumed, so it must stay valid
+ * until submission; the multiplexer keeps its own.
+ *
+ * mu_uring_timers_t keeps per-request deadlines in a mu_timer_wheel_t and
+ * arms a single IORING_OP_TIMEOUT for the earliest of them.  Timers may fire
+ * up to a configured slack late, so one expiry serves every deadline within
+ * the slack of the earliest.  Arming a later deadline costs no SQE at all;
+ * arming an earlier one moves the kernel timeout with IORING_TIMEOUT_UPDATE,
+ * unless the armed expiry is still within its slack.
+ */
+
+#ifndef _MU_URING_TIME_H_
+#define _MU_URING_TIME_H_
+
+#if defined(__linux__)
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_timer_wheel.h"
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+/**
+ * @brief A deadline multiplexer.  Treat the fields as private.
+ */
+typedef struct {
+    mu_timer_wheel_t wheel;
+    struct __kernel_timespec ts; ///< Expiry of the kernel timeout
+    mu_time_abs_t armed_at;      ///< Deadline of the kernel timeout
+    mu_time_rel_t slack;         ///< Tolerated lateness before re-arming
+    uint64_t user_data;          ///< Tag of the kernel timeout's CQEs
+    bool armed;                  ///< A kernel timeout is pending
+    uint64_t kernel_arms;        ///< IORING_OP_TIMEOUT SQEs issued
+    uint64_t kernel_updates;     ///< IORING_TIMEOUT_UPDATE SQEs issued
+} mu_uring_timers_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Convert a deadline to a kernel timespec.
+ */
+void mu_uring_timespec(struct __kernel_timespec *ts, mu_time_abs_t deadline);
+
+/**
+ * @brief Prepare an IORING_OP_TIMEOUT that completes with -ETIME at an
+ * absolute deadline.
+ *
+ * @param sqe The submission entry to fill.
+ * @param ts Storage for the deadline; must stay valid until submission.
+ * @param deadline The deadline.
+ * @param count Complete early after this many other completions, or 0.
+ * @param user_data Passed back in the CQE.
+ */
+void mu_uring_prep_timeout(struct io_uring_sqe *sqe,
+                           struct __kernel_timespec *ts, mu_time_abs_t deadline,
+                           unsigned count, uint64_t user_data);
+
+/**
+ * @brief Prepare an IORING_OP_LINK_TIMEOUT that cancels the preceding SQE
+ * (which must carry IOSQE_IO_LINK) if it is not done by a deadline.
+ */
+void mu_uring_prep_link_timeout(struct io_uring_sqe *sqe,
+                                struct __kernel_timespec *ts,
+                                mu_time_abs_t deadline, uint64_t user_data);
+
+/**
+ * @brief Prepare an update moving a pending timeout to a new deadline.
+ *
+ * @param sqe The submission entry to fill.
+ * @param ts Storage for the new deadline.
+ * @param target The user_data of the timeout to move.
+ * @param deadline The new deadline.
+ * @param user_data Passed back in the update's own CQE.
+ */
+void mu_uring_prep_timeout_update(struct io_uring_sqe *sqe,
+                                  struct __kernel_timespec *ts, uint64_t target,
+                                  mu_time_abs_t deadline, uint64_t user_data);
+
+/**
+ * @brief Prepare removal of a pending timeout.
+ */
+void mu_uring_prep_timeout_remove(struct io_uring_sqe *sqe, uint64_t target,
+                                  uint64_t user_data);
+
+/**
+ * @brief Initialize a multiplexer.
+ *
+ * @param t The multiplexer.
+ * @param now The current time.
+ * @param resolution Tick of the underlying timer wheel.
+ * @param slack How late a timer may fire, beyond the rounding of its
+ * deadline up to a tick.
+ * @param pool Node pool for mu_timer_wheel_schedule(), or NULL.
+ * @param user_data Tag for the multiplexer's CQEs.  It uses this value and
+ * user_data + 1; route CQEs carrying either to mu_uring_timers_complete().
+ */
+void mu_uring_timers_init(mu_uring_timers_t *t, mu_time_abs_t now,
+                          mu_time_rel_t resolution, mu_time_rel_t slack,
+                          mu_pool_t *pool, uint64_t user_data);
+
+/**
+ * @brief Return the wheel, to arm and cancel timers on.
+ */
+mu_timer_wheel_t *mu_uring_timers_wheel(mu_uring_timers_t *t);
+
+/**
+ * @brief Return true if the kernel timeout must be armed or moved, i.e. if
+ * mu_uring_timers_prep() wants an SQE before the next submission.
+ */
+bool mu_uring_timers_needs_sqe(const mu_uring_timers_t *t);
+
+/**
+ * @brief Fill an SQE that arms or moves the kernel timeout.  Call only when
+ * mu_uring_timers_needs_sqe() is true.
+ */
+void mu_uring_timers_prep(mu_uring_timers_t *t, struct io_uring_sqe *sqe);
+
+/**
+ * @brief Handle a CQE.
+ *
+ * @param t The multiplexer.
+ * @param user_data The CQE's user_data.
+ * @param res The CQE's result.
+ * @param now The current time.
+ * @return The number of timers fired, or -1 if the CQE was not the
+ * multiplexer's.
+ */
+int mu_uring_timers_complete(mu_uring_timers_t *t, uint64_t user_data,
+                             int32_t res, mu_time_abs_t now);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #if defined(__linux__) */
+
+#endif /* #ifndef _MU_URING_TIME_H_ */
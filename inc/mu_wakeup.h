@@ -0,0 +1,172 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_wakeup.h
+ * @brief Registry of subsystem deadlines for tickless idle.
+ *
+ * Each subsystem that keeps its own deadlines -- a timer wheel, a calendar
+ * queue, a periodic task -- owns a mu_wakeup_source_t and reports its
+ * earliest deadline whenever that changes.  The registry keeps the sources in
+ * a min-heap of fixed capacity, so a report costs O(log n) and
+ * mu_wakeup_next() (or mu_time_next_wakeup() on the default registry) answers
+ * in O(1).  The main loop uses the answer to pick a sleep depth and program
+ * the wake-up timer, without polling every subsystem.
+ *
+ * A registry belongs to the main loop.  Reports from an ISR or signal handler
+ * must go through the main loop first, for example via mu_fire_queue.h.
+ */
+
+#ifndef _MU_WAKEUP_H_
+#define _MU_WAKEUP_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_calendar_queue.h"
+#include "mu_time.h"
+#include "mu_timer_wheel.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#ifndef MU_WAKEUP_CAPACITY
+#define MU_WAKEUP_CAPACITY 16 ///< Sources with a deadline per registry
+#endif
+
+/**
+ * @brief A subsystem reporting deadlines.  Treat the fields as private.
+ */
+typedef struct {
+    mu_time_abs_t deadline; ///< Earliest deadline, while in the heap
+    const char *name;       ///< For diagnostics; may be NULL
+    int16_t index;          ///< Position in the heap, or -1
+} mu_wakeup_source_t;
+
+/**
+ * @brief A wakeup registry.  Treat the fields as private.
+ */
+typedef struct {
+    mu_wakeup_source_t *heap[MU_WAKEUP_CAPACITY];
+    size_t count; ///< Sources with a deadline
+} mu_wakeup_registry_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize an empty registry.
+ */
+void mu_wakeup_init(mu_wakeup_registry_t *reg);
+
+/**
+ * @brief Initialize a source with no deadline.
+ */
+void mu_wakeup_source_init(mu_wakeup_source_t *src, const char *name);
+
+/**
+ * @brief Report a source's earliest deadline, replacing its previous one.
+ *
+ * @return false if the source had no deadline and the registry already holds
+ * MU_WAKEUP_CAPACITY sources with one.
+ */
+bool mu_wakeup_report(mu_wakeup_registry_t *reg, mu_wakeup_source_t *src,
+                      mu_time_abs_t deadline);
+
+/**
+ * @brief Report that a source has no deadline.
+ */
+void mu_wakeup_clear(mu_wakeup_registry_t *reg, mu_wakeup_source_t *src);
+
+/**
+ * @brief Report the earliest deadline of a timer wheel, or clear the source if
+ * no timer is armed.
+ */
+bool mu_wakeup_report_wheel(mu_wakeup_registry_t *reg, mu_wakeup_source_t *src,
+                            const mu_timer_wheel_t *wheel);
+
+/**
+ * @brief Report the earliest event of a calendar queue, or clear the source if
+ * the queue is empty.
+ */
+bool mu_wakeup_report_calendar(mu_wakeup_registry_t *reg,
+                               mu_wakeup_source_t *src, mu_calendar_queue_t *q);
+
+/**
+ * @brief Return true if the source currently has a deadline.
+ */
+bool mu_wakeup_source_is_set(const mu_wakeup_source_t *src);
+
+/**
+ * @brief Find the earliest deadline of all sources.  O(1).
+ *
+ * @param reg The registry.
+ * @param deadline Receives the earliest deadline.
+ * @return false if no source has a deadline.
+ */
+bool mu_wakeup_next(const mu_wakeup_registry_t *reg, mu_time_abs_t *deadline);
+
+/**
+ * @brief Return the source with the earliest deadline, or NULL.  O(1).
+ */
+mu_wakeup_source_t *mu_wakeup_next_source(const mu_wakeup_registry_t *reg);
+
+/**
+ * @brief Return how long the main loop may sleep: the time from `now` to the
+ * earliest deadline, 0 if that is already due, or mu_time_rel_max() if no
+ * source has a deadline.
+ */
+mu_time_rel_t mu_wakeup_idle_for(const mu_wakeup_registry_t *reg,
+                                 mu_time_abs_t now);
+
+/**
+ * @brief Return the process-wide registry behind mu_time_next_wakeup().
+ */
+mu_wakeup_registry_t *mu_wakeup_default(void);
+
+/**
+ * @brief Find the earliest deadline reported to the default registry.  O(1).
+ *
+ * @return false if no source has a deadline.
+ */
+bool mu_time_next_wakeup(mu_time_abs_t *deadline);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_WAKEUP_H_ */
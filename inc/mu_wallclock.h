@@ -0,0 +1,175 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_wallclock.h
+ * @brief Derive wall-clock time from monotonic readings with one addition.
+ *
+ * Measurements want a monotonic clock; logs want wall time that agrees with
+ * the system.  Rather than read both clocks per event, a mu_wallclock_t keeps
+ * the offset from CLOCK_MONOTONIC to CLOCK_REALTIME (the clock behind
+ * mu_time_now()) and mu_wallclock_to_wall() applies it with mu_time_offset().
+ *
+ * CLOCK_MONOTONIC is used rather than CLOCK_MONOTONIC_RAW because NTP slews
+ * it together with CLOCK_REALTIME, so the offset between them only changes
+ * when the wall clock is stepped.  The owner refreshes the offset
+ * periodically through mu_wallclock_poll(), which also catches steps; on
+ * Linux, mu_wallclock_step_fd() reports a step the moment it happens.
+ *
+ * The offset is a single atomic, so any number of threads may convert while
+ * the owning thread refreshes.
+ */
+
+#ifndef _MU_WALLCLOCK_H_
+#define _MU_WALLCLOCK_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_WALLCLOCK_DEFAULT_PERIOD 1000000000LL  ///< 1 second
+#define MU_WALLCLOCK_DEFAULT_STEP_THRESHOLD 1000000LL ///< 1 mSec
+
+/**
+ * @brief A monotonic-to-wall mapping.  Treat the fields as private.
+ */
+typedef struct {
+    atomic_int_fast64_t offset;     ///< wall - monotonic, nanoseconds
+    atomic_uint_fast32_t steps;     ///< Steps detected so far
+    mu_time_abs_t next_refresh;     ///< Monotonic time of the next refresh
+    mu_time_rel_t period;           ///< Time between refreshes
+    mu_time_rel_t step_threshold;   ///< Offset change treated as a step
+    uint32_t refreshes;             ///< Refreshes so far
+} mu_wallclock_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Read CLOCK_MONOTONIC.  Async-signal-safe.
+ */
+mu_time_abs_t mu_wallclock_mono_now(void);
+
+/**
+ * @brief Initialize the mapping from a fresh reading of both clocks.
+ *
+ * @param wc The mapping.
+ * @param period Time between refreshes, or 0 for the default of 1 second.
+ * @param step_threshold Offset change counted as a step rather than jitter,
+ * or 0 for the default of 1 mSec.
+ */
+void mu_wallclock_init(mu_wallclock_t *wc, mu_time_rel_t period,
+                       mu_time_rel_t step_threshold);
+
+/**
+ * @brief Convert a monotonic reading to wall time.  Any thread; wait-free.
+ */
+mu_time_abs_t mu_wallclock_to_wall(const mu_wallclock_t *wc,
+                                   mu_time_abs_t mono);
+
+/**
+ * @brief Return the current wall time from a monotonic reading.
+ */
+mu_time_abs_t mu_wallclock_now(const mu_wallclock_t *wc);
+
+/**
+ * @brief Refresh the mapping if a period has elapsed.  Owner only.
+ *
+ * @param wc The mapping.
+ * @param mono The current monotonic time.
+ * @return true if the refresh found a step.
+ */
+bool mu_wallclock_poll(mu_wallclock_t *wc, mu_time_abs_t mono);
+
+/**
+ * @brief Re-read both clocks now and update the mapping.  Owner only.
+ *
+ * The clocks are read monotonic, wall, monotonic, keeping the tightest of a
+ * few brackets, so a preemption between the reads does not skew the offset.
+ *
+ * @return true if the offset moved by more than the step threshold.
+ */
+bool mu_wallclock_refresh(mu_wallclock_t *wc);
+
+/**
+ * @brief Update the mapping from a (monotonic, wall) pair read elsewhere,
+ * e.g. from a PTP or GPS timestamp.  Owner only.
+ *
+ * @return true if the offset moved by more than the step threshold.
+ */
+bool mu_wallclock_set(mu_wallclock_t *wc, mu_time_abs_t mono,
+                      mu_time_abs_t wall);
+
+/**
+ * @brief Return the current offset from monotonic to wall time.
+ */
+mu_time_rel_t mu_wallclock_offset(const mu_wallclock_t *wc);
+
+/**
+ * @brief Return the number of steps detected.  Readers can compare it with a
+ * previous value to mark discontinuities in their output.
+ */
+uint32_t mu_wallclock_steps(const mu_wallclock_t *wc);
+
+#if defined(__linux__)
+/**
+ * @brief Open a descriptor that becomes readable when the wall clock is set.
+ *
+ * Uses a timerfd with TFD_TIMER_CANCEL_ON_SET.  Poll it with the owner's
+ * other descriptors and call mu_wallclock_handle_step_fd() when readable.
+ *
+ * @return The descriptor, or -1 with errno set.
+ */
+int mu_wallclock_step_fd(void);
+
+/**
+ * @brief Consume a readable step descriptor, re-arm it and refresh.
+ *
+ * @return true if the refresh found a step.
+ */
+bool mu_wallclock_handle_step_fd(mu_wallclock_t *wc, int fd);
+#endif
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_WALLCLOCK_H_ */
@@ -0,0 +1,194 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file mu_wfq.h
+ * @brief Weighted fair queueing of jobs between tenants, in virtual time.
+ *
+ * Each tenant has a weight and a FIFO of jobs.  A tenant's virtual tag is the
+ * virtual finish time of the service it has received so far: running a job
+ * for `d` advances it by d * MU_WFQ_WEIGHT_ONE / weight.  The scheduler
+ * always serves the backlogged tenant with the smallest tag, so over any
+ * interval in which tenants stay backlogged, each receives service in
+ * proportion to its weight.  A tenant that becomes backlogged starts at the
+ * current virtual time rather than its stale tag, so idling earns no burst.
+ *
+ * Service durations are measured, not declared.  mu_wfq_next() charges the
+ * tenant its running estimate (an average of its measured durations) so that
+ * several workers may serve the same tenant at once; mu_wfq_complete()
+ * corrects the tag by the difference once the measured mu_time_rel_t is
+ * known.  Both are a handful of integer operations plus an O(log tenants)
+ * sift.
+ *
+ * Backlogged tenants live in a 4-ary min-heap of (tag, tenant) pairs in
+ * caller-provided storage, so comparisons touch one contiguous array and the
+ * tree is half as deep as a binary heap.
+ *
+ * A scheduler is not thread-safe; guard it with the job runner's lock.
+ */
+
+#ifndef _MU_WFQ_H_
+#define _MU_WFQ_H_
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// C++ Compatibility
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// *****************************************************************************
+// Public types and definitions
+
+#define MU_WFQ_WEIGHT_ONE 1024 ///< Weight of a tenant with a nominal share
+
+struct mu_wfq_tenant;
+
+/**
+ * @brief A queued job, embedded in the caller's job.  Treat the fields as
+ * private.
+ */
+typedef struct mu_wfq_job {
+    struct mu_wfq_job *next;
+    struct mu_wfq_tenant *tenant;
+    mu_time_rel_t charged; ///< Estimate charged at dispatch
+} mu_wfq_job_t;
+
+/**
+ * @brief A tenant.  Treat the fields as private.
+ */
+typedef struct mu_wfq_tenant {
+    mu_wfq_job_t *head;     ///< Oldest queued job
+    mu_wfq_job_t *tail;     ///< Newest queued job
+    uint64_t tag;           ///< Virtual finish time of service so far
+    mu_time_rel_t estimate; ///< Running average of measured durations
+    mu_time_rel_t served;   ///< Total measured service
+    uint32_t weight;
+    uint32_t queued;        ///< Jobs waiting
+    uint32_t running;       ///< Jobs dispatched but not completed
+    int32_t index;          ///< Position in the heap, or -1
+} mu_wfq_tenant_t;
+
+/**
+ * @brief A heap entry.  The tag is kept inline so that sifting never
+ * dereferences a tenant.
+ */
+typedef struct {
+    uint64_t tag;
+    mu_wfq_tenant_t *tenant;
+} mu_wfq_slot_t;
+
+/**
+ * @brief A scheduler.  Treat the fields as private.
+ */
+typedef struct {
+    mu_wfq_slot_t *heap; ///< Caller's storage, one slot per tenant
+    size_t capacity;
+    size_t count;        ///< Backlogged tenants
+    uint64_t vtime;      ///< Tag of the last tenant served
+} mu_wfq_t;
+
+// *****************************************************************************
+// Public declarations
+
+/**
+ * @brief Initialize a scheduler.
+ *
+ * @param s The scheduler.
+ * @param heap Storage for the heap.
+ * @param capacity Slots in `heap`: the most tenants that may be backlogged at
+ * once.
+ */
+void mu_wfq_init(mu_wfq_t *s, mu_wfq_slot_t *heap, size_t capacity);
+
+/**
+ * @brief Initialize a tenant.
+ *
+ * @param t The tenant.
+ * @param weight Its share relative to MU_WFQ_WEIGHT_ONE; at least 1.
+ * @param estimate Initial guess at a job's duration, refined by measurement.
+ */
+void mu_wfq_tenant_init(mu_wfq_tenant_t *t, uint32_t weight,
+                        mu_time_rel_t estimate);
+
+/**
+ * @brief Change a tenant's weight.  Takes effect from its next charge.
+ */
+void mu_wfq_set_weight(mu_wfq_tenant_t *t, uint32_t weight);
+
+/**
+ * @brief Queue a job for a tenant.
+ *
+ * @return false if the tenant was idle and the heap is full.
+ */
+bool mu_wfq_enqueue(mu_wfq_t *s, mu_wfq_tenant_t *t, mu_wfq_job_t *job);
+
+/**
+ * @brief Dequeue the next job to run, or NULL if no tenant is backlogged.
+ *
+ * The job's tenant is charged its estimate now; report the measured duration
+ * with mu_wfq_complete().
+ */
+mu_wfq_job_t *mu_wfq_next(mu_wfq_t *s);
+
+/**
+ * @brief Account for a finished job.
+ *
+ * @param s The scheduler.
+ * @param job A job returned by mu_wfq_next().
+ * @param service How long it ran.
+ */
+void mu_wfq_complete(mu_wfq_t *s, mu_wfq_job_t *job, mu_time_rel_t service);
+
+/**
+ * @brief Return the job's tenant.
+ */
+mu_wfq_tenant_t *mu_wfq_job_tenant(const mu_wfq_job_t *job);
+
+/**
+ * @brief Return the number of backlogged tenants.
+ */
+size_t mu_wfq_backlogged(const mu_wfq_t *s);
+
+/**
+ * @brief Return the total measured service of a tenant.
+ */
+mu_time_rel_t mu_wfq_served(const mu_wfq_tenant_t *t);
+
+// *****************************************************************************
+// End of file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef _MU_WFQ_H_ */
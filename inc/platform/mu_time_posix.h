@@ -63,6 +63,26 @@ typedef int64_t mu_time_rel_t;
 // *****************************************************************************
 // Public declarations
 
+/**
+ * @brief Converts an absolute time into signed nanoseconds since the Unix
+ * epoch.
+ *
+ * This is the bridge between the native POSIX representation and the integer
+ * `mu_tb_ns64` timebase (see mu_timebase.h).
+ *
+ * @param t An absolute time.
+ * @return Nanoseconds since 1970-01-01T00:00:00Z.
+ */
+int64_t mu_time_posix_to_nanos(mu_time_abs_t t);
+
+/**
+ * @brief Converts signed nanoseconds since the Unix epoch into an absolute
+ * time.
+ * @param nanos Nanoseconds since 1970-01-01T00:00:00Z.
+ * @return The equivalent absolute time, with nanoseconds in [0, 999999999].
+ */
+mu_time_abs_t mu_time_posix_from_nanos(int64_t nanos);
+
 // *****************************************************************************
 // End of file
 
@@ -0,0 +1,333 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_asof.h"
+#include "mu_time.h"
+#include "mu_time_column.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+/**
+ * @brief One partition of the left column and the right rows that arrive
+ * during it.
+ */
+typedef struct {
+    const mu_asof_t *join;
+    size_t *match;
+    size_t *last;      ///< Latest right row per key, or &single if one key
+    size_t single;     ///< The table of an unkeyed join
+    size_t begin;      ///< First left row
+    size_t end;        ///< Left row past the partition
+    size_t r_begin;    ///< First right row at or after the partition start
+    size_t r_end;      ///< Right row past the last one at or before its end
+    size_t matched;    ///< Left rows matched
+    size_t unresolved; ///< Keyed rows whose key had not appeared yet
+    size_t lo;         ///< First unresolved row
+    size_t hi;         ///< Row past the last unresolved row
+} part_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static size_t parts_for(const mu_asof_t *join, size_t n_threads);
+static size_t join_parts(const mu_asof_t *join, size_t *match, size_t *scratch,
+                         size_t n_parts);
+static void *part_main(void *arg);
+static void join_part(part_t *part);
+static void resolve(part_t *part, const size_t *carry);
+static void advance(const mu_asof_t *join, size_t *last, size_t from,
+                    size_t to);
+static bool within(const mu_asof_t *join, int64_t t, size_t j);
+static size_t gallop(const int64_t *v, size_t lo, size_t hi, int64_t t);
+static size_t key_of(const uint32_t *keys, size_t i);
+
+// *****************************************************************************
+// Public code
+
+void mu_asof_init(mu_asof_t *join, const mu_time_column_t *left,
+                  const mu_time_column_t *right) {
+    join->left = left;
+    join->right = right;
+    join->left_keys = NULL;
+    join->right_keys = NULL;
+    join->n_keys = 1;
+    join->tolerance = MU_ASOF_UNBOUNDED;
+}
+
+void mu_asof_set_tolerance(mu_asof_t *join, mu_time_rel_t tolerance) {
+    join->tolerance = tolerance;
+}
+
+bool mu_asof_set_keys(mu_asof_t *join, const uint32_t *left_keys,
+                      const uint32_t *right_keys, size_t n_keys) {
+    if ((left_keys == NULL) != (right_keys == NULL) ||
+        (left_keys != NULL && n_keys == 0)) {
+        return false;
+    }
+    join->left_keys = left_keys;
+    join->right_keys = right_keys;
+    join->n_keys = left_keys != NULL ? n_keys : 1;
+    return true;
+}
+
+size_t mu_asof_scratch_size(const mu_asof_t *join, size_t n_threads) {
+    if (join->n_keys == 1) {
+        return 0;
+    }
+    n_threads = n_threads == 0 ? 1 : n_threads;
+    n_threads = n_threads < MU_ASOF_MAX_PARTS ? n_threads : MU_ASOF_MAX_PARTS;
+    return join->n_keys * n_threads;
+}
+
+size_t mu_asof_run(const mu_asof_t *join, size_t *match, size_t *scratch) {
+    return join_parts(join, match, scratch, 1);
+}
+
+size_t mu_asof_run_parallel(const mu_asof_t *join, size_t *match,
+                            size_t *scratch, size_t n_threads) {
+    return join_parts(join, match, scratch, parts_for(join, n_threads));
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static size_t parts_for(const mu_asof_t *join, size_t n_threads) {
+    size_t n = join->left->length / MU_ASOF_MIN_PART_ROWS;
+
+    n = n < n_threads ? n : n_threads;
+    n = n < MU_ASOF_MAX_PARTS ? n : MU_ASOF_MAX_PARTS;
+    return n == 0 ? 1 : n;
+}
+
+static size_t join_parts(const mu_asof_t *join, size_t *match, size_t *scratch,
+                         size_t n_parts) {
+    const int64_t *lv = join->left->values + join->left->offset;
+    const int64_t *rv = join->right->values + join->right->offset;
+    size_t n = join->left->length;
+    part_t parts[MU_ASOF_MAX_PARTS];
+    pthread_t threads[MU_ASOF_MAX_PARTS];
+    bool started[MU_ASOF_MAX_PARTS];
+    size_t r = 0;
+
+    if (n == 0) {
+        return 0;
+    }
+    for (size_t p = 0; p < n_parts; p++) {
+        part_t *part = &parts[p];
+        part->join = join;
+        part->match = match;
+        part->last = join->n_keys > 1 ? &scratch[p * join->n_keys]
+                                      : &part->single;
+        part->begin = n * p / n_parts;
+        part->end = n * (p + 1) / n_parts;
+        part->r_begin = r;
+        r = gallop(rv, r, join->right->length, lv[part->end - 1]);
+        part->r_end = r;
+    }
+
+    // The caller joins the first partition, and any whose thread failed.
+    for (size_t p = 1; p < n_parts; p++) {
+        started[p] =
+            pthread_create(&threads[p], NULL, part_main, &parts[p]) == 0;
+    }
+    join_part(&parts[0]);
+    for (size_t p = 1; p < n_parts; p++) {
+        if (started[p]) {
+            pthread_join(threads[p], NULL);
+        } else {
+            join_part(&parts[p]);
+        }
+    }
+
+    // Fold each table into the next, so that parts[p - 1].last holds the
+    // latest right row per key before partition p.
+    size_t matched = parts[0].matched;
+    for (size_t p = 1; p < n_parts; p++) {
+        const size_t *carry = parts[p - 1].last;
+        size_t *last = parts[p].last;
+        if (parts[p].unresolved > 0) {
+            resolve(&parts[p], carry);
+        }
+        for (size_t k = 0; k < join->n_keys; k++) {
+            last[k] = last[k] == MU_ASOF_NONE ? carry[k] : last[k];
+        }
+        matched += parts[p].matched;
+    }
+    return matched;
+}
+
+static void *part_main(void *arg) {
+    join_part(arg);
+    return NULL;
+}
+
+/**
+ * @brief Join a partition on its own, leaving the latest right row per key
+ * in part->last.
+ */
+static void join_part(part_t *part) {
+    const mu_asof_t *join = part->join;
+    const int64_t *lv = join->left->values + join->left->offset;
+    const int64_t *rv = join->right->values + join->right->offset;
+    size_t r = part->r_begin;
+
+    for (size_t k = 0; k < join->n_keys; k++) {
+        part->last[k] = MU_ASOF_NONE;
+    }
+    part->matched = 0;
+    part->unresolved = 0;
+    part->lo = part->end;
+    part->hi = part->begin;
+    for (size_t i = part->begin; i < part->end; i++) {
+        int64_t t = lv[i];
+        size_t to = gallop(rv, r, part->r_end, t);
+        if (to != r) {
+            advance(join, part->last, r, to);
+            r = to;
+        }
+        part->match[i] = MU_ASOF_NONE;
+        if (!mu_time_column_is_valid(join->left, i)) {
+            continue;
+        }
+        size_t j = part->last[key_of(join->left_keys, i)];
+        if (j == MU_ASOF_NONE) {
+            // An earlier partition may still hold a match.
+            part->unresolved += 1;
+            part->lo = i < part->lo ? i : part->lo;
+            part->hi = i + 1;
+        } else if (within(join, t, j)) {
+            part->match[i] = j;
+            part->matched += 1;
+        }
+    }
+}
+
+/**
+ * @brief Match the unresolved rows of a partition against the latest right
+ * rows before it.
+ */
+static void resolve(part_t *part, const size_t *carry) {
+    const mu_asof_t *join = part->join;
+    const int64_t *lv = join->left->values + join->left->offset;
+
+    for (size_t i = part->lo; i < part->hi; i++) {
+        if (part->match[i] != MU_ASOF_NONE ||
+            !mu_time_column_is_valid(join->left, i)) {
+            continue;
+        }
+        size_t k = key_of(join->left_keys, i);
+        // Rows whose key had appeared in the partition already failed the
+        // tolerance against a newer row than carry[k], and fail it again.
+        if (carry[k] != MU_ASOF_NONE && within(join, lv[i], carry[k])) {
+            part->match[i] = carry[k];
+            part->matched += 1;
+        }
+    }
+}
+
+/**
+ * @brief Take right rows [from, to) into the per-key table of latest rows.
+ */
+static void advance(const mu_asof_t *join, size_t *last, size_t from,
+                    size_t to) {
+    const mu_time_column_t *right = join->right;
+    const uint32_t *keys = join->right_keys;
+
+    if (keys == NULL) {
+        // Only the last valid row of the block matters.
+        for (size_t j = to; j-- > from;) {
+            if (mu_time_column_is_valid(right, j)) {
+                last[0] = j;
+                break;
+            }
+        }
+    } else if (right->validity == NULL) {
+        for (size_t j = from; j < to; j++) {
+            last[keys[j]] = j;
+        }
+    } else {
+        for (size_t j = from; j < to; j++) {
+            if (mu_time_column_is_valid(right, j)) {
+                last[keys[j]] = j;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Return true if right row j, at or before t, is within tolerance.
+ */
+static bool within(const mu_asof_t *join, int64_t t, size_t j) {
+    int64_t r = join->right->values[join->right->offset + j];
+    uint64_t age = (uint64_t)t - (uint64_t)r;
+
+    return join->tolerance == MU_ASOF_UNBOUNDED ||
+           age <= (uint64_t)join->tolerance;
+}
+
+/**
+ * @brief Return the first index in [lo, hi) whose value is after t, or hi.
+ *
+ * Probes lo + 1, lo + 2, lo + 4, ... before bisecting, so the cost is
+ * logarithmic in the distance moved rather than in hi - lo.
+ */
+static size_t gallop(const int64_t *v, size_t lo, size_t hi, int64_t t) {
+    size_t step = 1;
+    size_t top;
+
+    if (lo == hi || v[lo] > t) {
+        return lo;
+    }
+    // v[lo] <= t
+    while (step < hi - lo && v[lo + step] <= t) {
+        lo += step;
+        step <<= 1;
+    }
+    top = step < hi - lo ? lo + step : hi;
+    lo += 1;
+    while (lo < top) {
+        size_t mid = lo + (top - lo) / 2;
+        if (v[mid] <= t) {
+            lo = mid + 1;
+        } else {
+            top = mid;
+        }
+    }
+    return lo;
+}
+
+static size_t key_of(const uint32_t *keys, size_t i) {
+    return keys == NULL ? 0 : keys[i];
+}
+
+// *****************************************************************************
+// End of file
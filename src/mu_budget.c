@@ -0,0 +1,213 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_budget.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static mu_time_abs_t read_clock(const mu_budget_t *budget);
+
+// *****************************************************************************
+// Public code
+
+void mu_budget_init(mu_budget_t *budget, const mu_coarse_clock_t *coarse) {
+    budget->coarse = coarse;
+    budget->start = read_clock(budget);
+    budget->deadline = budget->start;
+    budget->checked = budget->start;
+    budget->slice = 0;
+    budget->countdown = 1;
+    budget->stride = 1;
+}
+
+void mu_budget_start(mu_budget_t *budget, mu_time_rel_t slice) {
+    budget->start = read_clock(budget);
+    budget->deadline = mu_time_offset(budget->start, slice);
+    budget->checked = budget->start;
+    budget->slice = slice;
+    budget->countdown = 1;
+    budget->stride = 1;
+}
+
+bool mu_budget_check(mu_budget_t *budget) {
+    mu_time_abs_t now = read_clock(budget);
+    mu_time_rel_t since = mu_time_difference(budget->checked, now);
+    mu_time_rel_t target = budget->slice >> MU_BUDGET_CHECKS_SHIFT;
+    uint64_t stride = 2 * (uint64_t)budget->stride;
+
+    // Size the next stride from the cost per poll just measured, growing at
+    // most twofold so that one cheap interval cannot commit us to a long
+    // run of expensive ones.  A coarse clock that has not moved reads as
+    // free polls; reading it more often would not help.
+    if (since > 0 && (uint64_t)target * budget->stride < stride * since) {
+        stride = (uint64_t)target * budget->stride / (uint64_t)since;
+    }
+    if (stride < 1) {
+        stride = 1;
+    } else if (stride > MU_BUDGET_STRIDE_MAX) {
+        stride = MU_BUDGET_STRIDE_MAX;
+    }
+    budget->stride = (uint32_t)stride;
+    budget->checked = now;
+    if (mu_time_is_before(now, budget->deadline)) {
+        budget->countdown = budget->stride;
+        return false;
+    }
+    budget->countdown = 1;
+    return true;
+}
+
+mu_time_rel_t mu_budget_elapsed(const mu_budget_t *budget) {
+    return mu_time_difference(budget->start, budget->checked);
+}
+
+mu_time_rel_t mu_budget_remaining(const mu_budget_t *budget) {
+    return mu_time_difference(budget->checked, budget->deadline);
+}
+
+uint32_t mu_budget_stride(const mu_budget_t *budget) {
+    return budget->stride;
+}
+
+void mu_budget_rr_init(mu_budget_rr_t *rr, const mu_coarse_clock_t *coarse,
+                       mu_time_rel_t tolerance) {
+    mu_budget_init(&rr->budget, coarse);
+    rr->head = NULL;
+    rr->tail = NULL;
+    rr->tolerance = tolerance;
+}
+
+void mu_budget_task_init(mu_budget_task_t *task, mu_budget_fn fn, void *arg,
+                         mu_time_rel_t slice) {
+    task->next = NULL;
+    task->fn = fn;
+    task->arg = arg;
+    task->slice = slice;
+    task->max_overrun = 0;
+    task->runs = 0;
+    task->overruns = 0;
+    task->queued = false;
+}
+
+void mu_budget_rr_add(mu_budget_rr_t *rr, mu_budget_task_t *task) {
+    if (task->queued) {
+        return;
+    }
+    task->next = NULL;
+    task->queued = true;
+    if (rr->tail == NULL) {
+        rr->head = task;
+    } else {
+        rr->tail->next = task;
+    }
+    rr->tail = task;
+}
+
+void mu_budget_rr_remove(mu_budget_rr_t *rr, mu_budget_task_t *task) {
+    mu_budget_task_t *prev = NULL;
+
+    if (!task->queued) {
+        return;
+    }
+    for (mu_budget_task_t *t = rr->head; t != task; t = t->next) {
+        prev = t;
+    }
+    if (prev == NULL) {
+        rr->head = task->next;
+    } else {
+        prev->next = task->next;
+    }
+    if (rr->tail == task) {
+        rr->tail = prev;
+    }
+    task->next = NULL;
+    task->queued = false;
+}
+
+mu_budget_task_t *mu_budget_rr_run(mu_budget_rr_t *rr) {
+    mu_budget_task_t *task = rr->head;
+
+    if (task == NULL) {
+        return NULL;
+    }
+    rr->head = task->next;
+    if (rr->head == NULL) {
+        rr->tail = NULL;
+    }
+    task->next = NULL;
+    task->queued = false;
+
+    mu_budget_start(&rr->budget, task->slice);
+    bool more = task->fn(task, &rr->budget);
+    task->runs += 1;
+
+    mu_time_rel_t over = mu_time_difference(rr->budget.deadline,
+                                            read_clock(&rr->budget));
+    if (over > task->max_overrun) {
+        task->max_overrun = over;
+    }
+    if (over > rr->tolerance) {
+        task->overruns += 1;
+    }
+    if (more) {
+        // The task may have queued itself again from its body.
+        mu_budget_rr_add(rr, task);
+    }
+    return task;
+}
+
+bool mu_budget_rr_is_empty(const mu_budget_rr_t *rr) {
+    return rr->head == NULL;
+}
+
+void *mu_budget_task_arg(const mu_budget_task_t *task) { return task->arg; }
+
+uint32_t mu_budget_task_runs(const mu_budget_task_t *task) {
+    return task->runs;
+}
+
+uint32_t mu_budget_task_overruns(const mu_budget_task_t *task) {
+    return task->overruns;
+}
+
+mu_time_rel_t mu_budget_task_max_overrun(const mu_budget_task_t *task) {
+    return task->max_overrun;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static mu_time_abs_t read_clock(const mu_budget_t *budget) {
+    return budget->coarse != NULL ? budget->coarse->now : mu_time_now();
+}
+
+// *****************************************************************************
+// End of file
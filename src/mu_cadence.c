@@ -0,0 +1,249 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_cadence.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void interval(mu_cadence_t *det, int64_t d, mu_cadence_run_t *runs,
+                     size_t *emitted);
+static void resolve(mu_cadence_t *det, mu_cadence_run_t *runs,
+                    size_t *emitted);
+static void close_run(mu_cadence_t *det, mu_cadence_run_t *runs,
+                      size_t *emitted);
+static void open_run(mu_cadence_t *det, mu_cadence_kind_t kind, int64_t d);
+static void promote(mu_cadence_t *det);
+static void set_period(mu_cadence_t *det, int64_t period);
+static bool near(int64_t a, int64_t b, int64_t tolerance);
+
+// *****************************************************************************
+// Public code
+
+void mu_cadence_init(mu_cadence_t *det, int64_t period, int64_t tolerance,
+                     uint32_t confirm) {
+    det->max_tolerance = tolerance > 0 ? tolerance : 0;
+    set_period(det, period > 0 ? period : 0);
+    det->confirm = confirm > 0 ? confirm : 1;
+    det->samples = 0;
+    det->last = 0;
+    det->run.count = 0;
+    det->candidate.count = 0;
+}
+
+size_t mu_cadence_push(mu_cadence_t *det, int64_t t,
+                       mu_cadence_run_t runs[MU_CADENCE_MAX_EMIT]) {
+    size_t emitted = 0;
+
+    if (det->samples > 0) {
+        interval(det, t - det->last, runs, &emitted);
+    }
+    det->last = t;
+    det->samples += 1;
+    return emitted;
+}
+
+size_t mu_cadence_scan(mu_cadence_t *det, const int64_t *t, size_t n,
+                       mu_cadence_run_t *runs, size_t max, size_t *consumed) {
+    size_t emitted = 0;
+    size_t i = 0;
+
+    while (i < n && max - emitted >= MU_CADENCE_MAX_EMIT) {
+        // Inside a regular run, test whole blocks of intervals at once.  The
+        // test is branch-free so that it vectorizes.
+        if (det->run.count > 0 && det->run.kind == MU_CADENCE_REGULAR &&
+            det->candidate.count == 0 && i > 0 && n - i >= MU_CADENCE_BLOCK) {
+            const int64_t *b = &t[i - 1];
+            int64_t lo = det->period - det->tolerance;
+            int64_t hi = det->period + det->tolerance;
+            int64_t off = 0;
+            for (int j = 0; j < MU_CADENCE_BLOCK; j++) {
+                // Negative exactly when d < lo or d > hi.
+                int64_t d = b[j + 1] - b[j];
+                off |= (d - lo) | (hi - d);
+            }
+            if (off >= 0) {
+                det->run.count += MU_CADENCE_BLOCK;
+                det->run.span += b[MU_CADENCE_BLOCK] - b[0];
+                det->samples += MU_CADENCE_BLOCK;
+                det->last = b[MU_CADENCE_BLOCK];
+                i += MU_CADENCE_BLOCK;
+                continue;
+            }
+        }
+        // Per sample until the next block could be clean.
+        size_t end = i + MU_CADENCE_BLOCK < n ? i + MU_CADENCE_BLOCK : n;
+        while (i < end && max - emitted >= MU_CADENCE_MAX_EMIT) {
+            emitted += mu_cadence_push(det, t[i++], &runs[emitted]);
+        }
+    }
+    *consumed = i;
+    return emitted;
+}
+
+size_t mu_cadence_flush(mu_cadence_t *det,
+                        mu_cadence_run_t runs[MU_CADENCE_MAX_EMIT]) {
+    size_t emitted = 0;
+
+    resolve(det, runs, &emitted);
+    close_run(det, runs, &emitted);
+    return emitted;
+}
+
+int64_t mu_cadence_period(const mu_cadence_t *det) { return det->period; }
+
+uint64_t mu_cadence_missing(const mu_cadence_run_t *run) {
+    if (run->kind != MU_CADENCE_GAP || run->period <= 0) {
+        return 0;
+    }
+    uint64_t periods = (uint64_t)((run->span + run->period / 2) / run->period);
+    return periods > run->count ? periods - run->count : 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Classify the interval ending at the sample being pushed.
+ */
+static void interval(mu_cadence_t *det, int64_t d, mu_cadence_run_t *runs,
+                     size_t *emitted) {
+    mu_cadence_run_t *cand = &det->candidate;
+
+    if (cand->count > 0) {
+        int64_t mean = (cand->span + cand->count / 2) / cand->count;
+        if (d > det->tolerance && near(d, mean, det->tolerance)) {
+            cand->count += 1;
+            cand->span += d;
+            if (cand->count >= det->confirm) {
+                promote(det);
+            }
+            return;
+        }
+        resolve(det, runs, emitted);
+    }
+
+    mu_cadence_kind_t kind;
+    if (d < 0) {
+        kind = MU_CADENCE_BACKWARD;
+    } else if (d <= det->tolerance) {
+        kind = MU_CADENCE_DUPLICATE;
+    } else if (det->period > 0 && near(d, det->period, det->tolerance)) {
+        kind = MU_CADENCE_REGULAR;
+    } else {
+        // Off the period: hold it until it is confirmed or contradicted.
+        close_run(det, runs, emitted);
+        cand->start = det->last;
+        cand->span = d;
+        cand->first = det->samples - 1;
+        cand->count = 1;
+        cand->period = det->period;
+        if (cand->count >= det->confirm) {
+            promote(det);
+        }
+        return;
+    }
+    if (det->run.count > 0 && det->run.kind == kind) {
+        det->run.count += 1;
+        det->run.span += d;
+    } else {
+        close_run(det, runs, emitted);
+        open_run(det, kind, d);
+    }
+}
+
+/**
+ * @brief Report unconfirmed candidates as a GAP or IRREGULAR run.
+ */
+static void resolve(mu_cadence_t *det, mu_cadence_run_t *runs,
+                    size_t *emitted) {
+    mu_cadence_run_t *cand = &det->candidate;
+
+    if (cand->count == 0) {
+        return;
+    }
+    bool longer = cand->period > 0 && cand->span > cand->period * cand->count;
+    cand->kind = longer ? MU_CADENCE_GAP : MU_CADENCE_IRREGULAR;
+    runs[(*emitted)++] = *cand;
+    cand->count = 0;
+}
+
+static void close_run(mu_cadence_t *det, mu_cadence_run_t *runs,
+                      size_t *emitted) {
+    if (det->run.count > 0) {
+        runs[(*emitted)++] = det->run;
+        det->run.count = 0;
+    }
+}
+
+/**
+ * @brief Open a run at the interval ending at the sample being pushed.
+ */
+static void open_run(mu_cadence_t *det, mu_cadence_kind_t kind, int64_t d) {
+    det->run.start = det->last;
+    det->run.span = d;
+    det->run.period = det->period;
+    det->run.first = det->samples - 1;
+    det->run.count = 1;
+    det->run.kind = (uint8_t)kind;
+}
+
+/**
+ * @brief Adopt the candidates' mean interval as the period; they open a
+ * REGULAR run at it.
+ */
+static void promote(mu_cadence_t *det) {
+    mu_cadence_run_t *cand = &det->candidate;
+
+    set_period(det, (cand->span + cand->count / 2) / cand->count);
+    det->run = *cand;
+    det->run.kind = MU_CADENCE_REGULAR;
+    det->run.period = det->period;
+    cand->count = 0;
+}
+
+/**
+ * @brief Set the period, keeping the tolerance below half of it so that
+ * duplicates and regular intervals cannot be confused.
+ */
+static void set_period(mu_cadence_t *det, int64_t period) {
+    det->period = period;
+    det->tolerance = det->max_tolerance;
+    if (period > 0 && det->tolerance >= period / 2) {
+        det->tolerance = (period - 1) / 2;
+    }
+}
+
+static bool near(int64_t a, int64_t b, int64_t tolerance) {
+    return a - b <= tolerance && b - a <= tolerance;
+}
+
+// *****************************************************************************
+// End of file
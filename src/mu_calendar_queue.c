@@ -0,0 +1,354 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_calendar_queue.h"
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+// A well-tuned calendar touches about one bucket and one list node per
+// operation.  Rebuild with a fresh width when the average is well above that.
+#define COST_LIMIT 3
+
+// Operations between cost checks, at least
+#define COST_WINDOW 64
+
+// Average dequeue gaps per bucket.  Brown suggests three, but list nodes are
+// scattered through memory while bucket heads are contiguous, so skipping an
+// empty bucket is much cheaper than stepping over a queued event.  One gap per
+// bucket measured best in bench_mu_calendar_queue.
+#define WIDTH_GAPS 1
+
+// The dequeue gap average has GAP_SHIFT fraction bits and a weight of
+// 2^-GAP_SHIFT per new gap, which smooths the heavy-tailed gaps of random
+// event streams.  It replaces the queue's spread as the width estimate once
+// GAP_WARMUP gaps have been seen.
+#define GAP_SHIFT 6
+#define GAP_WARMUP 64
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static int64_t floor_div(int64_t a, int64_t b);
+static void set_cursor(mu_calendar_queue_t *q, mu_time_rel_t key);
+static size_t insert(mu_calendar_queue_t *q, mu_calendar_event_t *ev);
+static mu_calendar_event_t **find_min(mu_calendar_queue_t *q, size_t *steps);
+static bool charge(mu_calendar_queue_t *q, size_t steps);
+static mu_time_rel_t rebuild(mu_calendar_queue_t *q, size_t nbuckets);
+
+// *****************************************************************************
+// Public code
+
+bool mu_calendar_queue_init(mu_calendar_queue_t *q,
+                            mu_calendar_event_t **buckets, size_t capacity,
+                            mu_time_abs_t now, mu_time_rel_t width) {
+    size_t n = 1;
+
+    if (capacity == 0) {
+        return false;
+    }
+    // The largest power of two that fits, so that bucket masks work and
+    // growth never passes the caller's array.
+    while (n <= capacity / 2) {
+        n *= 2;
+    }
+    q->buckets = buckets;
+    q->capacity = n;
+    q->nbuckets = (n < MU_CALENDAR_QUEUE_MIN_BUCKETS)
+                      ? n
+                      : MU_CALENDAR_QUEUE_MIN_BUCKETS;
+    q->count = 0;
+    q->origin = now;
+    q->width = (width > 0) ? width : mu_time_rel_from_millis(1);
+    q->last_key = 0;
+    q->gap_avg = 0;
+    q->gap_samples = 0;
+    q->ops = 0;
+    q->cost = 0;
+    q->resizes = 0;
+    for (size_t i = 0; i < q->nbuckets; i++) {
+        q->buckets[i] = NULL;
+    }
+    set_cursor(q, 0);
+    return true;
+}
+
+void mu_calendar_queue_enqueue(mu_calendar_queue_t *q, mu_calendar_event_t *ev,
+                               mu_time_abs_t time) {
+    ev->key = mu_time_difference(q->origin, time);
+    if (q->count == 0 || ev->key < q->top - q->width) {
+        // Nothing queued, or earlier than the cursor: the cursor moves to it.
+        set_cursor(q, ev->key);
+    }
+    bool costly = charge(q, insert(q, ev));
+    q->count += 1;
+    if (q->count > 2 * q->nbuckets && q->nbuckets * 2 <= q->capacity) {
+        rebuild(q, q->nbuckets * 2);
+    } else if (costly) {
+        rebuild(q, q->nbuckets);
+    }
+}
+
+mu_calendar_event_t *mu_calendar_queue_dequeue(mu_calendar_queue_t *q) {
+    size_t steps;
+    mu_calendar_event_t **head = find_min(q, &steps);
+    mu_calendar_event_t *ev;
+
+    if (head == NULL) {
+        return NULL;
+    }
+    ev = *head;
+    *head = ev->next;
+    ev->next = NULL;
+    q->count -= 1;
+
+    // Fold the gap since the previous dequeue into the running average: a
+    // plain mean while warming up, then exponentially weighted.
+    int64_t gap = (int64_t)ev->key - (int64_t)q->last_key;
+    bool retune = false;
+    if (gap < 0) {
+        gap = 0;
+    }
+    if (q->gap_samples < GAP_WARMUP) {
+        q->gap_samples += 1;
+        q->gap_avg += ((gap << GAP_SHIFT) - q->gap_avg) / q->gap_samples;
+        // The width so far came from the queue's spread; replace it.
+        retune = q->gap_samples == GAP_WARMUP;
+    } else {
+        q->gap_avg += gap - (q->gap_avg >> GAP_SHIFT);
+    }
+    q->last_key = ev->key;
+
+    // Shrink, re-tune, or move the origin up before keys run out of range.
+    // The dequeued event is rebased along with the queue.
+    size_t n = q->nbuckets;
+    bool shrink = q->count < n / 2 && n > MU_CALENDAR_QUEUE_MIN_BUCKETS;
+    retune |= charge(q, steps);
+    if (retune || shrink || q->last_key > mu_time_rel_max() / 2) {
+        ev->key -= rebuild(q, shrink ? n / 2 : n);
+    }
+    return ev;
+}
+
+mu_calendar_event_t *mu_calendar_queue_peek(mu_calendar_queue_t *q) {
+    size_t steps;
+    mu_calendar_event_t **head = find_min(q, &steps);
+    return (head == NULL) ? NULL : *head;
+}
+
+bool mu_calendar_queue_remove(mu_calendar_queue_t *q, mu_calendar_event_t *ev) {
+    int64_t vb = floor_div(ev->key, q->width);
+    mu_calendar_event_t **link = &q->buckets[(size_t)vb & (q->nbuckets - 1)];
+
+    while (*link != NULL) {
+        if (*link == ev) {
+            *link = ev->next;
+            ev->next = NULL;
+            q->count -= 1;
+            return true;
+        }
+        link = &(*link)->next;
+    }
+    return false;
+}
+
+mu_time_abs_t mu_calendar_queue_event_time(const mu_calendar_queue_t *q,
+                                           const mu_calendar_event_t *ev) {
+    return mu_time_offset(q->origin, ev->key);
+}
+
+size_t mu_calendar_queue_count(const mu_calendar_queue_t *q) {
+    return q->count;
+}
+
+mu_time_rel_t mu_calendar_queue_width(const mu_calendar_queue_t *q) {
+    return q->width;
+}
+
+size_t mu_calendar_queue_buckets(const mu_calendar_queue_t *q) {
+    return q->nbuckets;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static int64_t floor_div(int64_t a, int64_t b) {
+    int64_t d = a / b;
+    return (a % b != 0 && a < 0) ? d - 1 : d;
+}
+
+static void set_cursor(mu_calendar_queue_t *q, mu_time_rel_t key) {
+    q->cursor = floor_div(key, q->width);
+    q->top = (q->cursor + 1) * (int64_t)q->width;
+}
+
+/**
+ * @brief Insert into the event's bucket after any equal keys.
+ *
+ * @return The number of list nodes stepped over.
+ */
+static size_t insert(mu_calendar_queue_t *q, mu_calendar_event_t *ev) {
+    int64_t vb = floor_div(ev->key, q->width);
+    mu_calendar_event_t **link = &q->buckets[(size_t)vb & (q->nbuckets - 1)];
+    size_t steps = 0;
+
+    while (*link != NULL && (*link)->key <= ev->key) {
+        link = &(*link)->next;
+        steps += 1;
+    }
+    ev->next = *link;
+    *link = ev;
+    return steps;
+}
+
+/**
+ * @brief Advance the cursor to the earliest event.
+ *
+ * @return The link holding the earliest event, or NULL if the queue is empty.
+ */
+static mu_calendar_event_t **find_min(mu_calendar_queue_t *q, size_t *steps) {
+    size_t mask = q->nbuckets - 1;
+
+    *steps = 0;
+    if (q->count == 0) {
+        return NULL;
+    }
+    // Walk one year of the calendar from the cursor.  Heads are the minimum of
+    // their bucket, so the first head that falls within its day is the
+    // earliest event.
+    for (; *steps < q->nbuckets; *steps += 1) {
+        mu_calendar_event_t **head = &q->buckets[(size_t)q->cursor & mask];
+        if (*head != NULL && (*head)->key < q->top) {
+            return head;
+        }
+        q->cursor += 1;
+        q->top += q->width;
+    }
+
+    // A whole year without a due event: the queue is sparse relative to the
+    // width.  Jump straight to the smallest head.
+    mu_calendar_event_t **best = NULL;
+    for (size_t i = 0; i < q->nbuckets; i++) {
+        mu_calendar_event_t **head = &q->buckets[i];
+        if (*head != NULL && (best == NULL || (*head)->key < (*best)->key)) {
+            best = head;
+        }
+    }
+    set_cursor(q, (*best)->key);
+    *steps += q->nbuckets;
+    return best;
+}
+
+/**
+ * @brief Account for work done by one operation.
+ *
+ * @return true at the end of a window whose average cost calls for a new
+ * width.
+ */
+static bool charge(mu_calendar_queue_t *q, size_t steps) {
+    size_t window = (q->nbuckets > COST_WINDOW) ? q->nbuckets : COST_WINDOW;
+
+    q->cost += (uint32_t)((steps > window) ? window : steps);
+    q->ops += 1;
+    if (q->ops < window) {
+        return false;
+    }
+    bool costly = q->cost > q->ops * COST_LIMIT;
+    q->ops = 0;
+    q->cost = 0;
+    return costly;
+}
+
+/**
+ * @brief Re-hash every event into `nbuckets` buckets with a fresh width, and
+ * rebase keys on the earliest event.
+ *
+ * @return The amount subtracted from every key.
+ */
+static mu_time_rel_t rebuild(mu_calendar_queue_t *q, size_t nbuckets) {
+    mu_calendar_event_t *all = NULL;
+    mu_calendar_event_t **tail = &all;
+    mu_time_rel_t lo = q->last_key;
+    mu_time_rel_t hi = q->last_key;
+
+    // Unlink every bucket onto one list.  Equal keys share a bucket, so their
+    // relative order survives re-insertion.
+    for (size_t i = 0; i < q->nbuckets; i++) {
+        if (q->buckets[i] == NULL) {
+            continue;
+        }
+        *tail = q->buckets[i];
+        while (*tail != NULL) {
+            if ((*tail)->key < lo) {
+                lo = (*tail)->key;
+            }
+            if ((*tail)->key > hi) {
+                hi = (*tail)->key;
+            }
+            tail = &(*tail)->next;
+        }
+        q->buckets[i] = NULL;
+    }
+
+    // Estimate the width from observed gaps, or from the spread of the queue
+    // until enough gaps have been seen.
+    int64_t width;
+    if (q->gap_samples >= GAP_WARMUP) {
+        width = (WIDTH_GAPS * q->gap_avg) >> GAP_SHIFT;
+    } else if (q->count > 1) {
+        width = WIDTH_GAPS * ((int64_t)hi - (int64_t)lo) / (int64_t)q->count;
+    } else {
+        width = q->width;
+    }
+    q->width = (mu_time_rel_t)((width > 0) ? width : 1);
+
+    // Rebase so keys stay small and the cursor starts at the earliest event.
+    mu_time_rel_t shift = lo;
+    q->origin = mu_time_offset(q->origin, shift);
+    q->last_key -= shift;
+
+    q->nbuckets = nbuckets;
+    for (size_t i = 0; i < nbuckets; i++) {
+        q->buckets[i] = NULL;
+    }
+    while (all != NULL) {
+        mu_calendar_event_t *ev = all;
+        all = ev->next;
+        ev->key -= shift;
+        insert(q, ev);
+    }
+    set_cursor(q, 0);
+    q->resizes += 1;
+    return shift;
+}
+
+// *****************************************************************************
+// End of file
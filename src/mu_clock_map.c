@@ -0,0 +1,186 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_clock_map.h"
+#include "mu_time.h"
+#include "mu_timebase.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static mu_clock_map_point_t *hull_at(mu_clock_map_t *cm, size_t i);
+static double slope(const mu_clock_map_point_t *a,
+                    const mu_clock_map_point_t *b);
+static void hull_push(mu_clock_map_t *cm, const mu_clock_map_point_t *p);
+static void update_estimate(mu_clock_map_t *cm);
+static uint32_t host_hz(void);
+
+// *****************************************************************************
+// Public code
+
+void mu_clock_map_init(mu_clock_map_t *cm, uint32_t device_hz) {
+    cm->device_hz = device_hz;
+    mu_clock_map_reset(cm);
+}
+
+void mu_clock_map_reset(mu_clock_map_t *cm) {
+    cm->sample_count = 0;
+    cm->last_dev = 0;
+    cm->dev_origin = 0;
+    cm->hull_head = 0;
+    cm->hull_len = 0;
+    mu_timebase_map_init(&cm->map, cm->device_hz, host_hz(), 0, 0);
+}
+
+void mu_clock_map_add_sample(mu_clock_map_t *cm, uint32_t device_ticks,
+                             mu_time_abs_t host_time) {
+    mu_clock_map_point_t p;
+
+    if (cm->sample_count == 0) {
+        cm->last_dev = device_ticks;
+        cm->dev_origin = device_ticks;
+        cm->host_origin = host_time;
+    } else {
+        uint64_t prev = cm->last_dev;
+        mu_timebase_unwrap32(&cm->last_dev, device_ticks);
+        if ((int64_t)(cm->last_dev - prev) <= 0) {
+            // device counter did not advance: keep the newest position only
+            cm->last_dev = prev;
+            return;
+        }
+    }
+    cm->sample_count += 1;
+
+    p.dev = (int64_t)(cm->last_dev - cm->dev_origin);
+    p.host = (int64_t)mu_time_difference(cm->host_origin, host_time);
+    hull_push(cm, &p);
+    update_estimate(cm);
+}
+
+bool mu_clock_map_is_valid(const mu_clock_map_t *cm) {
+    return cm->sample_count > 0;
+}
+
+mu_time_abs_t mu_clock_map_to_host(const mu_clock_map_t *cm,
+                                   uint32_t device_ticks) {
+    int32_t step = (int32_t)(device_ticks - (uint32_t)cm->last_dev);
+    uint64_t dev = cm->last_dev + (uint64_t)(int64_t)step;
+    int64_t rel = (int64_t)mu_timebase_map_apply(&cm->map, dev);
+    return mu_time_offset(cm->host_origin, (mu_time_rel_t)rel);
+}
+
+int32_t mu_clock_map_skew_ppb(const mu_clock_map_t *cm) {
+    double ratio = (double)cm->map.nominal_q32 / (double)cm->map.scale_q32;
+    return (int32_t)((ratio - 1.0) * 1e9 + (ratio >= 1.0 ? 0.5 : -0.5));
+}
+
+size_t mu_clock_map_hull_size(const mu_clock_map_t *cm) {
+    return cm->hull_len;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static mu_clock_map_point_t *hull_at(mu_clock_map_t *cm, size_t i) {
+    return &cm->hull[(cm->hull_head + i) % MU_CLOCK_MAP_HULL_CAPACITY];
+}
+
+static double slope(const mu_clock_map_point_t *a,
+                    const mu_clock_map_point_t *b) {
+    return (double)(b->host - a->host) / (double)(b->dev - a->dev);
+}
+
+static void hull_push(mu_clock_map_t *cm, const mu_clock_map_point_t *p) {
+    // Pop vertices that no longer make a convex (counterclockwise) turn.
+    while (cm->hull_len >= 2) {
+        mu_clock_map_point_t *a = hull_at(cm, cm->hull_len - 2);
+        mu_clock_map_point_t *b = hull_at(cm, cm->hull_len - 1);
+        if (slope(a, b) < slope(b, p)) {
+            break;
+        }
+        cm->hull_len -= 1;
+    }
+    if (cm->hull_len == MU_CLOCK_MAP_HULL_CAPACITY) {
+        // age out the oldest vertex
+        cm->hull_head = (cm->hull_head + 1) % MU_CLOCK_MAP_HULL_CAPACITY;
+        cm->hull_len -= 1;
+    }
+    *hull_at(cm, cm->hull_len) = *p;
+    cm->hull_len += 1;
+}
+
+static void update_estimate(mu_clock_map_t *cm) {
+    mu_clock_map_point_t *a;
+    mu_clock_map_point_t *b;
+    size_t lo = 0;
+    size_t hi;
+    double scale;
+    double limit;
+
+    if (cm->hull_len < 2) {
+        a = hull_at(cm, 0);
+        mu_timebase_map_set_origin(&cm->map, cm->dev_origin + (uint64_t)a->dev,
+                                   (uint64_t)a->host);
+        return;
+    }
+
+    // Binary search for the edge spanning the middle of the window.
+    int64_t mid = hull_at(cm, 0)->dev +
+                  (hull_at(cm, cm->hull_len - 1)->dev - hull_at(cm, 0)->dev) / 2;
+    hi = cm->hull_len - 1;
+    while (hi - lo > 1) {
+        size_t m = (lo + hi) / 2;
+        if (hull_at(cm, m)->dev <= mid) {
+            lo = m;
+        } else {
+            hi = m;
+        }
+    }
+    a = hull_at(cm, lo);
+    b = hull_at(cm, lo + 1);
+
+    scale = slope(a, b) * 4294967296.0;
+    limit = (double)cm->map.nominal_q32 * (double)MU_CLOCK_MAP_MAX_SKEW_PPB * 1e-9;
+    if (scale > (double)cm->map.nominal_q32 + limit) {
+        scale = (double)cm->map.nominal_q32 + limit;
+    } else if (scale < (double)cm->map.nominal_q32 - limit) {
+        scale = (double)cm->map.nominal_q32 - limit;
+    }
+    cm->map.scale_q32 = (uint64_t)(scale + 0.5);
+    mu_timebase_map_set_origin(&cm->map, cm->dev_origin + (uint64_t)a->dev,
+                               (uint64_t)a->host);
+}
+
+static uint32_t host_hz(void) {
+    return (uint32_t)mu_time_rel_from_millis(1000);
+}
+
+// *****************************************************************************
+// End of file
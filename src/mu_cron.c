@@ -0,0 +1,490 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_cron.h"
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define SECONDS_PER_DAY 86400
+#define MINUTES_PER_DAY 1440
+
+/**
+ * @brief Bounds and names of one field.
+ */
+typedef struct {
+    int lo;
+    int hi;
+    const char *const *names; ///< Names of lo, lo + 1, ..., or NULL
+    int named;                ///< Number of names
+} field_t;
+
+/**
+ * @brief A macro and its expansion.
+ */
+typedef struct {
+    const char *name;
+    const char *expr;
+} macro_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static const char *const s_month_names[] = {"jan", "feb", "mar", "apr",
+                                            "may", "jun", "jul", "aug",
+                                            "sep", "oct", "nov", "dec"};
+
+static const char *const s_weekday_names[] = {"sun", "mon", "tue", "wed",
+                                              "thu", "fri", "sat"};
+
+static const field_t s_fields[5] = {
+    {0, 59, NULL, 0},
+    {0, 23, NULL, 0},
+    {1, 31, NULL, 0},
+    {1, 12, s_month_names, 12},
+    {0, 7, s_weekday_names, 7},
+};
+
+static const macro_t s_macros[] = {
+    {"@yearly", "0 0 1 1 *"},  {"@annually", "0 0 1 1 *"},
+    {"@monthly", "0 0 1 * *"}, {"@weekly", "0 0 * * 0"},
+    {"@daily", "0 0 * * *"},   {"@midnight", "0 0 * * *"},
+    {"@hourly", "0 * * * *"},
+};
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool parse_field(const char **p, const field_t *field, uint64_t *bits,
+                        bool *any);
+static bool parse_value(const char **p, const field_t *field, int *value);
+static uint64_t day_bits(const mu_cron_t *cron, int64_t year, int month);
+static int days_in_month(int64_t year, int month);
+static int64_t days_from_civil(int64_t y, int m, int d);
+static void civil_from_days(int64_t z, int64_t *y, int *m, int *d);
+static int64_t floor_div(int64_t a, int64_t b);
+static void job_fire(mu_timer_t *timer, void *arg);
+static bool next_utc(const mu_cron_t *cron, mu_time_bucket_zone_t *zone,
+                     int64_t after, int64_t floor_local, int64_t *utc,
+                     int64_t *local);
+
+// *****************************************************************************
+// Public code
+
+bool mu_cron_compile(mu_cron_t *cron, const char *expr) {
+    uint64_t bits[5];
+    bool any[5];
+
+    while (isspace((unsigned char)*expr)) {
+        expr++;
+    }
+    if (*expr == '@') {
+        size_t n = strcspn(expr, " \t\n");
+        for (size_t i = 0; i < sizeof(s_macros) / sizeof(s_macros[0]); i++) {
+            if (strlen(s_macros[i].name) == n &&
+                strncasecmp(expr, s_macros[i].name, n) == 0) {
+                return mu_cron_compile(cron, s_macros[i].expr);
+            }
+        }
+        return false;
+    }
+    for (int f = 0; f < 5; f++) {
+        if (f > 0 && !isspace((unsigned char)*expr)) {
+            return false;
+        }
+        while (isspace((unsigned char)*expr)) {
+            expr++;
+        }
+        if (!parse_field(&expr, &s_fields[f], &bits[f], &any[f])) {
+            return false;
+        }
+    }
+    while (isspace((unsigned char)*expr)) {
+        expr++;
+    }
+    if (*expr != '\0') {
+        return false;
+    }
+    // Weekday 7 is another name for Sunday.
+    bits[4] = (bits[4] | (bits[4] >> 7)) & 0x7f;
+
+    cron->minutes = bits[0];
+    cron->hours = (uint32_t)bits[1];
+    cron->days = (uint32_t)bits[2];
+    cron->months = (uint16_t)bits[3];
+    cron->weekdays = (uint8_t)bits[4];
+    cron->any_day = any[2];
+    cron->any_weekday = any[4];
+    return true;
+}
+
+bool mu_cron_matches_local(const mu_cron_t *cron, int64_t local) {
+    int64_t minute = floor_div(local, 60);
+    int64_t days = floor_div(minute, MINUTES_PER_DAY);
+    int of_day = (int)(minute - days * MINUTES_PER_DAY);
+    int64_t y;
+    int m, d;
+
+    civil_from_days(days, &y, &m, &d);
+    return (cron->months >> m & 1) && (day_bits(cron, y, m) >> d & 1) &&
+           (cron->hours >> (of_day / 60) & 1) &&
+           (cron->minutes >> (of_day % 60) & 1);
+}
+
+bool mu_cron_next_local(const mu_cron_t *cron, int64_t after, int64_t *next) {
+    int64_t minute = floor_div(after, 60) + 1;
+    int64_t days = floor_div(minute, MINUTES_PER_DAY);
+    int of_day = (int)(minute - days * MINUTES_PER_DAY);
+    int h = of_day / 60;
+    int mi = of_day % 60;
+    int64_t y;
+    int m, d;
+
+    civil_from_days(days, &y, &m, &d);
+    for (int months = 0; months < MU_CRON_SEARCH_MONTHS;) {
+        uint32_t later_months = (uint32_t)cron->months >> m << m;
+        if (later_months == 0 || (later_months & (1u << m)) == 0) {
+            // Skip to the next matching month, this year or next.
+            if (later_months != 0) {
+                m = __builtin_ctz(later_months);
+            } else {
+                y += 1;
+                m = __builtin_ctz(cron->months);
+            }
+            d = 1, h = 0, mi = 0;
+            months += 1;
+            continue;
+        }
+        uint64_t later_days = day_bits(cron, y, m) >> d << d;
+        if (later_days == 0) {
+            if (++m > 12) {
+                y += 1, m = 1;
+            }
+            d = 1, h = 0, mi = 0;
+            months += 1;
+            continue;
+        }
+        int nd = __builtin_ctzll(later_days);
+        if (nd != d) {
+            d = nd, h = 0, mi = 0;
+        }
+        uint32_t later_hours = h < 24 ? cron->hours >> h << h : 0;
+        if (later_hours == 0) {
+            d += 1, h = 0, mi = 0;
+            continue;
+        }
+        int nh = __builtin_ctz(later_hours);
+        if (nh != h) {
+            h = nh, mi = 0;
+        }
+        uint64_t later_minutes = cron->minutes >> mi << mi;
+        if (later_minutes == 0) {
+            h += 1, mi = 0;
+            continue;
+        }
+        mi = __builtin_ctzll(later_minutes);
+        *next = (days_from_civil(y, m, d) * MINUTES_PER_DAY + h * 60 + mi) * 60;
+        return true;
+    }
+    return false;
+}
+
+bool mu_cron_next(const mu_cron_t *cron, mu_time_bucket_zone_t *zone,
+                  mu_time_abs_t after, mu_time_abs_t *next) {
+    int64_t utc, local;
+
+    if (!next_utc(cron, zone, (int64_t)after.seconds, INT64_MIN, &utc,
+                  &local)) {
+        return false;
+    }
+    *next = mu_time_posix_from_nanos(utc * 1000000000);
+    return true;
+}
+
+void mu_cron_sched_init(mu_cron_sched_t *sched, mu_timer_wheel_t *wheel,
+                        mu_time_bucket_zone_t *zone) {
+    sched->wheel = wheel;
+    sched->zone = zone;
+}
+
+void mu_cron_job_init(mu_cron_job_t *job, const mu_cron_t *cron, mu_cron_fn fn,
+                      void *arg) {
+    mu_timer_init(&job->timer, job_fire, job);
+    job->cron = cron;
+    job->sched = NULL;
+    job->fn = fn;
+    job->arg = arg;
+    job->last_local = INT64_MIN;
+}
+
+bool mu_cron_job_start(mu_cron_sched_t *sched, mu_cron_job_t *job,
+                       mu_time_abs_t now) {
+    int64_t utc, local;
+
+    mu_cron_job_stop(job);
+    job->sched = sched;
+    job->last_local = INT64_MIN;
+    if (!next_utc(job->cron, sched->zone, (int64_t)now.seconds, INT64_MIN,
+                  &utc, &local)) {
+        return false;
+    }
+    job->next = mu_time_posix_from_nanos(utc * 1000000000);
+    job->last_local = local;
+    mu_timer_wheel_arm(sched->wheel, &job->timer, job->next);
+    return true;
+}
+
+void mu_cron_job_stop(mu_cron_job_t *job) {
+    if (job->sched != NULL) {
+        mu_timer_wheel_cancel(job->sched->wheel, &job->timer);
+    }
+}
+
+bool mu_cron_job_is_running(const mu_cron_job_t *job) {
+    return mu_timer_is_pending(&job->timer);
+}
+
+mu_time_abs_t mu_cron_job_next(const mu_cron_job_t *job) { return job->next; }
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Run a job's occurrence and arm the one after it.
+ */
+static void job_fire(mu_timer_t *timer, void *arg) {
+    mu_cron_job_t *job = arg;
+    mu_time_abs_t when = job->next;
+    int64_t utc, local;
+
+    (void)timer;
+    // Arm first so that the callback may stop or restart the job.  Searching
+    // from the local time just run keeps a repeated local hour from running
+    // the occurrence twice.
+    if (next_utc(job->cron, job->sched->zone, (int64_t)when.seconds,
+                 job->last_local, &utc, &local)) {
+        job->next = mu_time_posix_from_nanos(utc * 1000000000);
+        job->last_local = local;
+        mu_timer_wheel_arm(job->sched->wheel, &job->timer, job->next);
+    }
+    job->fn(job, when, job->arg);
+}
+
+/**
+ * @brief Find the first occurrence after UTC second `after` whose local time
+ * is also after `floor_local`.
+ */
+static bool next_utc(const mu_cron_t *cron, mu_time_bucket_zone_t *zone,
+                     int64_t after, int64_t floor_local, int64_t *utc,
+                     int64_t *local) {
+    int32_t off0 = mu_time_bucket_utc_offset(zone, after);
+    int64_t from = after + off0;
+
+    if (from < floor_local) {
+        from = floor_local;
+    }
+    for (;;) {
+        int64_t l;
+        if (!mu_cron_next_local(cron, from, &l)) {
+            return false;
+        }
+        // The common case: no offset change in between.
+        int64_t t = l - off0;
+        int32_t off1 = mu_time_bucket_utc_offset(zone, t);
+        if (off1 != off0) {
+            // Valid under the new offset, or skipped: keep the old one.
+            int64_t t2 = l - off1;
+            if (mu_time_bucket_utc_offset(zone, t2) == off1) {
+                t = t2;
+            }
+        }
+        if (t > after) {
+            *utc = t;
+            *local = l;
+            return true;
+        }
+        from = l;
+    }
+}
+
+/**
+ * @brief Parse one field into a bitset of lo..hi.
+ */
+static bool parse_field(const char **p, const field_t *field, uint64_t *bits,
+                        bool *any) {
+    const char *s = *p;
+
+    *bits = 0;
+    *any = (*s == '*');
+    for (;;) {
+        int lo, hi, step = 1;
+        if (*s == '*') {
+            lo = field->lo, hi = field->hi;
+            s++;
+        } else {
+            if (!parse_value(&s, field, &lo)) {
+                return false;
+            }
+            hi = lo;
+            if (*s == '-') {
+                s++;
+                if (!parse_value(&s, field, &hi) || hi < lo) {
+                    return false;
+                }
+            }
+        }
+        if (*s == '/') {
+            s++;
+            if (!isdigit((unsigned char)*s)) {
+                return false;
+            }
+            step = 0;
+            while (isdigit((unsigned char)*s) && step <= field->hi) {
+                step = step * 10 + (*s++ - '0');
+            }
+            if (step == 0 || isdigit((unsigned char)*s)) {
+                return false;
+            }
+            if (hi == lo) {
+                // "a/n" runs from a to the end of the field.
+                hi = field->hi;
+            }
+        }
+        for (int v = lo; v <= hi; v += step) {
+            *bits |= (uint64_t)1 << v;
+        }
+        if (*s != ',') {
+            break;
+        }
+        s++;
+    }
+    *p = s;
+    return *s == '\0' || isspace((unsigned char)*s);
+}
+
+static bool parse_value(const char **p, const field_t *field, int *value) {
+    const char *s = *p;
+
+    if (isdigit((unsigned char)*s)) {
+        int v = 0;
+        while (isdigit((unsigned char)*s) && v <= field->hi) {
+            v = v * 10 + (*s++ - '0');
+        }
+        if (isdigit((unsigned char)*s) || v < field->lo || v > field->hi) {
+            return false;
+        }
+        *value = v;
+        *p = s;
+        return true;
+    }
+    if (field->names != NULL && isalpha((unsigned char)s[0]) &&
+        isalpha((unsigned char)s[1]) && isalpha((unsigned char)s[2]) &&
+        !isalpha((unsigned char)s[3])) {
+        for (int i = 0; i < field->named; i++) {
+            if (strncasecmp(s, field->names[i], 3) == 0) {
+                *value = field->lo + i;
+                *p = s + 3;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Return the matching days of a month as bits 1..31.
+ */
+static uint64_t day_bits(const mu_cron_t *cron, int64_t year, int month) {
+    uint64_t all = (((uint64_t)1 << days_in_month(year, month)) - 1) << 1;
+    int64_t first = days_from_civil(year, month, 1);
+    int w = (int)(first + 4 - floor_div(first + 4, 7) * 7); // 1st's weekday
+    uint64_t wd = cron->weekdays;
+
+    // Rotate the weekday set so that bit 0 is the weekday of the 1st, then
+    // repeat it across the month.
+    uint64_t week = ((wd >> w) | (wd << (7 - w))) & 0x7f;
+    uint64_t by_weekday = (week | week << 7 | week << 14 | week << 21 |
+                           week << 28) << 1;
+    uint64_t by_day = cron->days;
+    uint64_t bits;
+
+    // A field starting with `*` (even `*/n`) makes a day match both fields;
+    // a plain `*` has every bit set, so it leaves the other field alone.
+    if (cron->any_day || cron->any_weekday) {
+        bits = by_day & by_weekday;
+    } else {
+        bits = by_day | by_weekday;
+    }
+    return bits & all;
+}
+
+static int days_in_month(int64_t year, int month) {
+    static const uint8_t days[12] = {31, 28, 31, 30, 31, 30,
+                                     31, 31, 30, 31, 30, 31};
+    if (month == 2 && (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0))) {
+        return 29;
+    }
+    return days[month - 1];
+}
+
+/**
+ * @brief Days since 1970-01-01 of a proleptic Gregorian date.
+ */
+static int64_t days_from_civil(int64_t y, int m, int d) {
+    y -= m <= 2;
+    int64_t era = floor_div(y, 400);
+    int64_t yoe = y - era * 400;
+    int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static void civil_from_days(int64_t z, int64_t *y, int *m, int *d) {
+    z += 719468;
+    int64_t era = floor_div(z, 146097);
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    *d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    *m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *y = yoe + era * 400 + (*m <= 2);
+}
+
+static int64_t floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+// *****************************************************************************
+// End of file
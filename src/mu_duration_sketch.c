@@ -0,0 +1,387 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_duration_sketch.h"
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define SUB_BITS MU_DURATION_SKETCH_SUB_BITS
+#define SUB_COUNT (1 << SUB_BITS)
+#define SUB_MASK (SUB_COUNT - 1)
+
+#define SERIAL_MAGIC 0xd5
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static int32_t bucket_index(uint64_t v);
+static mu_time_rel_t bucket_value(const mu_duration_sketch_t *sketch,
+                                  int32_t index);
+static uint64_t bucket_lower(int32_t index);
+static int leading_bit(uint64_t v);
+static void add_count(mu_duration_sketch_t *sketch, int32_t index, uint64_t n);
+static size_t put_varint(uint8_t *buf, size_t pos, size_t size, uint64_t v);
+static bool get_varint(const uint8_t *buf, size_t len, size_t *pos,
+                       uint64_t *v);
+static uint64_t zigzag(int64_t v);
+static int64_t unzigzag(uint64_t v);
+
+// *****************************************************************************
+// Public code
+
+void mu_duration_sketch_init(mu_duration_sketch_t *sketch, uint32_t *bins,
+                             uint16_t max_bins) {
+    sketch->bins = bins;
+    sketch->max_bins = max_bins;
+    mu_duration_sketch_clear(sketch);
+}
+
+void mu_duration_sketch_clear(mu_duration_sketch_t *sketch) {
+    sketch->span = 0;
+    sketch->offset = 0;
+    sketch->collapsed = 0;
+    sketch->count = 0;
+    sketch->sum = 0;
+    sketch->min = 0;
+    sketch->max = 0;
+}
+
+void mu_duration_sketch_record(mu_duration_sketch_t *sketch,
+                               mu_time_rel_t duration) {
+    mu_duration_sketch_record_n(sketch, duration, 1);
+}
+
+void mu_duration_sketch_record_n(mu_duration_sketch_t *sketch,
+                                 mu_time_rel_t duration, uint32_t n) {
+    if (n == 0) {
+        return;
+    }
+    if (duration < 0) {
+        duration = 0;
+    }
+    if (sketch->count == 0 || duration < sketch->min) {
+        sketch->min = duration;
+    }
+    if (sketch->count == 0 || duration > sketch->max) {
+        sketch->max = duration;
+    }
+    sketch->count += n;
+    sketch->sum += (int64_t)duration * n;
+    add_count(sketch, bucket_index((uint64_t)duration), n);
+}
+
+uint64_t mu_duration_sketch_count(const mu_duration_sketch_t *sketch) {
+    return sketch->count;
+}
+
+int64_t mu_duration_sketch_sum(const mu_duration_sketch_t *sketch) {
+    return sketch->sum;
+}
+
+mu_time_rel_t mu_duration_sketch_min(const mu_duration_sketch_t *sketch) {
+    return sketch->min;
+}
+
+mu_time_rel_t mu_duration_sketch_max(const mu_duration_sketch_t *sketch) {
+    return sketch->max;
+}
+
+mu_time_rel_t mu_duration_sketch_quantile(const mu_duration_sketch_t *sketch,
+                                          float q) {
+    mu_time_rel_t v;
+    mu_duration_sketch_quantiles(sketch, &q, 1, &v);
+    return v;
+}
+
+void mu_duration_sketch_quantiles(const mu_duration_sketch_t *sketch,
+                                  const float *qs, size_t n,
+                                  mu_time_rel_t *out) {
+    uint64_t seen = 0;
+    int32_t i = 0;
+
+    for (size_t k = 0; k < n; k++) {
+        double rank;
+        if (sketch->count == 0) {
+            out[k] = 0;
+            continue;
+        } else if (qs[k] <= 0.0f) {
+            out[k] = sketch->min;
+            continue;
+        } else if (qs[k] >= 1.0f) {
+            out[k] = sketch->max;
+            continue;
+        }
+        // Resume the walk where the previous (smaller) quantile stopped.
+        rank = (double)qs[k] * (double)(sketch->count - 1);
+        while (i < sketch->span && (double)(seen + sketch->bins[i]) <= rank) {
+            seen += sketch->bins[i];
+            i += 1;
+        }
+        out[k] = (i < sketch->span) ? bucket_value(sketch, sketch->offset + i)
+                                    : sketch->max;
+    }
+}
+
+float mu_duration_sketch_relative_error(void) {
+    return 1.0f / (float)(2 * SUB_COUNT);
+}
+
+void mu_duration_sketch_merge(mu_duration_sketch_t *dst,
+                              const mu_duration_sketch_t *src) {
+    if (src->count == 0) {
+        return;
+    }
+    if (dst->count == 0 || src->min < dst->min) {
+        dst->min = src->min;
+    }
+    if (dst->count == 0 || src->max > dst->max) {
+        dst->max = src->max;
+    }
+    dst->count += src->count;
+    dst->sum += src->sum;
+    dst->collapsed |= src->collapsed;
+
+    // Widen the window once for both ends, then add bin by bin.
+    add_count(dst, src->offset, 0);
+    add_count(dst, src->offset + src->span - 1, 0);
+    for (int32_t i = 0; i < src->span; i++) {
+        int32_t index = src->offset + i;
+        if (index < dst->offset) {
+            index = dst->offset; // collapsed in dst
+        }
+        dst->bins[index - dst->offset] += src->bins[i];
+    }
+}
+
+size_t mu_duration_sketch_serialize(const mu_duration_sketch_t *sketch,
+                                    uint8_t *buf, size_t size) {
+    size_t pos = 0;
+
+    if (size < 3) {
+        return 0;
+    }
+    buf[pos++] = SERIAL_MAGIC;
+    buf[pos++] = SUB_BITS;
+    buf[pos++] = (uint8_t)(sketch->collapsed ? 1 : 0);
+    pos = put_varint(buf, pos, size, sketch->count);
+    pos = put_varint(buf, pos, size, zigzag(sketch->sum));
+    pos = put_varint(buf, pos, size, zigzag(sketch->min));
+    pos = put_varint(buf, pos, size, zigzag(sketch->max));
+    pos = put_varint(buf, pos, size, sketch->offset);
+    pos = put_varint(buf, pos, size, sketch->span);
+    for (int32_t i = 0; i < sketch->span; i++) {
+        pos = put_varint(buf, pos, size, sketch->bins[i]);
+    }
+    return pos;
+}
+
+bool mu_duration_sketch_deserialize(mu_duration_sketch_t *sketch,
+                                    const uint8_t *buf, size_t len) {
+    size_t pos = 3;
+    uint64_t count, sum, min, max, offset, span;
+
+    if (len < 3 || buf[0] != SERIAL_MAGIC || buf[1] != SUB_BITS) {
+        return false;
+    }
+    if (!get_varint(buf, len, &pos, &count) ||
+        !get_varint(buf, len, &pos, &sum) ||
+        !get_varint(buf, len, &pos, &min) ||
+        !get_varint(buf, len, &pos, &max) ||
+        !get_varint(buf, len, &pos, &offset) ||
+        !get_varint(buf, len, &pos, &span)) {
+        return false;
+    }
+    if (span > sketch->max_bins || offset > UINT16_MAX) {
+        return false;
+    }
+    for (uint64_t i = 0; i < span; i++) {
+        uint64_t n;
+        if (!get_varint(buf, len, &pos, &n) || n > UINT32_MAX) {
+            return false;
+        }
+        sketch->bins[i] = (uint32_t)n;
+    }
+    sketch->collapsed = buf[2] & 1;
+    sketch->count = count;
+    sketch->sum = unzigzag(sum);
+    sketch->min = (mu_time_rel_t)unzigzag(min);
+    sketch->max = (mu_time_rel_t)unzigzag(max);
+    sketch->offset = (uint16_t)offset;
+    sketch->span = (uint16_t)span;
+    return true;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static int32_t bucket_index(uint64_t v) {
+    int e;
+    if (v < SUB_COUNT) {
+        return (int32_t)v;
+    }
+    e = leading_bit(v);
+    return ((e - SUB_BITS + 1) << SUB_BITS) + (int32_t)((v >> (e - SUB_BITS)) & SUB_MASK);
+}
+
+static mu_time_rel_t bucket_value(const mu_duration_sketch_t *sketch,
+                                  int32_t index) {
+    // midpoint of the bucket, clamped to the observed range
+    uint64_t lo = bucket_lower(index);
+    uint64_t hi = bucket_lower(index + 1) - 1;
+    mu_time_rel_t v = (mu_time_rel_t)(lo + (hi - lo) / 2);
+    if (v < sketch->min) {
+        v = sketch->min;
+    } else if (v > sketch->max) {
+        v = sketch->max;
+    }
+    return v;
+}
+
+static uint64_t bucket_lower(int32_t index) {
+    int e;
+    if (index < SUB_COUNT) {
+        return (uint64_t)index;
+    }
+    e = (index >> SUB_BITS) + SUB_BITS - 1;
+    return ((uint64_t)SUB_COUNT | (uint64_t)(index & SUB_MASK)) << (e - SUB_BITS);
+}
+
+static int leading_bit(uint64_t v) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(v);
+#else
+    int e = 0;
+    while (v >>= 1) {
+        e += 1;
+    }
+    return e;
+#endif
+}
+
+static void add_count(mu_duration_sketch_t *sketch, int32_t index, uint64_t n) {
+    int32_t low = sketch->offset;
+    int32_t high = low + sketch->span - 1;
+    int32_t max_bins = sketch->max_bins;
+
+    if (sketch->span == 0) {
+        sketch->offset = (uint16_t)index;
+        sketch->span = 1;
+        sketch->bins[0] = 0;
+    } else if (index < low) {
+        // Extend downward, as far as the window allows.
+        int32_t new_low = index;
+        int32_t shift;
+        if (high - index + 1 > max_bins) {
+            new_low = high - max_bins + 1;
+            sketch->collapsed = 1;
+        }
+        shift = low - new_low;
+        if (shift > 0) {
+            memmove(&sketch->bins[shift], &sketch->bins[0],
+                    (size_t)sketch->span * sizeof(uint32_t));
+            memset(&sketch->bins[0], 0, (size_t)shift * sizeof(uint32_t));
+            sketch->offset = (uint16_t)new_low;
+            sketch->span = (uint16_t)(sketch->span + shift);
+        }
+        index = new_low;
+    } else if (index > high) {
+        int32_t new_low = low;
+        if (index - low + 1 > max_bins) {
+            // Collapse everything below the new window into its lowest bin.
+            uint32_t folded = 0;
+            int32_t keep;
+            new_low = index - max_bins + 1;
+            for (int32_t i = low; i <= high && i <= new_low; i++) {
+                folded += sketch->bins[i - low];
+            }
+            keep = (high > new_low) ? high - new_low : 0;
+            if (keep > 0) {
+                memmove(&sketch->bins[1], &sketch->bins[new_low - low + 1],
+                        (size_t)keep * sizeof(uint32_t));
+            }
+            sketch->bins[0] = folded;
+            sketch->offset = (uint16_t)new_low;
+            sketch->span = (uint16_t)(keep + 1);
+            sketch->collapsed = 1;
+            high = new_low + keep;
+        }
+        memset(&sketch->bins[high - new_low + 1], 0,
+               (size_t)(index - high) * sizeof(uint32_t));
+        sketch->span = (uint16_t)(index - new_low + 1);
+    }
+    sketch->bins[index - sketch->offset] += (uint32_t)n;
+}
+
+static size_t put_varint(uint8_t *buf, size_t pos, size_t size, uint64_t v) {
+    // pos == 0 marks an earlier overflow, which sticks
+    if (pos == 0) {
+        return 0;
+    }
+    do {
+        if (pos >= size) {
+            return 0;
+        }
+        buf[pos++] = (uint8_t)((v & 0x7f) | (v >= 0x80 ? 0x80 : 0));
+        v >>= 7;
+    } while (v != 0);
+    return pos;
+}
+
+static bool get_varint(const uint8_t *buf, size_t len, size_t *pos,
+                       uint64_t *v) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t b;
+        if (*pos >= len) {
+            return false;
+        }
+        b = buf[(*pos)++];
+        result |= (uint64_t)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) {
+            *v = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,128 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_fire_queue.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define WORD_BITS 32
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static int lowest_bit(unsigned word);
+
+// *****************************************************************************
+// Public code
+
+void mu_fire_queue_init(mu_fire_queue_t *q) {
+    memset(q->entries, 0, sizeof(q->entries));
+    for (int w = 0; w < MU_FIRE_QUEUE_WORDS; w++) {
+        atomic_init(&q->pending[w], 0);
+    }
+    q->count = 0;
+}
+
+bool mu_fire_queue_attach(mu_fire_queue_t *q, mu_fire_t *fire, mu_fire_fn fn,
+                          void *arg) {
+    if (q->count >= MU_FIRE_QUEUE_CAPACITY) {
+        return false;
+    }
+    atomic_init(&fire->posts, 0);
+    fire->fn = fn;
+    fire->arg = arg;
+    fire->index = (uint16_t)q->count;
+    q->entries[q->count++] = fire;
+    return true;
+}
+
+void mu_fire_post(mu_fire_queue_t *q, mu_fire_t *fire) {
+    // Only the post that finds the count at zero raises the pending bit.  The
+    // bit is therefore set exactly while a nonzero count awaits the drain,
+    // which clears the bit before it claims the count.
+    if (atomic_fetch_add_explicit(&fire->posts, 1, memory_order_release) == 0) {
+        atomic_fetch_or_explicit(&q->pending[fire->index / WORD_BITS],
+                                 1u << (fire->index % WORD_BITS),
+                                 memory_order_release);
+    }
+}
+
+bool mu_fire_queue_is_pending(mu_fire_queue_t *q) {
+    for (int w = 0; w < MU_FIRE_QUEUE_WORDS; w++) {
+        if (atomic_load_explicit(&q->pending[w], memory_order_relaxed) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t mu_fire_queue_drain(mu_fire_queue_t *q) {
+    size_t fired = 0;
+
+    for (int w = 0; w < MU_FIRE_QUEUE_WORDS; w++) {
+        if (atomic_load_explicit(&q->pending[w], memory_order_relaxed) == 0) {
+            continue;
+        }
+        unsigned bits =
+            atomic_exchange_explicit(&q->pending[w], 0, memory_order_acquire);
+        while (bits != 0) {
+            int b = lowest_bit(bits);
+            bits &= bits - 1;
+            mu_fire_t *fire = q->entries[w * WORD_BITS + b];
+            uint32_t posts = (uint32_t)atomic_exchange_explicit(
+                &fire->posts, 0, memory_order_acquire);
+            fire->fn(fire, posts, fire->arg);
+            fired += 1;
+        }
+    }
+    return fired;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static int lowest_bit(unsigned word) {
+#if defined(__GNUC__)
+    return __builtin_ctz(word);
+#else
+    int b = 0;
+    while ((word & 1u) == 0) {
+        word >>= 1;
+        b += 1;
+    }
+    return b;
+#endif
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,561 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_openmetrics.h"
+#include "mu_clock_map.h"
+#include "mu_duration_sketch.h"
+#include "mu_time.h"
+#include "mu_timer_wheel.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+// Append a string literal without a strlen() at run time
+#define PUT_LITERAL(p, s) put((p), (s), sizeof(s) - 1)
+
+typedef enum {
+    STATE_HEADER,
+    STATE_LINES,
+    STATE_DONE,
+} render_state_t;
+
+/**
+ * Renders line `line` of one series for one family into `out`, returning its
+ * length, or 0 when the series has no more lines in the family.
+ */
+typedef size_t (*line_fn)(const mu_openmetrics_series_t *series,
+                          mu_openmetrics_cursor_t *cursor, unsigned line,
+                          char *out);
+
+typedef struct {
+    const char *suffix; // appended to the series name
+    const char *type;   // OpenMetrics metric type
+    line_fn render;
+} family_t;
+
+typedef struct {
+    const family_t *families;
+    uint8_t n_families;
+} kind_info_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool add_series(mu_openmetrics_t *exporter, mu_openmetrics_kind_t kind,
+                       const char *name, const char *labels, const void *source,
+                       mu_openmetrics_gauge_fn fn);
+static size_t emit(const mu_openmetrics_t *exporter,
+                   mu_openmetrics_cursor_t *cursor, char *out);
+static size_t group_end(const mu_openmetrics_t *exporter, size_t first);
+
+static size_t sketch_line(const mu_openmetrics_series_t *series,
+                          mu_openmetrics_cursor_t *cursor, unsigned line,
+                          char *out);
+static size_t wheel_pending_line(const mu_openmetrics_series_t *series,
+                                 mu_openmetrics_cursor_t *cursor, unsigned line,
+                                 char *out);
+static size_t wheel_counter_line(const mu_openmetrics_series_t *series,
+                                 mu_openmetrics_cursor_t *cursor, unsigned line,
+                                 char *out);
+static size_t clock_skew_line(const mu_openmetrics_series_t *series,
+                              mu_openmetrics_cursor_t *cursor, unsigned line,
+                              char *out);
+static size_t clock_hull_line(const mu_openmetrics_series_t *series,
+                              mu_openmetrics_cursor_t *cursor, unsigned line,
+                              char *out);
+static size_t clock_samples_line(const mu_openmetrics_series_t *series,
+                                 mu_openmetrics_cursor_t *cursor, unsigned line,
+                                 char *out);
+static size_t gauge_fn_line(const mu_openmetrics_series_t *series,
+                            mu_openmetrics_cursor_t *cursor, unsigned line,
+                            char *out);
+
+static char *put(char *p, const char *s, size_t n);
+static char *put_str(char *p, const char *s);
+static char *put_sample(char *p, const mu_openmetrics_series_t *series,
+                        const char *suffix, const char *extra_label);
+static char *put_int(char *p, int64_t v);
+static char *put_seconds(char *p, int64_t tics);
+
+// *****************************************************************************
+// Private (static) storage
+
+static const float s_quantiles[] = MU_OPENMETRICS_QUANTILES;
+static const char *const s_quantile_labels[] = {
+    "quantile=\"0.5\"", "quantile=\"0.9\"", "quantile=\"0.99\"",
+    "quantile=\"0.999\""};
+
+static const family_t s_sketch_families[] = {
+    {"", "summary", sketch_line},
+};
+
+static const family_t s_wheel_families[] = {
+    {"_pending", "gauge", wheel_pending_line},
+    {"_armed", "counter", wheel_counter_line},
+    {"_fired", "counter", wheel_counter_line},
+    {"_cancelled", "counter", wheel_counter_line},
+    {"_cascaded", "counter", wheel_counter_line},
+};
+
+// one per MU_TIMER_WHEEL_LEVELS
+static const char *const s_level_labels[] = {"level=\"0\"", "level=\"1\"",
+                                             "level=\"2\"", "level=\"3\""};
+
+static const family_t s_clock_families[] = {
+    {"_skew_ppb", "gauge", clock_skew_line},
+    {"_hull_vertices", "gauge", clock_hull_line},
+    {"_samples", "counter", clock_samples_line},
+};
+
+static const family_t s_gauge_fn_families[] = {
+    {"", "gauge", gauge_fn_line},
+};
+
+#define N_FAMILIES(a) ((uint8_t)(sizeof(a) / sizeof(a[0])))
+
+static const kind_info_t s_kinds[] = {
+    [MU_OPENMETRICS_SKETCH] = {s_sketch_families, N_FAMILIES(s_sketch_families)},
+    [MU_OPENMETRICS_TIMER_WHEEL] = {s_wheel_families, N_FAMILIES(s_wheel_families)},
+    [MU_OPENMETRICS_CLOCK_MAP] = {s_clock_families, N_FAMILIES(s_clock_families)},
+    [MU_OPENMETRICS_GAUGE_FN] = {s_gauge_fn_families,
+                                 N_FAMILIES(s_gauge_fn_families)},
+};
+
+// *****************************************************************************
+// Public code
+
+void mu_openmetrics_init(mu_openmetrics_t *exporter,
+                         mu_openmetrics_series_t *storage, size_t capacity) {
+    exporter->series = storage;
+    exporter->capacity = capacity;
+    exporter->count = 0;
+}
+
+bool mu_openmetrics_add_sketch(mu_openmetrics_t *exporter, const char *name,
+                               const char *labels,
+                               const mu_duration_sketch_t *sketch) {
+    return add_series(exporter, MU_OPENMETRICS_SKETCH, name, labels, sketch,
+                      NULL);
+}
+
+bool mu_openmetrics_add_timer_wheel(mu_openmetrics_t *exporter,
+                                    const char *name, const char *labels,
+                                    const mu_timer_wheel_t *wheel) {
+    return add_series(exporter, MU_OPENMETRICS_TIMER_WHEEL, name, labels, wheel,
+                      NULL);
+}
+
+bool mu_openmetrics_add_clock_map(mu_openmetrics_t *exporter, const char *name,
+                                  const char *labels, const mu_clock_map_t *cm) {
+    return add_series(exporter, MU_OPENMETRICS_CLOCK_MAP, name, labels, cm,
+                      NULL);
+}
+
+bool mu_openmetrics_add_gauge(mu_openmetrics_t *exporter, const char *name,
+                              const char *labels, mu_openmetrics_gauge_fn fn,
+                              void *arg) {
+    return add_series(exporter, MU_OPENMETRICS_GAUGE_FN, name, labels, arg, fn);
+}
+
+void mu_openmetrics_cursor_init(mu_openmetrics_cursor_t *cursor) {
+    cursor->group = 0;
+    cursor->group_end = 0;
+    cursor->member = 0;
+    cursor->family = 0;
+    cursor->line = 0;
+    cursor->state = STATE_HEADER;
+}
+
+size_t mu_openmetrics_render(const mu_openmetrics_t *exporter,
+                             mu_openmetrics_cursor_t *cursor, char *buf,
+                             size_t size) {
+    char line[MU_OPENMETRICS_LINE_MAX];
+    size_t used = 0;
+
+    // While a whole line is sure to fit, render straight into the buffer.
+    while (size - used >= MU_OPENMETRICS_LINE_MAX) {
+        size_t n = emit(exporter, cursor, &buf[used]);
+        if (n == 0) {
+            return used;
+        }
+        used += n;
+    }
+    // Near the end of the buffer, stage each line so it can be retried.
+    while (cursor->state != STATE_DONE) {
+        mu_openmetrics_cursor_t saved = *cursor;
+        size_t n = emit(exporter, cursor, line);
+        if (n == 0) {
+            break;
+        } else if (used + n > size) {
+            *cursor = saved; // try this line again in the next buffer
+            break;
+        }
+        memcpy(&buf[used], line, n);
+        used += n;
+    }
+    return used;
+}
+
+bool mu_openmetrics_is_done(const mu_openmetrics_cursor_t *cursor) {
+    return cursor->state == STATE_DONE;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool add_series(mu_openmetrics_t *exporter, mu_openmetrics_kind_t kind,
+                       const char *name, const char *labels, const void *source,
+                       mu_openmetrics_gauge_fn fn) {
+    size_t name_len = strlen(name);
+    size_t labels_len = strlen(labels);
+    size_t at = exporter->count;
+    mu_openmetrics_series_t *s;
+
+    if (exporter->count >= exporter->capacity ||
+        name_len >= MU_OPENMETRICS_NAME_MAX ||
+        labels_len >= MU_OPENMETRICS_LABELS_MAX) {
+        return false;
+    }
+    // A family's samples must be contiguous: insert after the last series of
+    // the same name and kind, if there is one.
+    for (size_t i = exporter->count; i > 0; i--) {
+        const mu_openmetrics_series_t *t = &exporter->series[i - 1];
+        if (t->kind == kind && t->name_len == name_len &&
+            memcmp(t->name, name, name_len) == 0) {
+            at = i;
+            break;
+        }
+    }
+    memmove(&exporter->series[at + 1], &exporter->series[at],
+            (exporter->count - at) * sizeof(mu_openmetrics_series_t));
+    exporter->count += 1;
+
+    s = &exporter->series[at];
+    s->kind = kind;
+    s->source = source;
+    s->gauge_fn = fn;
+    s->name_len = (uint8_t)name_len;
+    s->labels_len = (uint8_t)labels_len;
+    memcpy(s->name, name, name_len + 1);
+    memcpy(s->labels, labels, labels_len + 1);
+    return true;
+}
+
+static size_t emit(const mu_openmetrics_t *exporter,
+                   mu_openmetrics_cursor_t *cursor, char *out) {
+    for (;;) {
+        const mu_openmetrics_series_t *first;
+        const kind_info_t *kind;
+        const family_t *family;
+        char *p;
+        size_t n;
+
+        if (cursor->state == STATE_DONE) {
+            return 0;
+        }
+        if (cursor->group >= exporter->count) {
+            cursor->state = STATE_DONE;
+            return (size_t)(PUT_LITERAL(out, "# EOF\n") - out);
+        }
+        first = &exporter->series[cursor->group];
+        kind = &s_kinds[first->kind];
+        if (cursor->family >= kind->n_families) {
+            // on to the next group
+            cursor->group = cursor->group_end;
+            cursor->family = 0;
+            cursor->state = STATE_HEADER;
+            continue;
+        }
+        family = &kind->families[cursor->family];
+
+        if (cursor->state == STATE_HEADER) {
+            if (cursor->family == 0) {
+                cursor->group_end = group_end(exporter, cursor->group);
+            }
+            cursor->member = cursor->group;
+            cursor->line = 0;
+            cursor->state = STATE_LINES;
+            p = PUT_LITERAL(out, "# TYPE ");
+            p = put(p, first->name, first->name_len);
+            p = put_str(p, family->suffix);
+            p = PUT_LITERAL(p, " ");
+            p = put_str(p, family->type);
+            p = PUT_LITERAL(p, "\n");
+            return (size_t)(p - out);
+        }
+
+        if (cursor->member >= cursor->group_end) {
+            cursor->family += 1;
+            cursor->state = STATE_HEADER;
+            continue;
+        }
+        n = family->render(&exporter->series[cursor->member], cursor,
+                           cursor->line, out);
+        if (n == 0) {
+            cursor->member += 1;
+            cursor->line = 0;
+            continue;
+        }
+        cursor->line += 1;
+        return n;
+    }
+}
+
+static size_t group_end(const mu_openmetrics_t *exporter, size_t first) {
+    const mu_openmetrics_series_t *f = &exporter->series[first];
+    size_t i = first + 1;
+    while (i < exporter->count && exporter->series[i].kind == f->kind &&
+           exporter->series[i].name_len == f->name_len &&
+           memcmp(exporter->series[i].name, f->name, f->name_len) == 0) {
+        i += 1;
+    }
+    return i;
+}
+
+static size_t sketch_line(const mu_openmetrics_series_t *series,
+                          mu_openmetrics_cursor_t *cursor, unsigned line,
+                          char *out) {
+    const mu_duration_sketch_t *sketch = series->source;
+    char *p = out;
+
+    if (line == 0) {
+        // one pass over the bins for all quantiles of this series
+        mu_duration_sketch_quantiles(sketch, s_quantiles,
+                                     MU_OPENMETRICS_QUANTILE_COUNT,
+                                     cursor->quantiles);
+    }
+    if (line < MU_OPENMETRICS_QUANTILE_COUNT) {
+        p = put_sample(p, series, "", s_quantile_labels[line]);
+        p = put_seconds(p, cursor->quantiles[line]);
+    } else if (line == MU_OPENMETRICS_QUANTILE_COUNT) {
+        p = put_sample(p, series, "_sum", NULL);
+        p = put_seconds(p, mu_duration_sketch_sum(sketch));
+    } else if (line == MU_OPENMETRICS_QUANTILE_COUNT + 1) {
+        p = put_sample(p, series, "_count", NULL);
+        p = put_int(p, (int64_t)mu_duration_sketch_count(sketch));
+    } else {
+        return 0;
+    }
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
+
+static size_t wheel_pending_line(const mu_openmetrics_series_t *series,
+                                 mu_openmetrics_cursor_t *cursor, unsigned line,
+                                 char *out) {
+    mu_timer_wheel_stats_t stats;
+    char *p = out;
+    (void)cursor;
+    if (line >= MU_TIMER_WHEEL_LEVELS) {
+        return 0;
+    }
+    mu_timer_wheel_get_stats(series->source, &stats);
+    p = put_sample(p, series, "_pending", s_level_labels[line]);
+    p = put_int(p, (int64_t)stats.level_pending[line]);
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
+
+static size_t wheel_counter_line(const mu_openmetrics_series_t *series,
+                                 mu_openmetrics_cursor_t *cursor, unsigned line,
+                                 char *out) {
+    mu_timer_wheel_stats_t stats;
+    const char *suffix;
+    uint64_t v;
+    char *p = out;
+
+    if (line > 0) {
+        return 0;
+    }
+    mu_timer_wheel_get_stats(series->source, &stats);
+    // the family index selects the counter, see s_wheel_families
+    switch (cursor->family) {
+    case 1:
+        suffix = "_armed_total";
+        v = stats.armed;
+        break;
+    case 2:
+        suffix = "_fired_total";
+        v = stats.fired;
+        break;
+    case 3:
+        suffix = "_cancelled_total";
+        v = stats.cancelled;
+        break;
+    default:
+        suffix = "_cascaded_total";
+        v = stats.cascaded;
+        break;
+    }
+    p = put_sample(p, series, suffix, NULL);
+    p = put_int(p, (int64_t)v);
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
+
+static size_t clock_skew_line(const mu_openmetrics_series_t *series,
+                              mu_openmetrics_cursor_t *cursor, unsigned line,
+                              char *out) {
+    char *p = out;
+    (void)cursor;
+    if (line > 0) {
+        return 0;
+    }
+    p = put_sample(p, series, "_skew_ppb", NULL);
+    p = put_int(p, mu_clock_map_skew_ppb(series->source));
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
+
+static size_t clock_hull_line(const mu_openmetrics_series_t *series,
+                              mu_openmetrics_cursor_t *cursor, unsigned line,
+                              char *out) {
+    char *p = out;
+    (void)cursor;
+    if (line > 0) {
+        return 0;
+    }
+    p = put_sample(p, series, "_hull_vertices", NULL);
+    p = put_int(p, (int64_t)mu_clock_map_hull_size(series->source));
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
+
+static size_t clock_samples_line(const mu_openmetrics_series_t *series,
+                                 mu_openmetrics_cursor_t *cursor, unsigned line,
+                                 char *out) {
+    const mu_clock_map_t *cm = series->source;
+    char *p = out;
+    (void)cursor;
+    if (line > 0) {
+        return 0;
+    }
+    p = put_sample(p, series, "_samples_total", NULL);
+    p = put_int(p, cm->sample_count);
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
+
+static size_t gauge_fn_line(const mu_openmetrics_series_t *series,
+                            mu_openmetrics_cursor_t *cursor, unsigned line,
+                            char *out) {
+    char *p = out;
+    (void)cursor;
+    if (line > 0) {
+        return 0;
+    }
+    p = put_sample(p, series, "", NULL);
+    p = put_int(p, series->gauge_fn((void *)series->source));
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
+
+static char *put(char *p, const char *s, size_t n) {
+    memcpy(p, s, n);
+    return p + n;
+}
+
+static char *put_str(char *p, const char *s) {
+    return put(p, s, strlen(s));
+}
+
+static char *put_sample(char *p, const mu_openmetrics_series_t *series,
+                        const char *suffix, const char *extra_label) {
+    p = put(p, series->name, series->name_len);
+    p = put_str(p, suffix);
+    if (series->labels_len > 0 || extra_label != NULL) {
+        *p++ = '{';
+        p = put(p, series->labels, series->labels_len);
+        if (extra_label != NULL) {
+            if (series->labels_len > 0) {
+                *p++ = ',';
+            }
+            p = put_str(p, extra_label);
+        }
+        *p++ = '}';
+    }
+    *p++ = ' ';
+    return p;
+}
+
+static char *put_int(char *p, int64_t v) {
+    char digits[20];
+    int n = 0;
+    uint64_t u = (v < 0) ? (uint64_t)0 - (uint64_t)v : (uint64_t)v;
+
+    if (v < 0) {
+        *p++ = '-';
+    }
+    do {
+        digits[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    while (n > 0) {
+        *p++ = digits[--n];
+    }
+    return p;
+}
+
+static char *put_seconds(char *p, int64_t tics) {
+    // Fixed-point rendering: whole seconds, then the fraction with trailing
+    // zeros trimmed.
+    uint32_t per_second = (uint32_t)mu_time_rel_from_millis(1000);
+    uint64_t u = (tics < 0) ? (uint64_t)0 - (uint64_t)tics : (uint64_t)tics;
+    uint32_t frac = (uint32_t)(u % per_second);
+    char digits[10];
+    int width = 0;
+    int n;
+
+    if (tics < 0) {
+        *p++ = '-';
+    }
+    p = put_int(p, (int64_t)(u / per_second));
+    if (frac == 0) {
+        return p;
+    }
+    for (uint32_t place = per_second; place > 1; place /= 10) {
+        width += 1;
+    }
+    n = width;
+    while (n > 0 && frac % 10 == 0) {
+        frac /= 10;
+        n -= 1;
+    }
+    *p++ = '.';
+    for (int i = n - 1; i >= 0; i--) {
+        digits[i] = (char)('0' + frac % 10);
+        frac /= 10;
+    }
+    return put(p, digits, (size_t)n);
+}
+
+// *****************************************************************************
+// End of file
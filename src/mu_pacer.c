@@ -0,0 +1,197 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_pacer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define NANOS_PER_SECOND 1000000000ULL
+
+typedef enum {
+    FLOW_IDLE,    ///< Not scheduled
+    FLOW_WAITING, ///< On the wheel
+    FLOW_DUE,     ///< On the due list
+} flow_state_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void flow_fire(mu_timer_t *timer, void *arg);
+static void push_due(mu_pacer_t *p, mu_pacer_flow_t *flow);
+
+// *****************************************************************************
+// Public code
+
+void mu_pacer_init(mu_pacer_t *p, mu_time_abs_t now, mu_time_rel_t max_lag) {
+    mu_timer_wheel_init(&p->wheel, now, MU_PACER_RESOLUTION, NULL);
+    p->due_head = NULL;
+    p->due_tail = NULL;
+    p->due_count = 0;
+    p->max_lag = max_lag;
+}
+
+void mu_pacer_flow_init(mu_pacer_flow_t *flow, uint64_t rate,
+                        mu_time_abs_t now, void *arg) {
+    mu_timer_init(&flow->timer, flow_fire, NULL);
+    flow->next_due = NULL;
+    flow->next_send = now;
+    flow->carry = 0;
+    flow->packets = 0;
+    flow->bytes = 0;
+    flow->arg = arg;
+    flow->state = FLOW_IDLE;
+    mu_pacer_set_rate(flow, rate);
+}
+
+void mu_pacer_set_rate(mu_pacer_flow_t *flow, uint64_t rate) {
+    flow->rate = rate;
+    if (rate == 0) {
+        flow->ns_per_byte = 0;
+        flow->ns_per_byte_frac = 0;
+    } else {
+        // 1e9 << 32 still fits in 64 bits
+        uint64_t q32 = (NANOS_PER_SECOND << 32) / rate;
+        flow->ns_per_byte = q32 >> 32;
+        flow->ns_per_byte_frac = (uint32_t)q32;
+    }
+}
+
+void mu_pacer_schedule(mu_pacer_t *p, mu_pacer_flow_t *flow,
+                       mu_time_abs_t now) {
+    if (flow->state != FLOW_IDLE) {
+        return;
+    }
+    if (mu_time_is_after(flow->next_send, now)) {
+        flow->timer.arg = p;
+        mu_timer_wheel_arm(&p->wheel, &flow->timer, flow->next_send);
+        flow->state = FLOW_WAITING;
+    } else {
+        push_due(p, flow);
+    }
+}
+
+void mu_pacer_unschedule(mu_pacer_t *p, mu_pacer_flow_t *flow) {
+    if (flow->state == FLOW_WAITING) {
+        mu_timer_wheel_cancel(&p->wheel, &flow->timer);
+    } else if (flow->state == FLOW_DUE) {
+        mu_pacer_flow_t **link = &p->due_head;
+        mu_pacer_flow_t *prev = NULL;
+        while (*link != flow) {
+            prev = *link;
+            link = &(*link)->next_due;
+        }
+        *link = flow->next_due;
+        if (p->due_tail == flow) {
+            p->due_tail = prev;
+        }
+        p->due_count -= 1;
+    }
+    flow->state = FLOW_IDLE;
+}
+
+size_t mu_pacer_poll(mu_pacer_t *p, mu_time_abs_t now,
+                     mu_pacer_flow_t **batch, size_t max) {
+    size_t n = 0;
+
+    mu_timer_wheel_advance(&p->wheel, now);
+    while (n < max && p->due_head != NULL) {
+        mu_pacer_flow_t *flow = p->due_head;
+        p->due_head = flow->next_due;
+        flow->state = FLOW_IDLE;
+        batch[n++] = flow;
+    }
+    if (p->due_head == NULL) {
+        p->due_tail = NULL;
+    }
+    p->due_count -= n;
+    return n;
+}
+
+void mu_pacer_sent(mu_pacer_t *p, mu_pacer_flow_t *flow, uint32_t bytes,
+                   mu_time_abs_t now) {
+    mu_time_abs_t floor = mu_time_offset(now, -p->max_lag);
+    mu_time_abs_t base = flow->next_send;
+
+    // Catch up on a late start, but only so far
+    if (mu_time_is_before(base, floor)) {
+        base = floor;
+    }
+    uint64_t frac = (uint64_t)bytes * flow->ns_per_byte_frac + flow->carry;
+    uint64_t interval = (uint64_t)bytes * flow->ns_per_byte + (frac >> 32);
+    flow->carry = (uint32_t)frac;
+    flow->next_send = mu_time_offset(base, (mu_time_rel_t)interval);
+    flow->packets += 1;
+    flow->bytes += bytes;
+}
+
+mu_time_abs_t mu_pacer_next_send(const mu_pacer_flow_t *flow) {
+    return flow->next_send;
+}
+
+void *mu_pacer_flow_arg(const mu_pacer_flow_t *flow) {
+    return flow->arg;
+}
+
+bool mu_pacer_next_deadline(const mu_pacer_t *p, mu_time_abs_t now,
+                            mu_time_abs_t *when) {
+    if (p->due_count > 0) {
+        *when = now;
+        return true;
+    }
+    return mu_timer_wheel_next_deadline(&p->wheel, when);
+}
+
+size_t mu_pacer_due(const mu_pacer_t *p) {
+    return p->due_count;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void flow_fire(mu_timer_t *timer, void *arg) {
+    // The timer is the flow's first member
+    push_due((mu_pacer_t *)arg, (mu_pacer_flow_t *)timer);
+}
+
+static void push_due(mu_pacer_t *p, mu_pacer_flow_t *flow) {
+    flow->next_due = NULL;
+    flow->state = FLOW_DUE;
+    if (p->due_tail == NULL) {
+        p->due_head = flow;
+    } else {
+        p->due_tail->next_due = flow;
+    }
+    p->due_tail = flow;
+    p->due_count += 1;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,614 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_pcap.h"
+#include "mu_time.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define PCAP_HEADER_SIZE 24
+#define PCAP_RECORD_HEADER_SIZE 16
+
+#define PCAPNG_SHB 0x0a0d0d0a
+#define PCAPNG_IDB 0x00000001
+#define PCAPNG_EPB 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1a2b3c4d
+#define PCAPNG_OPT_END 0
+#define PCAPNG_OPT_IF_TSRESOL 9
+#define PCAPNG_OPT_IF_TSOFFSET 14
+#define PCAPNG_DEFAULT_TSRESOL 6 // microseconds
+
+#define INDEX_MAGIC "MUPCIDX1"
+#define INDEX_HEADER_SIZE 8
+#define INDEX_ENTRY_SIZE 16
+
+#define NANOS_PER_SECOND 1000000000LL
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool parse_header(mu_pcap_reader_t *reader);
+static bool next_pcap(mu_pcap_reader_t *reader, mu_pcap_record_t *record);
+static bool next_pcapng(mu_pcap_reader_t *reader, mu_pcap_record_t *record);
+static bool block_at(mu_pcap_reader_t *reader, size_t pos, uint32_t *type,
+                     uint32_t *length);
+static void scan_block(mu_pcap_reader_t *reader, size_t pos, uint32_t type,
+                       uint32_t length);
+static void parse_idb(mu_pcap_reader_t *reader, const uint8_t *body,
+                      size_t size);
+static int64_t pcapng_nanos(const mu_pcap_interface_t *iface, uint64_t ts);
+static uint16_t rd16(const mu_pcap_reader_t *reader, const uint8_t *p);
+static uint32_t rd32(const mu_pcap_reader_t *reader, const uint8_t *p);
+static uint32_t raw32(const uint8_t *p);
+static uint32_t swap32(uint32_t v);
+static void put_le64(uint8_t *p, uint64_t v);
+static uint64_t get_le64(const uint8_t *p);
+static bool write_index_entry(FILE *f, int64_t max_ns, uint64_t offset);
+static bool map_file(const char *path, const uint8_t **base, size_t *size);
+
+// *****************************************************************************
+// Public code
+
+bool mu_pcap_reader_open(mu_pcap_reader_t *reader, const char *path) {
+    const uint8_t *base;
+    size_t size;
+
+    if (!map_file(path, &base, &size)) {
+        return false;
+    }
+    if (!mu_pcap_reader_init_buffer(reader, base, size)) {
+        munmap((void *)base, size);
+        return false;
+    }
+    reader->mapped = true;
+    return true;
+}
+
+bool mu_pcap_reader_init_buffer(mu_pcap_reader_t *reader, const void *data,
+                                size_t size) {
+    reader->base = data;
+    reader->size = size;
+    reader->pos = 0;
+    reader->scanned = 0;
+    reader->mapped = false;
+    reader->swap = false;
+    reader->nanos = false;
+    reader->malformed = false;
+    reader->linktype = 0;
+    reader->n_interfaces = 0;
+    return parse_header(reader);
+}
+
+void mu_pcap_reader_close(mu_pcap_reader_t *reader) {
+    if (reader->mapped && reader->size > 0) {
+        munmap((void *)reader->base, reader->size);
+    }
+    reader->base = NULL;
+    reader->size = 0;
+    reader->mapped = false;
+}
+
+bool mu_pcap_reader_next(mu_pcap_reader_t *reader, mu_pcap_record_t *record) {
+    if (reader->format == MU_PCAP_FORMAT_PCAP) {
+        return next_pcap(reader, record);
+    }
+    return next_pcapng(reader, record);
+}
+
+bool mu_pcap_reader_is_malformed(const mu_pcap_reader_t *reader) {
+    return reader->malformed;
+}
+
+mu_pcap_format_t mu_pcap_reader_format(const mu_pcap_reader_t *reader) {
+    return reader->format;
+}
+
+uint32_t mu_pcap_reader_linktype(const mu_pcap_reader_t *reader,
+                                 uint32_t interface) {
+    if (reader->format == MU_PCAP_FORMAT_PCAP) {
+        return reader->linktype;
+    }
+    return (interface < reader->n_interfaces)
+               ? reader->interfaces[interface].linktype
+               : 0;
+}
+
+void mu_pcap_reader_seek(mu_pcap_reader_t *reader, uint64_t offset) {
+    uint32_t type, length;
+
+    if (reader->format == MU_PCAP_FORMAT_PCAPNG) {
+        // Pick up interface descriptions between what has been seen and the
+        // target by hopping over block headers.
+        while (reader->scanned < offset &&
+               block_at(reader, reader->scanned, &type, &length)) {
+            scan_block(reader, reader->scanned, type, length);
+        }
+    }
+    reader->pos = (size_t)offset;
+    reader->malformed = false;
+}
+
+void mu_pcap_reader_rewind(mu_pcap_reader_t *reader) {
+    mu_pcap_reader_seek(reader, (reader->format == MU_PCAP_FORMAT_PCAP)
+                                    ? PCAP_HEADER_SIZE
+                                    : 0);
+}
+
+bool mu_pcap_writer_open(mu_pcap_writer_t *writer, const char *path,
+                         uint32_t linktype, uint32_t snaplen,
+                         const char *index_path, uint32_t stride) {
+    // Host byte order throughout, as libpcap writes; readers detect it from
+    // the magic.
+    struct {
+        uint32_t magic;
+        uint16_t version_major;
+        uint16_t version_minor;
+        int32_t thiszone;
+        uint32_t sigfigs;
+        uint32_t snaplen;
+        uint32_t linktype;
+    } header = {MU_PCAP_MAGIC_NANOS, 2, 4, 0, 0, snaplen, linktype};
+
+    writer->file = fopen(path, "wb");
+    writer->index = NULL;
+    writer->buffer = malloc(MU_PCAP_WRITE_BUFFER);
+    writer->offset = PCAP_HEADER_SIZE;
+    writer->records = 0;
+    writer->stride = (stride > 0) ? stride : MU_PCAP_INDEX_STRIDE;
+    writer->snaplen = snaplen;
+    writer->max_ns = INT64_MIN;
+    if (writer->file == NULL) {
+        free(writer->buffer);
+        return false;
+    }
+    if (writer->buffer != NULL) {
+        setvbuf(writer->file, writer->buffer, _IOFBF, MU_PCAP_WRITE_BUFFER);
+    }
+    if (index_path != NULL) {
+        writer->index = fopen(index_path, "wb");
+        if (writer->index == NULL ||
+            fwrite(INDEX_MAGIC, 1, INDEX_HEADER_SIZE, writer->index) !=
+                INDEX_HEADER_SIZE) {
+            mu_pcap_writer_close(writer);
+            return false;
+        }
+    }
+    if (fwrite(&header, 1, sizeof(header), writer->file) != sizeof(header)) {
+        mu_pcap_writer_close(writer);
+        return false;
+    }
+    return true;
+}
+
+bool mu_pcap_writer_write(mu_pcap_writer_t *writer, mu_time_abs_t time,
+                          const void *data, uint32_t length) {
+    int64_t ns = mu_time_posix_to_nanos(time);
+    int64_t sec = ns / NANOS_PER_SECOND;
+    int64_t frac = ns % NANOS_PER_SECOND;
+    uint32_t caplen = (length < writer->snaplen) ? length : writer->snaplen;
+    uint32_t header[4];
+
+    if (frac < 0) {
+        sec -= 1;
+        frac += NANOS_PER_SECOND;
+    }
+    header[0] = (uint32_t)sec;
+    header[1] = (uint32_t)frac;
+    header[2] = caplen;
+    header[3] = length;
+
+    if (writer->index != NULL && writer->records % writer->stride == 0 &&
+        !write_index_entry(writer->index, writer->max_ns, writer->offset)) {
+        return false;
+    }
+    if (fwrite(header, 1, sizeof(header), writer->file) != sizeof(header) ||
+        fwrite(data, 1, caplen, writer->file) != caplen) {
+        return false;
+    }
+    writer->offset += sizeof(header) + caplen;
+    writer->records += 1;
+    if (ns > writer->max_ns) {
+        writer->max_ns = ns;
+    }
+    return true;
+}
+
+bool mu_pcap_writer_close(mu_pcap_writer_t *writer) {
+    bool ok = true;
+
+    if (writer->index != NULL) {
+        ok = fclose(writer->index) == 0;
+        writer->index = NULL;
+    }
+    if (writer->file != NULL) {
+        ok = (fclose(writer->file) == 0) && ok;
+        writer->file = NULL;
+    }
+    free(writer->buffer);
+    writer->buffer = NULL;
+    return ok;
+}
+
+bool mu_pcap_index_build(mu_pcap_reader_t *reader, const char *path,
+                         uint32_t stride) {
+    FILE *f = fopen(path, "wb");
+    mu_pcap_record_t record;
+    int64_t max_ns = INT64_MIN;
+    uint64_t n = 0;
+    bool ok;
+
+    if (f == NULL) {
+        return false;
+    }
+    if (stride == 0) {
+        stride = MU_PCAP_INDEX_STRIDE;
+    }
+    mu_pcap_reader_rewind(reader);
+    ok = fwrite(INDEX_MAGIC, 1, INDEX_HEADER_SIZE, f) == INDEX_HEADER_SIZE;
+    while (ok && mu_pcap_reader_next(reader, &record)) {
+        if (n % stride == 0) {
+            ok = write_index_entry(f, max_ns, record.offset);
+        }
+        int64_t ns = mu_time_posix_to_nanos(record.time);
+        if (ns > max_ns) {
+            max_ns = ns;
+        }
+        n += 1;
+    }
+    ok = (fclose(f) == 0) && ok;
+    mu_pcap_reader_rewind(reader);
+    return ok;
+}
+
+bool mu_pcap_index_open(mu_pcap_index_t *index, const char *path) {
+    if (!map_file(path, &index->base, &index->size)) {
+        return false;
+    }
+    if (index->size < INDEX_HEADER_SIZE ||
+        memcmp(index->base, INDEX_MAGIC, INDEX_HEADER_SIZE) != 0) {
+        mu_pcap_index_close(index);
+        return false;
+    }
+    index->count = (index->size - INDEX_HEADER_SIZE) / INDEX_ENTRY_SIZE;
+    return true;
+}
+
+void mu_pcap_index_close(mu_pcap_index_t *index) {
+    if (index->base != NULL && index->size > 0) {
+        munmap((void *)index->base, index->size);
+    }
+    index->base = NULL;
+    index->size = 0;
+    index->count = 0;
+}
+
+void mu_pcap_reader_seek_time(mu_pcap_reader_t *reader,
+                              const mu_pcap_index_t *index,
+                              mu_time_abs_t start) {
+    int64_t target = mu_time_posix_to_nanos(start);
+    const uint8_t *entries = index->base + INDEX_HEADER_SIZE;
+    size_t lo = 0;
+    size_t hi = index->count;
+
+    // Find the last entry whose running maximum is still before the target;
+    // the maxima never decrease, so this is a binary search.
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((int64_t)get_le64(entries + mid * INDEX_ENTRY_SIZE) < target) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        mu_pcap_reader_rewind(reader);
+    } else {
+        mu_pcap_reader_seek(
+            reader, get_le64(entries + (lo - 1) * INDEX_ENTRY_SIZE + 8));
+    }
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool parse_header(mu_pcap_reader_t *reader) {
+    uint32_t magic;
+
+    if (reader->size < 12) {
+        return false;
+    }
+    magic = raw32(reader->base);
+    if (magic == MU_PCAP_MAGIC_MICROS || magic == MU_PCAP_MAGIC_NANOS ||
+        swap32(magic) == MU_PCAP_MAGIC_MICROS ||
+        swap32(magic) == MU_PCAP_MAGIC_NANOS) {
+        if (reader->size < PCAP_HEADER_SIZE) {
+            return false;
+        }
+        reader->format = MU_PCAP_FORMAT_PCAP;
+        reader->swap = magic != MU_PCAP_MAGIC_MICROS &&
+                       magic != MU_PCAP_MAGIC_NANOS;
+        reader->nanos = rd32(reader, reader->base) == MU_PCAP_MAGIC_NANOS;
+        reader->linktype = rd32(reader, reader->base + 20) & 0x0fffffff;
+        reader->pos = PCAP_HEADER_SIZE;
+        return true;
+    }
+    if (magic == PCAPNG_SHB) {
+        uint32_t type, length;
+        reader->format = MU_PCAP_FORMAT_PCAPNG;
+        if (!block_at(reader, 0, &type, &length)) {
+            return false;
+        }
+        scan_block(reader, 0, type, length);
+        reader->pos = 0;
+        return true;
+    }
+    return false;
+}
+
+static bool next_pcap(mu_pcap_reader_t *reader, mu_pcap_record_t *record) {
+    const uint8_t *p = reader->base + reader->pos;
+    size_t left = reader->size - reader->pos;
+
+    if (left == 0) {
+        return false;
+    }
+    if (left < PCAP_RECORD_HEADER_SIZE) {
+        reader->malformed = true;
+        return false;
+    }
+    uint32_t sec = rd32(reader, p);
+    uint32_t frac = rd32(reader, p + 4);
+    uint32_t caplen = rd32(reader, p + 8);
+    if (caplen > left - PCAP_RECORD_HEADER_SIZE) {
+        reader->malformed = true;
+        return false;
+    }
+    record->time.seconds = (time_t)sec;
+    record->time.nanoseconds = reader->nanos ? (long)frac : (long)frac * 1000;
+    record->data = p + PCAP_RECORD_HEADER_SIZE;
+    record->caplen = caplen;
+    record->origlen = rd32(reader, p + 12);
+    record->interface = 0;
+    record->offset = reader->pos;
+    reader->pos += PCAP_RECORD_HEADER_SIZE + caplen;
+    return true;
+}
+
+static bool next_pcapng(mu_pcap_reader_t *reader, mu_pcap_record_t *record) {
+    uint32_t type, length;
+
+    while (reader->pos < reader->size) {
+        size_t pos = reader->pos;
+        if (!block_at(reader, pos, &type, &length)) {
+            reader->malformed = true;
+            return false;
+        }
+        scan_block(reader, pos, type, length);
+        reader->pos = pos + length;
+        if (type != PCAPNG_EPB) {
+            continue;
+        }
+        const uint8_t *body = reader->base + pos + 8;
+        uint32_t iface = rd32(reader, body);
+        uint32_t caplen = rd32(reader, body + 12);
+        if (length < 32 || caplen > length - 32 ||
+            iface >= reader->n_interfaces) {
+            reader->malformed = true;
+            return false;
+        }
+        uint64_t ts = ((uint64_t)rd32(reader, body + 4) << 32) |
+                      rd32(reader, body + 8);
+        record->time = mu_time_posix_from_nanos(
+            pcapng_nanos(&reader->interfaces[iface], ts));
+        record->data = body + 20;
+        record->caplen = caplen;
+        record->origlen = rd32(reader, body + 16);
+        record->interface = iface;
+        record->offset = pos;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Validate the pcapng block at `pos` and return its type and length.
+ */
+static bool block_at(mu_pcap_reader_t *reader, size_t pos, uint32_t *type,
+                     uint32_t *length) {
+    const uint8_t *p = reader->base + pos;
+
+    if (reader->size - pos < 12) {
+        return false;
+    }
+    *type = rd32(reader, p);
+    if (*type == PCAPNG_SHB) {
+        // A section header sets the byte order of everything that follows.
+        uint32_t bom = raw32(p + 8);
+        if (bom == PCAPNG_BYTE_ORDER_MAGIC) {
+            reader->swap = false;
+        } else if (swap32(bom) == PCAPNG_BYTE_ORDER_MAGIC) {
+            reader->swap = true;
+        } else {
+            return false;
+        }
+    }
+    *length = rd32(reader, p + 4);
+    return *length >= 12 && (*length & 3) == 0 &&
+           *length <= reader->size - pos;
+}
+
+/**
+ * @brief Update section and interface state from a block, once per block.
+ */
+static void scan_block(mu_pcap_reader_t *reader, size_t pos, uint32_t type,
+                       uint32_t length) {
+    if (pos < reader->scanned) {
+        return;
+    }
+    if (type == PCAPNG_SHB) {
+        reader->n_interfaces = 0;
+    } else if (type == PCAPNG_IDB) {
+        parse_idb(reader, reader->base + pos + 8, length - 12);
+    }
+    reader->scanned = pos + length;
+}
+
+static void parse_idb(mu_pcap_reader_t *reader, const uint8_t *body,
+                      size_t size) {
+    mu_pcap_interface_t iface = {0, PCAPNG_DEFAULT_TSRESOL, 0};
+    size_t off = 8;
+
+    if (size < 8 || reader->n_interfaces == MU_PCAP_MAX_INTERFACES) {
+        return;
+    }
+    iface.linktype = rd16(reader, body);
+    while (off + 4 <= size) {
+        uint16_t code = rd16(reader, body + off);
+        uint16_t len = rd16(reader, body + off + 2);
+        const uint8_t *value = body + off + 4;
+        if (code == PCAPNG_OPT_END || off + 4 + len > size) {
+            break;
+        }
+        if (code == PCAPNG_OPT_IF_TSRESOL && len == 1) {
+            iface.tsresol = value[0];
+        } else if (code == PCAPNG_OPT_IF_TSOFFSET && len == 8) {
+            uint64_t seconds;
+            memcpy(&seconds, value, sizeof(seconds));
+            if (reader->swap) {
+                seconds = ((uint64_t)swap32((uint32_t)seconds) << 32) |
+                          swap32((uint32_t)(seconds >> 32));
+            }
+            iface.tsoffset_ns = (int64_t)seconds * NANOS_PER_SECOND;
+        }
+        off += 4 + (((size_t)len + 3) & ~(size_t)3);
+    }
+    reader->interfaces[reader->n_interfaces++] = iface;
+}
+
+static int64_t pcapng_nanos(const mu_pcap_interface_t *iface, uint64_t ts) {
+    unsigned n = iface->tsresol & 0x7f;
+    int64_t ns;
+
+    if (iface->tsresol & 0x80) {
+        ns = (int64_t)(((unsigned __int128)ts * NANOS_PER_SECOND) >> n);
+    } else if (n <= 9) {
+        static const int64_t scale[10] = {1000000000, 100000000, 10000000,
+                                          1000000,    100000,    10000,
+                                          1000,       100,       10,
+                                          1};
+        ns = (int64_t)ts * scale[n];
+    } else {
+        // 10^19 is the largest power of ten in 64 bits
+        uint64_t div = 1;
+        for (unsigned i = 9; i < n && i - 9 < 19; i++) {
+            div *= 10;
+        }
+        ns = (int64_t)(ts / div);
+    }
+    return ns + iface->tsoffset_ns;
+}
+
+static uint16_t rd16(const mu_pcap_reader_t *reader, const uint8_t *p) {
+    uint16_t v;
+    memcpy(&v, p, sizeof(v));
+    return reader->swap ? (uint16_t)((v >> 8) | (v << 8)) : v;
+}
+
+static uint32_t rd32(const mu_pcap_reader_t *reader, const uint8_t *p) {
+    uint32_t v = raw32(p);
+    return reader->swap ? swap32(v) : v;
+}
+
+static uint32_t raw32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t swap32(uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+}
+
+static void put_le64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint64_t get_le64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static bool write_index_entry(FILE *f, int64_t max_ns, uint64_t offset) {
+    uint8_t entry[INDEX_ENTRY_SIZE];
+
+    put_le64(entry, (uint64_t)max_ns);
+    put_le64(entry + 8, offset);
+    return fwrite(entry, 1, sizeof(entry), f) == sizeof(entry);
+}
+
+static bool map_file(const char *path, const uint8_t **base, size_t *size) {
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    void *p;
+
+    if (fd < 0) {
+        return false;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+    // Records are read front to back.
+    madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+    *base = p;
+    *size = (size_t)st.st_size;
+    return true;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,472 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_pdes.h"
+#include "mu_calendar_queue.h"
+#include "mu_pool.h"
+#include "mu_time.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+// Payload offset, keeping the payload maximally aligned
+#define HEADER_SIZE                                                            \
+    ((sizeof(mu_pdes_event_t) + _Alignof(max_align_t) - 1) &                   \
+     ~(_Alignof(max_align_t) - 1))
+
+#define RING_MASK (MU_PDES_RING_CAPACITY - 1)
+
+// Spin this many times at a barrier before yielding the CPU
+#define BARRIER_SPINS 1000
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void *worker_main(void *arg);
+static void run_worker(mu_pdes_worker_t *w);
+static void barrier_wait(mu_pdes_worker_t *w);
+static void publish_bounds(mu_pdes_worker_t *w);
+static void process_window(mu_pdes_worker_t *w, mu_time_abs_t end,
+                           bool inclusive);
+static void deliver(mu_pdes_worker_t *w, mu_pdes_event_t *ev);
+static void push_remote(mu_pdes_ring_t *ring, mu_pdes_event_t *ev);
+static void drain_inbound(mu_pdes_worker_t *w);
+static void release(mu_pdes_worker_t *w, mu_pdes_event_t *ev);
+static mu_pdes_event_t *event_of(mu_calendar_event_t *entry);
+
+// *****************************************************************************
+// Public code
+
+bool mu_pdes_init(mu_pdes_t *sim, size_t n_lps, size_t n_workers,
+                  size_t payload_size, mu_time_abs_t start) {
+    if (n_workers > n_lps) {
+        n_workers = n_lps;
+    }
+    sim->n_lps = n_lps;
+    sim->n_workers = n_workers;
+    sim->windows = 0;
+    sim->lps = calloc(n_lps, sizeof(mu_pdes_lp_t));
+    sim->workers = calloc(n_workers, sizeof(mu_pdes_worker_t));
+    if (sim->lps == NULL || sim->workers == NULL) {
+        mu_pdes_destroy(sim);
+        return false;
+    }
+    for (size_t i = 0; i < n_workers; i++) {
+        mu_pdes_worker_t *w = &sim->workers[i];
+        w->sim = sim;
+        w->index = (uint32_t)i;
+        mu_pool_init_dynamic(&w->pool, HEADER_SIZE + payload_size,
+                             MU_PDES_SLAB_EVENTS);
+        w->outbound = calloc(n_workers, sizeof(mu_pdes_ring_t));
+        if (w->outbound == NULL) {
+            mu_pdes_destroy(sim);
+            return false;
+        }
+        for (size_t j = 0; j < n_workers; j++) {
+            mu_pdes_ring_t *ring = &w->outbound[j];
+            ring->slots =
+                malloc(MU_PDES_RING_CAPACITY * sizeof(mu_pdes_event_t *));
+            if (ring->slots == NULL) {
+                mu_pdes_destroy(sim);
+                return false;
+            }
+            atomic_init(&ring->head, 0);
+            atomic_init(&ring->tail, 0);
+            ring->spill = NULL;
+            ring->spill_tail = &ring->spill;
+        }
+    }
+    for (size_t i = 0; i < n_lps; i++) {
+        mu_pdes_lp_t *lp = &sim->lps[i];
+        lp->sim = sim;
+        lp->id = (uint32_t)i;
+        lp->worker = (uint32_t)(i % n_workers);
+        lp->now = start;
+        lp->lookahead = 0;
+        lp->fn = NULL;
+        lp->ctx = NULL;
+        lp->buckets = malloc(MU_PDES_LP_BUCKETS * sizeof(mu_calendar_event_t *));
+        if (lp->buckets == NULL) {
+            mu_pdes_destroy(sim);
+            return false;
+        }
+        mu_calendar_queue_init(&lp->queue, lp->buckets, MU_PDES_LP_BUCKETS,
+                               start, 0);
+    }
+    atomic_init(&sim->start, 0);
+    atomic_init(&sim->barrier_count, n_workers);
+    atomic_init(&sim->barrier_sense, false);
+    return true;
+}
+
+void mu_pdes_destroy(mu_pdes_t *sim) {
+    // Event blocks live in the workers' pool slabs, so freeing the pools
+    // releases every queued event.
+    if (sim->lps != NULL) {
+        for (size_t i = 0; i < sim->n_lps; i++) {
+            free(sim->lps[i].buckets);
+        }
+        free(sim->lps);
+        sim->lps = NULL;
+    }
+    if (sim->workers != NULL) {
+        for (size_t i = 0; i < sim->n_workers; i++) {
+            mu_pdes_worker_t *w = &sim->workers[i];
+            if (w->outbound != NULL) {
+                for (size_t j = 0; j < sim->n_workers; j++) {
+                    free(w->outbound[j].slots);
+                }
+                free(w->outbound);
+            }
+            if (w->sim != NULL) {
+                mu_pool_destroy(&w->pool);
+            }
+        }
+        free(sim->workers);
+        sim->workers = NULL;
+    }
+}
+
+void mu_pdes_lp_configure(mu_pdes_t *sim, size_t lp, mu_pdes_handler_fn fn,
+                          void *ctx, mu_time_rel_t lookahead) {
+    sim->lps[lp].fn = fn;
+    sim->lps[lp].ctx = ctx;
+    sim->lps[lp].lookahead = lookahead;
+}
+
+mu_pdes_event_t *mu_pdes_schedule(mu_pdes_t *sim, size_t lp,
+                                  mu_time_abs_t time) {
+    mu_pdes_lp_t *dst = &sim->lps[lp];
+    mu_pdes_event_t *ev = mu_pdes_alloc(dst);
+
+    if (ev != NULL) {
+        ev->time = time;
+        ev->dst = (uint32_t)lp;
+        mu_calendar_queue_enqueue(&dst->queue, &ev->entry, time);
+    }
+    return ev;
+}
+
+bool mu_pdes_run(mu_pdes_t *sim, mu_time_abs_t until) {
+    pthread_t *threads = NULL;
+    size_t started = 0;
+
+    sim->until = until;
+    atomic_store(&sim->start, 0);
+    if (sim->n_workers > 1) {
+        threads = malloc((sim->n_workers - 1) * sizeof(pthread_t));
+        if (threads == NULL) {
+            return false;
+        }
+    }
+    for (size_t i = 1; i < sim->n_workers; i++) {
+        if (pthread_create(&threads[i - 1], NULL, worker_main,
+                           &sim->workers[i]) != 0) {
+            break;
+        }
+        started += 1;
+    }
+    // Workers wait at the gate until every thread exists, so a failure can
+    // still send them home before any window begins.
+    bool ok = started + 1 == sim->n_workers;
+    atomic_store(&sim->start, ok ? 1 : -1);
+    if (ok) {
+        run_worker(&sim->workers[0]);
+    }
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    return ok;
+}
+
+void mu_pdes_get_stats(const mu_pdes_t *sim, mu_pdes_stats_t *stats) {
+    stats->events = 0;
+    stats->remote = 0;
+    stats->windows = sim->windows;
+    for (size_t i = 0; i < sim->n_workers; i++) {
+        stats->events += sim->workers[i].events;
+        stats->remote += sim->workers[i].remote;
+    }
+}
+
+mu_pdes_event_t *mu_pdes_alloc(mu_pdes_lp_t *lp) {
+    mu_pdes_worker_t *w = &lp->sim->workers[lp->worker];
+    mu_pdes_event_t *ev = mu_pool_alloc(&w->pool);
+
+    if (ev != NULL) {
+        ev->pool = &w->pool;
+    }
+    return ev;
+}
+
+bool mu_pdes_send(mu_pdes_lp_t *lp, mu_pdes_event_t *ev, size_t dst,
+                  mu_time_abs_t time) {
+    mu_time_rel_t delay = mu_time_difference(lp->now, time);
+    mu_pdes_t *sim = lp->sim;
+
+    if (delay < 0 || (dst != lp->id && delay < lp->lookahead)) {
+        return false;
+    }
+    ev->time = time;
+    ev->dst = (uint32_t)dst;
+    if (sim->lps[dst].worker == lp->worker) {
+        // Same worker: straight into the calendar.  An event for another LP
+        // is past the window's end, so the order of LPs within the window
+        // does not matter.
+        mu_calendar_queue_enqueue(&sim->lps[dst].queue, &ev->entry, time);
+    } else {
+        mu_pdes_worker_t *w = &sim->workers[lp->worker];
+        push_remote(&w->outbound[sim->lps[dst].worker], ev);
+        w->remote += 1;
+    }
+    return true;
+}
+
+void mu_pdes_free(mu_pdes_lp_t *lp, mu_pdes_event_t *ev) {
+    release(&lp->sim->workers[lp->worker], ev);
+}
+
+mu_time_abs_t mu_pdes_now(const mu_pdes_lp_t *lp) {
+    return lp->now;
+}
+
+size_t mu_pdes_lp_id(const mu_pdes_lp_t *lp) {
+    return lp->id;
+}
+
+void *mu_pdes_event_payload(mu_pdes_event_t *ev) {
+    return (char *)ev + HEADER_SIZE;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void *worker_main(void *arg) {
+    mu_pdes_worker_t *w = arg;
+    int start;
+
+    while ((start = atomic_load(&w->sim->start)) == 0) {
+        sched_yield();
+    }
+    if (start > 0) {
+        run_worker(w);
+    }
+    return NULL;
+}
+
+/**
+ * @brief The window loop, run by every worker in lock step.
+ */
+static void run_worker(mu_pdes_worker_t *w) {
+    mu_pdes_t *sim = w->sim;
+
+    for (;;) {
+        publish_bounds(w);
+        barrier_wait(w);
+
+        // Every worker reduces the same published values, so all agree on
+        // the window and on when to stop.
+        bool any = false;
+        mu_time_abs_t next = sim->until;
+        mu_time_abs_t end = sim->until;
+        for (size_t i = 0; i < sim->n_workers; i++) {
+            const mu_pdes_worker_t *o = &sim->workers[i];
+            if (!o->has_next) {
+                continue;
+            }
+            if (!any || mu_time_is_before(o->next, next)) {
+                next = o->next;
+            }
+            if (mu_time_is_before(o->bound, end)) {
+                end = o->bound;
+            }
+            any = true;
+        }
+        if (!any || !mu_time_is_before(next, sim->until)) {
+            break;
+        }
+        if (w->index == 0) {
+            sim->windows += 1;
+        }
+
+        // With zero lookahead the bound equals the earliest event.  Events at
+        // exactly that time are still safe: anything they send is no earlier.
+        process_window(w, end, !mu_time_is_before(next, end));
+        barrier_wait(w);
+        drain_inbound(w);
+    }
+}
+
+/**
+ * @brief Sense-reversing spin barrier over all workers.
+ */
+static void barrier_wait(mu_pdes_worker_t *w) {
+    mu_pdes_t *sim = w->sim;
+
+    w->sense = !w->sense;
+    if (atomic_fetch_sub_explicit(&sim->barrier_count, 1,
+                                  memory_order_acq_rel) == 1) {
+        atomic_store_explicit(&sim->barrier_count, sim->n_workers,
+                              memory_order_relaxed);
+        atomic_store_explicit(&sim->barrier_sense, w->sense,
+                              memory_order_release);
+        return;
+    }
+    for (int spins = 0; atomic_load_explicit(&sim->barrier_sense,
+                                             memory_order_acquire) != w->sense;
+         spins++) {
+        if (spins >= BARRIER_SPINS) {
+            sched_yield();
+        }
+    }
+}
+
+/**
+ * @brief Record the worker's earliest event and its lower bound on the time
+ * of any message its LPs can still send.
+ */
+static void publish_bounds(mu_pdes_worker_t *w) {
+    mu_pdes_t *sim = w->sim;
+
+    w->has_next = false;
+    for (size_t i = w->index; i < sim->n_lps; i += sim->n_workers) {
+        mu_pdes_lp_t *lp = &sim->lps[i];
+        mu_calendar_event_t *head = mu_calendar_queue_peek(&lp->queue);
+        if (head == NULL) {
+            continue;
+        }
+        mu_time_abs_t t = event_of(head)->time;
+        mu_time_abs_t b = mu_time_offset(t, lp->lookahead);
+        if (!w->has_next || mu_time_is_before(t, w->next)) {
+            w->next = t;
+        }
+        if (!w->has_next || mu_time_is_before(b, w->bound)) {
+            w->bound = b;
+        }
+        w->has_next = true;
+    }
+}
+
+/**
+ * @brief Process every event of the worker's LPs that is before `end` (or at
+ * it, if inclusive).
+ */
+static void process_window(mu_pdes_worker_t *w, mu_time_abs_t end,
+                           bool inclusive) {
+    mu_pdes_t *sim = w->sim;
+
+    for (size_t i = w->index; i < sim->n_lps; i += sim->n_workers) {
+        mu_pdes_lp_t *lp = &sim->lps[i];
+        mu_calendar_event_t *head;
+        while ((head = mu_calendar_queue_peek(&lp->queue)) != NULL &&
+               (mu_time_is_before(event_of(head)->time, end) ||
+                (inclusive && !mu_time_is_after(event_of(head)->time, end)))) {
+            mu_pdes_event_t *ev = event_of(mu_calendar_queue_dequeue(&lp->queue));
+            lp->now = ev->time;
+            lp->fn(lp, ev, lp->ctx);
+            release(w, ev);
+            w->events += 1;
+        }
+    }
+}
+
+static void deliver(mu_pdes_worker_t *w, mu_pdes_event_t *ev) {
+    mu_pdes_lp_t *lp = &w->sim->lps[ev->dst];
+    mu_calendar_queue_enqueue(&lp->queue, &ev->entry, ev->time);
+}
+
+/**
+ * @brief Append to a ring, or to its spill list once the ring is full.
+ *
+ * Once anything has spilled, later events spill too so that the consumer
+ * sees them in send order.
+ */
+static void push_remote(mu_pdes_ring_t *ring, mu_pdes_event_t *ev) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    if (ring->spill != NULL || tail - head == MU_PDES_RING_CAPACITY) {
+        ev->entry.next = NULL;
+        *ring->spill_tail = &ev->entry;
+        ring->spill_tail = &ev->entry.next;
+        return;
+    }
+    ring->slots[tail & RING_MASK] = ev;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+/**
+ * @brief Deliver everything sent to this worker during the window, in order
+ * of sending worker.  Producers are idle (past the barrier), so the spill
+ * lists are safe to take.
+ */
+static void drain_inbound(mu_pdes_worker_t *w) {
+    mu_pdes_t *sim = w->sim;
+
+    for (size_t i = 0; i < sim->n_workers; i++) {
+        mu_pdes_ring_t *ring = &sim->workers[i].outbound[w->index];
+        size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        while (head != tail) {
+            deliver(w, ring->slots[head & RING_MASK]);
+            head += 1;
+        }
+        atomic_store_explicit(&ring->head, head, memory_order_release);
+        mu_calendar_event_t *entry = ring->spill;
+        while (entry != NULL) {
+            mu_calendar_event_t *next = entry->next;
+            deliver(w, event_of(entry));
+            entry = next;
+        }
+        ring->spill = NULL;
+        ring->spill_tail = &ring->spill;
+    }
+}
+
+static void release(mu_pdes_worker_t *w, mu_pdes_event_t *ev) {
+    if (ev->pool == &w->pool) {
+        mu_pool_free(&w->pool, ev);
+    } else {
+        mu_pool_free_remote(ev->pool, ev);
+    }
+}
+
+static mu_pdes_event_t *event_of(mu_calendar_event_t *entry) {
+    return (mu_pdes_event_t *)((char *)entry -
+                               offsetof(mu_pdes_event_t, entry));
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,207 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_pool.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#ifdef MU_POOL_USE_MALLOC
+#include <stdlib.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+#define BLOCK_ALIGN (sizeof(void *) > 8 ? sizeof(void *) : 8)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void pool_reset(mu_pool_t *pool, size_t block_size);
+#ifdef MU_POOL_USE_MALLOC
+static bool grow(mu_pool_t *pool);
+#endif
+
+// *****************************************************************************
+// Public code
+
+size_t mu_pool_block_size(size_t requested) {
+    if (requested < sizeof(mu_pool_block_t)) {
+        requested = sizeof(mu_pool_block_t);
+    }
+    return (requested + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1);
+}
+
+void mu_pool_init(mu_pool_t *pool, size_t block_size, void *storage,
+                  size_t storage_size) {
+    pool_reset(pool, block_size);
+    mu_pool_add_slab(pool, storage, storage_size);
+}
+
+void mu_pool_add_slab(mu_pool_t *pool, void *storage, size_t storage_size) {
+    uint8_t *p = (uint8_t *)storage;
+    size_t n = storage_size / pool->block_size;
+
+    // Thread the new blocks in address order onto the front of the free list.
+    for (size_t i = n; i > 0; i--) {
+        mu_pool_block_t *b = (mu_pool_block_t *)(p + (i - 1) * pool->block_size);
+        b->next = pool->free_list;
+        pool->free_list = b;
+    }
+    pool->capacity += n;
+    pool->slabs += 1;
+}
+
+#ifdef MU_POOL_USE_MALLOC
+void mu_pool_init_dynamic(mu_pool_t *pool, size_t block_size,
+                          size_t slab_blocks) {
+    pool_reset(pool, block_size);
+    pool->slab_blocks = slab_blocks;
+}
+
+void mu_pool_destroy(mu_pool_t *pool) {
+    void *slab = pool->slab_list;
+    while (slab != NULL) {
+        void *next = *(void **)slab;
+        free(slab);
+        slab = next;
+    }
+    pool_reset(pool, pool->block_size);
+}
+#endif
+
+void *mu_pool_alloc(mu_pool_t *pool) {
+    mu_pool_block_t *b = pool->free_list;
+
+    if (b == NULL && mu_pool_reclaim(pool) == 0) {
+#ifdef MU_POOL_USE_MALLOC
+        if (pool->slab_blocks == 0 || !grow(pool)) {
+            pool->alloc_failures += 1;
+            return NULL;
+        }
+#else
+        pool->alloc_failures += 1;
+        return NULL;
+#endif
+    }
+    b = pool->free_list;
+    pool->free_list = b->next;
+    pool->allocs += 1;
+    pool->in_use += 1;
+    if (pool->in_use > pool->high_water) {
+        pool->high_water = pool->in_use;
+    }
+    return b;
+}
+
+void mu_pool_free(mu_pool_t *pool, void *block) {
+    mu_pool_block_t *b = (mu_pool_block_t *)block;
+    b->next = pool->free_list;
+    pool->free_list = b;
+    pool->in_use -= 1;
+}
+
+void mu_pool_free_remote(mu_pool_t *pool, void *block) {
+    mu_pool_block_t *b = (mu_pool_block_t *)block;
+    mu_pool_block_t *head = atomic_load_explicit(&pool->remote,
+                                                 memory_order_relaxed);
+    do {
+        b->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&pool->remote, &head, b,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+    atomic_fetch_add_explicit(&pool->remote_frees, 1, memory_order_relaxed);
+}
+
+size_t mu_pool_reclaim(mu_pool_t *pool) {
+    mu_pool_block_t *b;
+    size_t n = 0;
+
+    if (atomic_load_explicit(&pool->remote, memory_order_relaxed) == NULL) {
+        return 0;
+    }
+    // Take the whole stack at once: pushers never pop, so there is no ABA.
+    b = atomic_exchange_explicit(&pool->remote, NULL, memory_order_acquire);
+    while (b != NULL) {
+        mu_pool_block_t *next = b->next;
+        b->next = pool->free_list;
+        pool->free_list = b;
+        b = next;
+        n += 1;
+    }
+    pool->in_use -= n;
+    return n;
+}
+
+void mu_pool_get_stats(const mu_pool_t *pool, mu_pool_stats_t *stats) {
+    stats->block_size = pool->block_size;
+    stats->capacity = pool->capacity;
+    stats->in_use = pool->in_use;
+    stats->high_water = pool->high_water;
+    stats->slabs = pool->slabs;
+    stats->allocs = pool->allocs;
+    stats->alloc_failures = pool->alloc_failures;
+    stats->remote_frees = atomic_load_explicit(
+        (atomic_uint_fast64_t *)&pool->remote_frees, memory_order_relaxed);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void pool_reset(mu_pool_t *pool, size_t block_size) {
+    pool->free_list = NULL;
+    atomic_init(&pool->remote, NULL);
+    atomic_init(&pool->remote_frees, 0);
+    pool->block_size = mu_pool_block_size(block_size);
+    pool->capacity = 0;
+    pool->in_use = 0;
+    pool->high_water = 0;
+    pool->slabs = 0;
+    pool->allocs = 0;
+    pool->alloc_failures = 0;
+    pool->slab_blocks = 0;
+    pool->slab_list = NULL;
+}
+
+#ifdef MU_POOL_USE_MALLOC
+static bool grow(mu_pool_t *pool) {
+    // Each slab starts with a link to the previous slab, padded to a block.
+    size_t header = mu_pool_block_size(sizeof(void *));
+    uint8_t *slab = malloc(header + pool->slab_blocks * pool->block_size);
+    if (slab == NULL) {
+        return false;
+    }
+    *(void **)slab = pool->slab_list;
+    pool->slab_list = slab;
+    mu_pool_add_slab(pool, slab + header, pool->slab_blocks * pool->block_size);
+    return true;
+}
+#endif
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,322 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_resample.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define Q16_ONE 65536
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool is_aggregate(const mu_resampler_t *r);
+static bool grid_done(const mu_resampler_t *r);
+static size_t skip_past(const int64_t *t, size_t i, size_t n, int64_t limit);
+static void accumulate(mu_resampler_t *r, const int32_t *v, size_t n);
+static void reset(mu_resampler_t *r);
+static void write(mu_resampler_t *r, int32_t *out, uint8_t *valid, size_t k,
+                  bool ok, int32_t value);
+static bool settle(const mu_resampler_t *r, const int64_t *t1, int32_t v1,
+                   int32_t *value);
+static bool aggregate(const mu_resampler_t *r, int32_t *value);
+static uint32_t weight(int64_t at, int64_t t0, int64_t t1);
+static size_t finish_at(mu_resampler_t *r, int64_t end, int32_t *out,
+                        uint8_t *valid, size_t k, size_t max);
+
+// *****************************************************************************
+// Public code
+
+void mu_resampler_init(mu_resampler_t *r, mu_resample_method_t method,
+                       int64_t origin, int64_t step, uint64_t count) {
+    r->method = method;
+    r->next = origin;
+    r->step = step > 0 ? step : 1;
+    r->window = r->step;
+    r->max_gap = 0;
+    r->written = 0;
+    r->count = count;
+    r->has_prev = false;
+    r->prev_t = 0;
+    r->prev_v = 0;
+    reset(r);
+}
+
+void mu_resampler_set_window(mu_resampler_t *r, int64_t window) {
+    r->window = (window > 0 && window < r->step) ? window : r->step;
+}
+
+void mu_resampler_set_max_gap(mu_resampler_t *r, int64_t max_gap) {
+    r->max_gap = max_gap > 0 ? max_gap : 0;
+}
+
+size_t mu_resampler_push(mu_resampler_t *r, const int64_t *t, const int32_t *v,
+                         size_t n, int32_t *out, uint8_t *valid, size_t max,
+                         size_t *consumed) {
+    size_t k = 0;
+    size_t i = 0;
+
+    while (i < n && !grid_done(r)) {
+        // Samples [i, j) fall at or before the next grid point.  Only the
+        // last of them matters to LAST and LINEAR; aggregates reduce those
+        // inside the window.
+        size_t j = skip_past(t, i, n, r->next);
+        if (j > i) {
+            if (is_aggregate(r)) {
+                size_t w = skip_past(t, i, j, r->next - r->window);
+                accumulate(r, &v[w], j - w);
+            }
+            r->has_prev = true;
+            r->prev_t = t[j - 1];
+            r->prev_v = v[j - 1];
+            i = j;
+            if (i == n) {
+                break; // a later chunk may still hold samples at `next`
+            }
+        }
+        // t[i] is past the grid point, so its value is settled.
+        if (k == max) {
+            break;
+        }
+        int32_t value;
+        bool ok = settle(r, &t[i], v[i], &value);
+        write(r, out, valid, k++, ok, value);
+    }
+    *consumed = grid_done(r) ? n : i;
+    return k;
+}
+
+size_t mu_resampler_finish(mu_resampler_t *r, int64_t end, int32_t *out,
+                           uint8_t *valid, size_t max) {
+    return finish_at(r, end, out, valid, 0, max);
+}
+
+size_t mu_resampler_run(mu_resampler_t *r, const int64_t *t, const int32_t *v,
+                        size_t n, int32_t *out, uint8_t *valid) {
+    size_t consumed;
+    size_t left = (size_t)(r->count - r->written);
+    size_t k = mu_resampler_push(r, t, v, n, out, valid, left, &consumed);
+    int64_t end = r->next + (int64_t)(left - k) * r->step;
+
+    return k + finish_at(r, end, out, valid, k, left - k);
+}
+
+uint64_t mu_resampler_position(const mu_resampler_t *r) { return r->written; }
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Write grid points before `end` to out[k], out[k + 1], ...
+ */
+static size_t finish_at(mu_resampler_t *r, int64_t end, int32_t *out,
+                        uint8_t *valid, size_t k, size_t max) {
+    size_t written = 0;
+
+    while (written < max && !grid_done(r) && r->next < end) {
+        int32_t value;
+        bool ok = settle(r, NULL, 0, &value);
+        write(r, out, valid, k + written++, ok, value);
+    }
+    return written;
+}
+
+static bool is_aggregate(const mu_resampler_t *r) {
+    return r->method != MU_RESAMPLE_LAST && r->method != MU_RESAMPLE_LINEAR;
+}
+
+static bool grid_done(const mu_resampler_t *r) {
+    return r->count != 0 && r->written >= r->count;
+}
+
+/**
+ * @brief Return the first index in [i, n) with t > limit, or n.  Gallops, so
+ * skipping m samples costs O(log m).
+ */
+static size_t skip_past(const int64_t *t, size_t i, size_t n, int64_t limit) {
+    size_t lo = i, hi, step = 1;
+
+    if (i == n || t[i] > limit) {
+        return i;
+    }
+    // t[lo] <= limit; find hi with t[hi] > limit.
+    for (;;) {
+        hi = lo + step;
+        if (hi >= n) {
+            hi = n;
+            break;
+        }
+        if (t[hi] > limit) {
+            break;
+        }
+        lo = hi;
+        step *= 2;
+    }
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (t[mid] > limit) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    return hi;
+}
+
+/**
+ * @brief Fold samples into the window aggregate.  Separate branch-free
+ * reductions, so each vectorizes.
+ */
+static void accumulate(mu_resampler_t *r, const int32_t *v, size_t n) {
+    int64_t sum = 0;
+    int32_t lo = r->min, hi = r->max;
+
+    for (size_t i = 0; i < n; i++) {
+        sum += v[i];
+    }
+    for (size_t i = 0; i < n; i++) {
+        lo = v[i] < lo ? v[i] : lo;
+        hi = v[i] > hi ? v[i] : hi;
+    }
+    r->sum += sum;
+    r->min = lo;
+    r->max = hi;
+    r->n += (uint32_t)n;
+}
+
+static void reset(mu_resampler_t *r) {
+    r->sum = 0;
+    r->min = INT32_MAX;
+    r->max = INT32_MIN;
+    r->n = 0;
+}
+
+/**
+ * @brief Write the next grid point and advance to the one after.
+ */
+static void write(mu_resampler_t *r, int32_t *out, uint8_t *valid, size_t k,
+                  bool ok, int32_t value) {
+    out[k] = ok ? value : 0;
+    if (valid != NULL) {
+        uint8_t bit = (uint8_t)(1u << (k % 8));
+        valid[k / 8] = ok ? (uint8_t)(valid[k / 8] | bit)
+                          : (uint8_t)(valid[k / 8] & ~bit);
+    }
+    r->next += r->step;
+    r->written += 1;
+    reset(r);
+}
+
+/**
+ * @brief Compute the value of the next grid point.
+ *
+ * @param r The resampler.
+ * @param t1 Timestamp of the first sample past the grid point, or NULL if
+ * the input has ended.
+ * @param v1 That sample's value.
+ * @param value Receives the value.
+ * @return false if the grid point has no value.
+ */
+static bool settle(const mu_resampler_t *r, const int64_t *t1, int32_t v1,
+                   int32_t *value) {
+    *value = r->prev_v;
+    switch (r->method) {
+    case MU_RESAMPLE_LAST:
+        return r->has_prev &&
+               (r->max_gap == 0 || r->next - r->prev_t <= r->max_gap);
+    case MU_RESAMPLE_LINEAR:
+        if (!r->has_prev) {
+            return false;
+        } else if (t1 == NULL) {
+            return r->next == r->prev_t;
+        } else if (r->max_gap != 0 && *t1 - r->prev_t > r->max_gap) {
+            return false;
+        }
+        *value = mu_resample_lerp(r->prev_v, v1,
+                                  weight(r->next, r->prev_t, *t1));
+        return true;
+    default:
+        return aggregate(r, value);
+    }
+}
+
+static bool aggregate(const mu_resampler_t *r, int32_t *value) {
+    int64_t x;
+
+    switch (r->method) {
+    case MU_RESAMPLE_MEAN:
+        if (r->n == 0) {
+            return false;
+        }
+        // Round half away from zero.
+        x = r->sum >= 0 ? (r->sum + r->n / 2) / r->n
+                        : (r->sum - r->n / 2) / r->n;
+        break;
+    case MU_RESAMPLE_MIN:
+        x = r->min;
+        break;
+    case MU_RESAMPLE_MAX:
+        x = r->max;
+        break;
+    case MU_RESAMPLE_SUM:
+        x = r->sum;
+        break;
+    default:
+        x = r->n;
+        break;
+    }
+    if (r->n == 0 && (r->method == MU_RESAMPLE_MIN ||
+                      r->method == MU_RESAMPLE_MAX)) {
+        return false;
+    }
+    // A sum may outgrow int32: saturate.
+    *value = x > INT32_MAX ? INT32_MAX : x < INT32_MIN ? INT32_MIN : (int32_t)x;
+    return true;
+}
+
+/**
+ * @brief Return (at - t0) / (t1 - t0) in Q16, for t0 <= at < t1.
+ */
+static uint32_t weight(int64_t at, int64_t t0, int64_t t1) {
+    uint64_t num = (uint64_t)(at - t0);
+    uint64_t den = (uint64_t)(t1 - t0);
+
+    // Keep num << 16 within 64 bits.
+    while (den >= ((uint64_t)1 << 47)) {
+        num >>= 1;
+        den >>= 1;
+    }
+    uint64_t w = (num << 16) / den;
+    return w > Q16_ONE ? Q16_ONE : (uint32_t)w;
+}
+
+// *****************************************************************************
+// End of file
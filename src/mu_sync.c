@@ -0,0 +1,317 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sync.h"
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+#define SPIN_CHECK_MASK 15 ///< Read the clock every 16 attempts
+#define SPIN_GAIN_SHIFT 3  ///< Budget moves 1/8 of the way per observation
+
+typedef bool (*try_fn)(void *obj);
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static struct timespec to_timespec(mu_time_abs_t t);
+static bool spin_try(mu_spin_t *spin, try_fn try, void *obj, mu_time_abs_t *t0);
+static void cpu_relax(void);
+static bool try_mutex(void *obj);
+static bool try_sem(void *obj);
+
+// *****************************************************************************
+// Public code
+
+void mu_spin_init(mu_spin_t *spin, mu_time_rel_t initial) {
+    spin->max = MU_SPIN_MAX;
+    if (initial < 0) {
+        spin->max = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? MU_SPIN_MAX : 0;
+        initial = MU_SPIN_DEFAULT;
+    }
+    atomic_init(&spin->budget, initial < spin->max ? initial : spin->max);
+}
+
+mu_time_rel_t mu_spin_budget(const mu_spin_t *spin) {
+    return atomic_load_explicit(&((mu_spin_t *)spin)->budget,
+                                memory_order_relaxed);
+}
+
+void mu_spin_update(mu_spin_t *spin, mu_time_rel_t waited, bool blocked) {
+    mu_time_rel_t budget = mu_spin_budget(spin);
+    mu_time_rel_t target;
+
+    if (!blocked) {
+        // Spinning worked: keep twice the need, for headroom.
+        target = 2 * waited;
+    } else if (waited < spin->max) {
+        // A spin of this length would have avoided the block.
+        target = waited;
+    } else {
+        // Too long to spin for: decay.
+        target = 0;
+    }
+    if (target > spin->max) {
+        target = spin->max;
+    }
+    // Racing updates lose an observation at worst; the budget is a hint.
+    budget += (target - budget) / (1 << SPIN_GAIN_SHIFT);
+    atomic_store_explicit(&spin->budget, budget, memory_order_relaxed);
+}
+
+int mu_mutex_init(mu_mutex_t *m) {
+    mu_spin_init(&m->spin, -1);
+    return pthread_mutex_init(&m->mutex, NULL);
+}
+
+void mu_mutex_destroy(mu_mutex_t *m) { pthread_mutex_destroy(&m->mutex); }
+
+void mu_mutex_lock(mu_mutex_t *m) {
+    mu_time_abs_t t0;
+
+    if (spin_try(&m->spin, try_mutex, m, &t0)) {
+        return;
+    }
+    pthread_mutex_lock(&m->mutex);
+    mu_spin_update(&m->spin, mu_time_difference(t0, mu_time_now()), true);
+}
+
+bool mu_mutex_trylock(mu_mutex_t *m) { return try_mutex(m); }
+
+bool mu_mutex_timedlock(mu_mutex_t *m, mu_time_abs_t deadline) {
+    mu_time_abs_t t0;
+
+    if (spin_try(&m->spin, try_mutex, m, &t0)) {
+        return true;
+    }
+    struct timespec ts = to_timespec(deadline);
+    if (pthread_mutex_timedlock(&m->mutex, &ts) != 0) {
+        return false;
+    }
+    mu_spin_update(&m->spin, mu_time_difference(t0, mu_time_now()), true);
+    return true;
+}
+
+void mu_mutex_unlock(mu_mutex_t *m) { pthread_mutex_unlock(&m->mutex); }
+
+int mu_cond_init(mu_cond_t *c) {
+    pthread_condattr_t attr;
+    int err = pthread_condattr_init(&attr);
+
+    if (err != 0) {
+        return err;
+    }
+    // Explicit, so that the deadline clock never depends on a default.
+    err = pthread_condattr_setclock(&attr, CLOCK_REALTIME);
+    if (err == 0) {
+        err = pthread_cond_init(&c->cond, &attr);
+    }
+    pthread_condattr_destroy(&attr);
+    return err;
+}
+
+void mu_cond_destroy(mu_cond_t *c) { pthread_cond_destroy(&c->cond); }
+
+void mu_cond_wait(mu_cond_t *c, mu_mutex_t *m) {
+    pthread_cond_wait(&c->cond, &m->mutex);
+}
+
+bool mu_cond_timedwait(mu_cond_t *c, mu_mutex_t *m, mu_time_abs_t deadline) {
+    struct timespec ts = to_timespec(deadline);
+    return pthread_cond_timedwait(&c->cond, &m->mutex, &ts) != ETIMEDOUT;
+}
+
+void mu_cond_signal(mu_cond_t *c) { pthread_cond_signal(&c->cond); }
+
+void mu_cond_broadcast(mu_cond_t *c) { pthread_cond_broadcast(&c->cond); }
+
+int mu_sem_init(mu_sem_t *s, unsigned value) {
+    mu_spin_init(&s->spin, -1);
+    return sem_init(&s->sem, 0, value) == 0 ? 0 : errno;
+}
+
+void mu_sem_destroy(mu_sem_t *s) { sem_destroy(&s->sem); }
+
+void mu_sem_post(mu_sem_t *s) { sem_post(&s->sem); }
+
+void mu_sem_wait(mu_sem_t *s) {
+    mu_time_abs_t t0;
+
+    if (spin_try(&s->spin, try_sem, s, &t0)) {
+        return;
+    }
+    while (sem_wait(&s->sem) != 0) {
+        // EINTR: wait again
+    }
+    mu_spin_update(&s->spin, mu_time_difference(t0, mu_time_now()), true);
+}
+
+bool mu_sem_trywait(mu_sem_t *s) { return try_sem(s); }
+
+bool mu_sem_timedwait(mu_sem_t *s, mu_time_abs_t deadline) {
+    mu_time_abs_t t0;
+
+    if (spin_try(&s->spin, try_sem, s, &t0)) {
+        return true;
+    }
+    struct timespec ts = to_timespec(deadline);
+    while (sem_timedwait(&s->sem, &ts) != 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    mu_spin_update(&s->spin, mu_time_difference(t0, mu_time_now()), true);
+    return true;
+}
+
+#if defined(__linux__)
+bool mu_futex_wait(atomic_uint *word, unsigned expected,
+                   const mu_time_abs_t *deadline) {
+    struct timespec ts;
+    const struct timespec *tsp = NULL;
+
+    if (deadline != NULL) {
+        ts = to_timespec(*deadline);
+        tsp = &ts;
+    }
+    // FUTEX_WAIT takes a relative timeout on CLOCK_MONOTONIC; the bitset
+    // variant takes an absolute one on the clock we choose.  The absolute
+    // deadline also makes an EINTR retry exact.
+    for (;;) {
+        long r = syscall(SYS_futex, word,
+                         FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG |
+                             FUTEX_CLOCK_REALTIME,
+                         expected, tsp, NULL, FUTEX_BITSET_MATCH_ANY);
+        if (r == 0 || errno == EAGAIN) {
+            return true;
+        } else if (errno != EINTR) {
+            // ETIMEDOUT, or a wait that can never succeed (EINVAL, ENOSYS)
+            return false;
+        }
+        if (atomic_load_explicit(word, memory_order_acquire) != expected) {
+            return true;
+        }
+    }
+}
+
+bool mu_futex_await(atomic_uint *word, unsigned expected,
+                    const mu_time_abs_t *deadline, mu_spin_t *spin) {
+    mu_time_rel_t budget = mu_spin_budget(spin);
+    mu_time_abs_t t0 = mu_time_now();
+
+    for (unsigned i = 1; budget > 0; i++) {
+        if (atomic_load_explicit(word, memory_order_acquire) != expected) {
+            mu_spin_update(spin, mu_time_difference(t0, mu_time_now()), false);
+            return true;
+        }
+        if ((i & SPIN_CHECK_MASK) == 0 &&
+            mu_time_difference(t0, mu_time_now()) >= budget) {
+            break;
+        }
+        cpu_relax();
+    }
+    bool woken = mu_futex_wait(word, expected, deadline);
+    if (woken) {
+        mu_spin_update(spin, mu_time_difference(t0, mu_time_now()), true);
+    }
+    return woken;
+}
+
+int mu_futex_wake(atomic_uint *word, int count) {
+    long r = syscall(SYS_futex, word, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, count,
+                     NULL, NULL, 0);
+    return r < 0 ? 0 : (int)r;
+}
+#endif
+
+// *****************************************************************************
+// Private (static) code
+
+static struct timespec to_timespec(mu_time_abs_t t) {
+    struct timespec ts = {.tv_sec = t.seconds, .tv_nsec = t.nanoseconds};
+    return ts;
+}
+
+/**
+ * @brief Try to acquire, spinning for the budget.  On failure `*t0` holds
+ * the time the attempt began.
+ */
+static bool spin_try(mu_spin_t *spin, try_fn try, void *obj,
+                     mu_time_abs_t *t0) {
+    if (try(obj)) {
+        // Uncontended: nothing to learn.
+        return true;
+    }
+    mu_time_rel_t budget = mu_spin_budget(spin);
+    *t0 = mu_time_now();
+    for (unsigned i = 1; budget > 0; i++) {
+        cpu_relax();
+        if (try(obj)) {
+            mu_spin_update(spin, mu_time_difference(*t0, mu_time_now()),
+                           false);
+            return true;
+        }
+        if ((i & SPIN_CHECK_MASK) == 0 &&
+            mu_time_difference(*t0, mu_time_now()) >= budget) {
+            break;
+        }
+    }
+    return false;
+}
+
+static void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static bool try_mutex(void *obj) {
+    return pthread_mutex_trylock(&((mu_mutex_t *)obj)->mutex) == 0;
+}
+
+static bool try_sem(void *obj) {
+    return sem_trywait(&((mu_sem_t *)obj)->sem) == 0;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,255 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time_bucket.h"
+#include "mu_time.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define BLOCK_SIZE 256                 // timestamps converted per fast pass
+#define PROBE_STEP_MIN 3600            // first probe distance, seconds
+#define PROBE_STEP_MAX (7 * 86400)     // no zone has transitions closer
+#define INTERVAL_SPAN_MAX (400 * 86400) // stop probing beyond this
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static int32_t probe_offset(int64_t seconds);
+static const mu_time_bucket_interval_t *lookup(mu_time_bucket_zone_t *zone,
+                                               int64_t seconds);
+static const mu_time_bucket_interval_t *find_cached(mu_time_bucket_zone_t *zone,
+                                                    int64_t seconds);
+static void compute_interval(int64_t seconds, mu_time_bucket_interval_t *iv);
+static void bucket_block(mu_time_bucket_zone_t *zone, const int64_t *seconds,
+                         int32_t *buckets, size_t count, int64_t lo, int64_t hi,
+                         mu_time_bucket_unit_t unit);
+static int64_t floor_div(int64_t a, int64_t b);
+
+// *****************************************************************************
+// Public code
+
+void mu_time_bucket_zone_init(mu_time_bucket_zone_t *zone) {
+    tzset();
+    zone->is_utc = false;
+    zone->cached = 0;
+    zone->victim = 0;
+    zone->refreshes = 0;
+}
+
+void mu_time_bucket_zone_init_utc(mu_time_bucket_zone_t *zone) {
+    zone->is_utc = true;
+    zone->cache[0].start = INT64_MIN;
+    zone->cache[0].end = INT64_MAX;
+    zone->cache[0].utc_offset = 0;
+    zone->cached = 1;
+    zone->victim = 0;
+    zone->refreshes = 0;
+}
+
+int32_t mu_time_bucket_utc_offset(mu_time_bucket_zone_t *zone, int64_t seconds) {
+    return lookup(zone, seconds)->utc_offset;
+}
+
+void mu_time_bucket(mu_time_bucket_zone_t *zone, const mu_time_abs_t *times,
+                    int32_t *buckets, size_t count, mu_time_bucket_unit_t unit) {
+    int64_t seconds[BLOCK_SIZE];
+
+    while (count > 0) {
+        size_t n = (count < BLOCK_SIZE) ? count : BLOCK_SIZE;
+        int64_t lo = INT64_MAX;
+        int64_t hi = INT64_MIN;
+        for (size_t i = 0; i < n; i++) {
+            seconds[i] = (int64_t)times[i].seconds;
+            lo = (seconds[i] < lo) ? seconds[i] : lo;
+            hi = (seconds[i] > hi) ? seconds[i] : hi;
+        }
+        bucket_block(zone, seconds, buckets, n, lo, hi, unit);
+        times += n;
+        buckets += n;
+        count -= n;
+    }
+}
+
+void mu_time_bucket_seconds(mu_time_bucket_zone_t *zone, const int64_t *seconds,
+                            int32_t *buckets, size_t count,
+                            mu_time_bucket_unit_t unit) {
+    while (count > 0) {
+        size_t n = (count < BLOCK_SIZE) ? count : BLOCK_SIZE;
+        int64_t lo = INT64_MAX;
+        int64_t hi = INT64_MIN;
+        for (size_t i = 0; i < n; i++) {
+            lo = (seconds[i] < lo) ? seconds[i] : lo;
+            hi = (seconds[i] > hi) ? seconds[i] : hi;
+        }
+        bucket_block(zone, seconds, buckets, n, lo, hi, unit);
+        seconds += n;
+        buckets += n;
+        count -= n;
+    }
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static int32_t probe_offset(int64_t seconds) {
+    time_t t = (time_t)seconds;
+    struct tm tm;
+    if (localtime_r(&t, &tm) == NULL) {
+        return 0;
+    }
+    return (int32_t)tm.tm_gmtoff;
+}
+
+static const mu_time_bucket_interval_t *lookup(mu_time_bucket_zone_t *zone,
+                                               int64_t seconds) {
+    const mu_time_bucket_interval_t *iv = find_cached(zone, seconds);
+    if (iv == NULL) {
+        mu_time_bucket_interval_t *slot = &zone->cache[zone->victim];
+        compute_interval(seconds, slot);
+        zone->victim = (zone->victim + 1) % MU_TIME_BUCKET_CACHE_SIZE;
+        if (zone->cached < MU_TIME_BUCKET_CACHE_SIZE) {
+            zone->cached += 1;
+        }
+        zone->refreshes += 1;
+        iv = slot;
+    }
+    return iv;
+}
+
+static const mu_time_bucket_interval_t *find_cached(mu_time_bucket_zone_t *zone,
+                                                    int64_t seconds) {
+    for (size_t i = 0; i < zone->cached; i++) {
+        const mu_time_bucket_interval_t *iv = &zone->cache[i];
+        if (seconds >= iv->start && seconds < iv->end) {
+            return iv;
+        }
+    }
+    return NULL;
+}
+
+static void compute_interval(int64_t seconds, mu_time_bucket_interval_t *iv) {
+    int32_t offset = probe_offset(seconds);
+    int64_t same;
+    int64_t other;
+    int64_t step;
+
+    // Gallop forward until the offset changes, then bisect to the second.
+    same = seconds;
+    step = PROBE_STEP_MIN;
+    iv->end = INT64_MAX;
+    while (same - seconds < INTERVAL_SPAN_MAX) {
+        other = same + step;
+        if (probe_offset(other) != offset) {
+            while (other - same > 1) {
+                int64_t mid = same + (other - same) / 2;
+                if (probe_offset(mid) == offset) {
+                    same = mid;
+                } else {
+                    other = mid;
+                }
+            }
+            iv->end = other;
+            break;
+        }
+        same = other;
+        step = (step * 2 < PROBE_STEP_MAX) ? step * 2 : PROBE_STEP_MAX;
+    }
+    if (iv->end == INT64_MAX) {
+        iv->end = same + 1;
+    }
+
+    // ... and the same backward.
+    same = seconds;
+    step = PROBE_STEP_MIN;
+    iv->start = INT64_MIN;
+    while (seconds - same < INTERVAL_SPAN_MAX) {
+        other = same - step;
+        if (probe_offset(other) != offset) {
+            while (same - other > 1) {
+                int64_t mid = same - (same - other) / 2;
+                if (probe_offset(mid) == offset) {
+                    same = mid;
+                } else {
+                    other = mid;
+                }
+            }
+            iv->start = same;
+            break;
+        }
+        same = other;
+        step = (step * 2 < PROBE_STEP_MAX) ? step * 2 : PROBE_STEP_MAX;
+    }
+    if (iv->start == INT64_MIN) {
+        iv->start = same;
+    }
+    iv->utc_offset = offset;
+}
+
+static void bucket_block(mu_time_bucket_zone_t *zone, const int64_t *seconds,
+                         int32_t *buckets, size_t count, int64_t lo, int64_t hi,
+                         mu_time_bucket_unit_t unit) {
+    const mu_time_bucket_interval_t *iv = find_cached(zone, lo);
+
+    if (iv != NULL && hi < iv->end && (hi - lo) < (int64_t)UINT32_MAX - 86400) {
+        // Fast path: one offset for the whole block.  Rebase onto the bucket
+        // boundary at or below lo so the division is unsigned 32 bit by a
+        // constant, which vectorizes as a multiply-high and shift.
+        int64_t base = floor_div(lo + iv->utc_offset, unit);
+        int64_t origin = base * unit - iv->utc_offset;
+        if (unit == MU_TIME_BUCKET_DAY) {
+            for (size_t i = 0; i < count; i++) {
+                uint32_t r = (uint32_t)(seconds[i] - origin);
+                buckets[i] = (int32_t)base + (int32_t)(r / 86400u);
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                uint32_t r = (uint32_t)(seconds[i] - origin);
+                buckets[i] = (int32_t)base + (int32_t)(r / 3600u);
+            }
+        }
+        return;
+    }
+
+    // Slow path: the block straddles a transition (or is not cached yet).
+    for (size_t i = 0; i < count; i++) {
+        const mu_time_bucket_interval_t *e = lookup(zone, seconds[i]);
+        buckets[i] = (int32_t)floor_div(seconds[i] + e->utc_offset, unit);
+    }
+}
+
+static int64_t floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && a < 0) ? q - 1 : q;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,336 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time_column.h"
+#include "mu_time.h"
+#include "mu_time_bucket.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define NANOS_PER_SECOND 1000000000LL
+#define BLOCK_SIZE 256 // rows converted to seconds per bucketing pass
+
+typedef enum { CMP_BEFORE, CMP_AFTER, CMP_RANGE } cmp_t;
+
+/**
+ * @brief Descriptors owned by an exported array.
+ */
+typedef struct {
+    const void *buffers[2];
+    mu_time_column_release_fn on_release;
+    void *ctx;
+} export_array_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static size_t compare(const mu_time_column_t *col, int64_t lo, int64_t hi,
+                      cmp_t cmp, uint8_t *out);
+static uint8_t load_bits(const uint8_t *bitmap, size_t bit, size_t n);
+static int64_t floor_seconds(int64_t nanos);
+static void release_schema(struct ArrowSchema *schema);
+static void release_array(struct ArrowArray *array);
+
+// *****************************************************************************
+// Public code
+
+void mu_time_column_init(mu_time_column_t *col, int64_t *values,
+                         uint8_t *validity, size_t length) {
+    col->values = values;
+    col->validity = validity;
+    col->offset = 0;
+    col->length = length;
+}
+
+mu_time_abs_t mu_time_column_get(const mu_time_column_t *col, size_t i) {
+    return mu_time_posix_from_nanos(col->values[col->offset + i]);
+}
+
+void mu_time_column_set(mu_time_column_t *col, size_t i, mu_time_abs_t t) {
+    size_t bit = col->offset + i;
+
+    col->values[bit] = mu_time_posix_to_nanos(t);
+    if (col->validity != NULL) {
+        col->validity[bit >> 3] |= (uint8_t)(1 << (bit & 7));
+    }
+}
+
+void mu_time_column_set_null(mu_time_column_t *col, size_t i) {
+    size_t bit = col->offset + i;
+    col->validity[bit >> 3] &= (uint8_t)~(1 << (bit & 7));
+}
+
+size_t mu_time_column_null_count(const mu_time_column_t *col) {
+    size_t valid = 0;
+
+    if (col->validity == NULL) {
+        return 0;
+    }
+    for (size_t i = 0; i < col->length; i += 8) {
+        size_t n = (col->length - i < 8) ? col->length - i : 8;
+        valid += (size_t)__builtin_popcount(
+            load_bits(col->validity, col->offset + i, n));
+    }
+    return col->length - valid;
+}
+
+size_t mu_time_column_before(const mu_time_column_t *col, mu_time_abs_t t,
+                             uint8_t *out) {
+    return compare(col, mu_time_posix_to_nanos(t), 0, CMP_BEFORE, out);
+}
+
+size_t mu_time_column_after(const mu_time_column_t *col, mu_time_abs_t t,
+                            uint8_t *out) {
+    return compare(col, mu_time_posix_to_nanos(t), 0, CMP_AFTER, out);
+}
+
+size_t mu_time_column_in_range(const mu_time_column_t *col,
+                               mu_time_abs_t start, mu_time_abs_t end,
+                               uint8_t *out) {
+    return compare(col, mu_time_posix_to_nanos(start),
+                   mu_time_posix_to_nanos(end), CMP_RANGE, out);
+}
+
+void mu_time_column_difference(const mu_time_column_t *col, mu_time_abs_t ref,
+                               mu_time_rel_t *out) {
+    const int64_t *v = col->values + col->offset;
+    int64_t r = mu_time_posix_to_nanos(ref);
+
+    for (size_t i = 0; i < col->length; i++) {
+        out[i] = v[i] - r;
+    }
+}
+
+void mu_time_column_offset(const mu_time_column_t *col, mu_time_rel_t delta,
+                           int64_t *out) {
+    const int64_t *v = col->values + col->offset;
+
+    for (size_t i = 0; i < col->length; i++) {
+        out[i] = v[i] + delta;
+    }
+}
+
+void mu_time_column_bucket(const mu_time_column_t *col,
+                           mu_time_bucket_zone_t *zone, int32_t *buckets,
+                           mu_time_bucket_unit_t unit) {
+    const int64_t *v = col->values + col->offset;
+    int64_t seconds[BLOCK_SIZE];
+    int64_t fill = 0;
+
+    for (size_t base = 0; base < col->length; base += BLOCK_SIZE) {
+        size_t n = col->length - base;
+        if (n > BLOCK_SIZE) {
+            n = BLOCK_SIZE;
+        }
+        for (size_t i = 0; i < n; i++) {
+            seconds[i] = floor_seconds(v[base + i]);
+        }
+        if (col->validity != NULL) {
+            // Null rows may hold anything; give them their predecessor's time
+            // so they stay on the zone cache's fast path.
+            for (size_t i = 0; i < n; i++) {
+                if (mu_time_column_is_valid(col, base + i)) {
+                    fill = seconds[i];
+                } else {
+                    seconds[i] = fill;
+                }
+            }
+        }
+        mu_time_bucket_seconds(zone, seconds, buckets + base, n, unit);
+    }
+}
+
+bool mu_time_column_min_max(const mu_time_column_t *col, mu_time_abs_t *min,
+                            mu_time_abs_t *max) {
+    const int64_t *v = col->values + col->offset;
+    int64_t lo = INT64_MAX;
+    int64_t hi = INT64_MIN;
+    bool any = false;
+
+    if (col->validity == NULL) {
+        for (size_t i = 0; i < col->length; i++) {
+            lo = (v[i] < lo) ? v[i] : lo;
+            hi = (v[i] > hi) ? v[i] : hi;
+        }
+        any = col->length > 0;
+    } else {
+        for (size_t i = 0; i < col->length; i++) {
+            if (mu_time_column_is_valid(col, i)) {
+                lo = (v[i] < lo) ? v[i] : lo;
+                hi = (v[i] > hi) ? v[i] : hi;
+                any = true;
+            }
+        }
+    }
+    if (any) {
+        *min = mu_time_posix_from_nanos(lo);
+        *max = mu_time_posix_from_nanos(hi);
+    }
+    return any;
+}
+
+bool mu_time_column_export(const mu_time_column_t *col, const char *timezone,
+                           mu_time_column_release_fn on_release, void *ctx,
+                           struct ArrowSchema *schema, struct ArrowArray *array) {
+    size_t tz_len = strlen(timezone);
+    char *format = malloc(4 + tz_len + 1);
+    export_array_t *priv = malloc(sizeof(export_array_t));
+
+    if (format == NULL || priv == NULL) {
+        free(format);
+        free(priv);
+        return false;
+    }
+    memcpy(format, "tsn:", 4);
+    memcpy(format + 4, timezone, tz_len + 1);
+
+    schema->format = format;
+    schema->name = "";
+    schema->metadata = NULL;
+    schema->flags = ARROW_FLAG_NULLABLE;
+    schema->n_children = 0;
+    schema->children = NULL;
+    schema->dictionary = NULL;
+    schema->release = release_schema;
+    schema->private_data = format;
+
+    priv->buffers[0] = col->validity;
+    priv->buffers[1] = col->values;
+    priv->on_release = on_release;
+    priv->ctx = ctx;
+    array->length = (int64_t)col->length;
+    array->null_count = (int64_t)mu_time_column_null_count(col);
+    array->offset = (int64_t)col->offset;
+    array->n_buffers = 2;
+    array->n_children = 0;
+    array->buffers = priv->buffers;
+    array->children = NULL;
+    array->dictionary = NULL;
+    array->release = release_array;
+    array->private_data = priv;
+    return true;
+}
+
+bool mu_time_column_import(mu_time_column_t *col,
+                           const struct ArrowSchema *schema,
+                           const struct ArrowArray *array) {
+    if (strncmp(schema->format, "tsn:", 4) != 0 || array->n_buffers != 2) {
+        return false;
+    }
+    col->validity = (array->null_count == 0) ? NULL
+                                              : (uint8_t *)array->buffers[0];
+    col->values = (int64_t *)array->buffers[1];
+    col->offset = (size_t)array->offset;
+    col->length = (size_t)array->length;
+    return true;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Build the output bitmap eight rows at a time.
+ *
+ * The comparison of each group is branch-free so the compiler can vectorize
+ * it; the validity bitmap is then applied a byte at a time.
+ */
+static size_t compare(const mu_time_column_t *col, int64_t lo, int64_t hi,
+                      cmp_t cmp, uint8_t *out) {
+    const int64_t *v = col->values + col->offset;
+    size_t set = 0;
+
+    for (size_t i = 0; i < col->length; i += 8) {
+        size_t n = (col->length - i < 8) ? col->length - i : 8;
+        uint8_t bits = 0;
+        if (n == 8) {
+            for (int j = 0; j < 8; j++) {
+                int64_t x = v[i + j];
+                int hit = (cmp == CMP_BEFORE)  ? x < lo
+                          : (cmp == CMP_AFTER) ? x > lo
+                                               : (x >= lo) & (x < hi);
+                bits |= (uint8_t)(hit << j);
+            }
+        } else {
+            for (size_t j = 0; j < n; j++) {
+                int64_t x = v[i + j];
+                int hit = (cmp == CMP_BEFORE)  ? x < lo
+                          : (cmp == CMP_AFTER) ? x > lo
+                                               : (x >= lo) & (x < hi);
+                bits |= (uint8_t)(hit << j);
+            }
+        }
+        if (col->validity != NULL) {
+            bits &= load_bits(col->validity, col->offset + i, n);
+        }
+        out[i >> 3] = bits;
+        set += (size_t)__builtin_popcount(bits);
+    }
+    return set;
+}
+
+/**
+ * @brief Read n <= 8 bits starting at any bit position; higher bits are 0.
+ */
+static uint8_t load_bits(const uint8_t *bitmap, size_t bit, size_t n) {
+    size_t byte = bit >> 3;
+    unsigned shift = bit & 7;
+    unsigned bits = bitmap[byte] >> shift;
+
+    if (shift + n > 8) {
+        bits |= (unsigned)bitmap[byte + 1] << (8 - shift);
+    }
+    return (uint8_t)(bits & ((1u << n) - 1));
+}
+
+static int64_t floor_seconds(int64_t nanos) {
+    int64_t s = nanos / NANOS_PER_SECOND;
+    return (nanos % NANOS_PER_SECOND < 0) ? s - 1 : s;
+}
+
+static void release_schema(struct ArrowSchema *schema) {
+    free(schema->private_data);
+    schema->release = NULL;
+}
+
+static void release_array(struct ArrowArray *array) {
+    export_array_t *priv = array->private_data;
+
+    if (priv->on_release != NULL) {
+        priv->on_release(priv->ctx);
+    }
+    free(priv);
+    array->release = NULL;
+}
+
+// *****************************************************************************
+// End of file
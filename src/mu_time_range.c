@@ -0,0 +1,323 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time_range.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool emit(mu_time_range_set_t *out, int64_t start, int64_t end);
+static size_t first_ending_after(const mu_time_range_set_t *set, int64_t t);
+static size_t first_ending_at(const mu_time_range_set_t *set, int64_t t);
+static size_t first_starting_at(const mu_time_range_set_t *set, int64_t t);
+static int compare_start(const void *a, const void *b);
+
+// *****************************************************************************
+// Public code
+
+void mu_time_range_set_init(mu_time_range_set_t *set, mu_time_range_t *storage,
+                            size_t capacity) {
+    set->ranges = storage;
+    set->count = 0;
+    set->capacity = capacity;
+}
+
+void mu_time_range_set_clear(mu_time_range_set_t *set) { set->count = 0; }
+
+size_t mu_time_range_set_count(const mu_time_range_set_t *set) {
+    return set->count;
+}
+
+const mu_time_range_t *
+mu_time_range_set_ranges(const mu_time_range_set_t *set) {
+    return set->ranges;
+}
+
+bool mu_time_range_set_add(mu_time_range_set_t *set, mu_time_abs_t start,
+                           mu_time_abs_t end) {
+    return mu_time_range_set_add_nanos(set, mu_time_posix_to_nanos(start),
+                                       mu_time_posix_to_nanos(end));
+}
+
+bool mu_time_range_set_add_nanos(mu_time_range_set_t *set, int64_t start,
+                                 int64_t end) {
+    mu_time_range_t *r = set->ranges;
+
+    if (start >= end) {
+        return true;
+    }
+    // Ranges [lo, hi) overlap or touch the new one and are replaced by it.
+    size_t lo = first_ending_at(set, start);
+    size_t hi = lo;
+    while (hi < set->count && r[hi].start <= end) {
+        hi++;
+    }
+    if (lo == hi && set->count == set->capacity) {
+        return false;
+    }
+    if (lo < hi) {
+        start = r[lo].start < start ? r[lo].start : start;
+        end = r[hi - 1].end > end ? r[hi - 1].end : end;
+    }
+    memmove(&r[lo + 1], &r[hi], (set->count - hi) * sizeof(*r));
+    set->count = set->count - (hi - lo) + 1;
+    r[lo].start = start;
+    r[lo].end = end;
+    return true;
+}
+
+bool mu_time_range_set_append(mu_time_range_set_t *set, int64_t start,
+                              int64_t end) {
+    if (set->count == set->capacity) {
+        return false;
+    }
+    set->ranges[set->count].start = start;
+    set->ranges[set->count].end = end;
+    set->count += 1;
+    return true;
+}
+
+void mu_time_range_set_normalize(mu_time_range_set_t *set) {
+    mu_time_range_t *r = set->ranges;
+    size_t n = 0;
+
+    qsort(r, set->count, sizeof(*r), compare_start);
+    for (size_t i = 0; i < set->count; i++) {
+        if (r[i].start >= r[i].end) {
+            continue;
+        } else if (n > 0 && r[i].start <= r[n - 1].end) {
+            if (r[i].end > r[n - 1].end) {
+                r[n - 1].end = r[i].end;
+            }
+        } else {
+            r[n++] = r[i];
+        }
+    }
+    set->count = n;
+}
+
+bool mu_time_range_set_contains(const mu_time_range_set_t *set,
+                                mu_time_abs_t t) {
+    int64_t ns = mu_time_posix_to_nanos(t);
+    size_t i = first_ending_after(set, ns);
+    return i < set->count && set->ranges[i].start <= ns;
+}
+
+bool mu_time_range_union(mu_time_range_set_t *out,
+                         const mu_time_range_set_t *a,
+                         const mu_time_range_set_t *b) {
+    const mu_time_range_t *ra = a->ranges, *rb = b->ranges;
+    size_t i = 0, j = 0;
+
+    out->count = 0;
+    while (i < a->count || j < b->count) {
+        // Take whichever range starts first; emit() coalesces.
+        bool take_a = j == b->count ||
+                      (i < a->count && ra[i].start <= rb[j].start);
+        const mu_time_range_t *r = take_a ? &ra[i++] : &rb[j++];
+        if (!emit(out, r->start, r->end)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool mu_time_range_intersection(mu_time_range_set_t *out,
+                                const mu_time_range_set_t *a,
+                                const mu_time_range_set_t *b) {
+    const mu_time_range_t *ra = a->ranges, *rb = b->ranges;
+    size_t i = 0, j = 0;
+
+    out->count = 0;
+    while (i < a->count && j < b->count) {
+        int64_t lo = ra[i].start > rb[j].start ? ra[i].start : rb[j].start;
+        int64_t hi = ra[i].end < rb[j].end ? ra[i].end : rb[j].end;
+        if (lo < hi && !emit(out, lo, hi)) {
+            return false;
+        }
+        // The range ending first cannot meet anything further on.
+        if (ra[i].end < rb[j].end) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    return true;
+}
+
+bool mu_time_range_difference(mu_time_range_set_t *out,
+                              const mu_time_range_set_t *a,
+                              const mu_time_range_set_t *b) {
+    const mu_time_range_t *ra = a->ranges, *rb = b->ranges;
+    size_t j = 0;
+
+    out->count = 0;
+    for (size_t i = 0; i < a->count; i++) {
+        int64_t cur = ra[i].start;
+        while (j < b->count && rb[j].end <= cur) {
+            j++;
+        }
+        // Cut out each b range overlapping this a range.  The last one may
+        // reach into the next a range, so it is kept.
+        while (j < b->count && rb[j].start < ra[i].end) {
+            if (rb[j].start > cur && !emit(out, cur, rb[j].start)) {
+                return false;
+            }
+            cur = rb[j].end;
+            if (cur >= ra[i].end) {
+                break;
+            }
+            j++;
+        }
+        if (cur < ra[i].end && !emit(out, cur, ra[i].end)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+mu_time_rel_t mu_time_range_set_coverage(const mu_time_range_set_t *set) {
+    const mu_time_range_t *r = set->ranges;
+    int64_t total = 0;
+
+    for (size_t i = 0; i < set->count; i++) {
+        total += r[i].end - r[i].start;
+    }
+    return total;
+}
+
+mu_time_rel_t mu_time_range_set_coverage_within(const mu_time_range_set_t *set,
+                                                mu_time_abs_t start,
+                                                mu_time_abs_t end) {
+    int64_t lo = mu_time_posix_to_nanos(start);
+    int64_t hi = mu_time_posix_to_nanos(end);
+    size_t first = first_ending_after(set, lo);
+    size_t last = first_starting_at(set, hi);
+    const mu_time_range_t *r = set->ranges;
+    int64_t total = 0;
+
+    // Only the first and last ranges can stick out of the window, but
+    // clipping all of them keeps the loop branch-free, so it vectorizes.
+    for (size_t i = first; i < last; i++) {
+        int64_t s = r[i].start > lo ? r[i].start : lo;
+        int64_t e = r[i].end < hi ? r[i].end : hi;
+        int64_t len = e - s;
+        total += len > 0 ? len : 0;
+    }
+    return total;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Append [start, end) to a set being built in order, coalescing it
+ * with the last range when they overlap or touch.
+ */
+static bool emit(mu_time_range_set_t *out, int64_t start, int64_t end) {
+    if (out->count > 0) {
+        mu_time_range_t *last = &out->ranges[out->count - 1];
+        if (start <= last->end) {
+            if (end > last->end) {
+                last->end = end;
+            }
+            return true;
+        }
+    }
+    if (out->count == out->capacity) {
+        return false;
+    }
+    out->ranges[out->count].start = start;
+    out->ranges[out->count].end = end;
+    out->count += 1;
+    return true;
+}
+
+/**
+ * @brief Return the index of the first range with end > t, or count.
+ */
+static size_t first_ending_after(const mu_time_range_set_t *set, int64_t t) {
+    size_t lo = 0, hi = set->count;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (set->ranges[mid].end > t) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief Return the index of the first range with end >= t, or count.
+ */
+static size_t first_ending_at(const mu_time_range_set_t *set, int64_t t) {
+    size_t lo = 0, hi = set->count;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (set->ranges[mid].end >= t) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief Return the index of the first range with start >= t, or count.
+ */
+static size_t first_starting_at(const mu_time_range_set_t *set, int64_t t) {
+    size_t lo = 0, hi = set->count;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (set->ranges[mid].start >= t) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+static int compare_start(const void *a, const void *b) {
+    int64_t sa = ((const mu_time_range_t *)a)->start;
+    int64_t sb = ((const mu_time_range_t *)b)->start;
+    return (sa > sb) - (sa < sb);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,56 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_timebase.h"
+#include <stdint.h>
+
+// *****************************************************************************
+// Public code
+
+void mu_timebase_map_init(mu_timebase_map_t *map, uint32_t src_hz,
+                          uint32_t dst_hz, uint64_t src_origin,
+                          uint64_t dst_origin) {
+    map->nominal_q32 = (((uint64_t)dst_hz << 32) + (src_hz / 2)) / src_hz;
+    map->scale_q32 = map->nominal_q32;
+    mu_timebase_map_set_origin(map, src_origin, dst_origin);
+}
+
+void mu_timebase_map_set_origin(mu_timebase_map_t *map, uint64_t src_origin,
+                                uint64_t dst_origin) {
+    map->src_origin = src_origin;
+    map->dst_origin = dst_origin;
+}
+
+void mu_timebase_map_set_drift_ppb(mu_timebase_map_t *map, int32_t drift_ppb) {
+    // A source running fast by drift_ppb covers (1 + drift) seconds of its own
+    // ticks per true second, so the scale shrinks by the same factor.
+    double scale = (double)map->nominal_q32 / (1.0 + (double)drift_ppb * 1e-9);
+    map->scale_q32 = (uint64_t)(scale + 0.5);
+}
+
+// *****************************************************************************
+// End of file
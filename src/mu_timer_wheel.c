@@ -0,0 +1,409 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_timer_wheel.h"
+#include "mu_duration_sketch.h"
+#include "mu_pool.h"
+#include "mu_time.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define SLOT_MASK (MU_TIMER_WHEEL_SLOTS - 1)
+
+// Largest tick distance representable by the wheel
+#define MAX_SPAN ((1ULL << (MU_TIMER_WHEEL_SLOT_BITS * MU_TIMER_WHEEL_LEVELS)) - 1)
+
+#define TIMER_PENDING 0x01
+#define TIMER_POOLED 0x02
+
+// Level of a due timer waiting on the wheel's firing list
+#define FIRING_LEVEL MU_TIMER_WHEEL_LEVELS
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static uint64_t deadline_to_tick(const mu_timer_wheel_t *wheel,
+                                 mu_time_abs_t deadline);
+static void enqueue(mu_timer_wheel_t *wheel, mu_timer_t *timer);
+static void unlink_timer(mu_timer_wheel_t *wheel, mu_timer_t *timer);
+static void cascade(mu_timer_wheel_t *wheel, int level, int slot);
+static void release(mu_timer_wheel_t *wheel, mu_timer_t *timer);
+static const mu_timer_t *earliest_in(const mu_timer_t *list,
+                                     const mu_timer_t *best);
+static void bump(atomic_uint_fast64_t *counter, int64_t n);
+static uint64_t load_counter(const atomic_uint_fast64_t *counter);
+
+// *****************************************************************************
+// Public code
+
+void mu_timer_wheel_init(mu_timer_wheel_t *wheel, mu_time_abs_t now,
+                         mu_time_rel_t resolution, mu_pool_t *pool) {
+    wheel->origin = now;
+    wheel->resolution = resolution;
+    wheel->next_tick = 1;
+    wheel->pending = 0;
+    wheel->pool = pool;
+    wheel->lag = NULL;
+    wheel->firing = NULL;
+    for (int l = 0; l < MU_TIMER_WHEEL_LEVELS; l++) {
+        for (int s = 0; s < MU_TIMER_WHEEL_SLOTS; s++) {
+            wheel->slots[l][s] = NULL;
+        }
+        atomic_init(&wheel->level_pending[l], 0);
+    }
+    atomic_init(&wheel->armed, 0);
+    atomic_init(&wheel->fired, 0);
+    atomic_init(&wheel->cancelled, 0);
+    atomic_init(&wheel->cascades, 0);
+    atomic_init(&wheel->cascaded, 0);
+}
+
+void mu_timer_init(mu_timer_t *timer, mu_timer_fn fn, void *arg) {
+    timer->next = NULL;
+    timer->prev = NULL;
+    timer->fn = fn;
+    timer->arg = arg;
+    timer->flags = 0;
+}
+
+void mu_timer_wheel_arm(mu_timer_wheel_t *wheel, mu_timer_t *timer,
+                        mu_time_abs_t deadline) {
+    if (timer->flags & TIMER_PENDING) {
+        unlink_timer(wheel, timer);
+    } else {
+        wheel->pending += 1;
+    }
+    timer->deadline = deadline;
+    timer->expires = deadline_to_tick(wheel, deadline);
+    timer->flags |= TIMER_PENDING;
+    enqueue(wheel, timer);
+    bump(&wheel->armed, 1);
+}
+
+mu_timer_t *mu_timer_wheel_schedule(mu_timer_wheel_t *wheel,
+                                    mu_time_abs_t deadline, mu_timer_fn fn,
+                                    void *arg) {
+    mu_timer_t *timer;
+
+    if (wheel->pool == NULL || (timer = mu_pool_alloc(wheel->pool)) == NULL) {
+        return NULL;
+    }
+    mu_timer_init(timer, fn, arg);
+    timer->flags = TIMER_POOLED;
+    mu_timer_wheel_arm(wheel, timer, deadline);
+    return timer;
+}
+
+bool mu_timer_wheel_cancel(mu_timer_wheel_t *wheel, mu_timer_t *timer) {
+    if (!(timer->flags & TIMER_PENDING)) {
+        return false;
+    }
+    unlink_timer(wheel, timer);
+    timer->flags &= ~TIMER_PENDING;
+    wheel->pending -= 1;
+    bump(&wheel->cancelled, 1);
+    release(wheel, timer);
+    return true;
+}
+
+bool mu_timer_is_pending(const mu_timer_t *timer) {
+    return (timer->flags & TIMER_PENDING) != 0;
+}
+
+mu_time_abs_t mu_timer_deadline(const mu_timer_t *timer) {
+    return timer->deadline;
+}
+
+size_t mu_timer_wheel_advance(mu_timer_wheel_t *wheel, mu_time_abs_t now) {
+    mu_time_rel_t elapsed = mu_time_difference(wheel->origin, now);
+    uint64_t target;
+    size_t fired = 0;
+
+    if (elapsed < 0) {
+        return 0;
+    }
+    target = (uint64_t)(elapsed / wheel->resolution);
+    if (wheel->pending == 0 && target >= wheel->next_tick) {
+        // nothing to fire or cascade: jump straight to the target
+        wheel->next_tick = target + 1;
+        return 0;
+    }
+
+    while (wheel->next_tick <= target) {
+        uint64_t tick = wheel->next_tick;
+        int index = (int)(tick & SLOT_MASK);
+        mu_timer_t *list;
+
+        // Entering a new block of level-0 slots: pull the matching slot of
+        // each higher level down, as far as the carry propagates.
+        for (int l = 1; index == 0 && l < MU_TIMER_WHEEL_LEVELS; l++) {
+            index = (int)((tick >> (l * MU_TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK);
+            cascade(wheel, l, index);
+        }
+
+        // Due timers move to the firing list, where cancel and re-arm from
+        // a callback can still unlink them.  Timers re-armed for this slot
+        // index (64 ticks on) stay in the slot for their own tick.
+        list = wheel->slots[0][tick & SLOT_MASK];
+        wheel->slots[0][tick & SLOT_MASK] = NULL;
+        if (list != NULL) {
+            int64_t n = 0;
+            for (mu_timer_t *t = list; t != NULL; t = t->next) {
+                t->level = FIRING_LEVEL;
+                n += 1;
+            }
+            bump(&wheel->level_pending[0], -n);
+            wheel->firing = list;
+        }
+        // Advance before firing so that timers re-armed in the past land on
+        // the next tick rather than in the slot being processed.
+        wheel->next_tick = tick + 1;
+
+        while (wheel->firing != NULL) {
+            mu_timer_t *timer = wheel->firing;
+            unlink_timer(wheel, timer);
+            timer->flags &= ~TIMER_PENDING;
+            wheel->pending -= 1;
+            bump(&wheel->fired, 1);
+            fired += 1;
+            if (wheel->lag != NULL) {
+                mu_duration_sketch_record(wheel->lag,
+                                          mu_time_difference(timer->deadline, now));
+            }
+            timer->fn(timer, timer->arg);
+            if (!(timer->flags & TIMER_PENDING)) {
+                release(wheel, timer);
+            }
+        }
+    }
+    return fired;
+}
+
+size_t mu_timer_wheel_pending(const mu_timer_wheel_t *wheel) {
+    return wheel->pending;
+}
+
+bool mu_timer_wheel_next_deadline(const mu_timer_wheel_t *wheel,
+                                  mu_time_abs_t *deadline) {
+    const mu_timer_t *best = NULL;
+
+    if (wheel->pending == 0) {
+        return false;
+    }
+    // Within a level, slots after the current one hold increasing ticks, so
+    // only the first occupied slot of each level can hold the earliest
+    // deadline.  The current slot comes first while it still awaits its
+    // cascade, otherwise last.  The top level also holds clamped, out-of-range
+    // timers and is searched in full.
+    for (int l = 0; l < MU_TIMER_WHEEL_LEVELS; l++) {
+        int shift = l * MU_TIMER_WHEEL_SLOT_BITS;
+        int start = (int)((wheel->next_tick >> shift) & SLOT_MASK);
+        int first = (wheel->next_tick & ((1ULL << shift) - 1)) == 0 ? 0 : 1;
+        bool top = (l == MU_TIMER_WHEEL_LEVELS - 1);
+        for (int i = first; i < first + MU_TIMER_WHEEL_SLOTS; i++) {
+            const mu_timer_t *list = wheel->slots[l][(start + i) & SLOT_MASK];
+            if (list != NULL) {
+                best = earliest_in(list, best);
+                if (!top) {
+                    break;
+                }
+            }
+        }
+    }
+    *deadline = best->deadline;
+    return true;
+}
+
+void mu_timer_wheel_set_lag_sketch(mu_timer_wheel_t *wheel,
+                                   mu_duration_sketch_t *lag) {
+    wheel->lag = lag;
+}
+
+void mu_timer_wheel_get_stats(const mu_timer_wheel_t *wheel,
+                              mu_timer_wheel_stats_t *stats) {
+    stats->armed = load_counter(&wheel->armed);
+    stats->fired = load_counter(&wheel->fired);
+    stats->cancelled = load_counter(&wheel->cancelled);
+    stats->cascades = load_counter(&wheel->cascades);
+    stats->cascaded = load_counter(&wheel->cascaded);
+    stats->pending = 0;
+    for (int l = 0; l < MU_TIMER_WHEEL_LEVELS; l++) {
+        stats->level_pending[l] = load_counter(&wheel->level_pending[l]);
+        stats->pending += stats->level_pending[l];
+    }
+}
+
+void mu_timer_wheel_stats_add(mu_timer_wheel_stats_t *dst,
+                              const mu_timer_wheel_stats_t *src) {
+    dst->armed += src->armed;
+    dst->fired += src->fired;
+    dst->cancelled += src->cancelled;
+    dst->cascades += src->cascades;
+    dst->cascaded += src->cascaded;
+    dst->pending += src->pending;
+    for (int l = 0; l < MU_TIMER_WHEEL_LEVELS; l++) {
+        dst->level_pending[l] += src->level_pending[l];
+    }
+}
+
+float mu_timer_wheel_stats_cancel_ratio(const mu_timer_wheel_stats_t *stats) {
+    uint64_t done = stats->fired + stats->cancelled;
+    return (done == 0) ? 0.0f : (float)stats->cancelled / (float)done;
+}
+
+void mu_timer_wheel_slot_occupancy(const mu_timer_wheel_t *wheel, int level,
+                                   uint32_t *counts) {
+    for (int s = 0; s < MU_TIMER_WHEEL_SLOTS; s++) {
+        uint32_t n = 0;
+        for (const mu_timer_t *t = wheel->slots[level][s]; t != NULL;
+             t = t->next) {
+            n += 1;
+        }
+        counts[s] = n;
+    }
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static uint64_t deadline_to_tick(const mu_timer_wheel_t *wheel,
+                                 mu_time_abs_t deadline) {
+    mu_time_rel_t elapsed = mu_time_difference(wheel->origin, deadline);
+    if (elapsed <= 0) {
+        return 0;
+    }
+    // round up so timers never fire early
+    return (uint64_t)((elapsed + wheel->resolution - 1) / wheel->resolution);
+}
+
+static void enqueue(mu_timer_wheel_t *wheel, mu_timer_t *timer) {
+    uint64_t expires = timer->expires;
+    uint64_t delta;
+    int level = 0;
+    int slot;
+    mu_timer_t **head;
+
+    if (expires < wheel->next_tick) {
+        expires = wheel->next_tick;
+    }
+    delta = expires - wheel->next_tick;
+    if (delta > MAX_SPAN) {
+        expires = wheel->next_tick + MAX_SPAN;
+        delta = MAX_SPAN;
+    }
+    while (level < MU_TIMER_WHEEL_LEVELS - 1 &&
+           delta >= (1ULL << ((level + 1) * MU_TIMER_WHEEL_SLOT_BITS))) {
+        level += 1;
+    }
+    slot = (int)((expires >> (level * MU_TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK);
+
+    head = &wheel->slots[level][slot];
+    bump(&wheel->level_pending[level], 1);
+    timer->level = (uint8_t)level;
+    timer->slot = (uint8_t)slot;
+    timer->prev = NULL;
+    timer->next = *head;
+    if (*head != NULL) {
+        (*head)->prev = timer;
+    }
+    *head = timer;
+}
+
+static void unlink_timer(mu_timer_wheel_t *wheel, mu_timer_t *timer) {
+    mu_timer_t **head = &wheel->firing;
+
+    if (timer->level != FIRING_LEVEL) {
+        bump(&wheel->level_pending[timer->level], -1);
+        head = &wheel->slots[timer->level][timer->slot];
+    }
+    if (timer->prev != NULL) {
+        timer->prev->next = timer->next;
+    } else {
+        *head = timer->next;
+    }
+    if (timer->next != NULL) {
+        timer->next->prev = timer->prev;
+    }
+    timer->next = NULL;
+    timer->prev = NULL;
+}
+
+static void cascade(mu_timer_wheel_t *wheel, int level, int slot) {
+    mu_timer_t *list = wheel->slots[level][slot];
+    int64_t n = 0;
+
+    if (list == NULL) {
+        return;
+    }
+    wheel->slots[level][slot] = NULL;
+    while (list != NULL) {
+        mu_timer_t *timer = list;
+        list = timer->next;
+        enqueue(wheel, timer);
+        n += 1;
+    }
+    bump(&wheel->level_pending[level], -n);
+    bump(&wheel->cascades, 1);
+    bump(&wheel->cascaded, n);
+}
+
+static void release(mu_timer_wheel_t *wheel, mu_timer_t *timer) {
+    if (timer->flags & TIMER_POOLED) {
+        timer->flags = 0;
+        mu_pool_free(wheel->pool, timer);
+    }
+}
+
+static const mu_timer_t *earliest_in(const mu_timer_t *list,
+                                     const mu_timer_t *best) {
+    for (; list != NULL; list = list->next) {
+        if (best == NULL || mu_time_is_before(list->deadline, best->deadline)) {
+            best = list;
+        }
+    }
+    return best;
+}
+
+static void bump(atomic_uint_fast64_t *counter, int64_t n) {
+    // Only the owner writes, so a plain load and store is enough: no locked
+    // read-modify-write on the hot path.
+    uint64_t v = atomic_load_explicit(counter, memory_order_relaxed);
+    atomic_store_explicit(counter, v + (uint64_t)n, memory_order_relaxed);
+}
+
+static uint64_t load_counter(const atomic_uint_fast64_t *counter) {
+    return atomic_load_explicit((atomic_uint_fast64_t *)counter,
+                                memory_order_relaxed);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,334 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_tso.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define SLOT_MAGIC 0x3130304f53544d55ULL // "UMTSO001"
+#define SLOT_SIZE 32
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+/**
+ * @brief One copy of the mark, stored little-endian.
+ */
+typedef struct {
+    uint64_t magic;
+    uint64_t seq;
+    uint64_t mark;
+    uint64_t check; ///< FNV-1a of the fields above
+} slot_t;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static uint64_t now_ts(void);
+static int open_mark_file(const char *path);
+static bool sync_parent(const char *path);
+static bool raise_mark(mu_tso_t *tso, uint64_t end);
+static bool read_slots(mu_tso_t *tso, uint64_t *mark);
+static bool write_slot(mu_tso_t *tso, uint64_t mark);
+static uint64_t slot_check(const uint8_t *buf);
+static void put_le64(uint8_t *p, uint64_t v);
+static uint64_t get_le64(const uint8_t *p);
+
+// *****************************************************************************
+// Public code
+
+bool mu_tso_open(mu_tso_t *tso, const char *path, mu_time_rel_t window) {
+    uint64_t mark = 0;
+
+    tso->window = window > 0 ? window : MU_TSO_DEFAULT_WINDOW;
+    tso->fd = -1;
+    tso->seq = 0;
+    atomic_init(&tso->persists, 0);
+    if (path != NULL) {
+        tso->fd = open_mark_file(path);
+        if (tso->fd < 0 || !read_slots(tso, &mark)) {
+            int saved = errno;
+            if (tso->fd >= 0) {
+                close(tso->fd);
+            }
+            errno = saved;
+            return false;
+        }
+    }
+    // Everything issued before a restart lies below the recovered mark
+    uint64_t now = now_ts();
+    atomic_init(&tso->next, now > mark ? now : mark);
+    atomic_init(&tso->limit, mark);
+    pthread_mutex_init(&tso->lock, NULL);
+    return true;
+}
+
+void mu_tso_close(mu_tso_t *tso) {
+    if (tso->fd >= 0) {
+        close(tso->fd);
+        tso->fd = -1;
+    }
+    pthread_mutex_destroy(&tso->lock);
+}
+
+bool mu_tso_alloc(mu_tso_t *tso, uint32_t count, uint64_t *first) {
+    uint64_t cur = atomic_load_explicit(&tso->next, memory_order_relaxed);
+    bool raised = false;
+
+    for (;;) {
+        uint64_t now = now_ts();
+        uint64_t limit = atomic_load_explicit(&tso->limit, memory_order_acquire);
+        uint64_t base = cur > now ? cur : now;
+        if (raised && base + count > limit) {
+            // The clock outran the window during the sync: stay as close to
+            // it as the mark allows rather than chase it with another sync
+            base = (limit - count > cur) ? limit - count : cur;
+        }
+        uint64_t end = base + count;
+        if (end > limit) {
+            if (!raise_mark(tso, end)) {
+                return false;
+            }
+            raised = true;
+            cur = atomic_load_explicit(&tso->next, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&tso->next, &cur, end,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            *first = base;
+            return true;
+        }
+    }
+}
+
+bool mu_tso_next(mu_tso_t *tso, uint64_t *ts) {
+    return mu_tso_alloc(tso, 1, ts);
+}
+
+void mu_tso_batch_init(mu_tso_batch_t *batch) {
+    batch->next = 0;
+    batch->end = 0;
+}
+
+bool mu_tso_batch_next(mu_tso_t *tso, mu_tso_batch_t *batch, uint32_t refill,
+                       uint64_t *ts) {
+    if (batch->next == batch->end) {
+        uint64_t first;
+        if (!mu_tso_alloc(tso, refill > 0 ? refill : 1, &first)) {
+            return false;
+        }
+        batch->next = first;
+        batch->end = first + (refill > 0 ? refill : 1);
+    }
+    *ts = batch->next++;
+    return true;
+}
+
+uint64_t mu_tso_high_water(mu_tso_t *tso) {
+    return atomic_load_explicit(&tso->limit, memory_order_acquire);
+}
+
+uint64_t mu_tso_persists(mu_tso_t *tso) {
+    return atomic_load_explicit(&tso->persists, memory_order_relaxed);
+}
+
+mu_time_abs_t mu_tso_to_time(uint64_t ts) {
+    return mu_time_posix_from_nanos((int64_t)ts);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static uint64_t now_ts(void) {
+    return (uint64_t)mu_time_posix_to_nanos(mu_time_now());
+}
+
+static bool raise_mark(mu_tso_t *tso, uint64_t end) {
+    bool ok = true;
+
+    pthread_mutex_lock(&tso->lock);
+    // Another thread may have raised it far enough while we waited
+    if (end > atomic_load_explicit(&tso->limit, memory_order_relaxed)) {
+        uint64_t mark = end + (uint64_t)tso->window;
+        ok = (tso->fd < 0) || write_slot(tso, mark);
+        if (ok) {
+            // Publish only once durable: nothing at or above the old mark is
+            // issued before this store
+            atomic_store_explicit(&tso->limit, mark, memory_order_release);
+            atomic_fetch_add_explicit(&tso->persists, 1, memory_order_relaxed);
+        }
+    }
+    pthread_mutex_unlock(&tso->lock);
+    return ok;
+}
+
+static bool read_slots(mu_tso_t *tso, uint64_t *mark) {
+    uint8_t buf[2 * SLOT_SIZE];
+    ssize_t n = pread(tso->fd, buf, sizeof(buf), 0);
+
+    bool found = false;
+
+    if (n < 0) {
+        return false;
+    }
+    *mark = 0;
+    for (int s = 0; s < 2 && (s + 1) * SLOT_SIZE <= n; s++) {
+        const uint8_t *p = buf + s * SLOT_SIZE;
+        if (get_le64(p) != SLOT_MAGIC || get_le64(p + 24) != slot_check(p)) {
+            continue; // never written, or torn
+        }
+        uint64_t seq = get_le64(p + 8);
+        if (seq >= tso->seq) {
+            tso->seq = seq;
+            *mark = get_le64(p + 16);
+        }
+        found = true;
+    }
+    if (n > 0 && !found) {
+        // Not ours, or damaged beyond both slots: a mark of 0 could reissue
+        // timestamps, so refuse rather than guess.
+        errno = EINVAL;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Open the mark file, creating it durably if absent.
+ *
+ * A new file's directory entry is synced before any mark is written to it,
+ * so a crash cannot lose the file after a mark in it was synced.
+ */
+static int open_mark_file(const char *path) {
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+
+    if (fd >= 0 || errno != ENOENT) {
+        return fd;
+    }
+    fd = open(path, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        // Lost a race with another creator: theirs is as good as ours.
+        return errno == EEXIST ? open(path, O_RDWR | O_CLOEXEC) : -1;
+    }
+    if (!sync_parent(path)) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief fsync() the directory holding path.
+ */
+static bool sync_parent(const char *path) {
+    char dir[PATH_MAX];
+    const char *slash = strrchr(path, '/');
+    size_t len = slash == NULL ? 0 : (size_t)(slash - path);
+
+    if (len >= sizeof(dir)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    if (slash == NULL) {
+        strcpy(dir, ".");
+    } else if (len == 0) {
+        strcpy(dir, "/");
+    } else {
+        memcpy(dir, path, len);
+        dir[len] = '\0';
+    }
+    int fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = fsync(fd) == 0;
+    int saved = errno;
+    close(fd);
+    errno = saved;
+    return ok;
+}
+
+static bool write_slot(mu_tso_t *tso, uint64_t mark) {
+    uint8_t buf[SLOT_SIZE];
+    uint64_t seq = tso->seq + 1;
+
+    put_le64(buf, SLOT_MAGIC);
+    put_le64(buf + 8, seq);
+    put_le64(buf + 16, mark);
+    put_le64(buf + 24, slot_check(buf));
+    // Alternate slots so the previous mark survives a torn write
+    off_t offset = (off_t)(seq & 1) * SLOT_SIZE;
+    ssize_t n = pwrite(tso->fd, buf, SLOT_SIZE, offset);
+    if (n != SLOT_SIZE) {
+        if (n >= 0) {
+            errno = EIO;
+        }
+        return false;
+    }
+    if (fdatasync(tso->fd) != 0) {
+        return false;
+    }
+    tso->seq = seq;
+    return true;
+}
+
+static uint64_t slot_check(const uint8_t *buf) {
+    uint64_t h = FNV_OFFSET;
+    for (int i = 0; i < 24; i++) {
+        h = (h ^ buf[i]) * FNV_PRIME;
+    }
+    return h;
+}
+
+static void put_le64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint64_t get_le64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,190 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_uring_time.h"
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define NANOS_PER_SECOND 1000000000LL
+
+// Deadlines ride on the clock behind mu_time_now().  An update keeps the
+// clock of the timeout it moves and accepts only the ABS flag.
+#define ABS_FLAGS (IORING_TIMEOUT_ABS | IORING_TIMEOUT_REALTIME)
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static void prep_rw(struct io_uring_sqe *sqe, int op, uint64_t addr,
+                    uint32_t len, uint64_t user_data);
+static mu_time_abs_t kernel_deadline(const mu_timer_wheel_t *wheel,
+                                     mu_time_abs_t deadline);
+
+// *****************************************************************************
+// Public code
+
+void mu_uring_timespec(struct __kernel_timespec *ts, mu_time_abs_t deadline) {
+    int64_t nanos = mu_time_posix_to_nanos(deadline);
+    int64_t seconds = nanos / NANOS_PER_SECOND;
+    int64_t rem = nanos % NANOS_PER_SECOND;
+    if (rem < 0) {
+        rem += NANOS_PER_SECOND;
+        seconds -= 1;
+    }
+    ts->tv_sec = seconds;
+    ts->tv_nsec = rem;
+}
+
+void mu_uring_prep_timeout(struct io_uring_sqe *sqe,
+                           struct __kernel_timespec *ts, mu_time_abs_t deadline,
+                           unsigned count, uint64_t user_data) {
+    mu_uring_timespec(ts, deadline);
+    prep_rw(sqe, IORING_OP_TIMEOUT, (uint64_t)(uintptr_t)ts, 1, user_data);
+    sqe->off = count;
+    sqe->timeout_flags = ABS_FLAGS;
+}
+
+void mu_uring_prep_link_timeout(struct io_uring_sqe *sqe,
+                                struct __kernel_timespec *ts,
+                                mu_time_abs_t deadline, uint64_t user_data) {
+    mu_uring_timespec(ts, deadline);
+    prep_rw(sqe, IORING_OP_LINK_TIMEOUT, (uint64_t)(uintptr_t)ts, 1,
+            user_data);
+    sqe->timeout_flags = ABS_FLAGS;
+}
+
+void mu_uring_prep_timeout_update(struct io_uring_sqe *sqe,
+                                  struct __kernel_timespec *ts, uint64_t target,
+                                  mu_time_abs_t deadline, uint64_t user_data) {
+    mu_uring_timespec(ts, deadline);
+    prep_rw(sqe, IORING_OP_TIMEOUT_REMOVE, target, 0, user_data);
+    sqe->addr2 = (uint64_t)(uintptr_t)ts;
+    sqe->timeout_flags = IORING_TIMEOUT_UPDATE | IORING_TIMEOUT_ABS;
+}
+
+void mu_uring_prep_timeout_remove(struct io_uring_sqe *sqe, uint64_t target,
+                                  uint64_t user_data) {
+    prep_rw(sqe, IORING_OP_TIMEOUT_REMOVE, target, 0, user_data);
+}
+
+void mu_uring_timers_init(mu_uring_timers_t *t, mu_time_abs_t now,
+                          mu_time_rel_t resolution, mu_time_rel_t slack,
+                          mu_pool_t *pool, uint64_t user_data) {
+    memset(t, 0, sizeof(*t));
+    mu_timer_wheel_init(&t->wheel, now, resolution, pool);
+    t->slack = slack;
+    t->user_data = user_data;
+}
+
+mu_timer_wheel_t *mu_uring_timers_wheel(mu_uring_timers_t *t) {
+    return &t->wheel;
+}
+
+bool mu_uring_timers_needs_sqe(const mu_uring_timers_t *t) {
+    mu_time_abs_t next;
+
+    if (!mu_timer_wheel_next_deadline(&t->wheel, &next)) {
+        // A stale kernel timeout is left to expire; its CQE fires nothing.
+        return false;
+    }
+    if (!t->armed) {
+        return true;
+    }
+    next = kernel_deadline(&t->wheel, next);
+    return mu_time_difference(next, t->armed_at) > t->slack;
+}
+
+void mu_uring_timers_prep(mu_uring_timers_t *t, struct io_uring_sqe *sqe) {
+    mu_time_abs_t next;
+
+    mu_timer_wheel_next_deadline(&t->wheel, &next);
+    t->armed_at = kernel_deadline(&t->wheel, next);
+    if (t->armed) {
+        // Deadlines are arriving earlier than the armed one: wake exactly on
+        // time, which leaves the whole slack to absorb the next earlier one.
+        mu_uring_prep_timeout_update(sqe, &t->ts, t->user_data, t->armed_at,
+                                     t->user_data + 1);
+        t->kernel_updates += 1;
+    } else {
+        // Wake as late as allowed, so one expiry serves every deadline within
+        // the slack of the earliest.
+        t->armed_at = mu_time_offset(t->armed_at, t->slack);
+        mu_uring_prep_timeout(sqe, &t->ts, t->armed_at, 0, t->user_data);
+        t->armed = true;
+        t->kernel_arms += 1;
+    }
+}
+
+int mu_uring_timers_complete(mu_uring_timers_t *t, uint64_t user_data,
+                             int32_t res, mu_time_abs_t now) {
+    if (user_data == t->user_data + 1) {
+        // The update's own CQE.  -ENOENT means the timeout had already
+        // fired; its -ETIME completion follows or has been seen.
+        return 0;
+    } else if (user_data != t->user_data) {
+        return -1;
+    }
+    if (res == -ETIME || res == -ECANCELED || res == 0) {
+        t->armed = false;
+    }
+    return (int)mu_timer_wheel_advance(&t->wheel, now);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void prep_rw(struct io_uring_sqe *sqe, int op, uint64_t addr,
+                    uint32_t len, uint64_t user_data) {
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = (uint8_t)op;
+    sqe->fd = -1;
+    sqe->addr = addr;
+    sqe->len = len;
+    sqe->user_data = user_data;
+}
+
+static mu_time_abs_t kernel_deadline(const mu_timer_wheel_t *wheel,
+                                     mu_time_abs_t deadline) {
+    // The wheel fires a timer on the first tick boundary at or after its
+    // deadline, so waking any earlier would find nothing to do.
+    mu_time_rel_t elapsed = mu_time_difference(wheel->origin, deadline);
+    if (elapsed <= 0) {
+        return wheel->origin;
+    }
+    mu_time_rel_t ticks = (elapsed + wheel->resolution - 1) / wheel->resolution;
+    return mu_time_offset(wheel->origin, ticks * wheel->resolution);
+}
+
+#endif /* #if defined(__linux__) */
+
+// *****************************************************************************
+// End of file
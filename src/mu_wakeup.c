@@ -0,0 +1,197 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_wakeup.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_wakeup_registry_t s_default;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool earlier(const mu_wakeup_source_t *a, const mu_wakeup_source_t *b);
+static void place(mu_wakeup_registry_t *reg, size_t i,
+                  mu_wakeup_source_t *src);
+static void sift_up(mu_wakeup_registry_t *reg, size_t i);
+static void sift_down(mu_wakeup_registry_t *reg, size_t i);
+
+// *****************************************************************************
+// Public code
+
+void mu_wakeup_init(mu_wakeup_registry_t *reg) {
+    reg->count = 0;
+}
+
+void mu_wakeup_source_init(mu_wakeup_source_t *src, const char *name) {
+    src->name = name;
+    src->index = -1;
+}
+
+bool mu_wakeup_report(mu_wakeup_registry_t *reg, mu_wakeup_source_t *src,
+                      mu_time_abs_t deadline) {
+    if (src->index < 0) {
+        if (reg->count >= MU_WAKEUP_CAPACITY) {
+            return false;
+        }
+        src->deadline = deadline;
+        place(reg, reg->count++, src);
+        sift_up(reg, (size_t)src->index);
+    } else if (mu_time_is_before(deadline, src->deadline)) {
+        src->deadline = deadline;
+        sift_up(reg, (size_t)src->index);
+    } else {
+        src->deadline = deadline;
+        sift_down(reg, (size_t)src->index);
+    }
+    return true;
+}
+
+void mu_wakeup_clear(mu_wakeup_registry_t *reg, mu_wakeup_source_t *src) {
+    if (src->index < 0) {
+        return;
+    }
+    size_t i = (size_t)src->index;
+    mu_wakeup_source_t *last = reg->heap[--reg->count];
+    src->index = -1;
+    if (last != src) {
+        // The last leaf may belong above or below the hole
+        place(reg, i, last);
+        sift_up(reg, i);
+        sift_down(reg, (size_t)last->index);
+    }
+}
+
+bool mu_wakeup_report_wheel(mu_wakeup_registry_t *reg, mu_wakeup_source_t *src,
+                            const mu_timer_wheel_t *wheel) {
+    mu_time_abs_t deadline;
+
+    if (!mu_timer_wheel_next_deadline(wheel, &deadline)) {
+        mu_wakeup_clear(reg, src);
+        return true;
+    }
+    return mu_wakeup_report(reg, src, deadline);
+}
+
+bool mu_wakeup_report_calendar(mu_wakeup_registry_t *reg,
+                               mu_wakeup_source_t *src,
+                               mu_calendar_queue_t *q) {
+    mu_calendar_event_t *ev = mu_calendar_queue_peek(q);
+
+    if (ev == NULL) {
+        mu_wakeup_clear(reg, src);
+        return true;
+    }
+    return mu_wakeup_report(reg, src, mu_calendar_queue_event_time(q, ev));
+}
+
+bool mu_wakeup_source_is_set(const mu_wakeup_source_t *src) {
+    return src->index >= 0;
+}
+
+bool mu_wakeup_next(const mu_wakeup_registry_t *reg, mu_time_abs_t *deadline) {
+    if (reg->count == 0) {
+        return false;
+    }
+    *deadline = reg->heap[0]->deadline;
+    return true;
+}
+
+mu_wakeup_source_t *mu_wakeup_next_source(const mu_wakeup_registry_t *reg) {
+    return reg->count == 0 ? NULL : reg->heap[0];
+}
+
+mu_time_rel_t mu_wakeup_idle_for(const mu_wakeup_registry_t *reg,
+                                 mu_time_abs_t now) {
+    if (reg->count == 0) {
+        return mu_time_rel_max();
+    }
+    mu_time_rel_t idle = mu_time_difference(now, reg->heap[0]->deadline);
+    return idle > 0 ? idle : 0;
+}
+
+mu_wakeup_registry_t *mu_wakeup_default(void) {
+    return &s_default;
+}
+
+bool mu_time_next_wakeup(mu_time_abs_t *deadline) {
+    return mu_wakeup_next(&s_default, deadline);
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool earlier(const mu_wakeup_source_t *a, const mu_wakeup_source_t *b) {
+    return mu_time_is_before(a->deadline, b->deadline);
+}
+
+static void place(mu_wakeup_registry_t *reg, size_t i,
+                  mu_wakeup_source_t *src) {
+    reg->heap[i] = src;
+    src->index = (int16_t)i;
+}
+
+static void sift_up(mu_wakeup_registry_t *reg, size_t i) {
+    mu_wakeup_source_t *src = reg->heap[i];
+
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!earlier(src, reg->heap[parent])) {
+            break;
+        }
+        place(reg, i, reg->heap[parent]);
+        i = parent;
+    }
+    place(reg, i, src);
+}
+
+static void sift_down(mu_wakeup_registry_t *reg, size_t i) {
+    mu_wakeup_source_t *src = reg->heap[i];
+
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= reg->count) {
+            break;
+        }
+        if (child + 1 < reg->count &&
+            earlier(reg->heap[child + 1], reg->heap[child])) {
+            child += 1;
+        }
+        if (!earlier(reg->heap[child], src)) {
+            break;
+        }
+        place(reg, i, reg->heap[child]);
+        i = child;
+    }
+    place(reg, i, src);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,162 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_wallclock.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+// *****************************************************************************
+// Private types and definitions
+
+#define BRACKET_READS 3
+
+// *****************************************************************************
+// Private (forward) declarations
+
+#if defined(__linux__)
+static void arm_step_fd(int fd);
+#endif
+
+// *****************************************************************************
+// Public code
+
+mu_time_abs_t mu_wallclock_mono_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (mu_time_abs_t){.seconds = ts.tv_sec, .nanoseconds = ts.tv_nsec};
+}
+
+void mu_wallclock_init(mu_wallclock_t *wc, mu_time_rel_t period,
+                       mu_time_rel_t step_threshold) {
+    wc->period = period > 0 ? period : MU_WALLCLOCK_DEFAULT_PERIOD;
+    wc->step_threshold =
+        step_threshold > 0 ? step_threshold : MU_WALLCLOCK_DEFAULT_STEP_THRESHOLD;
+    wc->refreshes = 0;
+    atomic_init(&wc->offset, 0);
+    atomic_init(&wc->steps, 0);
+    mu_wallclock_refresh(wc);
+    // The first reading establishes the offset; it is not a step
+    atomic_store_explicit(&wc->steps, 0, memory_order_relaxed);
+}
+
+mu_time_abs_t mu_wallclock_to_wall(const mu_wallclock_t *wc,
+                                   mu_time_abs_t mono) {
+    return mu_time_offset(mono, mu_wallclock_offset(wc));
+}
+
+mu_time_abs_t mu_wallclock_now(const mu_wallclock_t *wc) {
+    return mu_wallclock_to_wall(wc, mu_wallclock_mono_now());
+}
+
+bool mu_wallclock_poll(mu_wallclock_t *wc, mu_time_abs_t mono) {
+    if (mu_time_is_before(mono, wc->next_refresh)) {
+        return false;
+    }
+    return mu_wallclock_refresh(wc);
+}
+
+bool mu_wallclock_refresh(mu_wallclock_t *wc) {
+    mu_time_abs_t best_mono = {0, 0}, best_wall = {0, 0};
+    mu_time_rel_t best_gap = mu_time_rel_max();
+
+    for (int i = 0; i < BRACKET_READS; i++) {
+        mu_time_abs_t before = mu_wallclock_mono_now();
+        mu_time_abs_t wall = mu_time_now();
+        mu_time_abs_t after = mu_wallclock_mono_now();
+        mu_time_rel_t gap = mu_time_difference(before, after);
+        if (gap < best_gap) {
+            best_gap = gap;
+            best_mono = mu_time_offset(before, gap / 2);
+            best_wall = wall;
+        }
+    }
+    return mu_wallclock_set(wc, best_mono, best_wall);
+}
+
+bool mu_wallclock_set(mu_wallclock_t *wc, mu_time_abs_t mono,
+                      mu_time_abs_t wall) {
+    mu_time_rel_t offset = mu_time_difference(mono, wall);
+    mu_time_rel_t change = offset - mu_wallclock_offset(wc);
+    bool step = (change > wc->step_threshold || change < -wc->step_threshold);
+
+    atomic_store_explicit(&wc->offset, offset, memory_order_relaxed);
+    if (step) {
+        atomic_fetch_add_explicit(&wc->steps, 1, memory_order_relaxed);
+    }
+    wc->refreshes += 1;
+    wc->next_refresh = mu_time_offset(mono, wc->period);
+    return step;
+}
+
+mu_time_rel_t mu_wallclock_offset(const mu_wallclock_t *wc) {
+    return atomic_load_explicit(&wc->offset, memory_order_relaxed);
+}
+
+uint32_t mu_wallclock_steps(const mu_wallclock_t *wc) {
+    return (uint32_t)atomic_load_explicit(&wc->steps, memory_order_relaxed);
+}
+
+#if defined(__linux__)
+int mu_wallclock_step_fd(void) {
+    int fd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd >= 0) {
+        arm_step_fd(fd);
+    }
+    return fd;
+}
+
+bool mu_wallclock_handle_step_fd(mu_wallclock_t *wc, int fd) {
+    uint64_t expirations;
+
+    // A cancelled read (ECANCELED) is the notification; either way re-arm
+    (void)!read(fd, &expirations, sizeof(expirations));
+    arm_step_fd(fd);
+    return mu_wallclock_refresh(wc);
+}
+#endif
+
+// *****************************************************************************
+// Private (static) code
+
+#if defined(__linux__)
+static void arm_step_fd(int fd) {
+    // An absolute expiry that never comes: only a clock set wakes the fd
+    struct itimerspec never = {{0, 0}, {(time_t)1 << 33, 0}};
+    timerfd_settime(fd, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &never,
+                    NULL);
+}
+#endif
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,237 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_wfq.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define ARITY 4
+#define ESTIMATE_SHIFT 3 // average over the last ~8 jobs
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static bool tag_before(uint64_t a, uint64_t b);
+static void advance(mu_wfq_tenant_t *t, mu_time_rel_t service);
+static void heap_insert(mu_wfq_t *s, mu_wfq_tenant_t *t);
+static void heap_remove(mu_wfq_t *s, size_t i);
+static void heap_rekey(mu_wfq_t *s, mu_wfq_tenant_t *t);
+static void place(mu_wfq_t *s, size_t i, mu_wfq_slot_t slot);
+static void sift_up(mu_wfq_t *s, size_t i);
+static void sift_down(mu_wfq_t *s, size_t i);
+
+// *****************************************************************************
+// Public code
+
+void mu_wfq_init(mu_wfq_t *s, mu_wfq_slot_t *heap, size_t capacity) {
+    s->heap = heap;
+    s->capacity = capacity;
+    s->count = 0;
+    s->vtime = 0;
+}
+
+void mu_wfq_tenant_init(mu_wfq_tenant_t *t, uint32_t weight,
+                        mu_time_rel_t estimate) {
+    t->head = NULL;
+    t->tail = NULL;
+    t->tag = 0;
+    t->estimate = estimate;
+    t->served = 0;
+    t->weight = weight > 0 ? weight : 1;
+    t->queued = 0;
+    t->running = 0;
+    t->index = -1;
+}
+
+void mu_wfq_set_weight(mu_wfq_tenant_t *t, uint32_t weight) {
+    t->weight = weight > 0 ? weight : 1;
+}
+
+bool mu_wfq_enqueue(mu_wfq_t *s, mu_wfq_tenant_t *t, mu_wfq_job_t *job) {
+    if (t->index < 0) {
+        if (s->count >= s->capacity) {
+            return false;
+        }
+        // Newly backlogged: no credit for time spent idle
+        if (tag_before(t->tag, s->vtime)) {
+            t->tag = s->vtime;
+        }
+        heap_insert(s, t);
+    }
+    job->next = NULL;
+    job->tenant = t;
+    if (t->tail == NULL) {
+        t->head = job;
+    } else {
+        t->tail->next = job;
+    }
+    t->tail = job;
+    t->queued += 1;
+    return true;
+}
+
+mu_wfq_job_t *mu_wfq_next(mu_wfq_t *s) {
+    if (s->count == 0) {
+        return NULL;
+    }
+    mu_wfq_tenant_t *t = s->heap[0].tenant;
+    mu_wfq_job_t *job = t->head;
+
+    if (tag_before(s->vtime, t->tag)) {
+        s->vtime = t->tag;
+    }
+    t->head = job->next;
+    if (t->head == NULL) {
+        t->tail = NULL;
+    }
+    t->queued -= 1;
+    t->running += 1;
+    job->charged = t->estimate;
+    advance(t, job->charged);
+    if (t->queued == 0) {
+        heap_remove(s, 0);
+    } else {
+        heap_rekey(s, t);
+    }
+    return job;
+}
+
+void mu_wfq_complete(mu_wfq_t *s, mu_wfq_job_t *job, mu_time_rel_t service) {
+    mu_wfq_tenant_t *t = job->tenant;
+
+    t->running -= 1;
+    t->served += service;
+    t->estimate += (service - t->estimate) / (1 << ESTIMATE_SHIFT);
+    advance(t, service - job->charged);
+    if (t->index >= 0) {
+        heap_rekey(s, t);
+    }
+}
+
+mu_wfq_tenant_t *mu_wfq_job_tenant(const mu_wfq_job_t *job) {
+    return job->tenant;
+}
+
+size_t mu_wfq_backlogged(const mu_wfq_t *s) {
+    return s->count;
+}
+
+mu_time_rel_t mu_wfq_served(const mu_wfq_tenant_t *t) {
+    return t->served;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool tag_before(uint64_t a, uint64_t b) {
+    // Tags only ever move forward, so compare them modulo 2^64
+    return (int64_t)(a - b) < 0;
+}
+
+static void advance(mu_wfq_tenant_t *t, mu_time_rel_t service) {
+    int64_t delta = (int64_t)service * MU_WFQ_WEIGHT_ONE / (int64_t)t->weight;
+    t->tag += (uint64_t)delta;
+}
+
+static void heap_insert(mu_wfq_t *s, mu_wfq_tenant_t *t) {
+    size_t i = s->count++;
+    place(s, i, (mu_wfq_slot_t){t->tag, t});
+    sift_up(s, i);
+}
+
+static void heap_remove(mu_wfq_t *s, size_t i) {
+    mu_wfq_slot_t last = s->heap[--s->count];
+
+    s->heap[i].tenant->index = -1;
+    if (i < s->count) {
+        place(s, i, last);
+        sift_up(s, i);
+        sift_down(s, (size_t)last.tenant->index);
+    }
+}
+
+static void heap_rekey(mu_wfq_t *s, mu_wfq_tenant_t *t) {
+    size_t i = (size_t)t->index;
+    uint64_t old = s->heap[i].tag;
+
+    s->heap[i].tag = t->tag;
+    if (tag_before(t->tag, old)) {
+        sift_up(s, i);
+    } else {
+        sift_down(s, i);
+    }
+}
+
+static void place(mu_wfq_t *s, size_t i, mu_wfq_slot_t slot) {
+    s->heap[i] = slot;
+    slot.tenant->index = (int32_t)i;
+}
+
+static void sift_up(mu_wfq_t *s, size_t i) {
+    mu_wfq_slot_t slot = s->heap[i];
+
+    while (i > 0) {
+        size_t parent = (i - 1) / ARITY;
+        if (!tag_before(slot.tag, s->heap[parent].tag)) {
+            break;
+        }
+        place(s, i, s->heap[parent]);
+        i = parent;
+    }
+    place(s, i, slot);
+}
+
+static void sift_down(mu_wfq_t *s, size_t i) {
+    mu_wfq_slot_t slot = s->heap[i];
+
+    for (;;) {
+        size_t first = ARITY * i + 1;
+        if (first >= s->count) {
+            break;
+        }
+        size_t last = first + ARITY < s->count ? first + ARITY : s->count;
+        size_t best = first;
+        for (size_t c = first + 1; c < last; c++) {
+            if (tag_before(s->heap[c].tag, s->heap[best].tag)) {
+                best = c;
+            }
+        }
+        if (!tag_before(s->heap[best].tag, slot.tag)) {
+            break;
+        }
+        place(s, i, s->heap[best]);
+        i = best;
+    }
+    place(s, i, slot);
+}
+
+// *****************************************************************************
+// End of file
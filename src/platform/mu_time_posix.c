@@ -52,10 +52,13 @@ mu_time_abs_t mu_time_offset(mu_time_abs_t base, mu_time_rel_t delta) {
     result.seconds = base.seconds + (delta / 1000000000);
     result.nanoseconds = base.nanoseconds + (delta % 1000000000);
 
-    // Handle nanosecond overflow
+    // Handle nanosecond overflow and underflow (negative delta)
     if (result.nanoseconds >= 1000000000) {
         result.seconds += 1;
         result.nanoseconds -= 1000000000;
+    } else if (result.nanoseconds < 0) {
+        result.seconds -= 1;
+        result.nanoseconds += 1000000000;
     }
 
     return result;
@@ -81,12 +84,30 @@ float mu_time_rel_to_seconds(mu_time_rel_t delta_t) {
     return (float)delta_t / 1000000000.0f;
 }
 
-mu_time_rel_t mu_time_rel_from_millis(uint32_t milliseconds) {
-    return (mu_time_rel_t)(milliseconds * 1000000);
+mu_time_rel_t mu_time_rel_from_millis(int32_t milliseconds) {
+    return (mu_time_rel_t)milliseconds * 1000000;
 }
 
-uint32_t mu_time_rel_to_millis(mu_time_rel_t delta_t) {
-    return (uint32_t)(delta_t / 1000000);
+int32_t mu_time_rel_to_millis(mu_time_rel_t delta_t) {
+    return (int32_t)(delta_t / 1000000);
+}
+
+int64_t mu_time_posix_to_nanos(mu_time_abs_t t) {
+    return ((int64_t)t.seconds * 1000000000) + t.nanoseconds;
+}
+
+mu_time_abs_t mu_time_posix_from_nanos(int64_t nanos) {
+    mu_time_abs_t result;
+    result.seconds = (time_t)(nanos / 1000000000);
+    result.nanoseconds = (long)(nanos % 1000000000);
+
+    // Keep nanoseconds in [0, 1e9) for times before the epoch
+    if (result.nanoseconds < 0) {
+        result.seconds -= 1;
+        result.nanoseconds += 1000000000;
+    }
+
+    return result;
 }
 
 // *****************************************************************************
@@ -0,0 +1,244 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_calendar_queue.c
+ * @brief Hold-model benchmark: mu_calendar_queue versus a binary heap.
+ *
+ * Each hold operation dequeues the earliest event and re-enqueues it at that
+ * time plus a random increment, keeping the queue size constant.  This is the
+ * standard workload for simulation event sets (Jones 1986, Brown 1988).
+ *
+ * Build and run with `make bench` in the test directory.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_calendar_queue.h"
+#include "mu_time.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_HOLDS 2000000
+#define N_WARMUP 1000000
+#define MEAN_INCREMENT 1e9 // 1 second, in nSec
+
+typedef enum {
+    DIST_EXPONENTIAL,
+    DIST_UNIFORM,
+    DIST_BIMODAL,
+    DIST_TRIANGULAR,
+} dist_t;
+
+typedef struct {
+    mu_calendar_event_t event;
+    int64_t time;
+} item_t;
+
+typedef struct {
+    item_t **nodes;
+    size_t count;
+} heap_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static const char *s_dist_names[] = {"exponential", "uniform[0,2]",
+                                     "bimodal", "triangular"};
+static const size_t s_sizes[] = {100, 1000, 10000, 100000, 1000000};
+static uint64_t s_seed = 88172645463325252ULL;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static double bench_calendar(item_t *items, size_t n, dist_t dist,
+                             size_t *buckets, mu_time_rel_t *width);
+static double bench_heap(item_t *items, size_t n, dist_t dist);
+static void heap_push(heap_t *h, item_t *item);
+static item_t *heap_pop(heap_t *h);
+static int64_t increment(dist_t dist);
+static double uniform01(void);
+static int64_t now_nanos(void);
+
+// *****************************************************************************
+// Public code
+
+int main(void) {
+    size_t max_n = s_sizes[sizeof(s_sizes) / sizeof(s_sizes[0]) - 1];
+    item_t *items = malloc(max_n * sizeof(item_t));
+
+    printf("%-14s %9s %12s %12s %8s %10s\n", "increments", "size",
+           "calendar ns", "heap ns", "buckets", "width ns");
+    for (int d = 0; d <= DIST_TRIANGULAR; d++) {
+        for (size_t s = 0; s < sizeof(s_sizes) / sizeof(s_sizes[0]); s++) {
+            size_t n = s_sizes[s];
+            size_t buckets;
+            mu_time_rel_t width;
+            double cq = bench_calendar(items, n, (dist_t)d, &buckets, &width);
+            double bh = bench_heap(items, n, (dist_t)d);
+            printf("%-14s %9zu %12.1f %12.1f %8zu %10lld\n", s_dist_names[d],
+                   n, cq, bh, buckets, (long long)width);
+        }
+    }
+    free(items);
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static double bench_calendar(item_t *items, size_t n, dist_t dist,
+                             size_t *buckets, mu_time_rel_t *width) {
+    mu_calendar_queue_t q;
+    size_t capacity = n;
+    mu_calendar_event_t **storage = malloc(capacity * sizeof(*storage));
+    mu_time_abs_t origin = mu_time_now();
+
+    mu_calendar_queue_init(&q, storage, capacity, origin, 0);
+    for (size_t i = 0; i < n; i++) {
+        mu_calendar_queue_enqueue(&q, &items[i].event,
+                                  mu_time_offset(origin, increment(dist)));
+    }
+    for (int i = 0; i < N_WARMUP; i++) {
+        mu_calendar_event_t *ev = mu_calendar_queue_dequeue(&q);
+        mu_time_abs_t t = mu_calendar_queue_event_time(&q, ev);
+        mu_calendar_queue_enqueue(&q, ev, mu_time_offset(t, increment(dist)));
+    }
+    int64_t start = now_nanos();
+    for (int i = 0; i < N_HOLDS; i++) {
+        mu_calendar_event_t *ev = mu_calendar_queue_dequeue(&q);
+        mu_time_abs_t t = mu_calendar_queue_event_time(&q, ev);
+        mu_calendar_queue_enqueue(&q, ev, mu_time_offset(t, increment(dist)));
+    }
+    int64_t elapsed = now_nanos() - start;
+    *buckets = mu_calendar_queue_buckets(&q);
+    *width = mu_calendar_queue_width(&q);
+    free(storage);
+    return (double)elapsed / N_HOLDS;
+}
+
+static double bench_heap(item_t *items, size_t n, dist_t dist) {
+    heap_t h = {malloc(n * sizeof(item_t *)), 0};
+
+    for (size_t i = 0; i < n; i++) {
+        items[i].time = increment(dist);
+        heap_push(&h, &items[i]);
+    }
+    for (int i = 0; i < N_WARMUP; i++) {
+        item_t *item = heap_pop(&h);
+        item->time += increment(dist);
+        heap_push(&h, item);
+    }
+    int64_t start = now_nanos();
+    for (int i = 0; i < N_HOLDS; i++) {
+        item_t *item = heap_pop(&h);
+        item->time += increment(dist);
+        heap_push(&h, item);
+    }
+    int64_t elapsed = now_nanos() - start;
+    free(h.nodes);
+    return (double)elapsed / N_HOLDS;
+}
+
+static void heap_push(heap_t *h, item_t *item) {
+    size_t i = h->count++;
+
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (h->nodes[parent]->time <= item->time) {
+            break;
+        }
+        h->nodes[i] = h->nodes[parent];
+        i = parent;
+    }
+    h->nodes[i] = item;
+}
+
+static item_t *heap_pop(heap_t *h) {
+    item_t *top = h->nodes[0];
+    item_t *last = h->nodes[--h->count];
+    size_t i = 0;
+
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= h->count) {
+            break;
+        }
+        if (child + 1 < h->count &&
+            h->nodes[child + 1]->time < h->nodes[child]->time) {
+            child += 1;
+        }
+        if (last->time <= h->nodes[child]->time) {
+            break;
+        }
+        h->nodes[i] = h->nodes[child];
+        i = child;
+    }
+    if (h->count > 0) {
+        h->nodes[i] = last;
+    }
+    return top;
+}
+
+static int64_t increment(dist_t dist) {
+    double u = uniform01();
+
+    switch (dist) {
+    case DIST_EXPONENTIAL:
+        return (int64_t)(-log(1.0 - u) * MEAN_INCREMENT);
+    case DIST_UNIFORM:
+        return (int64_t)(2.0 * u * MEAN_INCREMENT);
+    case DIST_BIMODAL:
+        // 90% within [0, 0.1], 10% within [9, 11]; mean about 1
+        return (int64_t)((u < 0.9 ? 0.1 * u / 0.9 : 9.0 + 20.0 * (u - 0.9)) *
+                         MEAN_INCREMENT);
+    case DIST_TRIANGULAR:
+        return (int64_t)(1.5 * sqrt(u) * MEAN_INCREMENT);
+    }
+    return 0;
+}
+
+static double uniform01(void) {
+    // xorshift64
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 7;
+    s_seed ^= s_seed << 17;
+    return (double)(s_seed >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int64_t now_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// *****************************************************************************
+// End of file
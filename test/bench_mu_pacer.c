@@ -0,0 +1,136 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_mu_pacer.c
+ * @brief Paced packets per second of CPU for mu_pacer.
+ *
+ * Always-backlogged flows with rates spread over 1 Mbit/s .. 1 Gbit/s send
+ * 1250-byte packets.  Simulated time advances one wheel tick per poll, so the
+ * figure is the pacer's own cost per packet: poll, account and reschedule.
+ *
+ * Build and run with `make bench` in the test directory.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_pacer.h"
+#include "mu_time.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_PACKETS 20000000
+#define PACKET_BYTES 1250
+#define BATCH 64
+
+// *****************************************************************************
+// Private (static) storage
+
+static const size_t s_flow_counts[] = {10, 1000, 100000};
+static uint64_t s_seed = 88172645463325252ULL;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+static double bench(size_t n_flows, double *rate);
+static uint64_t next_random(void);
+static int64_t now_nanos(void);
+
+// *****************************************************************************
+// Public code
+
+int main(void) {
+    printf("%9s %12s %14s %14s\n", "flows", "ns/packet", "packets/s",
+           "paced pkt/s");
+    for (size_t i = 0; i < sizeof(s_flow_counts) / sizeof(s_flow_counts[0]);
+         i++) {
+        double offered;
+        double ns = bench(s_flow_counts[i], &offered);
+        printf("%9zu %12.1f %14.0f %14.0f\n", s_flow_counts[i], ns, 1e9 / ns,
+               offered);
+    }
+    return 0;
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static double bench(size_t n_flows, double *offered) {
+    mu_pacer_t pacer;
+    mu_pacer_flow_t *flows = malloc(n_flows * sizeof(*flows));
+    mu_pacer_flow_t *batch[BATCH];
+    mu_time_abs_t now = mu_time_now();
+    double total_rate = 0;
+
+    mu_pacer_init(&pacer, now, 100 * MU_PACER_RESOLUTION);
+    for (size_t i = 0; i < n_flows; i++) {
+        // 125 kB/s .. 125 MB/s, log-uniform
+        uint64_t rate = 125000ULL << (next_random() % 10);
+        mu_pacer_flow_init(&flows[i], rate, now, NULL);
+        mu_pacer_schedule(&pacer, &flows[i], now);
+        total_rate += (double)rate;
+    }
+    // Simulated packets per simulated second, for scale
+    *offered = total_rate / PACKET_BYTES;
+
+    long sent = 0;
+    int64_t start = now_nanos();
+    while (sent < N_PACKETS) {
+        now = mu_time_offset(now, MU_PACER_RESOLUTION);
+        size_t n;
+        while ((n = mu_pacer_poll(&pacer, now, batch, BATCH)) > 0) {
+            for (size_t k = 0; k < n; k++) {
+                mu_pacer_sent(&pacer, batch[k], PACKET_BYTES, now);
+                mu_pacer_schedule(&pacer, batch[k], now);
+            }
+            sent += (long)n;
+        }
+    }
+    int64_t elapsed = now_nanos() - start;
+    free(flows);
+    return (double)elapsed / (double)sent;
+}
+
+static uint64_t next_random(void) {
+    // xorshift64
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 7;
+    s_seed ^= s_seed << 17;
+    return s_seed;
+}
+
+static int64_t now_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,339 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_asof.h"
+#include "mu_time_column.h"
+#include "unity.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define BIG_LEFT (MU_ASOF_MIN_PART_ROWS * 4 + 123)
+#define BIG_RIGHT (BIG_LEFT * 2)
+#define BIG_KEYS 17
+#define THREADS 4
+
+// *****************************************************************************
+// Private (static) storage
+
+static int64_t s_lt[BIG_LEFT];
+static int64_t s_rt[BIG_RIGHT];
+static uint32_t s_lk[BIG_LEFT];
+static uint32_t s_rk[BIG_RIGHT];
+static uint8_t s_lvalid[(BIG_LEFT + 7) / 8];
+static uint8_t s_rvalid[(BIG_RIGHT + 7) / 8];
+static size_t s_match[BIG_LEFT];
+static size_t s_expect[BIG_LEFT];
+static size_t s_scratch[BIG_KEYS * THREADS];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_asof_latest(void);
+void test_mu_asof_tolerance(void);
+void test_mu_asof_keys(void);
+void test_mu_asof_nulls(void);
+void test_mu_asof_offset(void);
+void test_mu_asof_reference(void);
+void test_mu_asof_parallel(void);
+
+static void random_columns(size_t n_left, size_t n_right, bool nulls);
+static size_t reference(const mu_asof_t *join, size_t *match);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_mu_asof_latest(void) {
+    int64_t rt[] = {10, 20, 20, 30};
+    int64_t lt[] = {5, 10, 15, 20, 25, 35};
+    size_t expect[] = {MU_ASOF_NONE, 0, 0, 2, 2, 3};
+    mu_time_column_t left, right;
+    mu_asof_t join;
+
+    mu_time_column_init(&left, lt, NULL, 6);
+    mu_time_column_init(&right, rt, NULL, 4);
+    mu_asof_init(&join, &left, &right);
+    TEST_ASSERT_EQUAL_size_t(0, mu_asof_scratch_size(&join, 8));
+    TEST_ASSERT_EQUAL_size_t(5, mu_asof_run(&join, s_match, NULL));
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(expect, s_match, 6);
+
+    // An empty right column matches nothing.
+    mu_time_column_init(&right, rt, NULL, 0);
+    TEST_ASSERT_EQUAL_size_t(0, mu_asof_run(&join, s_match, NULL));
+    TEST_ASSERT_EQUAL_size_t(MU_ASOF_NONE, s_match[5]);
+}
+
+void test_mu_asof_tolerance(void) {
+    int64_t rt[] = {10, 20, 20, 30};
+    int64_t lt[] = {5, 10, 15, 20, 25, 35};
+    size_t within4[] = {MU_ASOF_NONE, 0, MU_ASOF_NONE,
+                        2,            2, MU_ASOF_NONE};
+    size_t exact[] = {MU_ASOF_NONE, 0,            MU_ASOF_NONE,
+                      2,            MU_ASOF_NONE, MU_ASOF_NONE};
+    mu_time_column_t left, right;
+    mu_asof_t join;
+
+    lt[4] = 24;
+    mu_time_column_init(&left, lt, NULL, 6);
+    mu_time_column_init(&right, rt, NULL, 4);
+    mu_asof_init(&join, &left, &right);
+    mu_asof_set_tolerance(&join, 4);
+    TEST_ASSERT_EQUAL_size_t(3, mu_asof_run(&join, s_match, NULL));
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(within4, s_match, 6);
+    mu_asof_set_tolerance(&join, 0);
+    TEST_ASSERT_EQUAL_size_t(2, mu_asof_run(&join, s_match, NULL));
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(exact, s_match, 6);
+}
+
+void test_mu_asof_keys(void) {
+    enum { A, B, C };
+    int64_t rt[] = {10, 12, 20, 30};
+    uint32_t rk[] = {A, B, A, B};
+    int64_t lt[] = {15, 15, 25, 31, 31};
+    uint32_t lk[] = {A, B, B, A, C};
+    size_t expect[] = {0, 1, 1, 2, MU_ASOF_NONE};
+    mu_time_column_t left, right;
+    mu_asof_t join;
+
+    mu_time_column_init(&left, lt, NULL, 5);
+    mu_time_column_init(&right, rt, NULL, 4);
+    mu_asof_init(&join, &left, &right);
+    TEST_ASSERT_TRUE(mu_asof_set_keys(&join, lk, rk, 3));
+    TEST_ASSERT_EQUAL_size_t(3, mu_asof_scratch_size(&join, 1));
+    TEST_ASSERT_EQUAL_size_t(6, mu_asof_scratch_size(&join, 2));
+    TEST_ASSERT_EQUAL_size_t(4, mu_asof_run(&join, s_match, s_scratch));
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(expect, s_match, 5);
+
+    // Key arrays come in pairs; a lone one leaves the join as it was.
+    TEST_ASSERT_FALSE(mu_asof_set_keys(&join, lk, NULL, 3));
+    TEST_ASSERT_FALSE(mu_asof_set_keys(&join, NULL, rk, 3));
+    TEST_ASSERT_FALSE(mu_asof_set_keys(&join, lk, rk, 0));
+    TEST_ASSERT_EQUAL_size_t(3, mu_asof_scratch_size(&join, 1));
+    TEST_ASSERT_EQUAL_size_t(4, mu_asof_run(&join, s_match, s_scratch));
+    TEST_ASSERT_EQUAL_UINT64_ARRAY(expect, s_match, 5);
+
+    // Both NULL: unkeyed again, with no scratch.
+    TEST_ASSERT_TRUE(mu_asof_set_keys(&join, NULL, NULL, 0));
+    TEST_ASSERT_EQUAL_size_t(0, mu_asof_scratch_size(&join, 1));
+    TEST_ASSERT_EQUAL_size_t(5, mu_asof_run(&join, s_match, NULL));
+    TEST_ASSERT_EQUAL_size_t(3, s_match[3]);
+
+    // A single key needs no scratch either.
+    memset(s_lk, 0, sizeof(s_lk));
+    memset(s_rk, 0, sizeof(s_rk));
+    TEST_ASSERT_TRUE(mu_asof_set_keys(&join, s_lk, s_rk, 1));
+    TEST_ASSERT_EQUAL_size_t(0, mu_asof_scratch_size(&join, 4));
+    TEST_ASSERT_EQUAL_size_t(5, mu_asof_run(&join, s_match, NULL));
+    TEST_ASSERT_EQUAL_size_t(3, s_match[3]);
+
+    // The B quote at 12 is too old for the trade at 25.
+    TEST_ASSERT_TRUE(mu_asof_set_keys(&join, lk, rk, 3));
+    mu_asof_set_tolerance(&join, 11);
+    mu_asof_run(&join, s_match, s_scratch);
+    TEST_ASSERT_EQUAL_size_t(MU_ASOF_NONE, s_match[2]);
+    TEST_ASSERT_EQUAL_size_t(2, s_match[3]);
+}
+
+void test_mu_asof_nulls(void) {
+    int64_t rt[] = {10, 20, 30};
+    uint32_t rk[] = {0, 1, 0};
+    int64_t lt[] = {25, 35, 40};
+    uint32_t lk[] = {1, 0, 0};
+    uint8_t rvalid = 0x05; // the quote at 20 is null
+    uint8_t lvalid = 0x05; // the trade at 35 is null
+    mu_time_column_t left, right;
+    mu_asof_t join;
+
+    mu_time_column_init(&left, lt, &lvalid, 3);
+    mu_time_column_init(&right, rt, &rvalid, 3);
+    mu_asof_init(&join, &left, &right);
+    TEST_ASSERT_EQUAL_size_t(2, mu_asof_run(&join, s_match, NULL));
+    TEST_ASSERT_EQUAL_size_t(0, s_match[0]);
+    TEST_ASSERT_EQUAL_size_t(MU_ASOF_NONE, s_match[1]);
+    TEST_ASSERT_EQUAL_size_t(2, s_match[2]);
+
+    TEST_ASSERT_TRUE(mu_asof_set_keys(&join, lk, rk, 2));
+    TEST_ASSERT_EQUAL_size_t(1, mu_asof_run(&join, s_match, s_scratch));
+    TEST_ASSERT_EQUAL_size_t(MU_ASOF_NONE, s_match[0]);
+    TEST_ASSERT_EQUAL_size_t(2, s_match[2]);
+}
+
+void test_mu_asof_offset(void) {
+    int64_t rt[] = {0, 10, 20, 30};
+    int64_t lt[] = {0, 0, 25};
+    mu_time_column_t left, right;
+    mu_asof_t join;
+
+    mu_time_column_init(&left, lt, NULL, 1);
+    left.offset = 2;
+    mu_time_column_init(&right, rt, NULL, 3);
+    right.offset = 1;
+    mu_asof_init(&join, &left, &right);
+    mu_asof_run(&join, s_match, NULL);
+    TEST_ASSERT_EQUAL_size_t(1, s_match[0]); // rt[2], right row 1
+}
+
+void test_mu_asof_reference(void) {
+    mu_time_column_t left, right;
+    mu_asof_t join;
+
+    srand(3);
+    for (int round = 0; round < 8; round++) {
+        bool nulls = round & 1;
+        bool keyed = round & 2;
+        random_columns(3000, 1000 + 6000 * (round >> 2), nulls);
+        mu_time_column_init(&left, s_lt, nulls ? s_lvalid : NULL, 3000);
+        mu_time_column_init(&right, s_rt, nulls ? s_rvalid : NULL,
+                            1000 + 6000 * (round >> 2));
+        mu_asof_init(&join, &left, &right);
+        mu_asof_set_tolerance(&join, round % 3 ? MU_ASOF_UNBOUNDED : 5000);
+        if (keyed) {
+            TEST_ASSERT_TRUE(mu_asof_set_keys(&join, s_lk, s_rk, BIG_KEYS));
+        }
+        size_t n = reference(&join, s_expect);
+        TEST_ASSERT_EQUAL_size_t(n, mu_asof_run(&join, s_match, s_scratch));
+        TEST_ASSERT_EQUAL_UINT64_ARRAY(s_expect, s_match, 3000);
+    }
+}
+
+void test_mu_asof_parallel(void) {
+    mu_time_column_t left, right;
+    mu_asof_t join;
+
+    srand(7);
+    random_columns(BIG_LEFT, BIG_RIGHT, true);
+    // A key that only appears in the last partition, long after its quote.
+    s_rk[0] = BIG_KEYS - 1;
+    s_lk[BIG_LEFT - 1] = BIG_KEYS - 1;
+    s_rvalid[0] |= 1;
+    s_lvalid[(BIG_LEFT - 1) / 8] |= 1u << ((BIG_LEFT - 1) % 8);
+    mu_time_column_init(&left, s_lt, s_lvalid, BIG_LEFT);
+    mu_time_column_init(&right, s_rt, s_rvalid, BIG_RIGHT);
+    mu_asof_init(&join, &left, &right);
+    for (int round = 0; round < 4; round++) {
+        if (round == 2) {
+            TEST_ASSERT_TRUE(mu_asof_set_keys(&join, s_lk, s_rk, BIG_KEYS));
+        }
+        mu_asof_set_tolerance(&join, round & 1 ? 3000 : MU_ASOF_UNBOUNDED);
+        size_t n = mu_asof_run(&join, s_expect, s_scratch);
+        TEST_ASSERT_EQUAL_size_t(
+            n, mu_asof_run_parallel(&join, s_match, s_scratch, THREADS));
+        TEST_ASSERT_EQUAL_UINT64_ARRAY(s_expect, s_match, BIG_LEFT);
+    }
+    mu_asof_set_tolerance(&join, MU_ASOF_UNBOUNDED);
+    mu_asof_run_parallel(&join, s_match, s_scratch, THREADS);
+    TEST_ASSERT_EQUAL_size_t(0, s_match[BIG_LEFT - 1]);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_asof_latest);
+    RUN_TEST(test_mu_asof_tolerance);
+    RUN_TEST(test_mu_asof_keys);
+    RUN_TEST(test_mu_asof_nulls);
+    RUN_TEST(test_mu_asof_offset);
+    RUN_TEST(test_mu_asof_reference);
+    RUN_TEST(test_mu_asof_parallel);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Fill sorted random times, with ties and bursts, random keys, and
+ * about 1 in 16 rows null.
+ */
+static void random_columns(size_t n_left, size_t n_right, bool nulls) {
+    int64_t t = 0;
+
+    for (size_t i = 0; i < n_right; i++) {
+        t += rand() % 8 == 0 ? 0 : rand() % 1000;
+        s_rt[i] = t;
+        s_rk[i] = (uint32_t)(rand() % (BIG_KEYS - 1));
+    }
+    t = 0;
+    for (size_t i = 0; i < n_left; i++) {
+        t += rand() % 1000 * (int64_t)n_right / (int64_t)n_left;
+        s_lt[i] = t;
+        s_lk[i] = (uint32_t)(rand() % (BIG_KEYS - 1));
+    }
+    memset(s_lvalid, 0xff, sizeof(s_lvalid));
+    memset(s_rvalid, 0xff, sizeof(s_rvalid));
+    for (size_t i = 0; nulls && i < n_left; i++) {
+        if (rand() % 16 == 0) {
+            s_lvalid[i / 8] &= (uint8_t)~(1u << (i % 8));
+        }
+    }
+    for (size_t i = 0; nulls && i < n_right; i++) {
+        if (rand() % 16 == 0) {
+            s_rvalid[i / 8] &= (uint8_t)~(1u << (i % 8));
+        }
+    }
+}
+
+/**
+ * @brief Join the slow way: walk back from the end for every left row.
+ */
+static size_t reference(const mu_asof_t *join, size_t *match) {
+    const mu_time_column_t *left = join->left;
+    const mu_time_column_t *right = join->right;
+    const uint32_t *lk = join->left_keys;
+    const uint32_t *rk = join->right_keys;
+    size_t matched = 0;
+
+    for (size_t i = 0; i < left->length; i++) {
+        match[i] = MU_ASOF_NONE;
+        if (!mu_time_column_is_valid(left, i)) {
+            continue;
+        }
+        for (size_t j = right->length; j-- > 0;) {
+            if (right->values[j] > left->values[i] ||
+                !mu_time_column_is_valid(right, j) ||
+                (lk != NULL && rk[j] != lk[i])) {
+                continue;
+            }
+            if (left->values[i] - right->values[j] <= join->tolerance) {
+                match[i] = j;
+                matched += 1;
+            }
+            break;
+        }
+    }
+    return matched;
+}
+
+// *****************************************************************************
+// End of file
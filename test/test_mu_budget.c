@@ -0,0 +1,268 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_budget.h"
+#include "mu_time.h"
+#include "unity.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define US(n) ((mu_time_rel_t)(n) * 1000)
+#define MS(n) ((mu_time_rel_t)(n) * 1000000)
+
+typedef struct {
+    int items;  ///< Work left
+    int done;   ///< Work done this run
+    char name;
+    bool greedy; ///< Ignore the budget
+} job_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static char s_order[32];
+static int s_order_len;
+static mu_coarse_clock_t s_clock; ///< Advanced by the tests, not by time
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_budget_exhausts(void);
+void test_mu_budget_noticed_promptly(void);
+void test_mu_budget_stride_calibrates(void);
+void test_mu_budget_coarse(void);
+void test_mu_budget_rr_round_robin(void);
+void test_mu_budget_rr_overrun(void);
+void test_mu_budget_rr_remove(void);
+
+static void work(mu_time_rel_t duration);
+static bool job_fn(mu_budget_task_t *task, mu_budget_t *budget);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    s_order_len = 0;
+    mu_coarse_clock_set(&s_clock, (mu_time_abs_t){1000, 0});
+}
+
+void tearDown(void) {}
+
+void test_mu_budget_exhausts(void) {
+    mu_budget_t b;
+    uint32_t polls = 0;
+
+    mu_budget_init(&b, NULL);
+    TEST_ASSERT_TRUE(mu_budget_exhausted(&b));
+
+    mu_budget_start(&b, MS(5));
+    while (!mu_budget_exhausted(&b)) {
+        polls += 1;
+    }
+    TEST_ASSERT_TRUE(polls > 0);
+    TEST_ASSERT_TRUE(mu_budget_elapsed(&b) >= MS(5));
+    TEST_ASSERT_TRUE(mu_budget_remaining(&b) <= 0);
+    // Stays exhausted.
+    TEST_ASSERT_TRUE(mu_budget_exhausted(&b));
+}
+
+void test_mu_budget_noticed_promptly(void) {
+    mu_budget_t b;
+    uint32_t polls = 0;
+
+    // 1 uSec per poll: the 5 mSec slice is spent after 5000 polls, and the
+    // clock is read about every 5000 >> MU_BUDGET_CHECKS_SHIFT of them.
+    mu_budget_init(&b, &s_clock);
+    mu_budget_start(&b, MS(5));
+    while (!mu_budget_exhausted(&b)) {
+        work(US(1));
+        polls += 1;
+    }
+    TEST_ASSERT_TRUE(polls >= 5000);
+    // Noticed within a couple of check intervals, not a whole slice late.
+    TEST_ASSERT_TRUE(polls < 5000 + 2 * (5000 >> MU_BUDGET_CHECKS_SHIFT));
+    TEST_ASSERT_EQUAL_INT64(US(polls), mu_budget_elapsed(&b));
+    TEST_ASSERT_TRUE(mu_budget_exhausted(&b));
+}
+
+void test_mu_budget_stride_calibrates(void) {
+    mu_budget_t b;
+
+    // A cheap loop body is checked rarely...
+    mu_budget_init(&b, &s_clock);
+    mu_budget_start(&b, MS(20));
+    while (!mu_budget_exhausted(&b)) {
+        work(US(1));
+    }
+    uint32_t cheap = mu_budget_stride(&b);
+    TEST_ASSERT_TRUE(cheap > 1);
+    TEST_ASSERT_TRUE(cheap <= MU_BUDGET_STRIDE_MAX);
+
+    // ...and an expensive one on every poll.
+    mu_budget_start(&b, MS(20));
+    while (!mu_budget_exhausted(&b)) {
+        work(MS(2));
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, mu_budget_stride(&b));
+}
+
+void test_mu_budget_coarse(void) {
+    mu_coarse_clock_t clock;
+    mu_budget_t b;
+    mu_time_abs_t t0 = mu_time_now();
+
+    mu_coarse_clock_set(&clock, t0);
+    mu_budget_init(&b, &clock);
+    mu_budget_start(&b, MS(10));
+
+    // Time only moves when the clock is refreshed.
+    for (int i = 0; i < 100000; i++) {
+        TEST_ASSERT_FALSE(mu_budget_exhausted(&b));
+    }
+    TEST_ASSERT_EQUAL_UINT32(MU_BUDGET_STRIDE_MAX, mu_budget_stride(&b));
+    mu_coarse_clock_set(&clock, mu_time_offset(t0, MS(9)));
+    TEST_ASSERT_FALSE(mu_budget_check(&b));
+    TEST_ASSERT_EQUAL_INT64(MS(1), mu_budget_remaining(&b));
+    mu_coarse_clock_set(&clock, mu_time_offset(t0, MS(10)));
+    TEST_ASSERT_TRUE(mu_budget_check(&b));
+    TEST_ASSERT_EQUAL_INT64(MS(10), mu_budget_elapsed(&b));
+
+    mu_coarse_clock_update(&clock);
+    TEST_ASSERT_FALSE(mu_time_is_before(clock.now, t0));
+}
+
+void test_mu_budget_rr_round_robin(void) {
+    mu_budget_rr_t rr;
+    mu_budget_task_t ta, tb;
+    job_t a = {.items = 3, .name = 'a'};
+    job_t b = {.items = 1, .name = 'b'};
+
+    mu_budget_rr_init(&rr, &s_clock, MS(50));
+    TEST_ASSERT_TRUE(mu_budget_rr_is_empty(&rr));
+    TEST_ASSERT_NULL(mu_budget_rr_run(&rr));
+
+    mu_budget_task_init(&ta, job_fn, &a, MS(1));
+    mu_budget_task_init(&tb, job_fn, &b, MS(1));
+    mu_budget_rr_add(&rr, &ta);
+    mu_budget_rr_add(&rr, &tb);
+    mu_budget_rr_add(&rr, &ta); // already queued
+    TEST_ASSERT_EQUAL_PTR(&a, mu_budget_task_arg(&ta));
+
+    while (mu_budget_rr_run(&rr) != NULL) {
+    }
+    // Each item takes longer than a slice, so a yields after each one and b
+    // gets its turn in between.
+    s_order[s_order_len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("abaa", s_order);
+    TEST_ASSERT_EQUAL_UINT32(3, mu_budget_task_runs(&ta));
+    TEST_ASSERT_EQUAL_UINT32(1, mu_budget_task_runs(&tb));
+    // Each run ends 0.5 mSec over, well within tolerance.
+    TEST_ASSERT_EQUAL_UINT32(0, mu_budget_task_overruns(&ta));
+    TEST_ASSERT_EQUAL_INT64(US(500), mu_budget_task_max_overrun(&ta));
+}
+
+void test_mu_budget_rr_overrun(void) {
+    mu_budget_rr_t rr;
+    mu_budget_task_t t;
+    job_t j = {.items = 2, .name = 'g', .greedy = true};
+
+    mu_budget_rr_init(&rr, &s_clock, US(500));
+    mu_budget_task_init(&t, job_fn, &j, MS(1));
+    mu_budget_rr_add(&rr, &t);
+    TEST_ASSERT_EQUAL_PTR(&t, mu_budget_rr_run(&rr));
+    TEST_ASSERT_TRUE(mu_budget_rr_is_empty(&rr));
+    TEST_ASSERT_EQUAL_UINT32(1, mu_budget_task_overruns(&t));
+    // Two 1.5 mSec items in a 1 mSec slice.
+    TEST_ASSERT_EQUAL_INT64(MS(2), mu_budget_task_max_overrun(&t));
+}
+
+void test_mu_budget_rr_remove(void) {
+    mu_budget_rr_t rr;
+    mu_budget_task_t t[3];
+    job_t j[3] = {{.items = 1, .name = 'x'},
+                  {.items = 1, .name = 'y'},
+                  {.items = 1, .name = 'z'}};
+
+    mu_budget_rr_init(&rr, &s_clock, MS(50));
+    for (int i = 0; i < 3; i++) {
+        mu_budget_task_init(&t[i], job_fn, &j[i], MS(1));
+        mu_budget_rr_add(&rr, &t[i]);
+    }
+    mu_budget_rr_remove(&rr, &t[2]);
+    mu_budget_rr_remove(&rr, &t[2]);
+    mu_budget_rr_remove(&rr, &t[0]);
+    mu_budget_rr_add(&rr, &t[2]);
+    while (mu_budget_rr_run(&rr) != NULL) {
+    }
+    s_order[s_order_len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("yz", s_order);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_budget_exhausts);
+    RUN_TEST(test_mu_budget_noticed_promptly);
+    RUN_TEST(test_mu_budget_stride_calibrates);
+    RUN_TEST(test_mu_budget_coarse);
+    RUN_TEST(test_mu_budget_rr_round_robin);
+    RUN_TEST(test_mu_budget_rr_overrun);
+    RUN_TEST(test_mu_budget_rr_remove);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Stand in for work that takes `duration`, on the test's clock.
+ */
+static void work(mu_time_rel_t duration) {
+    mu_coarse_clock_set(&s_clock, mu_time_offset(s_clock.now, duration));
+}
+
+/**
+ * @brief Do 1.5 mSec items until out of items or, unless greedy, budget.
+ */
+static bool job_fn(mu_budget_task_t *task, mu_budget_t *budget) {
+    job_t *job = mu_budget_task_arg(task);
+
+    s_order[s_order_len++] = job->name;
+    while (job->items > 0) {
+        work(US(1500));
+        job->items -= 1;
+        if (!job->greedy && mu_budget_check(budget)) {
+            break;
+        }
+    }
+    return job->items > 0;
+}
+
+// *****************************************************************************
+// End of file
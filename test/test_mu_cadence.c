@@ -0,0 +1,253 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_cadence.h"
+#include "unity.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define MAX_RUNS 4096
+#define STREAM 20000
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_cadence_run_t s_runs[MAX_RUNS];
+static size_t s_count;
+static int64_t s_stream[STREAM];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_cadence_regular(void);
+void test_mu_cadence_gap(void);
+void test_mu_cadence_duplicate_backward(void);
+void test_mu_cadence_period_change(void);
+void test_mu_cadence_irregular(void);
+void test_mu_cadence_learn(void);
+void test_mu_cadence_scan_matches_push(void);
+
+static void push_all(mu_cadence_t *det, const int64_t *t, size_t n);
+static void assert_run(size_t i, mu_cadence_kind_t kind, uint64_t first,
+                       uint32_t count, int64_t period);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) { s_count = 0; }
+
+void tearDown(void) {}
+
+void test_mu_cadence_regular(void) {
+    mu_cadence_t det;
+
+    for (int i = 0; i < 1000; i++) {
+        s_stream[i] = 5000 + i * 100 + (i % 3) - 1; // +-1 jitter
+    }
+    mu_cadence_init(&det, 100, 5, 3);
+    push_all(&det, s_stream, 1000);
+    TEST_ASSERT_EQUAL_size_t(1, s_count);
+    assert_run(0, MU_CADENCE_REGULAR, 0, 999, 100);
+    TEST_ASSERT_EQUAL_INT64(s_stream[0], s_runs[0].start);
+    TEST_ASSERT_EQUAL_INT64(s_stream[999] - s_stream[0], s_runs[0].span);
+}
+
+void test_mu_cadence_gap(void) {
+    const int64_t t[] = {0, 10, 20, 30, 70, 80, 90, 100, 120, 130};
+    mu_cadence_t det;
+
+    mu_cadence_init(&det, 10, 1, 3);
+    push_all(&det, t, sizeof(t) / sizeof(t[0]));
+    TEST_ASSERT_EQUAL_size_t(5, s_count);
+    assert_run(0, MU_CADENCE_REGULAR, 0, 3, 10);
+    assert_run(1, MU_CADENCE_GAP, 3, 1, 10);
+    TEST_ASSERT_EQUAL_INT64(40, s_runs[1].span);
+    TEST_ASSERT_EQUAL_UINT64(3, mu_cadence_missing(&s_runs[1]));
+    assert_run(2, MU_CADENCE_REGULAR, 4, 3, 10);
+    assert_run(3, MU_CADENCE_GAP, 7, 1, 10);
+    TEST_ASSERT_EQUAL_UINT64(1, mu_cadence_missing(&s_runs[3]));
+    assert_run(4, MU_CADENCE_REGULAR, 8, 1, 10);
+    TEST_ASSERT_EQUAL_UINT64(0, mu_cadence_missing(&s_runs[4]));
+}
+
+void test_mu_cadence_duplicate_backward(void) {
+    const int64_t t[] = {0, 10, 10, 10, 20, 15, 30, 40};
+    mu_cadence_t det;
+
+    mu_cadence_init(&det, 10, 1, 3);
+    push_all(&det, t, sizeof(t) / sizeof(t[0]));
+    TEST_ASSERT_EQUAL_size_t(6, s_count);
+    assert_run(0, MU_CADENCE_REGULAR, 0, 1, 10);
+    assert_run(1, MU_CADENCE_DUPLICATE, 1, 2, 10);
+    assert_run(2, MU_CADENCE_REGULAR, 3, 1, 10);
+    assert_run(3, MU_CADENCE_BACKWARD, 4, 1, 10);
+    TEST_ASSERT_EQUAL_INT64(-5, s_runs[3].span);
+    // 15 -> 30 is off the period, and not confirmed.
+    assert_run(4, MU_CADENCE_GAP, 5, 1, 10);
+    assert_run(5, MU_CADENCE_REGULAR, 6, 1, 10);
+}
+
+void test_mu_cadence_period_change(void) {
+    int64_t t[40];
+    mu_cadence_t det;
+
+    // 10 samples at 10, then 30 at 20: the first 20 is a candidate
+    // confirmed by the next two.
+    for (int i = 0; i < 10; i++) {
+        t[i] = i * 10;
+    }
+    for (int i = 10; i < 40; i++) {
+        t[i] = t[i - 1] + 20;
+    }
+    mu_cadence_init(&det, 10, 2, 3);
+    push_all(&det, t, 40);
+    TEST_ASSERT_EQUAL_INT64(20, mu_cadence_period(&det));
+    TEST_ASSERT_EQUAL_size_t(2, s_count);
+    assert_run(0, MU_CADENCE_REGULAR, 0, 9, 10);
+    assert_run(1, MU_CADENCE_REGULAR, 9, 30, 20);
+    TEST_ASSERT_EQUAL_INT64(90, s_runs[1].start);
+
+    // confirm = 1 adopts any off-period interval at once.
+    s_count = 0;
+    mu_cadence_init(&det, 10, 2, 1);
+    push_all(&det, t, 12);
+    TEST_ASSERT_EQUAL_size_t(2, s_count);
+    assert_run(1, MU_CADENCE_REGULAR, 9, 2, 20);
+}
+
+void test_mu_cadence_irregular(void) {
+    const int64_t t[] = {0, 100, 200, 240, 300, 400, 500};
+    mu_cadence_t det;
+
+    mu_cadence_init(&det, 100, 5, 3);
+    push_all(&det, t, sizeof(t) / sizeof(t[0]));
+    TEST_ASSERT_EQUAL_size_t(4, s_count);
+    assert_run(0, MU_CADENCE_REGULAR, 0, 2, 100);
+    assert_run(1, MU_CADENCE_IRREGULAR, 2, 1, 100);
+    assert_run(2, MU_CADENCE_IRREGULAR, 3, 1, 100);
+    assert_run(3, MU_CADENCE_REGULAR, 4, 2, 100);
+}
+
+void test_mu_cadence_learn(void) {
+    const int64_t t[] = {3, 3, 10, 17, 24, 31, 38, 60, 67};
+    mu_cadence_t det;
+
+    mu_cadence_init(&det, 0, 1, 3);
+    push_all(&det, t, sizeof(t) / sizeof(t[0]));
+    TEST_ASSERT_EQUAL_INT64(7, mu_cadence_period(&det));
+    TEST_ASSERT_EQUAL_size_t(4, s_count);
+    assert_run(0, MU_CADENCE_DUPLICATE, 0, 1, 0);
+    assert_run(1, MU_CADENCE_REGULAR, 1, 5, 7);
+    assert_run(2, MU_CADENCE_GAP, 6, 1, 7);
+    TEST_ASSERT_EQUAL_UINT64(2, mu_cadence_missing(&s_runs[2]));
+    assert_run(3, MU_CADENCE_REGULAR, 7, 1, 7);
+}
+
+void test_mu_cadence_scan_matches_push(void) {
+    static mu_cadence_run_t expect[MAX_RUNS];
+    mu_cadence_t det;
+    int64_t t = 0;
+
+    srand(3);
+    for (int i = 0; i < STREAM; i++) {
+        int r = rand() % 1000;
+        t += r < 990 ? 1000 + rand() % 11 - 5 // regular, with jitter
+             : r < 994 ? 1000 * (2 + rand() % 5) // gap
+             : r < 996 ? 0                        // duplicate
+             : r < 998 ? 300                      // irregular
+                       : -200;                    // backward
+        if (i == STREAM / 2) {
+            t += 500; // then a period change to 1500
+        }
+        s_stream[i] = t;
+        if (i > STREAM / 2) {
+            s_stream[i] += (int64_t)(i - STREAM / 2) * 500;
+        }
+    }
+
+    mu_cadence_init(&det, 1000, 10, 4);
+    push_all(&det, s_stream, STREAM);
+    size_t n = s_count;
+    memcpy(expect, s_runs, n * sizeof(expect[0]));
+    TEST_ASSERT_TRUE(n > 100);
+    TEST_ASSERT_INT64_WITHIN(5, 1500, mu_cadence_period(&det));
+
+    // The same stream in uneven slices into a small output buffer.
+    mu_cadence_init(&det, 1000, 10, 4);
+    s_count = 0;
+    size_t i = 0;
+    while (i < STREAM) {
+        size_t consumed, len = STREAM - i < 777 ? STREAM - i : 777;
+        s_count += mu_cadence_scan(&det, &s_stream[i], len, &s_runs[s_count],
+                                   5, &consumed);
+        i += consumed;
+    }
+    s_count += mu_cadence_flush(&det, &s_runs[s_count]);
+    TEST_ASSERT_EQUAL_size_t(n, s_count);
+    for (size_t k = 0; k < n; k++) {
+        TEST_ASSERT_EQUAL_MEMORY(&expect[k], &s_runs[k],
+                                 offsetof(mu_cadence_run_t, kind) + 1);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_cadence_regular);
+    RUN_TEST(test_mu_cadence_gap);
+    RUN_TEST(test_mu_cadence_duplicate_backward);
+    RUN_TEST(test_mu_cadence_period_change);
+    RUN_TEST(test_mu_cadence_irregular);
+    RUN_TEST(test_mu_cadence_learn);
+    RUN_TEST(test_mu_cadence_scan_matches_push);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void push_all(mu_cadence_t *det, const int64_t *t, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        s_count += mu_cadence_push(det, t[i], &s_runs[s_count]);
+    }
+    s_count += mu_cadence_flush(det, &s_runs[s_count]);
+}
+
+static void assert_run(size_t i, mu_cadence_kind_t kind, uint64_t first,
+                       uint32_t count, int64_t period) {
+    TEST_ASSERT_EQUAL_UINT8(kind, s_runs[i].kind);
+    TEST_ASSERT_EQUAL_UINT64(first, s_runs[i].first);
+    TEST_ASSERT_EQUAL_UINT32(count, s_runs[i].count);
+    TEST_ASSERT_EQUAL_INT64(period, s_runs[i].period);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,274 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_calendar_queue.h"
+#include "mu_time.h"
+#include "unity.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_EVENTS 4000
+#define N_BUCKETS 1024
+
+typedef struct {
+    mu_calendar_event_t event;
+    int id;
+} item_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_calendar_queue_t s_queue;
+static mu_calendar_event_t *s_buckets[N_BUCKETS];
+static item_t s_items[N_EVENTS];
+static mu_time_abs_t s_origin = {1000, 0};
+static uint32_t s_seed;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_calendar_queue_empty(void);
+void test_mu_calendar_queue_order(void);
+void test_mu_calendar_queue_fifo_ties(void);
+void test_mu_calendar_queue_earlier_than_cursor(void);
+void test_mu_calendar_queue_remove(void);
+void test_mu_calendar_queue_hold_model(void);
+void test_mu_calendar_queue_adapts_width(void);
+void test_mu_calendar_queue_small_capacity(void);
+
+static mu_time_abs_t at_micros(int64_t micros);
+static int64_t micros_of(mu_time_abs_t t);
+static uint32_t next_random(void);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    mu_calendar_queue_init(&s_queue, s_buckets, N_BUCKETS, s_origin, 0);
+    for (int i = 0; i < N_EVENTS; i++) {
+        s_items[i].id = i;
+    }
+    s_seed = 12345;
+}
+
+void tearDown(void) {}
+
+void test_mu_calendar_queue_empty(void) {
+    TEST_ASSERT_NULL(mu_calendar_queue_dequeue(&s_queue));
+    TEST_ASSERT_NULL(mu_calendar_queue_peek(&s_queue));
+    TEST_ASSERT_EQUAL_size_t(0, mu_calendar_queue_count(&s_queue));
+    TEST_ASSERT_EQUAL_size_t(MU_CALENDAR_QUEUE_MIN_BUCKETS,
+                             mu_calendar_queue_buckets(&s_queue));
+    TEST_ASSERT_EQUAL_INT64(mu_time_rel_from_millis(1),
+                            mu_calendar_queue_width(&s_queue));
+}
+
+void test_mu_calendar_queue_order(void) {
+    int64_t last = INT64_MIN;
+
+    for (int i = 0; i < N_EVENTS; i++) {
+        mu_calendar_queue_enqueue(&s_queue, &s_items[i].event,
+                                  at_micros(next_random() % 10000000));
+    }
+    TEST_ASSERT_EQUAL_size_t(N_EVENTS, mu_calendar_queue_count(&s_queue));
+    TEST_ASSERT_TRUE(mu_calendar_queue_buckets(&s_queue) > N_EVENTS / 4);
+
+    for (int i = 0; i < N_EVENTS; i++) {
+        mu_calendar_event_t *peek = mu_calendar_queue_peek(&s_queue);
+        mu_calendar_event_t *ev = mu_calendar_queue_dequeue(&s_queue);
+        TEST_ASSERT_EQUAL_PTR(peek, ev);
+        int64_t t = micros_of(mu_calendar_queue_event_time(&s_queue, ev));
+        TEST_ASSERT_TRUE(t >= last);
+        last = t;
+    }
+    TEST_ASSERT_NULL(mu_calendar_queue_dequeue(&s_queue));
+    TEST_ASSERT_EQUAL_size_t(MU_CALENDAR_QUEUE_MIN_BUCKETS,
+                             mu_calendar_queue_buckets(&s_queue));
+}
+
+void test_mu_calendar_queue_fifo_ties(void) {
+    // Three distinct times, interleaved, many events each
+    for (int i = 0; i < 300; i++) {
+        mu_calendar_queue_enqueue(&s_queue, &s_items[i].event,
+                                  at_micros((i % 3) * 500));
+    }
+    for (int i = 0; i < 300; i++) {
+        item_t *item = (item_t *)mu_calendar_queue_dequeue(&s_queue);
+        // all of time 0 by id, then time 500, then time 1000
+        TEST_ASSERT_EQUAL_INT((i % 100) * 3 + i / 100, item->id);
+    }
+}
+
+void test_mu_calendar_queue_earlier_than_cursor(void) {
+    item_t *item;
+
+    mu_calendar_queue_enqueue(&s_queue, &s_items[0].event, at_micros(50000));
+    mu_calendar_queue_enqueue(&s_queue, &s_items[1].event, at_micros(90000));
+    item = (item_t *)mu_calendar_queue_dequeue(&s_queue);
+    TEST_ASSERT_EQUAL_INT(0, item->id);
+
+    // Behind the last dequeued event, and before the origin
+    mu_calendar_queue_enqueue(&s_queue, &s_items[2].event, at_micros(20000));
+    mu_calendar_queue_enqueue(&s_queue, &s_items[3].event, at_micros(-7500));
+    item = (item_t *)mu_calendar_queue_dequeue(&s_queue);
+    TEST_ASSERT_EQUAL_INT(3, item->id);
+    TEST_ASSERT_EQUAL_INT64(-7500, micros_of(mu_calendar_queue_event_time(
+                                       &s_queue, &item->event)));
+    item = (item_t *)mu_calendar_queue_dequeue(&s_queue);
+    TEST_ASSERT_EQUAL_INT(2, item->id);
+    item = (item_t *)mu_calendar_queue_dequeue(&s_queue);
+    TEST_ASSERT_EQUAL_INT(1, item->id);
+    TEST_ASSERT_EQUAL_INT64(90000, micros_of(mu_calendar_queue_event_time(
+                                       &s_queue, &item->event)));
+}
+
+void test_mu_calendar_queue_remove(void) {
+    for (int i = 0; i < 10; i++) {
+        mu_calendar_queue_enqueue(&s_queue, &s_items[i].event,
+                                  at_micros(i * 1000));
+    }
+    TEST_ASSERT_TRUE(mu_calendar_queue_remove(&s_queue, &s_items[0].event));
+    TEST_ASSERT_TRUE(mu_calendar_queue_remove(&s_queue, &s_items[5].event));
+    TEST_ASSERT_FALSE(mu_calendar_queue_remove(&s_queue, &s_items[5].event));
+    TEST_ASSERT_EQUAL_size_t(8, mu_calendar_queue_count(&s_queue));
+
+    int expect[] = {1, 2, 3, 4, 6, 7, 8, 9};
+    for (int i = 0; i < 8; i++) {
+        item_t *item = (item_t *)mu_calendar_queue_dequeue(&s_queue);
+        TEST_ASSERT_EQUAL_INT(expect[i], item->id);
+    }
+}
+
+void test_mu_calendar_queue_hold_model(void) {
+    // Classic hold: dequeue the earliest, re-enqueue it a random increment
+    // later.  Track the simulated time, which must never go backwards.
+    int64_t now = 0;
+
+    for (int i = 0; i < 1000; i++) {
+        mu_calendar_queue_enqueue(&s_queue, &s_items[i].event,
+                                  at_micros(next_random() % 20000));
+    }
+    for (int i = 0; i < 50000; i++) {
+        mu_calendar_event_t *ev = mu_calendar_queue_dequeue(&s_queue);
+        int64_t t = micros_of(mu_calendar_queue_event_time(&s_queue, ev));
+        TEST_ASSERT_TRUE(t >= now);
+        now = t;
+        mu_calendar_queue_enqueue(&s_queue, ev,
+                                  at_micros(now + next_random() % 20000));
+    }
+    TEST_ASSERT_EQUAL_size_t(1000, mu_calendar_queue_count(&s_queue));
+}
+
+void test_mu_calendar_queue_adapts_width(void) {
+    // Events one second apart, far wider than the initial 1 mSec buckets
+    int64_t now = 0;
+
+    for (int i = 0; i < 200; i++) {
+        mu_calendar_queue_enqueue(&s_queue, &s_items[i].event,
+                                  at_micros((int64_t)i * 1000000));
+    }
+    for (int i = 0; i < 5000; i++) {
+        mu_calendar_event_t *ev = mu_calendar_queue_dequeue(&s_queue);
+        now = micros_of(mu_calendar_queue_event_time(&s_queue, ev));
+        mu_calendar_queue_enqueue(&s_queue, ev, at_micros(now + 200000000));
+    }
+    mu_time_rel_t width = mu_calendar_queue_width(&s_queue);
+    TEST_ASSERT_TRUE(width >= mu_time_rel_from_millis(500));
+    TEST_ASSERT_TRUE(width <= mu_time_rel_from_millis(5000));
+}
+
+void test_mu_calendar_queue_small_capacity(void) {
+    // Guard words past the buckets catch growth beyond the caller's array.
+    mu_calendar_event_t *storage[3 + 4];
+    mu_calendar_event_t *guard = &s_items[0].event;
+    const size_t fits[] = {1, 2, 2};
+
+    TEST_ASSERT_FALSE(
+        mu_calendar_queue_init(&s_queue, storage, 0, s_origin, 0));
+    for (size_t capacity = 1; capacity <= 3; capacity++) {
+        int64_t last = INT64_MIN;
+        for (size_t i = capacity; i < capacity + 4; i++) {
+            storage[i] = guard;
+        }
+        TEST_ASSERT_TRUE(
+            mu_calendar_queue_init(&s_queue, storage, capacity, s_origin, 0));
+        TEST_ASSERT_EQUAL_size_t(fits[capacity - 1],
+                                 mu_calendar_queue_buckets(&s_queue));
+        for (int i = 1; i < 500; i++) {
+            mu_calendar_queue_enqueue(&s_queue, &s_items[i].event,
+                                      at_micros(next_random() % 100000));
+        }
+        TEST_ASSERT_EQUAL_size_t(fits[capacity - 1],
+                                 mu_calendar_queue_buckets(&s_queue));
+        for (int i = 1; i < 500; i++) {
+            mu_calendar_event_t *ev = mu_calendar_queue_dequeue(&s_queue);
+            int64_t t = micros_of(mu_calendar_queue_event_time(&s_queue, ev));
+            TEST_ASSERT_TRUE(t >= last);
+            last = t;
+        }
+        TEST_ASSERT_NULL(mu_calendar_queue_dequeue(&s_queue));
+        for (size_t i = capacity; i < capacity + 4; i++) {
+            TEST_ASSERT_EQUAL_PTR(guard, storage[i]);
+        }
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_calendar_queue_empty);
+    RUN_TEST(test_mu_calendar_queue_order);
+    RUN_TEST(test_mu_calendar_queue_fifo_ties);
+    RUN_TEST(test_mu_calendar_queue_earlier_than_cursor);
+    RUN_TEST(test_mu_calendar_queue_remove);
+    RUN_TEST(test_mu_calendar_queue_hold_model);
+    RUN_TEST(test_mu_calendar_queue_adapts_width);
+    RUN_TEST(test_mu_calendar_queue_small_capacity);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static mu_time_abs_t at_micros(int64_t micros) {
+    return mu_time_offset(s_origin, micros * 1000);
+}
+
+static int64_t micros_of(mu_time_abs_t t) {
+    return mu_time_difference(s_origin, t) / 1000;
+}
+
+static uint32_t next_random(void) {
+    s_seed = s_seed * 1103515245 + 12345;
+    return s_seed >> 8;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,154 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_clock_map.h"
+#include "mu_time.h"
+#include "unity.h"
+#include <stdint.h>
+#include <stdio.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DEVICE_HZ 1000
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_clock_map_t s_cm;
+static uint32_t s_rand;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_clock_map_single_sample(void);
+void test_mu_clock_map_ignores_delayed_samples(void);
+void test_mu_clock_map_tracks_skew_across_wrap(void);
+void test_mu_clock_map_reset(void);
+
+static uint32_t next_rand(void);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    mu_clock_map_init(&s_cm, DEVICE_HZ);
+    s_rand = 12345;
+}
+
+void tearDown(void) {}
+
+void test_mu_clock_map_single_sample(void) {
+    mu_time_abs_t host = {1000, 0};
+
+    TEST_ASSERT_FALSE(mu_clock_map_is_valid(&s_cm));
+    mu_clock_map_add_sample(&s_cm, 5000, host);
+    TEST_ASSERT_TRUE(mu_clock_map_is_valid(&s_cm));
+
+    // nominal rate around the only sample, in both directions
+    mu_time_abs_t t = mu_clock_map_to_host(&s_cm, 6500);
+    TEST_ASSERT_EQUAL_INT64(1500000000, mu_time_difference(host, t));
+    t = mu_clock_map_to_host(&s_cm, 4000);
+    TEST_ASSERT_EQUAL_INT64(-1000000000, mu_time_difference(host, t));
+    TEST_ASSERT_EQUAL_INT64(999, t.seconds);
+    TEST_ASSERT_EQUAL_INT64(0, t.nanoseconds);
+}
+
+void test_mu_clock_map_ignores_delayed_samples(void) {
+    mu_time_abs_t base = {2000, 0};
+
+    // samples on an exact line, plus one that was delayed by 30 mSec
+    mu_clock_map_add_sample(&s_cm, 0, base);
+    mu_clock_map_add_sample(&s_cm, 1000, mu_time_offset(base, 1030000000));
+    mu_clock_map_add_sample(&s_cm, 2000, mu_time_offset(base, 2000000000));
+    TEST_ASSERT_EQUAL(2, mu_clock_map_hull_size(&s_cm));
+    TEST_ASSERT_EQUAL_INT32(0, mu_clock_map_skew_ppb(&s_cm));
+
+    mu_time_abs_t t = mu_clock_map_to_host(&s_cm, 1000);
+    TEST_ASSERT_EQUAL_INT64(1000000000, mu_time_difference(base, t));
+}
+
+void test_mu_clock_map_tracks_skew_across_wrap(void) {
+    // The device runs 50 ppm fast and its counter wraps during the run.
+    const double drift = 50e-6;
+    const uint32_t start = 0xfffc0000;
+    mu_time_abs_t origin = {1700000000, 0};
+    int64_t worst = 0;
+
+    for (int i = 0; i < 2000; i++) {
+        int64_t true_ns = (int64_t)i * 997000000;  // ~1 Hz exchange
+        uint32_t ticks = start + (uint32_t)(true_ns * (1.0 + drift) / 1e6);
+        // tick boundary in host time, then 0..5 mSec of transport delay
+        int64_t boundary_ns =
+            (int64_t)((double)(uint32_t)(ticks - start) * 1e6 / (1.0 + drift));
+        int64_t delay_ns = (int64_t)(next_rand() % 5000000);
+        mu_time_abs_t recv = mu_time_offset(origin, boundary_ns + delay_ns);
+        mu_clock_map_add_sample(&s_cm, ticks, recv);
+
+        if (i > 200) {
+            mu_time_abs_t est = mu_clock_map_to_host(&s_cm, ticks);
+            int64_t err = mu_time_difference(mu_time_offset(origin, boundary_ns), est);
+            if (err < 0) {
+                err = -err;
+            }
+            if (err > worst) {
+                worst = err;
+            }
+        }
+    }
+    TEST_ASSERT_INT32_WITHIN(2000, 50000, mu_clock_map_skew_ppb(&s_cm));
+    TEST_ASSERT_TRUE(worst < 200000);  // within 0.2 mSec
+    TEST_ASSERT_TRUE(mu_clock_map_hull_size(&s_cm) <= MU_CLOCK_MAP_HULL_CAPACITY);
+}
+
+void test_mu_clock_map_reset(void) {
+    mu_time_abs_t host = {1000, 0};
+    mu_clock_map_add_sample(&s_cm, 5000, host);
+    mu_clock_map_reset(&s_cm);
+    TEST_ASSERT_FALSE(mu_clock_map_is_valid(&s_cm));
+    TEST_ASSERT_EQUAL(0, mu_clock_map_hull_size(&s_cm));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_clock_map_single_sample);
+    RUN_TEST(test_mu_clock_map_ignores_delayed_samples);
+    RUN_TEST(test_mu_clock_map_tracks_skew_across_wrap);
+    RUN_TEST(test_mu_clock_map_reset);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static uint32_t next_rand(void) {
+    s_rand = s_rand * 1103515245 + 12345;
+    return s_rand >> 8;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,399 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_cron.h"
+#include "mu_time.h"
+#include "mu_time_bucket.h"
+#include "mu_timer_wheel.h"
+#include "unity.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define DAY 86400
+#define JAN_1_2025 1735689600 // a Wednesday
+#define JOBS 1000
+
+// *****************************************************************************
+// Private (static) storage
+
+static int s_fired[JOBS];
+static mu_time_abs_t s_last_when;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_cron_compile(void);
+void test_mu_cron_next_local(void);
+void test_mu_cron_day_rule(void);
+void test_mu_cron_rare(void);
+void test_mu_cron_brute_force(void);
+void test_mu_cron_dst(void);
+void test_mu_cron_sched(void);
+
+static mu_time_abs_t at(int64_t seconds);
+static bool brute_next(const char *expr, const mu_cron_t *cron, int64_t after,
+                       int64_t limit, int64_t *next);
+static bool field_starts_with_star(const char *expr, int field);
+static void count_fn(mu_cron_job_t *job, mu_time_abs_t when, void *arg);
+static void stop_fn(mu_cron_job_t *job, mu_time_abs_t when, void *arg);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_mu_cron_compile(void) {
+    mu_cron_t c;
+
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "*/15 0-6/2 1,15 * *"));
+    TEST_ASSERT_EQUAL_HEX64((1ULL << 0) | (1ULL << 15) | (1ULL << 30) |
+                                (1ULL << 45),
+                            c.minutes);
+    TEST_ASSERT_EQUAL_HEX32(0x55, c.hours);
+    TEST_ASSERT_EQUAL_HEX32((1u << 1) | (1u << 15), c.days);
+    TEST_ASSERT_EQUAL_HEX16(0x1ffe, c.months);
+    TEST_ASSERT_FALSE(c.any_day);
+    TEST_ASSERT_TRUE(c.any_weekday);
+
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, " 30 2 * jan-MAR,dec Mon-fri "));
+    TEST_ASSERT_EQUAL_HEX16((1u << 1) | (1u << 2) | (1u << 3) | (1u << 12),
+                            c.months);
+    TEST_ASSERT_EQUAL_HEX8(0x3e, c.weekdays);
+
+    // 7 is Sunday; "a/n" runs to the end of the field
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "50/5 * * * 5-7"));
+    TEST_ASSERT_EQUAL_HEX64((1ULL << 50) | (1ULL << 55), c.minutes);
+    TEST_ASSERT_EQUAL_HEX8(0x61, c.weekdays);
+
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "@weekly"));
+    TEST_ASSERT_EQUAL_HEX8(0x01, c.weekdays);
+    TEST_ASSERT_EQUAL_HEX64(1, c.minutes);
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "@Hourly"));
+    TEST_ASSERT_EQUAL_HEX32(0xffffff, c.hours);
+
+    const char *bad[] = {"",          "* * * *",     "* * * * * *",
+                         "60 * * * *", "* 24 * * *",  "* * 0 * *",
+                         "* * * 13 *", "* * * * 8",   "5-1 * * * *",
+                         "*/0 * * * *", "*/ * * * *", "a * * * *",
+                         "* * * foo *", "1,,2 * * * *", "@never",
+                         "1-2-3 * * * *"};
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        TEST_ASSERT_FALSE_MESSAGE(mu_cron_compile(&c, bad[i]), bad[i]);
+    }
+}
+
+void test_mu_cron_next_local(void) {
+    mu_cron_t c;
+    int64_t next;
+
+    // Every weekday at 02:30, from Friday 2025-01-03 03:00: Monday.
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "30 2 * * 1-5"));
+    TEST_ASSERT_TRUE(
+        mu_cron_next_local(&c, JAN_1_2025 + 2 * DAY + 3 * 3600, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 5 * DAY + 9000, next);
+    TEST_ASSERT_TRUE(mu_cron_matches_local(&c, next + 59));
+    TEST_ASSERT_FALSE(mu_cron_matches_local(&c, next + 60));
+
+    // Strictly after: an exact match is skipped.
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, next, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 6 * DAY + 9000, next);
+
+    // Year rollover.
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "0 0 1 1 *"));
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, JAN_1_2025, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 365 * DAY, next);
+
+    // Before the epoch.
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "59 23 31 12 *"));
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, -DAY, &next));
+    TEST_ASSERT_EQUAL_INT64(-60, next);
+}
+
+void test_mu_cron_day_rule(void) {
+    mu_cron_t c;
+    int64_t next;
+
+    // Both day fields restricted: either matches (Friday Jan 3).
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "0 0 13 * fri"));
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, JAN_1_2025, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 2 * DAY, next);
+
+    // Only one restricted: it alone decides.
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "0 0 13 * *"));
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, JAN_1_2025, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 12 * DAY, next);
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "0 0 * * fri"));
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, JAN_1_2025 + 3 * DAY, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 9 * DAY, next);
+
+    // A stepped `*` is still a restriction: days 1, 4, 7, ... 28, 31.
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "13 4 */3 * *"));
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, JAN_1_2025, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 4 * 3600 + 13 * 60, next);
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, next, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 3 * DAY + 4 * 3600 + 13 * 60, next);
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, JAN_1_2025 + 28 * DAY, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 30 * DAY + 4 * 3600 + 13 * 60, next);
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, next, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 31 * DAY + 4 * 3600 + 13 * 60, next);
+
+    // ...and, since it starts with `*`, a day must match both fields: odd
+    // days that are Mondays (Jan 13 and 27, not Jan 6).
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "0 0 */2 * 1"));
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, JAN_1_2025, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 12 * DAY, next);
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, next, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 26 * DAY, next);
+    TEST_ASSERT_FALSE(mu_cron_matches_local(&c, JAN_1_2025 + 5 * DAY));
+}
+
+void test_mu_cron_rare(void) {
+    mu_cron_t c;
+    int64_t next;
+
+    // Feb 29 three years out, the 31st only in long months.
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "0 12 29 feb *"));
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, JAN_1_2025, &next));
+    TEST_ASSERT_EQUAL_INT64(1835438400, next); // 2028-02-29 12:00
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "0 0 31 * *"));
+    TEST_ASSERT_TRUE(mu_cron_next_local(&c, JAN_1_2025 + 31 * DAY, &next));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + (31 + 28 + 30) * DAY, next); // Mar 31
+
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "0 0 30 2 *"));
+    TEST_ASSERT_FALSE(mu_cron_next_local(&c, JAN_1_2025, &next));
+}
+
+void test_mu_cron_brute_force(void) {
+    static const char *exprs[] = {
+        "*/7 */5 * * *",   "13 4 */3 * *",      "0 0 * * 0",
+        "5,35 8-17 * * 1-5", "0 */6 1-7 * 2",   "45 23 * 2,8 *",
+        "0 12 15 * 6",     "*/20 1 28-31 * *",  "17 * * * 3,5",
+        "0 0 1 */2 *",     "59 0 * jun-aug sat", "0 3 10,20,30 * sun",
+        "0 0 */2 * 1",     "30 6 1-15 * */2",
+    };
+    mu_cron_t c;
+
+    srand(1);
+    for (size_t e = 0; e < sizeof(exprs) / sizeof(exprs[0]); e++) {
+        TEST_ASSERT_TRUE(mu_cron_compile(&c, exprs[e]));
+        for (int i = 0; i < 20; i++) {
+            int64_t after = JAN_1_2025 + (int64_t)(rand() % (3 * 365)) * DAY +
+                            rand() % DAY;
+            int64_t expect, got;
+            if (!brute_next(exprs[e], &c, after, 120 * DAY, &expect)) {
+                continue;
+            }
+            TEST_ASSERT_TRUE(mu_cron_next_local(&c, after, &got));
+            TEST_ASSERT_EQUAL_INT64_MESSAGE(expect, got, exprs[e]);
+        }
+    }
+}
+
+void test_mu_cron_dst(void) {
+    mu_time_bucket_zone_t zone;
+    mu_cron_t c;
+    mu_time_abs_t next;
+
+    setenv("TZ", "EST5EDT,M3.2.0,M11.1.0", 1);
+    tzset();
+    mu_time_bucket_zone_init(&zone);
+
+    // 2025-03-09 02:30 local does not exist; it runs at 03:30 EDT (07:30Z).
+    int64_t mar9 = 1741478400; // 2025-03-09 00:00Z
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "30 2 * * *"));
+    TEST_ASSERT_TRUE(mu_cron_next(&c, &zone, at(mar9 + 5 * 3600), &next));
+    TEST_ASSERT_EQUAL_INT64(mar9 + 7 * 3600 + 1800, next.seconds);
+    TEST_ASSERT_EQUAL_INT64(0, next.nanoseconds);
+    // The day after, 02:30 EDT again.
+    TEST_ASSERT_TRUE(mu_cron_next(&c, &zone, next, &next));
+    TEST_ASSERT_EQUAL_INT64(mar9 + DAY + 6 * 3600 + 1800, next.seconds);
+
+    // 03:30 on the same day is 07:30Z too: a valid time in the new offset.
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "30 3 * * *"));
+    TEST_ASSERT_TRUE(mu_cron_next(&c, &zone, at(mar9 + 5 * 3600), &next));
+    TEST_ASSERT_EQUAL_INT64(mar9 + 7 * 3600 + 1800, next.seconds);
+
+    // 2025-11-02 01:30 local happens twice (05:30Z EDT, 06:30Z EST).
+    int64_t nov2 = 1762041600; // 2025-11-02 00:00Z
+    TEST_ASSERT_TRUE(mu_cron_compile(&c, "30 1 * * *"));
+    TEST_ASSERT_TRUE(mu_cron_next(&c, &zone, at(nov2 + 4 * 3600), &next));
+    TEST_ASSERT_EQUAL_INT64(nov2 + 5 * 3600 + 1800, next.seconds);
+    // Asked from inside the repeated hour, the second one is next...
+    TEST_ASSERT_TRUE(mu_cron_next(&c, &zone, at(nov2 + 6 * 3600 + 600), &next));
+    TEST_ASSERT_EQUAL_INT64(nov2 + 6 * 3600 + 1800, next.seconds);
+
+    // ...but a job that ran the first one skips it.
+    mu_timer_wheel_t wheel;
+    mu_cron_sched_t sched;
+    mu_cron_job_t job;
+    s_fired[0] = 0;
+    mu_timer_wheel_init(&wheel, at(nov2 + 4 * 3600), 1000000000, NULL);
+    mu_cron_sched_init(&sched, &wheel, &zone);
+    mu_cron_job_init(&job, &c, count_fn, &s_fired[0]);
+    TEST_ASSERT_TRUE(mu_cron_job_start(&sched, &job, at(nov2 + 4 * 3600)));
+    for (int64_t t = nov2 + 4 * 3600; t <= nov2 + 8 * 3600; t += 60) {
+        mu_timer_wheel_advance(&wheel, at(t));
+    }
+    TEST_ASSERT_EQUAL_INT(1, s_fired[0]);
+    TEST_ASSERT_EQUAL_INT64(nov2 + 5 * 3600 + 1800, s_last_when.seconds);
+    TEST_ASSERT_EQUAL_INT64(nov2 + DAY + 6 * 3600 + 1800,
+                            mu_cron_job_next(&job).seconds);
+    mu_cron_job_stop(&job);
+    TEST_ASSERT_FALSE(mu_cron_job_is_running(&job));
+
+    unsetenv("TZ");
+    tzset();
+}
+
+void test_mu_cron_sched(void) {
+    static mu_cron_job_t jobs[JOBS];
+    static mu_cron_t exprs[3];
+    mu_time_bucket_zone_t zone;
+    mu_timer_wheel_t wheel;
+    mu_cron_sched_t sched;
+    mu_cron_job_t stopper;
+    int stops = 0;
+    int64_t t0 = JAN_1_2025 + 10;
+
+    mu_time_bucket_zone_init_utc(&zone);
+    TEST_ASSERT_TRUE(mu_cron_compile(&exprs[0], "*/15 * * * *"));
+    TEST_ASSERT_TRUE(mu_cron_compile(&exprs[1], "0 * * * *"));
+    TEST_ASSERT_TRUE(mu_cron_compile(&exprs[2], "0 0 30 2 *"));
+    mu_timer_wheel_init(&wheel, at(t0), 1000000000, NULL);
+    mu_cron_sched_init(&sched, &wheel, &zone);
+
+    for (int i = 0; i < JOBS; i++) {
+        s_fired[i] = 0;
+        mu_cron_job_init(&jobs[i], &exprs[i % 2], count_fn, &s_fired[i]);
+        TEST_ASSERT_TRUE(mu_cron_job_start(&sched, &jobs[i], at(t0)));
+    }
+    mu_cron_job_init(&stopper, &exprs[0], stop_fn, &stops);
+    TEST_ASSERT_TRUE(mu_cron_job_start(&sched, &stopper, at(t0)));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 900,
+                            mu_cron_job_next(&stopper).seconds);
+    TEST_ASSERT_EQUAL_size_t(JOBS + 1, mu_timer_wheel_pending(&wheel));
+
+    mu_cron_job_t never;
+    mu_cron_job_init(&never, &exprs[2], count_fn, NULL);
+    TEST_ASSERT_FALSE(mu_cron_job_start(&sched, &never, at(t0)));
+    TEST_ASSERT_FALSE(mu_cron_job_is_running(&never));
+
+    // Three hours in one-minute steps.
+    for (int64_t t = t0; t <= t0 + 3 * 3600; t += 60) {
+        mu_timer_wheel_advance(&wheel, at(t));
+    }
+    for (int i = 0; i < JOBS; i++) {
+        TEST_ASSERT_EQUAL_INT(i % 2 == 0 ? 12 : 3, s_fired[i]);
+        TEST_ASSERT_TRUE(mu_cron_job_is_running(&jobs[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(1, stops);
+    TEST_ASSERT_FALSE(mu_cron_job_is_running(&stopper));
+    TEST_ASSERT_EQUAL_INT64(JAN_1_2025 + 3 * 3600, s_last_when.seconds);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_cron_compile);
+    RUN_TEST(test_mu_cron_next_local);
+    RUN_TEST(test_mu_cron_day_rule);
+    RUN_TEST(test_mu_cron_rare);
+    RUN_TEST(test_mu_cron_brute_force);
+    RUN_TEST(test_mu_cron_dst);
+    RUN_TEST(test_mu_cron_sched);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static mu_time_abs_t at(int64_t seconds) {
+    return mu_time_posix_from_nanos(seconds * 1000000000);
+}
+
+/**
+ * @brief Step minute by minute, matching fields with gmtime_r().
+ *
+ * The day rule comes from the expression text, as Vixie cron states it: if
+ * either day field starts with `*`, both must match, otherwise either may.
+ */
+static bool brute_next(const char *expr, const mu_cron_t *cron, int64_t after,
+                       int64_t limit, int64_t *next) {
+    int64_t t = (after / 60 + 1) * 60;
+    bool both = field_starts_with_star(expr, 2) ||
+                field_starts_with_star(expr, 4);
+
+    for (; t < after + limit; t += 60) {
+        time_t tt = (time_t)t;
+        struct tm tm;
+        gmtime_r(&tt, &tm);
+        bool dom = cron->days >> tm.tm_mday & 1;
+        bool dow = cron->weekdays >> tm.tm_wday & 1;
+        bool day = both ? (dom && dow) : (dom || dow);
+        if ((cron->minutes >> tm.tm_min & 1) &&
+            (cron->hours >> tm.tm_hour & 1) &&
+            (cron->months >> (tm.tm_mon + 1) & 1) && day) {
+            *next = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Return true if field `field` (from 0) of a five-field expression
+ * starts with `*`.
+ */
+static bool field_starts_with_star(const char *expr, int field) {
+    for (int f = 0; f < field; f++) {
+        expr += strcspn(expr, " ");
+        expr += strspn(expr, " ");
+    }
+    return *expr == '*';
+}
+
+static void count_fn(mu_cron_job_t *job, mu_time_abs_t when, void *arg) {
+    (void)job;
+    *(int *)arg += 1;
+    s_last_when = when;
+}
+
+static void stop_fn(mu_cron_job_t *job, mu_time_abs_t when, void *arg) {
+    (void)when;
+    *(int *)arg += 1;
+    mu_cron_job_stop(job);
+}
+
+// *****************************************************************************
+// End of file
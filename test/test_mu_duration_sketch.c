@@ -0,0 +1,214 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_duration_sketch.h"
+#include "mu_time.h"
+#include "unity.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_VALUES 20000
+#define N_BINS 1024
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_duration_sketch_t s_a;
+static mu_duration_sketch_t s_b;
+static uint32_t s_bins_a[N_BINS];
+static uint32_t s_bins_b[N_BINS];
+static mu_time_rel_t s_values[N_VALUES];
+static uint8_t s_buf[8192];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_duration_sketch_empty(void);
+void test_mu_duration_sketch_small_values_exact(void);
+void test_mu_duration_sketch_relative_error(void);
+void test_mu_duration_sketch_merge(void);
+void test_mu_duration_sketch_serialize(void);
+void test_mu_duration_sketch_collapse_keeps_tail(void);
+
+static void fill_values(uint32_t seed);
+static int compare_rel(const void *a, const void *b);
+static void assert_relative(mu_time_rel_t expected, mu_time_rel_t actual);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    mu_duration_sketch_init(&s_a, s_bins_a, N_BINS);
+    mu_duration_sketch_init(&s_b, s_bins_b, N_BINS);
+}
+
+void tearDown(void) {}
+
+void test_mu_duration_sketch_empty(void) {
+    TEST_ASSERT_EQUAL_UINT64(0, mu_duration_sketch_count(&s_a));
+    TEST_ASSERT_EQUAL_INT64(0, mu_duration_sketch_quantile(&s_a, 0.5f));
+}
+
+void test_mu_duration_sketch_small_values_exact(void) {
+    for (int i = 0; i < 10; i++) {
+        mu_duration_sketch_record(&s_a, i);
+    }
+    mu_duration_sketch_record(&s_a, -5);  // clamped to zero
+    TEST_ASSERT_EQUAL_UINT64(11, mu_duration_sketch_count(&s_a));
+    TEST_ASSERT_EQUAL_INT64(45, mu_duration_sketch_sum(&s_a));
+    TEST_ASSERT_EQUAL_INT64(0, mu_duration_sketch_min(&s_a));
+    TEST_ASSERT_EQUAL_INT64(9, mu_duration_sketch_max(&s_a));
+    TEST_ASSERT_EQUAL_INT64(4, mu_duration_sketch_quantile(&s_a, 0.5f));
+}
+
+void test_mu_duration_sketch_relative_error(void) {
+    const float qs[] = {0.01f, 0.25f, 0.5f, 0.9f, 0.99f, 0.999f};
+
+    fill_values(42);
+    for (int i = 0; i < N_VALUES; i++) {
+        mu_duration_sketch_record(&s_a, s_values[i]);
+    }
+    qsort(s_values, N_VALUES, sizeof(s_values[0]), compare_rel);
+    for (size_t k = 0; k < sizeof(qs) / sizeof(qs[0]); k++) {
+        size_t rank = (size_t)(qs[k] * (N_VALUES - 1));
+        assert_relative(s_values[rank], mu_duration_sketch_quantile(&s_a, qs[k]));
+    }
+    TEST_ASSERT_EQUAL_INT64(s_values[N_VALUES - 1],
+                            mu_duration_sketch_quantile(&s_a, 1.0f));
+
+    // the one-pass variant agrees with individual queries
+    mu_time_rel_t out[6];
+    mu_duration_sketch_quantiles(&s_a, qs, 6, out);
+    for (size_t k = 0; k < 6; k++) {
+        TEST_ASSERT_EQUAL_INT64(mu_duration_sketch_quantile(&s_a, qs[k]), out[k]);
+    }
+}
+
+void test_mu_duration_sketch_merge(void) {
+    mu_duration_sketch_t whole;
+    static uint32_t bins[N_BINS];
+
+    mu_duration_sketch_init(&whole, bins, N_BINS);
+    fill_values(7);
+    for (int i = 0; i < N_VALUES; i++) {
+        // disjoint ranges so the merge has to widen the window
+        mu_time_rel_t v = (i % 2) ? s_values[i] : s_values[i] / 1000;
+        mu_duration_sketch_record((i % 2) ? &s_a : &s_b, v);
+        mu_duration_sketch_record(&whole, v);
+    }
+    mu_duration_sketch_merge(&s_a, &s_b);
+    TEST_ASSERT_EQUAL_UINT64(mu_duration_sketch_count(&whole),
+                             mu_duration_sketch_count(&s_a));
+    TEST_ASSERT_EQUAL_INT64(mu_duration_sketch_sum(&whole),
+                            mu_duration_sketch_sum(&s_a));
+    for (float q = 0.05f; q < 1.0f; q += 0.1f) {
+        TEST_ASSERT_EQUAL_INT64(mu_duration_sketch_quantile(&whole, q),
+                                mu_duration_sketch_quantile(&s_a, q));
+    }
+}
+
+void test_mu_duration_sketch_serialize(void) {
+    size_t len;
+
+    fill_values(99);
+    for (int i = 0; i < 1000; i++) {
+        mu_duration_sketch_record(&s_a, s_values[i]);
+    }
+    TEST_ASSERT_EQUAL(0, mu_duration_sketch_serialize(&s_a, s_buf, 8));
+    len = mu_duration_sketch_serialize(&s_a, s_buf, sizeof(s_buf));
+    TEST_ASSERT_TRUE(len > 0);
+    TEST_ASSERT_TRUE(len < 3 * (size_t)s_a.span + 40);
+
+    TEST_ASSERT_TRUE(mu_duration_sketch_deserialize(&s_b, s_buf, len));
+    TEST_ASSERT_EQUAL_UINT64(1000, mu_duration_sketch_count(&s_b));
+    TEST_ASSERT_EQUAL_INT64(mu_duration_sketch_min(&s_a), mu_duration_sketch_min(&s_b));
+    TEST_ASSERT_EQUAL_INT64(mu_duration_sketch_quantile(&s_a, 0.9f),
+                            mu_duration_sketch_quantile(&s_b, 0.9f));
+    TEST_ASSERT_FALSE(mu_duration_sketch_deserialize(&s_b, s_buf, len - 1));
+}
+
+void test_mu_duration_sketch_collapse_keeps_tail(void) {
+    mu_duration_sketch_t small;
+    uint32_t bins[96];  // three octaves
+
+    mu_duration_sketch_init(&small, bins, 96);
+    fill_values(3);
+    for (int i = 0; i < N_VALUES; i++) {
+        mu_duration_sketch_record(&small, s_values[i]);
+    }
+    TEST_ASSERT_EQUAL(1, small.collapsed);
+    TEST_ASSERT_TRUE(small.span <= 96);
+    qsort(s_values, N_VALUES, sizeof(s_values[0]), compare_rel);
+    assert_relative(s_values[(size_t)(0.99f * (N_VALUES - 1))],
+                    mu_duration_sketch_quantile(&small, 0.99f));
+    TEST_ASSERT_EQUAL_UINT64(N_VALUES, mu_duration_sketch_count(&small));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_duration_sketch_empty);
+    RUN_TEST(test_mu_duration_sketch_small_values_exact);
+    RUN_TEST(test_mu_duration_sketch_relative_error);
+    RUN_TEST(test_mu_duration_sketch_merge);
+    RUN_TEST(test_mu_duration_sketch_serialize);
+    RUN_TEST(test_mu_duration_sketch_collapse_keeps_tail);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void fill_values(uint32_t seed) {
+    // Heavy-tailed latencies: 10 uSec to ~10 Sec in nanoseconds.
+    for (int i = 0; i < N_VALUES; i++) {
+        seed = seed * 1103515245 + 12345;
+        int octave = (int)((seed >> 16) % 20);
+        seed = seed * 1103515245 + 12345;
+        s_values[i] = (10000LL << octave) + (mu_time_rel_t)(seed >> 8) % (10000LL << octave);
+    }
+}
+
+static int compare_rel(const void *a, const void *b) {
+    mu_time_rel_t x = *(const mu_time_rel_t *)a;
+    mu_time_rel_t y = *(const mu_time_rel_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void assert_relative(mu_time_rel_t expected, mu_time_rel_t actual) {
+    double err = (double)(actual - expected) / (double)expected;
+    if (err < 0) {
+        err = -err;
+    }
+    TEST_ASSERT_TRUE(err <= mu_duration_sketch_relative_error());
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,275 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_fire_queue.h"
+#include "mu_time.h"
+#include "unity.h"
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_ENTRIES 40           // spans two bitmap words
+#define N_THREADS 3
+#define POSTS_PER_THREAD 200000
+#define HAMMER_DURATION_NS 300000000
+
+typedef struct {
+    uint64_t delivered;
+    uint32_t calls;
+} tally_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_fire_queue_t s_q;
+static mu_fire_t s_fires[N_ENTRIES];
+static tally_t s_tallies[N_ENTRIES];
+static atomic_uint_fast64_t s_posted[N_ENTRIES];
+static atomic_uint s_signal_seq;
+static atomic_uint_fast64_t s_signals;
+static atomic_bool s_time_ok;
+static pthread_t s_main;
+static atomic_bool s_stop;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_fire_queue_attach(void);
+void test_mu_fire_queue_coalesce(void);
+void test_mu_fire_queue_repost_from_callback(void);
+void test_mu_fire_queue_signal_hammer(void);
+
+static void tally_fn(mu_fire_t *fire, uint32_t posts, void *arg);
+static void repost_fn(mu_fire_t *fire, uint32_t posts, void *arg);
+static void on_signal(int signo);
+static void *poster(void *arg);
+static void *signaller(void *arg);
+static void attach_all(void);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    memset(s_tallies, 0, sizeof(s_tallies));
+    for (int i = 0; i < N_ENTRIES; i++) {
+        atomic_init(&s_posted[i], 0);
+    }
+    mu_fire_queue_init(&s_q);
+}
+
+void tearDown(void) {}
+
+void test_mu_fire_queue_attach(void) {
+    mu_fire_queue_t q;
+    static mu_fire_t fires[MU_FIRE_QUEUE_CAPACITY + 1];
+
+    mu_fire_queue_init(&q);
+    for (int i = 0; i < MU_FIRE_QUEUE_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(mu_fire_queue_attach(&q, &fires[i], tally_fn, NULL));
+    }
+    TEST_ASSERT_FALSE(mu_fire_queue_attach(&q, &fires[MU_FIRE_QUEUE_CAPACITY],
+                                           tally_fn, NULL));
+    TEST_ASSERT_FALSE(mu_fire_queue_is_pending(&q));
+    TEST_ASSERT_EQUAL_size_t(0, mu_fire_queue_drain(&q));
+}
+
+void test_mu_fire_queue_coalesce(void) {
+    attach_all();
+
+    mu_fire_post(&s_q, &s_fires[3]);
+    mu_fire_post(&s_q, &s_fires[35]);
+    mu_fire_post(&s_q, &s_fires[3]);
+    mu_fire_post(&s_q, &s_fires[3]);
+    TEST_ASSERT_TRUE(mu_fire_queue_is_pending(&s_q));
+
+    TEST_ASSERT_EQUAL_size_t(2, mu_fire_queue_drain(&s_q));
+    TEST_ASSERT_EQUAL_UINT32(1, s_tallies[3].calls);
+    TEST_ASSERT_EQUAL_UINT64(3, s_tallies[3].delivered);
+    TEST_ASSERT_EQUAL_UINT64(1, s_tallies[35].delivered);
+    TEST_ASSERT_FALSE(mu_fire_queue_is_pending(&s_q));
+    TEST_ASSERT_EQUAL_size_t(0, mu_fire_queue_drain(&s_q));
+}
+
+void test_mu_fire_queue_repost_from_callback(void) {
+    mu_fire_t fire;
+    int budget = 2;
+
+    TEST_ASSERT_TRUE(mu_fire_queue_attach(&s_q, &fire, repost_fn, &budget));
+    mu_fire_post(&s_q, &fire);
+    // The repost lands after the entry's count was claimed: next drain
+    TEST_ASSERT_EQUAL_size_t(1, mu_fire_queue_drain(&s_q));
+    TEST_ASSERT_TRUE(mu_fire_queue_is_pending(&s_q));
+    TEST_ASSERT_EQUAL_size_t(1, mu_fire_queue_drain(&s_q));
+    TEST_ASSERT_EQUAL_size_t(1, mu_fire_queue_drain(&s_q));
+    TEST_ASSERT_EQUAL_size_t(0, mu_fire_queue_drain(&s_q));
+    TEST_ASSERT_EQUAL_INT(0, budget);
+}
+
+void test_mu_fire_queue_signal_hammer(void) {
+    struct sigaction sa;
+    struct itimerval it = {{0, 50}, {0, 50}};
+    pthread_t posters[N_THREADS], sig_thread;
+
+    attach_all();
+    atomic_init(&s_signal_seq, 0);
+    atomic_init(&s_signals, 0);
+    atomic_init(&s_time_ok, true);
+    atomic_init(&s_stop, false);
+    s_main = pthread_self();
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    TEST_ASSERT_EQUAL_INT(0, sigaction(SIGALRM, &sa, NULL));
+    TEST_ASSERT_EQUAL_INT(0, sigaction(SIGUSR1, &sa, NULL));
+
+    // Signals interrupt the main thread mid-drain, including in the middle of
+    // its own posts, while other threads post to the same entries.
+    TEST_ASSERT_EQUAL_INT(0, setitimer(ITIMER_REAL, &it, NULL));
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&sig_thread, NULL, signaller, NULL));
+    for (intptr_t i = 0; i < N_THREADS; i++) {
+        TEST_ASSERT_EQUAL_INT(
+            0, pthread_create(&posters[i], NULL, poster, (void *)i));
+    }
+
+    mu_time_abs_t end = mu_time_offset(mu_time_now(), HAMMER_DURATION_NS);
+    unsigned seq = 0;
+    while (mu_time_is_before(mu_time_now(), end)) {
+        mu_fire_post(&s_q, &s_fires[seq++ % N_ENTRIES]);
+        atomic_fetch_add(&s_posted[(seq - 1) % N_ENTRIES], 1);
+        mu_fire_queue_drain(&s_q);
+    }
+    for (int i = 0; i < N_THREADS; i++) {
+        pthread_join(posters[i], NULL);
+    }
+    atomic_store(&s_stop, true);
+    pthread_join(sig_thread, NULL);
+
+    struct itimerval off = {{0, 0}, {0, 0}};
+    setitimer(ITIMER_REAL, &off, NULL);
+    signal(SIGALRM, SIG_IGN);
+    signal(SIGUSR1, SIG_IGN);
+    mu_fire_queue_drain(&s_q);
+
+    uint64_t total = 0;
+    for (int i = 0; i < N_ENTRIES; i++) {
+        TEST_ASSERT_EQUAL_UINT64(atomic_load(&s_posted[i]),
+                                 s_tallies[i].delivered);
+        total += s_tallies[i].delivered;
+    }
+    TEST_ASSERT_TRUE(atomic_load(&s_signals) > 100);
+    TEST_ASSERT_TRUE(total > N_THREADS * POSTS_PER_THREAD);
+    TEST_ASSERT_TRUE(atomic_load(&s_time_ok));
+    TEST_ASSERT_FALSE(mu_fire_queue_is_pending(&s_q));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_fire_queue_attach);
+    RUN_TEST(test_mu_fire_queue_coalesce);
+    RUN_TEST(test_mu_fire_queue_repost_from_callback);
+    RUN_TEST(test_mu_fire_queue_signal_hammer);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void tally_fn(mu_fire_t *fire, uint32_t posts, void *arg) {
+    tally_t *tally = &s_tallies[fire - s_fires];
+
+    (void)arg;
+    TEST_ASSERT_TRUE(posts > 0);
+    tally->delivered += posts;
+    tally->calls += 1;
+}
+
+static void repost_fn(mu_fire_t *fire, uint32_t posts, void *arg) {
+    int *budget = arg;
+
+    TEST_ASSERT_EQUAL_UINT32(1, posts);
+    if (*budget > 0) {
+        *budget -= 1;
+        mu_fire_post(&s_q, fire);
+    }
+}
+
+static void on_signal(int signo) {
+    int saved_errno = errno;
+    unsigned n = atomic_fetch_add(&s_signal_seq, 1);
+    int i = (int)((n * 7u + (unsigned)signo) % N_ENTRIES);
+
+    // Exercise the signal-safe mu_time subset
+    mu_time_abs_t now = mu_time_now();
+    mu_time_rel_t delta = mu_time_rel_from_millis((int32_t)(n % 5000));
+    mu_time_abs_t later = mu_time_offset(now, delta + 1);
+    if (mu_time_difference(now, later) != delta + 1 ||
+        !mu_time_is_before(now, later) || !mu_time_is_after(later, now)) {
+        atomic_store(&s_time_ok, false);
+    }
+    mu_fire_post(&s_q, &s_fires[i]);
+    atomic_fetch_add(&s_posted[i], 1);
+    atomic_fetch_add(&s_signals, 1);
+    errno = saved_errno;
+}
+
+static void *poster(void *arg) {
+    intptr_t id = (intptr_t)arg;
+
+    for (int n = 0; n < POSTS_PER_THREAD; n++) {
+        int i = (int)((n + id * 13) % N_ENTRIES);
+        mu_fire_post(&s_q, &s_fires[i]);
+        atomic_fetch_add(&s_posted[i], 1);
+    }
+    return NULL;
+}
+
+static void *signaller(void *arg) {
+    (void)arg;
+    while (!atomic_load(&s_stop)) {
+        pthread_kill(s_main, SIGUSR1);
+        for (volatile int spin = 0; spin < 2000; spin++) {
+        }
+    }
+    return NULL;
+}
+
+static void attach_all(void) {
+    for (int i = 0; i < N_ENTRIES; i++) {
+        mu_fire_queue_attach(&s_q, &s_fires[i], tally_fn, NULL);
+    }
+}
+
+// *****************************************************************************
+// End of file
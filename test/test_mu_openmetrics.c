@@ -0,0 +1,220 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_clock_map.h"
+#include "mu_duration_sketch.h"
+#include "mu_openmetrics.h"
+#include "mu_time.h"
+#include "mu_timer_wheel.h"
+#include "unity.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_SERIES 8
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_openmetrics_t s_exporter;
+static mu_openmetrics_series_t s_series[N_SERIES];
+static mu_duration_sketch_t s_get;
+static mu_duration_sketch_t s_put;
+static uint32_t s_get_bins[256];
+static uint32_t s_put_bins[256];
+static mu_timer_wheel_t s_wheel;
+static mu_timer_t s_timers[3];
+static mu_clock_map_t s_cm;
+static char s_text[4096];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_openmetrics_empty(void);
+void test_mu_openmetrics_full_render(void);
+void test_mu_openmetrics_incremental_render(void);
+void test_mu_openmetrics_limits(void);
+
+static int64_t answer(void *arg);
+static void on_timer(mu_timer_t *timer, void *arg);
+static size_t render_all(size_t chunk);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    mu_time_abs_t origin = {1000, 0};
+
+    mu_openmetrics_init(&s_exporter, s_series, N_SERIES);
+    mu_duration_sketch_init(&s_get, s_get_bins, 256);
+    mu_duration_sketch_init(&s_put, s_put_bins, 256);
+    mu_timer_wheel_init(&s_wheel, origin, 1000000, NULL);
+    mu_clock_map_init(&s_cm, 1000);
+}
+
+void tearDown(void) {}
+
+void test_mu_openmetrics_empty(void) {
+    TEST_ASSERT_EQUAL(6, render_all(sizeof(s_text)));
+    TEST_ASSERT_EQUAL_STRING("# EOF\n", s_text);
+}
+
+void test_mu_openmetrics_full_render(void) {
+    mu_time_abs_t origin = {1000, 0};
+    int32_t arg = 42;
+
+    for (int i = 0; i < 3; i++) {
+        mu_timer_init(&s_timers[i], on_timer, NULL);
+        mu_timer_wheel_arm(&s_wheel, &s_timers[i], mu_time_offset(origin, 5000000));
+    }
+    mu_duration_sketch_record(&s_get, 1500000);  // 1.5 mSec
+    mu_duration_sketch_record(&s_put, 2000000000); // 2 Sec
+    mu_duration_sketch_record(&s_put, 2000000000);
+    mu_clock_map_add_sample(&s_cm, 100, origin);
+
+    // Series of one family registered apart end up grouped.
+    TEST_ASSERT_TRUE(mu_openmetrics_add_sketch(&s_exporter, "rpc_seconds",
+                                               "op=\"get\"", &s_get));
+    TEST_ASSERT_TRUE(mu_openmetrics_add_timer_wheel(&s_exporter, "timers", "",
+                                                    &s_wheel));
+    TEST_ASSERT_TRUE(mu_openmetrics_add_sketch(&s_exporter, "rpc_seconds",
+                                               "op=\"put\"", &s_put));
+    TEST_ASSERT_TRUE(mu_openmetrics_add_clock_map(&s_exporter, "dev_clock",
+                                                  "dev=\"a\"", &s_cm));
+    TEST_ASSERT_TRUE(mu_openmetrics_add_gauge(&s_exporter, "answer", "", answer,
+                                              &arg));
+
+    render_all(sizeof(s_text));
+    TEST_ASSERT_EQUAL_STRING(
+        "# TYPE rpc_seconds summary\n"
+        "rpc_seconds{op=\"get\",quantile=\"0.5\"} 0.0015\n"
+        "rpc_seconds{op=\"get\",quantile=\"0.9\"} 0.0015\n"
+        "rpc_seconds{op=\"get\",quantile=\"0.99\"} 0.0015\n"
+        "rpc_seconds{op=\"get\",quantile=\"0.999\"} 0.0015\n"
+        "rpc_seconds_sum{op=\"get\"} 0.0015\n"
+        "rpc_seconds_count{op=\"get\"} 1\n"
+        "rpc_seconds{op=\"put\",quantile=\"0.5\"} 2\n"
+        "rpc_seconds{op=\"put\",quantile=\"0.9\"} 2\n"
+        "rpc_seconds{op=\"put\",quantile=\"0.99\"} 2\n"
+        "rpc_seconds{op=\"put\",quantile=\"0.999\"} 2\n"
+        "rpc_seconds_sum{op=\"put\"} 4\n"
+        "rpc_seconds_count{op=\"put\"} 2\n"
+        "# TYPE timers_pending gauge\n"
+        "timers_pending{level=\"0\"} 3\n"
+        "timers_pending{level=\"1\"} 0\n"
+        "timers_pending{level=\"2\"} 0\n"
+        "timers_pending{level=\"3\"} 0\n"
+        "# TYPE timers_armed counter\n"
+        "timers_armed_total 3\n"
+        "# TYPE timers_fired counter\n"
+        "timers_fired_total 0\n"
+        "# TYPE timers_cancelled counter\n"
+        "timers_cancelled_total 0\n"
+        "# TYPE timers_cascaded counter\n"
+        "timers_cascaded_total 0\n"
+        "# TYPE dev_clock_skew_ppb gauge\n"
+        "dev_clock_skew_ppb{dev=\"a\"} 0\n"
+        "# TYPE dev_clock_hull_vertices gauge\n"
+        "dev_clock_hull_vertices{dev=\"a\"} 1\n"
+        "# TYPE dev_clock_samples counter\n"
+        "dev_clock_samples_total{dev=\"a\"} 1\n"
+        "# TYPE answer gauge\n"
+        "answer 42\n"
+        "# EOF\n",
+        s_text);
+}
+
+void test_mu_openmetrics_incremental_render(void) {
+    static char whole[4096];
+    size_t len;
+
+    for (int i = 0; i < 100; i++) {
+        mu_duration_sketch_record(&s_get, 1000 + i * 997);
+    }
+    mu_openmetrics_add_sketch(&s_exporter, "a_seconds", "x=\"1\"", &s_get);
+    mu_openmetrics_add_sketch(&s_exporter, "a_seconds", "x=\"2\"", &s_get);
+    mu_openmetrics_add_timer_wheel(&s_exporter, "w", "x=\"1\"", &s_wheel);
+
+    len = render_all(sizeof(s_text));
+    memcpy(whole, s_text, len + 1);
+    // the smallest buffer that always holds one line
+    TEST_ASSERT_EQUAL(len, render_all(MU_OPENMETRICS_LINE_MAX));
+    TEST_ASSERT_EQUAL_STRING(whole, s_text);
+}
+
+void test_mu_openmetrics_limits(void) {
+    char long_name[MU_OPENMETRICS_NAME_MAX + 1];
+
+    memset(long_name, 'x', sizeof(long_name) - 1);
+    long_name[sizeof(long_name) - 1] = '\0';
+    TEST_ASSERT_FALSE(mu_openmetrics_add_sketch(&s_exporter, long_name, "", &s_get));
+    for (int i = 0; i < N_SERIES; i++) {
+        TEST_ASSERT_TRUE(mu_openmetrics_add_sketch(&s_exporter, "s", "", &s_get));
+    }
+    TEST_ASSERT_FALSE(mu_openmetrics_add_sketch(&s_exporter, "s", "", &s_get));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_openmetrics_empty);
+    RUN_TEST(test_mu_openmetrics_full_render);
+    RUN_TEST(test_mu_openmetrics_incremental_render);
+    RUN_TEST(test_mu_openmetrics_limits);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static int64_t answer(void *arg) {
+    return *(int32_t *)arg;
+}
+
+static void on_timer(mu_timer_t *timer, void *arg) {
+    (void)timer;
+    (void)arg;
+}
+
+static size_t render_all(size_t chunk) {
+    mu_openmetrics_cursor_t cursor;
+    size_t len = 0;
+
+    mu_openmetrics_cursor_init(&cursor);
+    while (!mu_openmetrics_is_done(&cursor)) {
+        size_t n = mu_openmetrics_render(&s_exporter, &cursor, &s_text[len], chunk);
+        TEST_ASSERT_TRUE(n > 0);
+        len += n;
+    }
+    s_text[len] = '\0';
+    return len;
+}
+
+// *****************************************************************************
+// End of file
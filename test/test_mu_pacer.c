@@ -0,0 +1,236 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_pacer.h"
+#include "mu_time.h"
+#include "unity.h"
+
+// *****************************************************************************
+// Private types and definitions
+
+#define USEC 1000LL
+#define MSEC 1000000LL
+#define N_FLOWS 8
+
+// *****************************************************************************
+// Private (static) storage
+
+static const mu_time_abs_t s_t0 = {2000, 0};
+static mu_pacer_t s_pacer;
+static mu_pacer_flow_t s_flows[N_FLOWS];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_pacer_interval_arithmetic(void);
+void test_mu_pacer_no_drift(void);
+void test_mu_pacer_schedule_and_poll(void);
+void test_mu_pacer_batch_limit(void);
+void test_mu_pacer_max_lag(void);
+void test_mu_pacer_unschedule(void);
+void test_mu_pacer_rates_over_a_second(void);
+
+static mu_time_abs_t at(int64_t nanos);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    mu_pacer_init(&s_pacer, s_t0, 100 * USEC);
+}
+
+void tearDown(void) {}
+
+void test_mu_pacer_interval_arithmetic(void) {
+    mu_pacer_flow_t *f = &s_flows[0];
+
+    // 1 MB/s: 1000 ns per byte exactly
+    mu_pacer_flow_init(f, 1000000, s_t0, NULL);
+    mu_pacer_sent(&s_pacer, f, 1500, s_t0);
+    TEST_ASSERT_EQUAL_INT64(1500 * USEC,
+                            mu_time_difference(s_t0, mu_pacer_next_send(f)));
+
+    // 12.5 GB/s (100 Gbit/s): 0.08 ns per byte, rounded down; the shortfall
+    // stays in the carry
+    mu_pacer_set_rate(f, 12500000000ULL);
+    mu_time_abs_t before = mu_pacer_next_send(f);
+    mu_pacer_sent(&s_pacer, f, 9000, before);
+    TEST_ASSERT_INT64_WITHIN(1, 720, mu_time_difference(before,
+                                                        mu_pacer_next_send(f)));
+
+    // Unpaced
+    mu_pacer_set_rate(f, 0);
+    before = mu_pacer_next_send(f);
+    mu_pacer_sent(&s_pacer, f, 1500, before);
+    TEST_ASSERT_EQUAL_INT64(0, mu_time_difference(before, mu_pacer_next_send(f)));
+    TEST_ASSERT_EQUAL_UINT64(3, f->packets);
+    TEST_ASSERT_EQUAL_UINT64(12000, f->bytes);
+}
+
+void test_mu_pacer_no_drift(void) {
+    mu_pacer_flow_t *f = &s_flows[0];
+
+    // 3 bytes/us does not divide evenly: 333.33... ns per byte.  After a
+    // million 1-byte packets the fractional carry keeps the total exact
+    // to within a nanosecond.
+    mu_pacer_flow_init(f, 3000000, s_t0, NULL);
+    for (int i = 0; i < 1000000; i++) {
+        mu_pacer_sent(&s_pacer, f, 1, mu_pacer_next_send(f));
+    }
+    mu_time_rel_t total = mu_time_difference(s_t0, mu_pacer_next_send(f));
+    TEST_ASSERT_INT64_WITHIN(1, 333333333, total);
+}
+
+void test_mu_pacer_schedule_and_poll(void) {
+    mu_pacer_flow_t *batch[N_FLOWS];
+    mu_pacer_flow_t *f = &s_flows[0];
+    mu_time_abs_t when;
+
+    TEST_ASSERT_FALSE(mu_pacer_next_deadline(&s_pacer, s_t0, &when));
+
+    // A fresh flow is due at once
+    mu_pacer_flow_init(f, 1000000, s_t0, &s_flows[0]);
+    mu_pacer_schedule(&s_pacer, f, s_t0);
+    mu_pacer_schedule(&s_pacer, f, s_t0); // already scheduled: no effect
+    TEST_ASSERT_EQUAL_size_t(1, mu_pacer_due(&s_pacer));
+    TEST_ASSERT_TRUE(mu_pacer_next_deadline(&s_pacer, s_t0, &when));
+    TEST_ASSERT_EQUAL_INT64(0, mu_time_difference(s_t0, when));
+    TEST_ASSERT_EQUAL_size_t(1, mu_pacer_poll(&s_pacer, s_t0, batch, N_FLOWS));
+    TEST_ASSERT_EQUAL_PTR(f, batch[0]);
+    TEST_ASSERT_EQUAL_PTR(&s_flows[0], mu_pacer_flow_arg(batch[0]));
+
+    // After a 1000 byte packet at 1 MB/s it waits 1 ms, never less
+    mu_pacer_sent(&s_pacer, f, 1000, s_t0);
+    mu_pacer_schedule(&s_pacer, f, s_t0);
+    TEST_ASSERT_TRUE(mu_pacer_next_deadline(&s_pacer, s_t0, &when));
+    TEST_ASSERT_EQUAL_INT64(MSEC, mu_time_difference(s_t0, when));
+    TEST_ASSERT_EQUAL_size_t(0, mu_pacer_poll(&s_pacer, at(MSEC - USEC),
+                                              batch, N_FLOWS));
+    TEST_ASSERT_EQUAL_size_t(1, mu_pacer_poll(&s_pacer, at(MSEC), batch,
+                                              N_FLOWS));
+    TEST_ASSERT_FALSE(mu_pacer_next_deadline(&s_pacer, at(MSEC), &when));
+}
+
+void test_mu_pacer_batch_limit(void) {
+    mu_pacer_flow_t *batch[3];
+
+    for (int i = 0; i < N_FLOWS; i++) {
+        mu_pacer_flow_init(&s_flows[i], 1000000, s_t0, NULL);
+        mu_pacer_sent(&s_pacer, &s_flows[i], (uint32_t)(100 * (i + 1)), s_t0);
+        mu_pacer_schedule(&s_pacer, &s_flows[i], s_t0);
+    }
+    // All due by 1 ms: released three at a time, earliest first
+    size_t seen = 0;
+    size_t n;
+    while ((n = mu_pacer_poll(&s_pacer, at(MSEC), batch, 3)) > 0) {
+        for (size_t k = 0; k < n; k++) {
+            TEST_ASSERT_EQUAL_PTR(&s_flows[seen + k], batch[k]);
+        }
+        seen += n;
+    }
+    TEST_ASSERT_EQUAL_size_t(N_FLOWS, seen);
+    TEST_ASSERT_EQUAL_size_t(0, mu_pacer_due(&s_pacer));
+}
+
+void test_mu_pacer_max_lag(void) {
+    mu_pacer_flow_t *f = &s_flows[0];
+
+    // A flow stalled for 10 ms catches up by at most 100 us
+    mu_pacer_flow_init(f, 1000000, s_t0, NULL);
+    mu_pacer_sent(&s_pacer, f, 1000, s_t0);
+    mu_time_abs_t late = at(11 * MSEC);
+    mu_pacer_sent(&s_pacer, f, 1000, late);
+    TEST_ASSERT_EQUAL_INT64(MSEC - 100 * USEC,
+                            mu_time_difference(late, mu_pacer_next_send(f)));
+}
+
+void test_mu_pacer_unschedule(void) {
+    mu_pacer_flow_t *batch[N_FLOWS];
+
+    for (int i = 0; i < 3; i++) {
+        mu_pacer_flow_init(&s_flows[i], 1000000, s_t0, NULL);
+        mu_pacer_schedule(&s_pacer, &s_flows[i], s_t0);
+    }
+    mu_pacer_flow_init(&s_flows[3], 1000000, s_t0, NULL);
+    mu_pacer_sent(&s_pacer, &s_flows[3], 500, s_t0);
+    mu_pacer_schedule(&s_pacer, &s_flows[3], s_t0);
+
+    mu_pacer_unschedule(&s_pacer, &s_flows[2]); // due tail
+    mu_pacer_unschedule(&s_pacer, &s_flows[0]); // due head
+    mu_pacer_unschedule(&s_pacer, &s_flows[3]); // waiting
+    mu_pacer_unschedule(&s_pacer, &s_flows[3]); // idle: no effect
+    TEST_ASSERT_EQUAL_size_t(1, mu_pacer_poll(&s_pacer, at(MSEC), batch,
+                                              N_FLOWS));
+    TEST_ASSERT_EQUAL_PTR(&s_flows[1], batch[0]);
+}
+
+void test_mu_pacer_rates_over_a_second(void) {
+    mu_pacer_flow_t *batch[N_FLOWS];
+    uint64_t rates[3] = {125000, 1250000, 12500000}; // 1, 10, 100 Mbit/s
+
+    for (int i = 0; i < 3; i++) {
+        mu_pacer_flow_init(&s_flows[i], rates[i], s_t0, NULL);
+        mu_pacer_schedule(&s_pacer, &s_flows[i], s_t0);
+    }
+    // Always-backlogged flows sending 1250-byte packets, polled every 10 us
+    for (int64_t t = 0; t < 1000 * MSEC; t += 10 * USEC) {
+        mu_time_abs_t now = at(t);
+        size_t n = mu_pacer_poll(&s_pacer, now, batch, N_FLOWS);
+        for (size_t k = 0; k < n; k++) {
+            TEST_ASSERT_FALSE(mu_time_is_before(now,
+                                                mu_pacer_next_send(batch[k])));
+            mu_pacer_sent(&s_pacer, batch[k], 1250, now);
+            mu_pacer_schedule(&s_pacer, batch[k], now);
+        }
+    }
+    // One second's worth of bytes, give or take the packet in flight
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_UINT64_WITHIN(1250, rates[i], s_flows[i].bytes);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_pacer_interval_arithmetic);
+    RUN_TEST(test_mu_pacer_no_drift);
+    RUN_TEST(test_mu_pacer_schedule_and_poll);
+    RUN_TEST(test_mu_pacer_batch_limit);
+    RUN_TEST(test_mu_pacer_max_lag);
+    RUN_TEST(test_mu_pacer_unschedule);
+    RUN_TEST(test_mu_pacer_rates_over_a_second);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static mu_time_abs_t at(int64_t nanos) {
+    return mu_time_offset(s_t0, nanos);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,402 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_pcap.h"
+#include "mu_time.h"
+#include "unity.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_RECORDS 5000
+#define LINKTYPE_ETHERNET 1
+
+// *****************************************************************************
+// Private (static) storage
+
+static char s_path[64];
+static char s_index_path[64];
+static uint8_t s_buf[512];
+static size_t s_len;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_pcap_write_read(void);
+void test_mu_pcap_snaplen(void);
+void test_mu_pcap_seek_time(void);
+void test_mu_pcap_index_build(void);
+void test_mu_pcap_swapped_micros(void);
+void test_mu_pcap_pcapng(void);
+void test_mu_pcap_truncated(void);
+void test_mu_pcap_not_a_capture(void);
+
+static mu_time_abs_t record_time(int i);
+static void write_capture(const char *index_path, uint32_t stride);
+static void put_u8(uint8_t v);
+static void put_u16(uint16_t v, bool big);
+static void put_u32(uint32_t v, bool big);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    snprintf(s_path, sizeof(s_path), "/tmp/test_mu_pcap_%d.pcap", (int)getpid());
+    snprintf(s_index_path, sizeof(s_index_path), "/tmp/test_mu_pcap_%d.idx",
+             (int)getpid());
+    s_len = 0;
+}
+
+void tearDown(void) {
+    unlink(s_path);
+    unlink(s_index_path);
+}
+
+void test_mu_pcap_write_read(void) {
+    mu_pcap_reader_t reader;
+    mu_pcap_record_t record;
+    int n = 0;
+
+    write_capture(NULL, 0);
+    TEST_ASSERT_TRUE(mu_pcap_reader_open(&reader, s_path));
+    TEST_ASSERT_EQUAL(MU_PCAP_FORMAT_PCAP, mu_pcap_reader_format(&reader));
+    TEST_ASSERT_EQUAL_UINT32(LINKTYPE_ETHERNET,
+                             mu_pcap_reader_linktype(&reader, 0));
+    while (mu_pcap_reader_next(&reader, &record)) {
+        mu_time_abs_t expect = record_time(n);
+        TEST_ASSERT_EQUAL_INT64(expect.seconds, record.time.seconds);
+        TEST_ASSERT_EQUAL_INT64(expect.nanoseconds, record.time.nanoseconds);
+        TEST_ASSERT_EQUAL_UINT32(4, record.caplen);
+        TEST_ASSERT_EQUAL_INT(n, *(const int32_t *)record.data);
+        n += 1;
+    }
+    TEST_ASSERT_FALSE(mu_pcap_reader_is_malformed(&reader));
+    TEST_ASSERT_EQUAL_INT(N_RECORDS, n);
+
+    mu_pcap_reader_rewind(&reader);
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_EQUAL_INT(0, *(const int32_t *)record.data);
+    mu_pcap_reader_close(&reader);
+}
+
+void test_mu_pcap_snaplen(void) {
+    mu_pcap_writer_t writer;
+    mu_pcap_reader_t reader;
+    mu_pcap_record_t record;
+    uint8_t frame[100] = {0};
+
+    TEST_ASSERT_TRUE(mu_pcap_writer_open(&writer, s_path, LINKTYPE_ETHERNET,
+                                         64, NULL, 0));
+    TEST_ASSERT_TRUE(
+        mu_pcap_writer_write(&writer, record_time(0), frame, sizeof(frame)));
+    TEST_ASSERT_TRUE(mu_pcap_writer_close(&writer));
+
+    TEST_ASSERT_TRUE(mu_pcap_reader_open(&reader, s_path));
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_EQUAL_UINT32(64, record.caplen);
+    TEST_ASSERT_EQUAL_UINT32(100, record.origlen);
+    TEST_ASSERT_FALSE(mu_pcap_reader_next(&reader, &record));
+    mu_pcap_reader_close(&reader);
+}
+
+void test_mu_pcap_seek_time(void) {
+    mu_pcap_reader_t reader;
+    mu_pcap_record_t record;
+    mu_pcap_index_t index;
+
+    write_capture(s_index_path, 100);
+    TEST_ASSERT_TRUE(mu_pcap_reader_open(&reader, s_path));
+    TEST_ASSERT_TRUE(mu_pcap_index_open(&index, s_index_path));
+    TEST_ASSERT_EQUAL_size_t(N_RECORDS / 100, index.count);
+
+    // Record 3456 is the first at or after its own time.  The seek lands on
+    // an index boundary before it, never after.
+    mu_time_abs_t start = record_time(3456);
+    mu_pcap_reader_seek_time(&reader, &index, start);
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    int first = *(const int32_t *)record.data;
+    TEST_ASSERT_TRUE(first <= 3456);
+    TEST_ASSERT_TRUE(first >= 3456 - 2 * 100);
+    while (mu_time_is_before(record.time, start)) {
+        TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    }
+    TEST_ASSERT_EQUAL_INT(3456, *(const int32_t *)record.data);
+
+    // Before everything, and after everything
+    mu_pcap_reader_seek_time(&reader, &index, record_time(-10));
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_EQUAL_INT(0, *(const int32_t *)record.data);
+    mu_pcap_reader_seek_time(&reader, &index, record_time(N_RECORDS + 10));
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_TRUE(*(const int32_t *)record.data >= N_RECORDS - 2 * 100);
+
+    mu_pcap_index_close(&index);
+    mu_pcap_reader_close(&reader);
+}
+
+void test_mu_pcap_index_build(void) {
+    mu_pcap_reader_t reader;
+    mu_pcap_record_t record;
+    mu_pcap_index_t index;
+
+    write_capture(NULL, 0);
+    TEST_ASSERT_TRUE(mu_pcap_reader_open(&reader, s_path));
+    TEST_ASSERT_TRUE(mu_pcap_index_build(&reader, s_index_path, 0));
+    TEST_ASSERT_TRUE(mu_pcap_index_open(&index, s_index_path));
+    TEST_ASSERT_EQUAL_size_t(
+        (N_RECORDS + MU_PCAP_INDEX_STRIDE - 1) / MU_PCAP_INDEX_STRIDE,
+        index.count);
+    mu_pcap_reader_seek_time(&reader, &index, record_time(4500));
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_TRUE(*(const int32_t *)record.data <= 4500);
+    TEST_ASSERT_TRUE(*(const int32_t *)record.data >= 4500 - 2 * 1024);
+    mu_pcap_index_close(&index);
+    mu_pcap_reader_close(&reader);
+}
+
+void test_mu_pcap_swapped_micros(void) {
+    mu_pcap_reader_t reader;
+    mu_pcap_record_t record;
+
+    // Big-endian microsecond pcap, one 2-byte record
+    put_u32(MU_PCAP_MAGIC_MICROS, true);
+    put_u16(2, true);
+    put_u16(4, true);
+    put_u32(0, true);
+    put_u32(0, true);
+    put_u32(65535, true);
+    put_u32(105, true); // LINKTYPE_IEEE802_11
+    put_u32(1700000000, true);
+    put_u32(123456, true);
+    put_u32(2, true);
+    put_u32(60, true);
+    put_u8(0xab);
+    put_u8(0xcd);
+
+    TEST_ASSERT_TRUE(mu_pcap_reader_init_buffer(&reader, s_buf, s_len));
+    TEST_ASSERT_EQUAL_UINT32(105, mu_pcap_reader_linktype(&reader, 0));
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_EQUAL_INT64(1700000000, record.time.seconds);
+    TEST_ASSERT_EQUAL_INT64(123456000, record.time.nanoseconds);
+    TEST_ASSERT_EQUAL_UINT32(60, record.origlen);
+    TEST_ASSERT_EQUAL_HEX8(0xcd, record.data[1]);
+    TEST_ASSERT_FALSE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_FALSE(mu_pcap_reader_is_malformed(&reader));
+}
+
+void test_mu_pcap_pcapng(void) {
+    mu_pcap_reader_t reader;
+    mu_pcap_record_t record;
+    bool big = true;
+
+    // Section header
+    put_u32(0x0a0d0d0a, big);
+    put_u32(28, big);
+    put_u32(0x1a2b3c4d, big);
+    put_u16(1, big);
+    put_u16(0, big);
+    put_u32(0xffffffff, big);
+    put_u32(0xffffffff, big);
+    put_u32(28, big);
+    // Interface 0: default microseconds
+    put_u32(1, big);
+    put_u32(20, big);
+    put_u16(LINKTYPE_ETHERNET, big);
+    put_u16(0, big);
+    put_u32(0, big);
+    put_u32(20, big);
+    // Interface 1: nanoseconds, offset 100 seconds
+    put_u32(1, big);
+    put_u32(44, big);
+    put_u16(105, big);
+    put_u16(0, big);
+    put_u32(0, big);
+    put_u16(9, big); // if_tsresol
+    put_u16(1, big);
+    put_u32(0x09000000, true); // value 9 then padding
+    put_u16(14, big); // if_tsoffset
+    put_u16(8, big);
+    put_u32(0, big);
+    put_u32(100, big);
+    put_u16(0, big); // opt_endofopt
+    put_u16(0, big);
+    put_u32(44, big);
+    // A name resolution block to skip
+    put_u32(4, big);
+    put_u32(16, big);
+    put_u32(0, big);
+    put_u32(16, big);
+    // Packet on interface 1: 1.5 s + offset
+    put_u32(6, big);
+    put_u32(36, big);
+    put_u32(1, big);
+    put_u32(0, big);
+    put_u32(1500000000, big);
+    put_u32(3, big);
+    put_u32(3, big);
+    put_u32(0x01020300, true);
+    put_u32(36, big);
+    // Packet on interface 0: 2 s in microseconds
+    put_u32(6, big);
+    put_u32(32, big);
+    put_u32(0, big);
+    put_u32(0, big);
+    put_u32(2000000, big);
+    put_u32(0, big);
+    put_u32(0, big);
+    put_u32(32, big);
+
+    TEST_ASSERT_TRUE(mu_pcap_reader_init_buffer(&reader, s_buf, s_len));
+    TEST_ASSERT_EQUAL(MU_PCAP_FORMAT_PCAPNG, mu_pcap_reader_format(&reader));
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_EQUAL_UINT32(1, record.interface);
+    TEST_ASSERT_EQUAL_UINT32(105, mu_pcap_reader_linktype(&reader, 1));
+    TEST_ASSERT_EQUAL_INT64(101, record.time.seconds);
+    TEST_ASSERT_EQUAL_INT64(500000000, record.time.nanoseconds);
+    TEST_ASSERT_EQUAL_UINT32(3, record.caplen);
+    TEST_ASSERT_EQUAL_HEX8(0x03, record.data[2]);
+    uint64_t second = 0;
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    second = record.offset;
+    TEST_ASSERT_EQUAL_INT64(2, record.time.seconds);
+    TEST_ASSERT_EQUAL_UINT32(0, record.caplen);
+    TEST_ASSERT_FALSE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_FALSE(mu_pcap_reader_is_malformed(&reader));
+
+    // Rewinding must not duplicate interfaces
+    mu_pcap_reader_rewind(&reader);
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_EQUAL_INT64(101, record.time.seconds);
+    // Seek on a fresh reader picks up the interfaces it skipped
+    TEST_ASSERT_TRUE(mu_pcap_reader_init_buffer(&reader, s_buf, s_len));
+    mu_pcap_reader_seek(&reader, second);
+    TEST_ASSERT_TRUE(mu_pcap_reader_next(&reader, &record));
+    TEST_ASSERT_EQUAL_INT64(2, record.time.seconds);
+    TEST_ASSERT_EQUAL_UINT32(1, mu_pcap_reader_linktype(&reader, 0));
+}
+
+void test_mu_pcap_truncated(void) {
+    mu_pcap_reader_t reader;
+    mu_pcap_record_t record;
+    uint8_t *copy;
+    FILE *f;
+    long size;
+
+    write_capture(NULL, 0);
+    f = fopen(s_path, "rb");
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    copy = malloc((size_t)size);
+    TEST_ASSERT_EQUAL(size, (long)fread(copy, 1, (size_t)size, f));
+    fclose(f);
+
+    // Cut the last record short
+    TEST_ASSERT_TRUE(
+        mu_pcap_reader_init_buffer(&reader, copy, (size_t)size - 2));
+    int n = 0;
+    while (mu_pcap_reader_next(&reader, &record)) {
+        n += 1;
+    }
+    TEST_ASSERT_EQUAL_INT(N_RECORDS - 1, n);
+    TEST_ASSERT_TRUE(mu_pcap_reader_is_malformed(&reader));
+    free(copy);
+}
+
+void test_mu_pcap_not_a_capture(void) {
+    mu_pcap_reader_t reader;
+
+    put_u32(0x12345678, false);
+    for (int i = 0; i < 8; i++) {
+        put_u32(0, false);
+    }
+    TEST_ASSERT_FALSE(mu_pcap_reader_init_buffer(&reader, s_buf, s_len));
+    TEST_ASSERT_FALSE(mu_pcap_reader_open(&reader, "/nonexistent/x.pcap"));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_pcap_write_read);
+    RUN_TEST(test_mu_pcap_snaplen);
+    RUN_TEST(test_mu_pcap_seek_time);
+    RUN_TEST(test_mu_pcap_index_build);
+    RUN_TEST(test_mu_pcap_swapped_micros);
+    RUN_TEST(test_mu_pcap_pcapng);
+    RUN_TEST(test_mu_pcap_truncated);
+    RUN_TEST(test_mu_pcap_not_a_capture);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+/**
+ * @brief Record times advance 1.000123 ms, with every tenth record 5 mSec
+ * early to exercise out-of-order captures.
+ */
+static mu_time_abs_t record_time(int i) {
+    mu_time_abs_t base = {1700000000, 0};
+    int64_t ns = (int64_t)i * 1000123;
+    if (i % 10 == 9) {
+        ns -= 5000000;
+    }
+    return mu_time_offset(base, ns);
+}
+
+static void write_capture(const char *index_path, uint32_t stride) {
+    mu_pcap_writer_t writer;
+
+    TEST_ASSERT_TRUE(mu_pcap_writer_open(&writer, s_path, LINKTYPE_ETHERNET,
+                                         65535, index_path, stride));
+    for (int32_t i = 0; i < N_RECORDS; i++) {
+        TEST_ASSERT_TRUE(
+            mu_pcap_writer_write(&writer, record_time(i), &i, sizeof(i)));
+    }
+    TEST_ASSERT_TRUE(mu_pcap_writer_close(&writer));
+}
+
+static void put_u8(uint8_t v) {
+    s_buf[s_len++] = v;
+}
+
+static void put_u16(uint16_t v, bool big) {
+    put_u8(big ? (uint8_t)(v >> 8) : (uint8_t)v);
+    put_u8(big ? (uint8_t)v : (uint8_t)(v >> 8));
+}
+
+static void put_u32(uint32_t v, bool big) {
+    put_u16(big ? (uint16_t)(v >> 16) : (uint16_t)v, big);
+    put_u16(big ? (uint16_t)v : (uint16_t)(v >> 16), big);
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,251 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_pdes.h"
+#include "mu_time.h"
+#include "unity.h"
+#include <stdint.h>
+#include <stdio.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_LPS 16
+#define LOOKAHEAD 1000000 // 1 mSec
+
+/**
+ * @brief PHOLD: every event schedules one new event, to a random LP, at
+ * least the lookahead later.
+ */
+typedef struct {
+    uint32_t seed;
+    uint64_t count;
+    uint64_t checksum; ///< Order-sensitive hash of processed events
+} phold_lp_t;
+
+typedef struct {
+    uint32_t hops;
+} phold_msg_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_pdes_t s_sim;
+static phold_lp_t s_lps[N_LPS];
+static mu_time_abs_t s_start = {1000, 0};
+static int s_violations;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_pdes_single_worker(void);
+void test_mu_pdes_parallel_matches_serial(void);
+void test_mu_pdes_resume(void);
+void test_mu_pdes_lookahead_enforced(void);
+void test_mu_pdes_zero_lookahead(void);
+
+static void phold(mu_pdes_lp_t *lp, mu_pdes_event_t *ev, void *ctx);
+static void probe_lookahead(mu_pdes_lp_t *lp, mu_pdes_event_t *ev, void *ctx);
+static void setup_phold(size_t n_workers, mu_time_rel_t lookahead);
+static uint64_t total_checksum(void);
+static uint32_t next_random(uint32_t *seed);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    s_violations = 0;
+}
+
+void tearDown(void) {
+    mu_pdes_destroy(&s_sim);
+}
+
+void test_mu_pdes_single_worker(void) {
+    mu_pdes_stats_t stats;
+
+    setup_phold(1, LOOKAHEAD);
+    TEST_ASSERT_TRUE(mu_pdes_run(&s_sim, mu_time_offset(s_start, 1000000000)));
+    mu_pdes_get_stats(&s_sim, &stats);
+    // 4 events per LP circulating, about 1 per 2.5 mSec each, for 1 second
+    TEST_ASSERT_TRUE(stats.events > 20000);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.remote);
+    TEST_ASSERT_TRUE(stats.windows > 100);
+    TEST_ASSERT_EQUAL_INT(0, s_violations);
+}
+
+void test_mu_pdes_parallel_matches_serial(void) {
+    mu_time_abs_t until = mu_time_offset(s_start, 500000000);
+    mu_pdes_stats_t serial, parallel;
+    uint64_t expect;
+
+    setup_phold(1, LOOKAHEAD);
+    mu_pdes_run(&s_sim, until);
+    mu_pdes_get_stats(&s_sim, &serial);
+    expect = total_checksum();
+    mu_pdes_destroy(&s_sim);
+
+    for (size_t workers = 2; workers <= 4; workers++) {
+        setup_phold(workers, LOOKAHEAD);
+        TEST_ASSERT_TRUE(mu_pdes_run(&s_sim, until));
+        mu_pdes_get_stats(&s_sim, &parallel);
+        TEST_ASSERT_EQUAL_UINT64(serial.events, parallel.events);
+        TEST_ASSERT_EQUAL_UINT64(serial.windows, parallel.windows);
+        TEST_ASSERT_TRUE(parallel.remote > 0);
+        TEST_ASSERT_EQUAL_UINT64(expect, total_checksum());
+        TEST_ASSERT_EQUAL_INT(0, s_violations);
+        mu_pdes_destroy(&s_sim);
+    }
+    setup_phold(1, LOOKAHEAD); // for tearDown
+}
+
+void test_mu_pdes_resume(void) {
+    mu_pdes_stats_t once, twice;
+    uint64_t expect;
+
+    setup_phold(3, LOOKAHEAD);
+    mu_pdes_run(&s_sim, mu_time_offset(s_start, 400000000));
+    mu_pdes_get_stats(&s_sim, &once);
+    expect = total_checksum();
+    mu_pdes_destroy(&s_sim);
+
+    setup_phold(3, LOOKAHEAD);
+    mu_pdes_run(&s_sim, mu_time_offset(s_start, 150000000));
+    mu_pdes_run(&s_sim, mu_time_offset(s_start, 400000000));
+    mu_pdes_get_stats(&s_sim, &twice);
+    TEST_ASSERT_EQUAL_UINT64(once.events, twice.events);
+    TEST_ASSERT_EQUAL_UINT64(expect, total_checksum());
+}
+
+void test_mu_pdes_lookahead_enforced(void) {
+    TEST_ASSERT_TRUE(mu_pdes_init(&s_sim, 2, 2, 0, s_start));
+    mu_pdes_lp_configure(&s_sim, 0, probe_lookahead, NULL, LOOKAHEAD);
+    mu_pdes_lp_configure(&s_sim, 1, probe_lookahead, NULL, LOOKAHEAD);
+    TEST_ASSERT_NOT_NULL(mu_pdes_schedule(&s_sim, 0, s_start));
+    mu_pdes_run(&s_sim, mu_time_offset(s_start, 1000000000));
+    TEST_ASSERT_EQUAL_INT(0, s_violations);
+}
+
+void test_mu_pdes_zero_lookahead(void) {
+    mu_pdes_stats_t stats;
+
+    setup_phold(2, 0);
+    TEST_ASSERT_TRUE(mu_pdes_run(&s_sim, mu_time_offset(s_start, 20000000)));
+    mu_pdes_get_stats(&s_sim, &stats);
+    TEST_ASSERT_TRUE(stats.events > 0);
+    // each window covers a single instant
+    TEST_ASSERT_TRUE(stats.windows * 4 >= stats.events);
+    TEST_ASSERT_EQUAL_INT(0, s_violations);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_pdes_single_worker);
+    RUN_TEST(test_mu_pdes_parallel_matches_serial);
+    RUN_TEST(test_mu_pdes_resume);
+    RUN_TEST(test_mu_pdes_lookahead_enforced);
+    RUN_TEST(test_mu_pdes_zero_lookahead);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void phold(mu_pdes_lp_t *lp, mu_pdes_event_t *ev, void *ctx) {
+    phold_lp_t *state = ctx;
+    phold_msg_t *msg = mu_pdes_event_payload(ev);
+    mu_time_abs_t now = mu_pdes_now(lp);
+    int64_t ns = mu_time_difference(s_start, now);
+
+    state->count += 1;
+    state->checksum = state->checksum * 31 + (uint64_t)ns + msg->hops;
+
+    mu_pdes_event_t *out = mu_pdes_alloc(lp);
+    phold_msg_t *next = mu_pdes_event_payload(out);
+    size_t dst = next_random(&state->seed) % N_LPS;
+    mu_time_rel_t delay = s_sim.lps[lp->id].lookahead +
+                          (mu_time_rel_t)(next_random(&state->seed) % 3000000);
+    next->hops = msg->hops + 1;
+    if (!mu_pdes_send(lp, out, dst, mu_time_offset(now, delay))) {
+        s_violations += 1;
+        mu_pdes_free(lp, out);
+    }
+}
+
+static void probe_lookahead(mu_pdes_lp_t *lp, mu_pdes_event_t *ev, void *ctx) {
+    size_t other = 1 - mu_pdes_lp_id(lp);
+    mu_time_abs_t now = mu_pdes_now(lp);
+    mu_pdes_event_t *out = mu_pdes_alloc(lp);
+    (void)ev;
+    (void)ctx;
+
+    // Too soon for another LP, fine for itself, never in the past
+    if (mu_pdes_send(lp, out, other, mu_time_offset(now, LOOKAHEAD - 1)) ||
+        mu_pdes_send(lp, out, mu_pdes_lp_id(lp), mu_time_offset(now, -1))) {
+        s_violations += 1;
+        return;
+    }
+    if (mu_pdes_lp_id(lp) == 0) {
+        if (!mu_pdes_send(lp, out, other, mu_time_offset(now, LOOKAHEAD))) {
+            s_violations += 1;
+        }
+    } else {
+        mu_pdes_free(lp, out);
+    }
+}
+
+static void setup_phold(size_t n_workers, mu_time_rel_t lookahead) {
+    TEST_ASSERT_TRUE(
+        mu_pdes_init(&s_sim, N_LPS, n_workers, sizeof(phold_msg_t), s_start));
+    for (size_t i = 0; i < N_LPS; i++) {
+        s_lps[i].seed = (uint32_t)(i + 1) * 2654435761u;
+        s_lps[i].count = 0;
+        s_lps[i].checksum = 0;
+        mu_pdes_lp_configure(&s_sim, i, phold, &s_lps[i], lookahead);
+        for (int j = 0; j < 4; j++) {
+            mu_pdes_event_t *ev = mu_pdes_schedule(
+                &s_sim, i, mu_time_offset(s_start, (int64_t)(i * 4 + j) * 1000));
+            ((phold_msg_t *)mu_pdes_event_payload(ev))->hops = 0;
+        }
+    }
+}
+
+static uint64_t total_checksum(void) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < N_LPS; i++) {
+        sum = sum * 1000003 + s_lps[i].checksum;
+    }
+    return sum;
+}
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+// *****************************************************************************
+// End of file
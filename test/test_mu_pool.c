@@ -0,0 +1,173 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_pool.h"
+#include "unity.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_BLOCKS 8
+#define N_REMOTE 10000
+
+typedef struct {
+    uint64_t payload[3];
+} node_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_pool_t s_pool;
+static uint64_t s_storage[N_BLOCKS * 3];
+static void *s_handoff[N_REMOTE];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_pool_static_exhaustion(void);
+void test_mu_pool_reuse(void);
+void test_mu_pool_remote_free(void);
+void test_mu_pool_dynamic_growth(void);
+
+static void *remote_freer(void *arg);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    mu_pool_init(&s_pool, sizeof(node_t), s_storage, sizeof(s_storage));
+}
+
+void tearDown(void) {}
+
+void test_mu_pool_static_exhaustion(void) {
+    mu_pool_stats_t stats;
+    void *blocks[N_BLOCKS];
+
+    for (int i = 0; i < N_BLOCKS; i++) {
+        blocks[i] = mu_pool_alloc(&s_pool);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    TEST_ASSERT_NULL(mu_pool_alloc(&s_pool));
+    mu_pool_get_stats(&s_pool, &stats);
+    TEST_ASSERT_EQUAL(24, stats.block_size);
+    TEST_ASSERT_EQUAL(N_BLOCKS, stats.capacity);
+    TEST_ASSERT_EQUAL(N_BLOCKS, stats.in_use);
+    TEST_ASSERT_EQUAL(N_BLOCKS, stats.high_water);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.alloc_failures);
+
+    mu_pool_free(&s_pool, blocks[3]);
+    TEST_ASSERT_EQUAL_PTR(blocks[3], mu_pool_alloc(&s_pool));
+}
+
+void test_mu_pool_reuse(void) {
+    mu_pool_stats_t stats;
+
+    for (int i = 0; i < 1000; i++) {
+        void *a = mu_pool_alloc(&s_pool);
+        void *b = mu_pool_alloc(&s_pool);
+        mu_pool_free(&s_pool, a);
+        mu_pool_free(&s_pool, b);
+    }
+    mu_pool_get_stats(&s_pool, &stats);
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(2, stats.high_water);
+    TEST_ASSERT_EQUAL_UINT64(2000, stats.allocs);
+}
+
+void test_mu_pool_remote_free(void) {
+    mu_pool_t pool;
+    mu_pool_stats_t stats;
+    pthread_t thread;
+    size_t reclaimed = 0;
+
+    // The owner allocates everything; another thread frees it all.
+    mu_pool_init_dynamic(&pool, sizeof(node_t), 256);
+    for (int i = 0; i < N_REMOTE; i++) {
+        s_handoff[i] = mu_pool_alloc(&pool);
+        TEST_ASSERT_NOT_NULL(s_handoff[i]);
+    }
+    pthread_create(&thread, NULL, remote_freer, &pool);
+    // keep allocating from reclaimed blocks while the frees are in flight
+    for (int i = 0; i < 1000; i++) {
+        reclaimed += mu_pool_reclaim(&pool);
+    }
+    pthread_join(thread, NULL);
+    reclaimed += mu_pool_reclaim(&pool);
+
+    mu_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL(N_REMOTE, reclaimed);
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL_UINT64(N_REMOTE, stats.remote_frees);
+    // no new slab needed to satisfy a further allocation
+    size_t slabs = stats.slabs;
+    TEST_ASSERT_NOT_NULL(mu_pool_alloc(&pool));
+    mu_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL(slabs, stats.slabs);
+    mu_pool_destroy(&pool);
+}
+
+void test_mu_pool_dynamic_growth(void) {
+    mu_pool_t pool;
+    mu_pool_stats_t stats;
+
+    mu_pool_init_dynamic(&pool, sizeof(node_t), 4);
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_NOT_NULL(mu_pool_alloc(&pool));
+    }
+    mu_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL(3, stats.slabs);
+    TEST_ASSERT_EQUAL(12, stats.capacity);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.alloc_failures);
+    mu_pool_destroy(&pool);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_pool_static_exhaustion);
+    RUN_TEST(test_mu_pool_reuse);
+    RUN_TEST(test_mu_pool_remote_free);
+    RUN_TEST(test_mu_pool_dynamic_growth);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void *remote_freer(void *arg) {
+    mu_pool_t *pool = (mu_pool_t *)arg;
+    for (int i = 0; i < N_REMOTE; i++) {
+        mu_pool_free_remote(pool, s_handoff[i]);
+    }
+    return NULL;
+}
+
+// *****************************************************************************
+// End of file
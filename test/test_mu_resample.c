@@ -0,0 +1,361 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_resample.h"
+#include "unity.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define SAMPLES 5000
+#define GRID 2000
+
+// *****************************************************************************
+// Private (static) storage
+
+static int64_t s_t[SAMPLES];
+static int32_t s_v[SAMPLES];
+static int32_t s_out[GRID];
+static uint8_t s_valid[(GRID + 7) / 8];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_resample_last(void);
+void test_mu_resample_linear(void);
+void test_mu_resample_max_gap(void);
+void test_mu_resample_aggregates(void);
+void test_mu_resample_empty_windows(void);
+void test_mu_resample_reference(void);
+void test_mu_resample_streaming(void);
+
+static bool bit(const uint8_t *valid, size_t k);
+static void random_series(int64_t spacing);
+static bool reference(mu_resample_method_t method, int64_t g, int64_t window,
+                      int64_t max_gap, int32_t *value);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_mu_resample_last(void) {
+    const int64_t t[] = {5, 15, 27};
+    const int32_t v[] = {1, 2, 3};
+    mu_resampler_t r;
+
+    memset(s_valid, 0xff, sizeof(s_valid));
+    mu_resampler_init(&r, MU_RESAMPLE_LAST, 0, 10, 4);
+    TEST_ASSERT_EQUAL_size_t(4, mu_resampler_run(&r, t, v, 3, s_out, s_valid));
+    TEST_ASSERT_FALSE(bit(s_valid, 0));
+    TEST_ASSERT_EQUAL_INT32(0, s_out[0]);
+    TEST_ASSERT_EQUAL_INT32(1, s_out[1]);
+    TEST_ASSERT_EQUAL_INT32(2, s_out[2]);
+    TEST_ASSERT_EQUAL_INT32(3, s_out[3]); // carried forward
+    TEST_ASSERT_EQUAL_HEX8(0x0e, s_valid[0] & 0x0f);
+    TEST_ASSERT_EQUAL_UINT64(4, mu_resampler_position(&r));
+}
+
+void test_mu_resample_linear(void) {
+    const int64_t t[] = {0, 100};
+    const int32_t v[] = {0, 1000};
+    const int64_t t2[] = {0, 3};
+    const int32_t v2[] = {1000, 0};
+    mu_resampler_t r;
+
+    mu_resampler_init(&r, MU_RESAMPLE_LINEAR, 0, 25, 6);
+    TEST_ASSERT_EQUAL_size_t(6, mu_resampler_run(&r, t, v, 2, s_out, s_valid));
+    for (int k = 0; k < 5; k++) {
+        TEST_ASSERT_EQUAL_INT32(250 * k, s_out[k]);
+        TEST_ASSERT_TRUE(bit(s_valid, k));
+    }
+    TEST_ASSERT_FALSE(bit(s_valid, 5)); // past the last sample
+
+    // Falling, with rounding.
+    mu_resampler_init(&r, MU_RESAMPLE_LINEAR, 0, 1, 4);
+    mu_resampler_run(&r, t2, v2, 2, s_out, s_valid);
+    TEST_ASSERT_EQUAL_INT32(1000, s_out[0]);
+    TEST_ASSERT_EQUAL_INT32(667, s_out[1]);
+    TEST_ASSERT_EQUAL_INT32(333, s_out[2]);
+    TEST_ASSERT_EQUAL_INT32(0, s_out[3]);
+
+    TEST_ASSERT_EQUAL_INT32(-5, mu_resample_lerp(-10, 0, 32768));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, mu_resample_lerp(INT32_MIN, INT32_MAX,
+                                                        65536));
+}
+
+void test_mu_resample_max_gap(void) {
+    const int64_t t[] = {0, 10, 100, 110};
+    const int32_t v[] = {0, 10, 100, 110};
+    mu_resampler_t r;
+
+    mu_resampler_init(&r, MU_RESAMPLE_LAST, 0, 20, 6);
+    mu_resampler_set_max_gap(&r, 30);
+    mu_resampler_run(&r, t, v, 4, s_out, s_valid);
+    TEST_ASSERT_EQUAL_HEX8(0x27, s_valid[0] & 0x3f); // 0, 20, 40, 100
+    TEST_ASSERT_EQUAL_INT32(10, s_out[2]);
+    TEST_ASSERT_EQUAL_INT32(0, s_out[3]);
+    TEST_ASSERT_EQUAL_INT32(100, s_out[5]);
+
+    mu_resampler_init(&r, MU_RESAMPLE_LINEAR, 0, 20, 6);
+    mu_resampler_set_max_gap(&r, 30);
+    mu_resampler_run(&r, t, v, 4, s_out, s_valid);
+    TEST_ASSERT_EQUAL_HEX8(0x21, s_valid[0] & 0x3f); // not across 10..100
+    TEST_ASSERT_EQUAL_INT32(100, s_out[5]);
+}
+
+void test_mu_resample_aggregates(void) {
+    static const struct {
+        mu_resample_method_t method;
+        int32_t first, second;
+    } cases[] = {
+        {MU_RESAMPLE_MEAN, 5, 15}, // 4.5 and 14.5 round away from zero
+        {MU_RESAMPLE_MIN, 0, 10},
+        {MU_RESAMPLE_MAX, 9, 19},
+        {MU_RESAMPLE_SUM, 45, 145},
+        {MU_RESAMPLE_COUNT, 10, 10},
+    };
+    mu_resampler_t r;
+
+    for (int i = 0; i < 100; i++) {
+        s_t[i] = i;
+        s_v[i] = i;
+    }
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        mu_resampler_init(&r, cases[c].method, 9, 10, 10);
+        mu_resampler_run(&r, s_t, s_v, 100, s_out, s_valid);
+        TEST_ASSERT_EQUAL_INT32(cases[c].first, s_out[0]);
+        TEST_ASSERT_EQUAL_INT32(cases[c].second, s_out[1]);
+        TEST_ASSERT_EQUAL_HEX8(0xff, s_valid[0]);
+    }
+
+    // A narrower window: (4, 9] holds 5..9.
+    mu_resampler_init(&r, MU_RESAMPLE_MEAN, 9, 10, 1);
+    mu_resampler_set_window(&r, 5);
+    mu_resampler_run(&r, s_t, s_v, 100, s_out, s_valid);
+    TEST_ASSERT_EQUAL_INT32(7, s_out[0]);
+
+    // Sums saturate; means of negatives round away from zero.
+    s_v[0] = s_v[1] = INT32_MAX;
+    mu_resampler_init(&r, MU_RESAMPLE_SUM, 1, 10, 1);
+    mu_resampler_run(&r, s_t, s_v, 2, s_out, s_valid);
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, s_out[0]);
+    s_v[0] = -1, s_v[1] = -2;
+    mu_resampler_init(&r, MU_RESAMPLE_MEAN, 1, 10, 1);
+    mu_resampler_run(&r, s_t, s_v, 2, s_out, s_valid);
+    TEST_ASSERT_EQUAL_INT32(-2, s_out[0]);
+}
+
+void test_mu_resample_empty_windows(void) {
+    const int64_t t[] = {5, 35};
+    const int32_t v[] = {7, 9};
+    mu_resampler_t r;
+
+    mu_resampler_init(&r, MU_RESAMPLE_MEAN, 10, 10, 4);
+    mu_resampler_run(&r, t, v, 2, s_out, s_valid);
+    TEST_ASSERT_EQUAL_HEX8(0x09, s_valid[0] & 0x0f); // 10 and 40
+    TEST_ASSERT_EQUAL_INT32(7, s_out[0]);
+    TEST_ASSERT_EQUAL_INT32(9, s_out[3]);
+
+    mu_resampler_init(&r, MU_RESAMPLE_COUNT, 10, 10, 4);
+    mu_resampler_run(&r, t, v, 2, s_out, s_valid);
+    TEST_ASSERT_EQUAL_HEX8(0x0f, s_valid[0] & 0x0f);
+    TEST_ASSERT_EQUAL_INT32(0, s_out[1]);
+}
+
+void test_mu_resample_reference(void) {
+    mu_resample_method_t methods[] = {
+        MU_RESAMPLE_LAST, MU_RESAMPLE_LINEAR, MU_RESAMPLE_MEAN,
+        MU_RESAMPLE_MIN,  MU_RESAMPLE_MAX,    MU_RESAMPLE_SUM,
+        MU_RESAMPLE_COUNT,
+    };
+    // Denser than the grid, then sparser.
+    int64_t spacings[] = {13, 600};
+
+    srand(11);
+    for (int s = 0; s < 2; s++) {
+        random_series(spacings[s]);
+        for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); m++) {
+            int64_t window = m % 2 ? 100 : 70;
+            int64_t max_gap = m == 0 ? 900 : 0;
+            mu_resampler_t r;
+            mu_resampler_init(&r, methods[m], -50, 100, GRID);
+            mu_resampler_set_window(&r, window);
+            mu_resampler_set_max_gap(&r, max_gap);
+            mu_resampler_run(&r, s_t, s_v, SAMPLES, s_out, s_valid);
+            for (size_t k = 0; k < GRID; k++) {
+                int32_t expect;
+                bool ok = reference(methods[m], -50 + 100 * (int64_t)k, window,
+                                    max_gap, &expect);
+                TEST_ASSERT_EQUAL(ok, bit(s_valid, k));
+                if (ok) {
+                    TEST_ASSERT_EQUAL_INT32(expect, s_out[k]);
+                }
+            }
+        }
+    }
+}
+
+void test_mu_resample_streaming(void) {
+    static int32_t expect[GRID];
+    static uint8_t expect_valid[(GRID + 7) / 8];
+    mu_resampler_t r;
+
+    srand(5);
+    random_series(37);
+    for (int m = MU_RESAMPLE_LAST; m <= MU_RESAMPLE_COUNT; m++) {
+        mu_resampler_init(&r, (mu_resample_method_t)m, 0, 100, GRID);
+        mu_resampler_run(&r, s_t, s_v, SAMPLES, expect, expect_valid);
+
+        // Unbounded grid, uneven chunks, 3 outputs at a time.
+        mu_resampler_init(&r, (mu_resample_method_t)m, 0, 100, 0);
+        size_t k = 0, i = 0;
+        while (i < SAMPLES) {
+            size_t chunk = 1 + (size_t)rand() % 50;
+            size_t end = i + chunk < SAMPLES ? i + chunk : SAMPLES;
+            while (i < end && k < GRID) {
+                int32_t out[3];
+                uint8_t valid = 0;
+                size_t consumed;
+                size_t n = mu_resampler_push(&r, &s_t[i], &s_v[i], end - i,
+                                             out, &valid, 3, &consumed);
+                for (size_t j = 0; j < n && k < GRID; j++, k++) {
+                    TEST_ASSERT_EQUAL(bit(expect_valid, k), (valid >> j) & 1);
+                    TEST_ASSERT_EQUAL_INT32(expect[k], out[j]);
+                }
+                i += consumed;
+            }
+            if (k >= GRID) {
+                break;
+            }
+        }
+        TEST_ASSERT_TRUE(k >= GRID - 1);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_resample_last);
+    RUN_TEST(test_mu_resample_linear);
+    RUN_TEST(test_mu_resample_max_gap);
+    RUN_TEST(test_mu_resample_aggregates);
+    RUN_TEST(test_mu_resample_empty_windows);
+    RUN_TEST(test_mu_resample_reference);
+    RUN_TEST(test_mu_resample_streaming);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool bit(const uint8_t *valid, size_t k) {
+    return (valid[k / 8] >> (k % 8)) & 1;
+}
+
+/**
+ * @brief Random increasing timestamps, with duplicates and bursts, and
+ * random values.
+ */
+static void random_series(int64_t spacing) {
+    int64_t t = -200;
+
+    for (int i = 0; i < SAMPLES; i++) {
+        int r = rand() % 100;
+        t += r < 5 ? 0 : r < 10 ? spacing * 10 : 1 + rand() % (2 * spacing);
+        s_t[i] = t;
+        s_v[i] = rand() % 200001 - 100000;
+    }
+}
+
+/**
+ * @brief Compute a grid point the slow way, from every sample.
+ */
+static bool reference(mu_resample_method_t method, int64_t g, int64_t window,
+                      int64_t max_gap, int32_t *value) {
+    int last = -1, next = -1;
+    int64_t sum = 0;
+    int32_t lo = INT32_MAX, hi = INT32_MIN;
+    int32_t n = 0;
+
+    for (int i = 0; i < SAMPLES; i++) {
+        if (s_t[i] <= g) {
+            last = i;
+        } else if (next < 0) {
+            next = i;
+        }
+        if (s_t[i] > g - window && s_t[i] <= g) {
+            sum += s_v[i];
+            lo = s_v[i] < lo ? s_v[i] : lo;
+            hi = s_v[i] > hi ? s_v[i] : hi;
+            n++;
+        }
+    }
+    switch (method) {
+    case MU_RESAMPLE_LAST:
+        *value = last >= 0 ? s_v[last] : 0;
+        return last >= 0 && (max_gap == 0 || g - s_t[last] <= max_gap);
+    case MU_RESAMPLE_LINEAR:
+        if (last < 0 || (next < 0 && s_t[last] != g)) {
+            return false;
+        } else if (next < 0) {
+            *value = s_v[last];
+            return true;
+        } else {
+            uint32_t w = (uint32_t)(((g - s_t[last]) << 16) /
+                                    (s_t[next] - s_t[last]));
+            *value = mu_resample_lerp(s_v[last], s_v[next], w);
+            return true;
+        }
+    case MU_RESAMPLE_MEAN:
+        if (n == 0) {
+            return false;
+        }
+        *value = (int32_t)(sum >= 0 ? (sum + n / 2) / n : (sum - n / 2) / n);
+        return true;
+    case MU_RESAMPLE_MIN:
+        *value = lo;
+        return n > 0;
+    case MU_RESAMPLE_MAX:
+        *value = hi;
+        return n > 0;
+    case MU_RESAMPLE_SUM:
+        *value = (int32_t)sum;
+        return true;
+    default:
+        *value = n;
+        return true;
+    }
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,337 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_sync.h"
+#include "mu_time.h"
+#include "unity.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define MS(n) ((mu_time_rel_t)(n) * 1000000)
+#define CONTEND_THREADS 4
+#define CONTEND_LOOPS 20000
+
+typedef struct {
+    mu_mutex_t mutex;
+    mu_cond_t cond;
+    mu_sem_t sem;
+    atomic_uint word;
+    atomic_bool held;
+    bool flag;
+    long count;
+    mu_time_rel_t hold;
+} shared_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static shared_t s_shared;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_mutex_timedlock(void);
+void test_mu_mutex_contended(void);
+void test_mu_cond_timedwait(void);
+void test_mu_sem_timedwait(void);
+void test_mu_futex_wait(void);
+void test_mu_spin_adapts(void);
+
+static mu_time_abs_t in(mu_time_rel_t delta);
+static void sleep_for(mu_time_rel_t delta);
+static void contend_with_holder(mu_time_rel_t hold);
+static void *holder(void *arg);
+static void *incrementer(void *arg);
+static void *signaller(void *arg);
+static void *poster(void *arg);
+#if defined(__linux__)
+static void *waker(void *arg);
+#endif
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    TEST_ASSERT_EQUAL_INT(0, mu_mutex_init(&s_shared.mutex));
+    TEST_ASSERT_EQUAL_INT(0, mu_cond_init(&s_shared.cond));
+    TEST_ASSERT_EQUAL_INT(0, mu_sem_init(&s_shared.sem, 0));
+    atomic_init(&s_shared.word, 0);
+    atomic_init(&s_shared.held, false);
+    s_shared.flag = false;
+    s_shared.count = 0;
+    s_shared.hold = 0;
+}
+
+void tearDown(void) {
+    mu_sem_destroy(&s_shared.sem);
+    mu_cond_destroy(&s_shared.cond);
+    mu_mutex_destroy(&s_shared.mutex);
+}
+
+void test_mu_mutex_timedlock(void) {
+    pthread_t th;
+
+    TEST_ASSERT_TRUE(mu_mutex_timedlock(&s_shared.mutex, in(MS(10))));
+    mu_mutex_unlock(&s_shared.mutex);
+
+    // Held elsewhere: the wait ends at the deadline, not before.
+    s_shared.hold = MS(200);
+    pthread_create(&th, NULL, holder, NULL);
+    while (!atomic_load(&s_shared.held)) {
+    }
+    mu_time_abs_t deadline = in(MS(20));
+    TEST_ASSERT_FALSE(mu_mutex_timedlock(&s_shared.mutex, deadline));
+    TEST_ASSERT_FALSE(mu_time_is_before(mu_time_now(), deadline));
+    TEST_ASSERT_FALSE(mu_mutex_trylock(&s_shared.mutex));
+    TEST_ASSERT_TRUE(mu_mutex_timedlock(&s_shared.mutex, in(MS(2000))));
+    mu_mutex_unlock(&s_shared.mutex);
+    pthread_join(th, NULL);
+}
+
+void test_mu_mutex_contended(void) {
+    pthread_t th[CONTEND_THREADS];
+
+    for (int i = 0; i < CONTEND_THREADS; i++) {
+        pthread_create(&th[i], NULL, incrementer, NULL);
+    }
+    for (int i = 0; i < CONTEND_THREADS; i++) {
+        pthread_join(th[i], NULL);
+    }
+    TEST_ASSERT_EQUAL_INT64(CONTEND_THREADS * CONTEND_LOOPS, s_shared.count);
+    TEST_ASSERT_TRUE(mu_spin_budget(&s_shared.mutex.spin) <= MU_SPIN_MAX);
+}
+
+void test_mu_cond_timedwait(void) {
+    pthread_t th;
+
+    mu_mutex_lock(&s_shared.mutex);
+    mu_time_abs_t deadline = in(MS(20));
+    while (mu_cond_timedwait(&s_shared.cond, &s_shared.mutex, deadline)) {
+    }
+    TEST_ASSERT_FALSE(mu_time_is_before(mu_time_now(), deadline));
+
+    pthread_create(&th, NULL, signaller, NULL);
+    deadline = in(MS(5000));
+    bool ok = true;
+    while (!s_shared.flag && ok) {
+        ok = mu_cond_timedwait(&s_shared.cond, &s_shared.mutex, deadline);
+    }
+    TEST_ASSERT_TRUE(s_shared.flag);
+    mu_mutex_unlock(&s_shared.mutex);
+    pthread_join(th, NULL);
+}
+
+void test_mu_sem_timedwait(void) {
+    pthread_t th;
+
+    mu_sem_post(&s_shared.sem);
+    TEST_ASSERT_TRUE(mu_sem_trywait(&s_shared.sem));
+    TEST_ASSERT_FALSE(mu_sem_trywait(&s_shared.sem));
+
+    mu_time_abs_t deadline = in(MS(20));
+    TEST_ASSERT_FALSE(mu_sem_timedwait(&s_shared.sem, deadline));
+    TEST_ASSERT_FALSE(mu_time_is_before(mu_time_now(), deadline));
+
+    pthread_create(&th, NULL, poster, NULL);
+    TEST_ASSERT_TRUE(mu_sem_timedwait(&s_shared.sem, in(MS(5000))));
+    mu_sem_wait(&s_shared.sem);
+    pthread_join(th, NULL);
+}
+
+void test_mu_futex_wait(void) {
+#if defined(__linux__)
+    pthread_t th;
+    mu_spin_t spin;
+
+    // A stale expected value returns at once.
+    TEST_ASSERT_TRUE(mu_futex_wait(&s_shared.word, 1, NULL));
+
+    mu_time_abs_t deadline = in(MS(20));
+    TEST_ASSERT_FALSE(mu_futex_wait(&s_shared.word, 0, &deadline));
+    TEST_ASSERT_FALSE(mu_time_is_before(mu_time_now(), deadline));
+
+    // A deadline already past does not sleep.
+    deadline = in(-MS(1));
+    TEST_ASSERT_FALSE(mu_futex_wait(&s_shared.word, 0, &deadline));
+
+    // A wait the kernel rejects fails rather than retrying forever.
+    deadline = (mu_time_abs_t){-5, 0};
+    errno = 0;
+    TEST_ASSERT_FALSE(mu_futex_wait(&s_shared.word, 0, &deadline));
+    TEST_ASSERT_EQUAL_INT(EINVAL, errno);
+
+    mu_spin_init(&spin, 0);
+    pthread_create(&th, NULL, waker, NULL);
+    deadline = in(MS(5000));
+    while (atomic_load(&s_shared.word) == 0) {
+        TEST_ASSERT_TRUE(mu_futex_await(&s_shared.word, 0, &deadline, &spin));
+    }
+    pthread_join(th, NULL);
+    // The 10 mSec block was too long to be worth spinning for.
+    TEST_ASSERT_EQUAL_INT64(0, mu_spin_budget(&spin));
+#else
+    TEST_IGNORE_MESSAGE("futex waits are Linux only");
+#endif
+}
+
+void test_mu_spin_adapts(void) {
+    mu_spin_t spin;
+
+    mu_spin_init(&spin, -1);
+    bool smp = sysconf(_SC_NPROCESSORS_ONLN) > 1;
+    TEST_ASSERT_EQUAL_INT64(smp ? MU_SPIN_DEFAULT : 0, mu_spin_budget(&spin));
+    mu_spin_init(&spin, 10 * MU_SPIN_MAX);
+    TEST_ASSERT_EQUAL_INT64(MU_SPIN_MAX, mu_spin_budget(&spin));
+
+    // Blocks too long to spin for decay the budget...
+    mu_spin_init(&spin, 8000);
+    mu_spin_update(&spin, MS(2), true);
+    TEST_ASSERT_EQUAL_INT64(7000, mu_spin_budget(&spin));
+    for (int i = 0; i < 40; i++) {
+        mu_spin_update(&spin, MS(2), true);
+    }
+    TEST_ASSERT_TRUE(mu_spin_budget(&spin) < 100);
+
+    // ...short blocks pull it toward the wait...
+    for (int i = 0; i < 60; i++) {
+        mu_spin_update(&spin, 10000, true);
+    }
+    TEST_ASSERT_INT64_WITHIN(100, 10000, mu_spin_budget(&spin));
+
+    // ...and successful spins toward twice the time spun.
+    for (int i = 0; i < 60; i++) {
+        mu_spin_update(&spin, 4000, false);
+    }
+    TEST_ASSERT_INT64_WITHIN(100, 8000, mu_spin_budget(&spin));
+    for (int i = 0; i < 60; i++) {
+        mu_spin_update(&spin, MU_SPIN_MAX, false);
+    }
+    TEST_ASSERT_TRUE(mu_spin_budget(&spin) <= MU_SPIN_MAX);
+
+    // A real mutex learns the same way.
+    for (int i = 0; i < 20; i++) {
+        contend_with_holder(MS(2));
+    }
+    TEST_ASSERT_TRUE(mu_spin_budget(&s_shared.mutex.spin) < MU_SPIN_DEFAULT);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_mutex_timedlock);
+    RUN_TEST(test_mu_mutex_contended);
+    RUN_TEST(test_mu_cond_timedwait);
+    RUN_TEST(test_mu_sem_timedwait);
+    RUN_TEST(test_mu_futex_wait);
+    RUN_TEST(test_mu_spin_adapts);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static mu_time_abs_t in(mu_time_rel_t delta) {
+    return mu_time_offset(mu_time_now(), delta);
+}
+
+static void sleep_for(mu_time_rel_t delta) {
+    struct timespec ts = {delta / 1000000000, delta % 1000000000};
+    nanosleep(&ts, NULL);
+}
+
+static void contend_with_holder(mu_time_rel_t hold) {
+    pthread_t th;
+
+    s_shared.hold = hold;
+    atomic_store(&s_shared.held, false);
+    pthread_create(&th, NULL, holder, NULL);
+    while (!atomic_load(&s_shared.held)) {
+    }
+    mu_mutex_lock(&s_shared.mutex);
+    mu_mutex_unlock(&s_shared.mutex);
+    pthread_join(th, NULL);
+}
+
+/**
+ * @brief Hold the mutex for s_shared.hold, raising s_shared.held once it is
+ * taken.
+ */
+static void *holder(void *arg) {
+    (void)arg;
+    mu_mutex_lock(&s_shared.mutex);
+    atomic_store(&s_shared.held, true);
+    sleep_for(s_shared.hold);
+    mu_mutex_unlock(&s_shared.mutex);
+    return NULL;
+}
+
+static void *incrementer(void *arg) {
+    (void)arg;
+    for (int i = 0; i < CONTEND_LOOPS; i++) {
+        mu_mutex_lock(&s_shared.mutex);
+        s_shared.count += 1;
+        mu_mutex_unlock(&s_shared.mutex);
+    }
+    return NULL;
+}
+
+static void *signaller(void *arg) {
+    (void)arg;
+    sleep_for(MS(10));
+    mu_mutex_lock(&s_shared.mutex);
+    s_shared.flag = true;
+    mu_cond_signal(&s_shared.cond);
+    mu_mutex_unlock(&s_shared.mutex);
+    return NULL;
+}
+
+static void *poster(void *arg) {
+    (void)arg;
+    sleep_for(MS(10));
+    mu_sem_post(&s_shared.sem);
+    mu_sem_post(&s_shared.sem);
+    return NULL;
+}
+
+#if defined(__linux__)
+static void *waker(void *arg) {
+    (void)arg;
+    sleep_for(MS(10));
+    atomic_store(&s_shared.word, 1);
+    mu_futex_wake(&s_shared.word, 1);
+    return NULL;
+}
+#endif
+
+// *****************************************************************************
+// End of file
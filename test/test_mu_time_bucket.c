@@ -0,0 +1,156 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_time_bucket.h"
+#include "unity.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_TIMES 2000
+
+// 2024-03-10 07:00:00 UTC: US Eastern switches from EST to EDT
+#define SPRING_FORWARD 1710054000
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_time_bucket_zone_t s_zone;
+static mu_time_abs_t s_times[N_TIMES];
+static int32_t s_buckets[N_TIMES];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_time_bucket_utc(void);
+void test_mu_time_bucket_seconds(void);
+void test_mu_time_bucket_transition_interval(void);
+void test_mu_time_bucket_matches_localtime(void);
+
+static int32_t reference_bucket(time_t t, int32_t unit);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    setenv("TZ", "EST5EDT,M3.2.0,M11.1.0", 1);
+    mu_time_bucket_zone_init(&s_zone);
+}
+
+void tearDown(void) {}
+
+void test_mu_time_bucket_utc(void) {
+    mu_time_abs_t times[] = {{0, 0}, {86399, 999}, {86400, 0}, {-1, 0},
+                             {3 * 86400 + 7200, 0}};
+    int32_t days[5];
+    int32_t hours[5];
+
+    mu_time_bucket_zone_init_utc(&s_zone);
+    mu_time_bucket(&s_zone, times, days, 5, MU_TIME_BUCKET_DAY);
+    mu_time_bucket(&s_zone, times, hours, 5, MU_TIME_BUCKET_HOUR);
+    TEST_ASSERT_EQUAL_INT32(0, days[0]);
+    TEST_ASSERT_EQUAL_INT32(0, days[1]);
+    TEST_ASSERT_EQUAL_INT32(1, days[2]);
+    TEST_ASSERT_EQUAL_INT32(-1, days[3]);
+    TEST_ASSERT_EQUAL_INT32(3, days[4]);
+    TEST_ASSERT_EQUAL_INT32(23, hours[1]);
+    TEST_ASSERT_EQUAL_INT32(-1, hours[3]);
+    TEST_ASSERT_EQUAL_INT32(74, hours[4]);
+    TEST_ASSERT_EQUAL_UINT32(0, s_zone.refreshes);
+}
+
+void test_mu_time_bucket_seconds(void) {
+    int64_t seconds[] = {SPRING_FORWARD - 1, SPRING_FORWARD};
+    int32_t hours[2];
+
+    mu_time_bucket_seconds(&s_zone, seconds, hours, 2, MU_TIME_BUCKET_HOUR);
+    // 01:59:59 EST is followed by 03:00:00 EDT: local hour 2 is skipped
+    TEST_ASSERT_EQUAL_INT32(2, hours[1] - hours[0]);
+}
+
+void test_mu_time_bucket_transition_interval(void) {
+    TEST_ASSERT_EQUAL_INT32(-5 * 3600,
+                            mu_time_bucket_utc_offset(&s_zone, SPRING_FORWARD - 1));
+    TEST_ASSERT_EQUAL_INT32(-4 * 3600,
+                            mu_time_bucket_utc_offset(&s_zone, SPRING_FORWARD));
+    TEST_ASSERT_EQUAL_INT64(SPRING_FORWARD, s_zone.cache[0].end);
+    TEST_ASSERT_EQUAL_INT64(SPRING_FORWARD, s_zone.cache[1].start);
+    TEST_ASSERT_EQUAL_UINT32(2, s_zone.refreshes);
+}
+
+void test_mu_time_bucket_matches_localtime(void) {
+    // Unsorted times scattered over two weeks around the transition, with a
+    // sorted run at the end.
+    uint32_t seed = 1;
+    for (int i = 0; i < N_TIMES; i++) {
+        seed = seed * 1103515245 + 12345;
+        int64_t jitter = (int64_t)(seed >> 4) % (14 * 86400);
+        int64_t s = (i < N_TIMES / 2) ? SPRING_FORWARD - 7 * 86400 + jitter
+                                      : SPRING_FORWARD + 37 * i;
+        s_times[i] = (mu_time_abs_t){.seconds = s, .nanoseconds = 0};
+    }
+
+    mu_time_bucket(&s_zone, s_times, s_buckets, N_TIMES, MU_TIME_BUCKET_DAY);
+    for (int i = 0; i < N_TIMES; i++) {
+        TEST_ASSERT_EQUAL_INT32(reference_bucket(s_times[i].seconds, 86400),
+                                s_buckets[i]);
+    }
+    mu_time_bucket(&s_zone, s_times, s_buckets, N_TIMES, MU_TIME_BUCKET_HOUR);
+    for (int i = 0; i < N_TIMES; i++) {
+        TEST_ASSERT_EQUAL_INT32(reference_bucket(s_times[i].seconds, 3600),
+                                s_buckets[i]);
+    }
+    TEST_ASSERT_TRUE(s_zone.refreshes <= 3);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_time_bucket_utc);
+    RUN_TEST(test_mu_time_bucket_seconds);
+    RUN_TEST(test_mu_time_bucket_transition_interval);
+    RUN_TEST(test_mu_time_bucket_matches_localtime);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static int32_t reference_bucket(time_t t, int32_t unit) {
+    struct tm tm;
+    localtime_r(&t, &tm);
+    int64_t local = (int64_t)t + tm.tm_gmtoff;
+    int64_t q = local / unit;
+    return (int32_t)((local % unit != 0 && local < 0) ? q - 1 : q);
+}
+
+// *****************************************************************************
+// End of file
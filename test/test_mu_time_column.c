@@ -0,0 +1,247 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_time_bucket.h"
+#include "mu_time_column.h"
+#include "unity.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_ROWS 21
+#define SECOND 1000000000LL
+#define BASE (1700000000 * SECOND) // 2023-11-14 22:13:20 UTC
+
+// *****************************************************************************
+// Private (static) storage
+
+static int64_t s_values[N_ROWS];
+static uint8_t s_validity[(N_ROWS + 7) / 8];
+static mu_time_column_t s_col;
+static int s_released;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_time_column_get_set(void);
+void test_mu_time_column_null_count(void);
+void test_mu_time_column_compare(void);
+void test_mu_time_column_compare_unaligned(void);
+void test_mu_time_column_difference_offset(void);
+void test_mu_time_column_bucket(void);
+void test_mu_time_column_min_max(void);
+void test_mu_time_column_export_import(void);
+
+static void on_release(void *ctx);
+static bool bit(const uint8_t *bitmap, size_t i);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    // Rows one hour apart; every third row null
+    memset(s_validity, 0xff, sizeof(s_validity));
+    mu_time_column_init(&s_col, s_values, s_validity, N_ROWS);
+    for (size_t i = 0; i < N_ROWS; i++) {
+        s_values[i] = BASE + (int64_t)i * 3600 * SECOND;
+        if (i % 3 == 0) {
+            mu_time_column_set_null(&s_col, i);
+        }
+    }
+    s_released = 0;
+}
+
+void tearDown(void) {}
+
+void test_mu_time_column_get_set(void) {
+    mu_time_abs_t t = {1700000000, 250};
+
+    TEST_ASSERT_FALSE(mu_time_column_is_valid(&s_col, 0));
+    TEST_ASSERT_TRUE(mu_time_column_is_valid(&s_col, 1));
+    mu_time_column_set(&s_col, 0, t);
+    TEST_ASSERT_TRUE(mu_time_column_is_valid(&s_col, 0));
+    TEST_ASSERT_EQUAL_INT64(BASE + 250, s_values[0]);
+    mu_time_abs_t u = mu_time_column_get(&s_col, 1);
+    TEST_ASSERT_EQUAL_INT64(1700003600, u.seconds);
+    TEST_ASSERT_EQUAL_INT64(0, u.nanoseconds);
+}
+
+void test_mu_time_column_null_count(void) {
+    mu_time_column_t all;
+
+    TEST_ASSERT_EQUAL_size_t(7, mu_time_column_null_count(&s_col));
+    mu_time_column_init(&all, s_values, NULL, N_ROWS);
+    TEST_ASSERT_EQUAL_size_t(0, mu_time_column_null_count(&all));
+}
+
+void test_mu_time_column_compare(void) {
+    uint8_t out[(N_ROWS + 7) / 8];
+    mu_time_abs_t t = mu_time_posix_from_nanos(BASE + 10 * 3600 * SECOND);
+
+    // rows 0..9 are before, less the nulls 0, 3, 6, 9
+    TEST_ASSERT_EQUAL_size_t(6, mu_time_column_before(&s_col, t, out));
+    for (size_t i = 0; i < N_ROWS; i++) {
+        TEST_ASSERT_EQUAL(i < 10 && i % 3 != 0, bit(out, i));
+    }
+    // rows 11..20, less 12, 15, 18
+    TEST_ASSERT_EQUAL_size_t(7, mu_time_column_after(&s_col, t, out));
+    TEST_ASSERT_TRUE(bit(out, 20));
+    TEST_ASSERT_FALSE(bit(out, 10));
+
+    mu_time_abs_t end = mu_time_posix_from_nanos(BASE + 14 * 3600 * SECOND);
+    TEST_ASSERT_EQUAL_size_t(3, mu_time_column_in_range(&s_col, t, end, out));
+    TEST_ASSERT_TRUE(bit(out, 10) && bit(out, 11) && bit(out, 13));
+    TEST_ASSERT_FALSE(bit(out, 12) || bit(out, 14));
+}
+
+void test_mu_time_column_compare_unaligned(void) {
+    // A slice starting at row 5, as an Arrow array with offset 5 would be
+    mu_time_column_t slice = s_col;
+    uint8_t out[2];
+    mu_time_abs_t t = mu_time_posix_from_nanos(BASE + 15 * 3600 * SECOND);
+
+    slice.offset = 5;
+    slice.length = 13;
+    TEST_ASSERT_EQUAL_size_t(4, mu_time_column_null_count(&slice)); // 6,9,12,15
+    // rows 5..14 before, less 6, 9, 12
+    TEST_ASSERT_EQUAL_size_t(7, mu_time_column_before(&slice, t, out));
+    TEST_ASSERT_TRUE(bit(out, 0));  // row 5
+    TEST_ASSERT_FALSE(bit(out, 1)); // row 6
+    TEST_ASSERT_TRUE(bit(out, 9));  // row 14
+    TEST_ASSERT_FALSE(bit(out, 10));
+}
+
+void test_mu_time_column_difference_offset(void) {
+    mu_time_rel_t diff[N_ROWS];
+    mu_time_abs_t ref = mu_time_posix_from_nanos(BASE);
+
+    mu_time_column_difference(&s_col, ref, diff);
+    TEST_ASSERT_EQUAL_INT64(7 * 3600 * SECOND, diff[7]);
+    TEST_ASSERT_EQUAL_INT64(
+        mu_time_difference(ref, mu_time_column_get(&s_col, 20)), diff[20]);
+
+    // in place
+    mu_time_column_offset(&s_col, -SECOND / 2, s_values);
+    TEST_ASSERT_EQUAL_INT64(BASE + 3600 * SECOND - SECOND / 2, s_values[1]);
+}
+
+void test_mu_time_column_bucket(void) {
+    mu_time_bucket_zone_t zone;
+    int32_t buckets[N_ROWS];
+    int64_t seconds[1];
+    int32_t expect[1];
+
+    mu_time_bucket_zone_init_utc(&zone);
+    s_values[3] = INT64_MIN; // garbage under a null
+    mu_time_column_bucket(&s_col, &zone, buckets, MU_TIME_BUCKET_HOUR);
+    for (size_t i = 0; i < N_ROWS; i++) {
+        if (!mu_time_column_is_valid(&s_col, i)) {
+            continue;
+        }
+        seconds[0] = s_values[i] / SECOND;
+        mu_time_bucket_seconds(&zone, seconds, expect, 1, MU_TIME_BUCKET_HOUR);
+        TEST_ASSERT_EQUAL_INT32(expect[0], buckets[i]);
+    }
+    TEST_ASSERT_EQUAL_INT32(buckets[1] + 1, buckets[2]);
+}
+
+void test_mu_time_column_min_max(void) {
+    mu_time_abs_t min, max;
+
+    s_values[0] = 0;         // null, must be ignored
+    s_values[18] = INT64_MAX; // null
+    TEST_ASSERT_TRUE(mu_time_column_min_max(&s_col, &min, &max));
+    TEST_ASSERT_EQUAL_INT64(1700003600, min.seconds);
+    TEST_ASSERT_EQUAL_INT64(1700000000 + 20 * 3600, max.seconds);
+
+    memset(s_validity, 0, sizeof(s_validity));
+    TEST_ASSERT_FALSE(mu_time_column_min_max(&s_col, &min, &max));
+}
+
+void test_mu_time_column_export_import(void) {
+    struct ArrowSchema schema;
+    struct ArrowArray array;
+    mu_time_column_t view;
+
+    TEST_ASSERT_TRUE(mu_time_column_export(&s_col, "UTC", on_release,
+                                           &s_released, &schema, &array));
+    TEST_ASSERT_EQUAL_STRING("tsn:UTC", schema.format);
+    TEST_ASSERT_EQUAL_INT64(ARROW_FLAG_NULLABLE, schema.flags);
+    TEST_ASSERT_EQUAL_INT64(N_ROWS, array.length);
+    TEST_ASSERT_EQUAL_INT64(7, array.null_count);
+    TEST_ASSERT_EQUAL_INT64(2, array.n_buffers);
+    // zero copy
+    TEST_ASSERT_EQUAL_PTR(s_validity, array.buffers[0]);
+    TEST_ASSERT_EQUAL_PTR(s_values, array.buffers[1]);
+
+    TEST_ASSERT_TRUE(mu_time_column_import(&view, &schema, &array));
+    TEST_ASSERT_EQUAL_PTR(s_values, view.values);
+    TEST_ASSERT_EQUAL_size_t(N_ROWS, view.length);
+    TEST_ASSERT_EQUAL_size_t(7, mu_time_column_null_count(&view));
+
+    schema.release(&schema);
+    TEST_ASSERT_NULL(schema.release);
+    TEST_ASSERT_EQUAL_INT(0, s_released);
+    array.release(&array);
+    TEST_ASSERT_NULL(array.release);
+    TEST_ASSERT_EQUAL_INT(1, s_released);
+
+    // Only nanosecond timestamps are viewed in place
+    struct ArrowSchema micros = {.format = "tsu:"};
+    TEST_ASSERT_FALSE(mu_time_column_import(&view, &micros, &array));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_time_column_get_set);
+    RUN_TEST(test_mu_time_column_null_count);
+    RUN_TEST(test_mu_time_column_compare);
+    RUN_TEST(test_mu_time_column_compare_unaligned);
+    RUN_TEST(test_mu_time_column_difference_offset);
+    RUN_TEST(test_mu_time_column_bucket);
+    RUN_TEST(test_mu_time_column_min_max);
+    RUN_TEST(test_mu_time_column_export_import);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void on_release(void *ctx) {
+    *(int *)ctx += 1;
+}
+
+static bool bit(const uint8_t *bitmap, size_t i) {
+    return (bitmap[i >> 3] >> (i & 7)) & 1;
+}
+
+// *****************************************************************************
+// End of file
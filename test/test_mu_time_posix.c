@@ -40,6 +40,7 @@
 
 void test_mu_time_now(void);
 void test_mu_time_offset(void);
+void test_mu_time_offset_negative(void);
 void test_mu_time_difference(void);
 void test_mu_time_is_before(void);
 void test_mu_time_is_after(void);
@@ -77,6 +78,16 @@ void test_mu_time_offset(void) {
     TEST_ASSERT_EQUAL_UINT32(expected.nanoseconds, result.nanoseconds);
 }
 
+void test_mu_time_offset_negative(void) {
+    mu_time_abs_t base = {1000, 250000000};  // 1000s + 250ms
+    mu_time_rel_t delta = -500000000;       // -0.5s in nanoseconds
+    mu_time_abs_t result = mu_time_offset(base, delta);
+
+    mu_time_abs_t expected = {999, 750000000};  // Expected result (999.75s)
+    TEST_ASSERT_EQUAL_UINT32(expected.seconds, result.seconds);
+    TEST_ASSERT_EQUAL_UINT32(expected.nanoseconds, result.nanoseconds);
+}
+
 void test_mu_time_difference(void) {
     mu_time_abs_t a = {1000, 0};
     mu_time_abs_t b = {1002, 500000000};  // 2.5s later
@@ -128,6 +139,7 @@ int main(void) {
     RUN_TEST(test_mu_time_now);
     RUN_TEST(test_mu_time_rel_max);
     RUN_TEST(test_mu_time_offset);
+    RUN_TEST(test_mu_time_offset_negative);
     RUN_TEST(test_mu_time_difference);
     RUN_TEST(test_mu_time_is_before);
     RUN_TEST(test_mu_time_is_after);
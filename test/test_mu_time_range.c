@@ -0,0 +1,335 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_time_range.h"
+#include "unity.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define SPAN 1000 ///< Brute-force timeline length
+#define CAP 256
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_time_range_add(void);
+void test_mu_time_range_normalize(void);
+void test_mu_time_range_contains(void);
+void test_mu_time_range_ops(void);
+void test_mu_time_range_coverage_within(void);
+void test_mu_time_range_capacity(void);
+void test_mu_time_range_brute_force(void);
+
+static mu_time_abs_t ns(int64_t nanos);
+static mu_time_rel_t within(const mu_time_range_set_t *set, int64_t lo,
+                            int64_t hi);
+static void random_set(mu_time_range_set_t *set, bool *bits);
+static void check_set(const mu_time_range_set_t *set, const bool *bits);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_mu_time_range_add(void) {
+    mu_time_range_t storage[8];
+    mu_time_range_set_t s;
+
+    mu_time_range_set_init(&s, storage, 8);
+    TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(&s, 10, 20));
+    TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(&s, 40, 50));
+    TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(&s, 0, 5));
+    TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(&s, 30, 30)); // empty
+    TEST_ASSERT_EQUAL_size_t(3, mu_time_range_set_count(&s));
+
+    // Touching ranges coalesce; a bridge swallows its neighbours.
+    TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(&s, 20, 25));
+    TEST_ASSERT_TRUE(mu_time_range_set_add(&s, ns(24), ns(41)));
+    const mu_time_range_t *r = mu_time_range_set_ranges(&s);
+    TEST_ASSERT_EQUAL_size_t(2, mu_time_range_set_count(&s));
+    TEST_ASSERT_EQUAL_INT64(0, r[0].start);
+    TEST_ASSERT_EQUAL_INT64(5, r[0].end);
+    TEST_ASSERT_EQUAL_INT64(10, r[1].start);
+    TEST_ASSERT_EQUAL_INT64(50, r[1].end);
+    TEST_ASSERT_EQUAL_INT64(45, mu_time_range_set_coverage(&s));
+
+    mu_time_range_set_clear(&s);
+    TEST_ASSERT_EQUAL_size_t(0, mu_time_range_set_count(&s));
+    TEST_ASSERT_EQUAL_INT64(0, mu_time_range_set_coverage(&s));
+    // Ranges may start at the very bottom of the timeline.
+    TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(&s, INT64_MIN + 10, -5));
+    TEST_ASSERT_TRUE(
+        mu_time_range_set_add_nanos(&s, INT64_MIN, INT64_MIN + 10));
+    TEST_ASSERT_EQUAL_size_t(1, mu_time_range_set_count(&s));
+    TEST_ASSERT_EQUAL_INT64(INT64_MIN, r[0].start);
+    TEST_ASSERT_EQUAL_INT64(-5, r[0].end);
+}
+
+void test_mu_time_range_normalize(void) {
+    mu_time_range_t storage[8];
+    mu_time_range_set_t s;
+
+    mu_time_range_set_init(&s, storage, 8);
+    TEST_ASSERT_TRUE(mu_time_range_set_append(&s, 50, 60));
+    TEST_ASSERT_TRUE(mu_time_range_set_append(&s, 0, 10));
+    TEST_ASSERT_TRUE(mu_time_range_set_append(&s, 5, 8));
+    TEST_ASSERT_TRUE(mu_time_range_set_append(&s, 70, 70));
+    TEST_ASSERT_TRUE(mu_time_range_set_append(&s, 10, 20));
+    TEST_ASSERT_TRUE(mu_time_range_set_append(&s, 55, 65));
+    mu_time_range_set_normalize(&s);
+
+    const mu_time_range_t *r = mu_time_range_set_ranges(&s);
+    TEST_ASSERT_EQUAL_size_t(2, mu_time_range_set_count(&s));
+    TEST_ASSERT_EQUAL_INT64(0, r[0].start);
+    TEST_ASSERT_EQUAL_INT64(20, r[0].end);
+    TEST_ASSERT_EQUAL_INT64(50, r[1].start);
+    TEST_ASSERT_EQUAL_INT64(65, r[1].end);
+}
+
+void test_mu_time_range_contains(void) {
+    mu_time_range_t storage[4];
+    mu_time_range_set_t s;
+
+    mu_time_range_set_init(&s, storage, 4);
+    TEST_ASSERT_FALSE(mu_time_range_set_contains(&s, ns(0)));
+    mu_time_range_set_add_nanos(&s, 1000000000, 2000000000);
+    mu_time_range_set_add_nanos(&s, 3000000000, 4000000000);
+    TEST_ASSERT_FALSE(mu_time_range_set_contains(&s, ns(999999999)));
+    TEST_ASSERT_TRUE(mu_time_range_set_contains(&s, ns(1000000000)));
+    TEST_ASSERT_TRUE(mu_time_range_set_contains(&s, ns(1999999999)));
+    TEST_ASSERT_FALSE(mu_time_range_set_contains(&s, ns(2000000000)));
+    TEST_ASSERT_TRUE(mu_time_range_set_contains(&s, ns(3500000000)));
+    TEST_ASSERT_FALSE(mu_time_range_set_contains(&s, ns(4000000000)));
+}
+
+void test_mu_time_range_ops(void) {
+    mu_time_range_t sa[4], sb[4], so[8];
+    mu_time_range_set_t a, b, out;
+
+    // Availability: up [0,100) and [200,300); maintenance [50,250).
+    mu_time_range_set_init(&a, sa, 4);
+    mu_time_range_set_init(&b, sb, 4);
+    mu_time_range_set_init(&out, so, 8);
+    mu_time_range_set_add_nanos(&a, 0, 100);
+    mu_time_range_set_add_nanos(&a, 200, 300);
+    mu_time_range_set_add_nanos(&b, 50, 250);
+
+    TEST_ASSERT_TRUE(mu_time_range_union(&out, &a, &b));
+    TEST_ASSERT_EQUAL_size_t(1, mu_time_range_set_count(&out));
+    TEST_ASSERT_EQUAL_INT64(300, mu_time_range_set_coverage(&out));
+
+    TEST_ASSERT_TRUE(mu_time_range_intersection(&out, &a, &b));
+    TEST_ASSERT_EQUAL_size_t(2, mu_time_range_set_count(&out));
+    TEST_ASSERT_EQUAL_INT64(50, so[0].start);
+    TEST_ASSERT_EQUAL_INT64(100, so[0].end);
+    TEST_ASSERT_EQUAL_INT64(200, so[1].start);
+    TEST_ASSERT_EQUAL_INT64(250, so[1].end);
+
+    TEST_ASSERT_TRUE(mu_time_range_difference(&out, &a, &b));
+    TEST_ASSERT_EQUAL_size_t(2, mu_time_range_set_count(&out));
+    TEST_ASSERT_EQUAL_INT64(0, so[0].start);
+    TEST_ASSERT_EQUAL_INT64(50, so[0].end);
+    TEST_ASSERT_EQUAL_INT64(250, so[1].start);
+    TEST_ASSERT_EQUAL_INT64(300, so[1].end);
+
+    TEST_ASSERT_TRUE(mu_time_range_difference(&out, &b, &a));
+    TEST_ASSERT_EQUAL_size_t(1, mu_time_range_set_count(&out));
+    TEST_ASSERT_EQUAL_INT64(100, so[0].start);
+    TEST_ASSERT_EQUAL_INT64(200, so[0].end);
+
+    // With an empty set.
+    mu_time_range_set_clear(&b);
+    TEST_ASSERT_TRUE(mu_time_range_intersection(&out, &a, &b));
+    TEST_ASSERT_EQUAL_size_t(0, mu_time_range_set_count(&out));
+    TEST_ASSERT_TRUE(mu_time_range_difference(&out, &a, &b));
+    TEST_ASSERT_EQUAL_size_t(2, mu_time_range_set_count(&out));
+}
+
+void test_mu_time_range_coverage_within(void) {
+    mu_time_range_t storage[4];
+    mu_time_range_set_t s;
+
+    mu_time_range_set_init(&s, storage, 4);
+    mu_time_range_set_add_nanos(&s, 0, 100);
+    mu_time_range_set_add_nanos(&s, 200, 300);
+    mu_time_range_set_add_nanos(&s, 400, 500);
+    TEST_ASSERT_EQUAL_INT64(100, within(&s, 50, 250));
+    TEST_ASSERT_EQUAL_INT64(0, within(&s, 300, 400));
+    TEST_ASSERT_EQUAL_INT64(300, within(&s, -5, 900));
+    TEST_ASSERT_EQUAL_INT64(0, within(&s, 250, 250));
+}
+
+void test_mu_time_range_capacity(void) {
+    mu_time_range_t sa[4], sb[4], so[2];
+    mu_time_range_set_t a, b, out;
+
+    mu_time_range_set_init(&a, sa, 2);
+    TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(&a, 0, 10));
+    TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(&a, 20, 30));
+    TEST_ASSERT_FALSE(mu_time_range_set_add_nanos(&a, 40, 50));
+    TEST_ASSERT_FALSE(mu_time_range_set_append(&a, 40, 50));
+    // Merging into existing ranges needs no room.
+    TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(&a, 5, 25));
+    TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(&a, 40, 50));
+
+    mu_time_range_set_init(&b, sb, 4);
+    mu_time_range_set_add_nanos(&b, 100, 110);
+    mu_time_range_set_init(&out, so, 2);
+    TEST_ASSERT_FALSE(mu_time_range_union(&out, &a, &b));
+    TEST_ASSERT_EQUAL_size_t(2, mu_time_range_set_count(&out));
+}
+
+void test_mu_time_range_brute_force(void) {
+    static mu_time_range_t sa[CAP], sb[CAP], so[2 * CAP];
+    static bool ba[SPAN], bb[SPAN], bo[SPAN];
+    mu_time_range_set_t a, b, out;
+
+    srand(7);
+    mu_time_range_set_init(&out, so, 2 * CAP);
+    for (int round = 0; round < 200; round++) {
+        mu_time_range_set_init(&a, sa, CAP);
+        mu_time_range_set_init(&b, sb, CAP);
+        random_set(&a, ba);
+        random_set(&b, bb);
+        check_set(&a, ba);
+        check_set(&b, bb);
+
+        TEST_ASSERT_TRUE(mu_time_range_union(&out, &a, &b));
+        for (int t = 0; t < SPAN; t++) {
+            bo[t] = ba[t] || bb[t];
+        }
+        check_set(&out, bo);
+
+        TEST_ASSERT_TRUE(mu_time_range_intersection(&out, &a, &b));
+        for (int t = 0; t < SPAN; t++) {
+            bo[t] = ba[t] && bb[t];
+        }
+        check_set(&out, bo);
+
+        TEST_ASSERT_TRUE(mu_time_range_difference(&out, &a, &b));
+        for (int t = 0; t < SPAN; t++) {
+            bo[t] = ba[t] && !bb[t];
+        }
+        check_set(&out, bo);
+
+        int lo = rand() % SPAN, hi = lo + rand() % (SPAN - lo + 1);
+        int64_t expect = 0;
+        for (int t = lo; t < hi; t++) {
+            expect += ba[t];
+        }
+        TEST_ASSERT_EQUAL_INT64(
+            expect, mu_time_range_set_coverage_within(&a, ns(lo), ns(hi)));
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_time_range_add);
+    RUN_TEST(test_mu_time_range_normalize);
+    RUN_TEST(test_mu_time_range_contains);
+    RUN_TEST(test_mu_time_range_ops);
+    RUN_TEST(test_mu_time_range_coverage_within);
+    RUN_TEST(test_mu_time_range_capacity);
+    RUN_TEST(test_mu_time_range_brute_force);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static mu_time_abs_t ns(int64_t nanos) {
+    return mu_time_posix_from_nanos(nanos);
+}
+
+static mu_time_rel_t within(const mu_time_range_set_t *set, int64_t lo,
+                            int64_t hi) {
+    return mu_time_range_set_coverage_within(set, ns(lo), ns(hi));
+}
+
+/**
+ * @brief Fill a set with random ranges on [0, SPAN), half added one at a
+ * time and half appended and normalized, and mark them in `bits`.
+ */
+static void random_set(mu_time_range_set_t *set, bool *bits) {
+    int n = rand() % 40;
+
+    memset(bits, 0, SPAN * sizeof(bool));
+    for (int i = 0; i < n; i++) {
+        int start = rand() % SPAN;
+        int end = start + rand() % 60;
+        if (end > SPAN) {
+            end = SPAN;
+        }
+        for (int t = start; t < end; t++) {
+            bits[t] = true;
+        }
+        if (i % 2 == 0) {
+            TEST_ASSERT_TRUE(mu_time_range_set_append(set, start, end));
+        } else {
+            mu_time_range_set_normalize(set);
+            TEST_ASSERT_TRUE(mu_time_range_set_add_nanos(set, start, end));
+        }
+    }
+    mu_time_range_set_normalize(set);
+}
+
+/**
+ * @brief Check a set is sorted and coalesced and covers exactly `bits`.
+ */
+static void check_set(const mu_time_range_set_t *set, const bool *bits) {
+    const mu_time_range_t *r = mu_time_range_set_ranges(set);
+    size_t n = mu_time_range_set_count(set);
+    int64_t covered = 0;
+    size_t k = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_TRUE(r[i].start < r[i].end);
+        if (i > 0) {
+            TEST_ASSERT_TRUE(r[i - 1].end < r[i].start);
+        }
+    }
+    for (int t = 0; t < SPAN; t++) {
+        while (k < n && r[k].end <= t) {
+            k++;
+        }
+        bool in = k < n && r[k].start <= t;
+        TEST_ASSERT_EQUAL(bits[t], in);
+        covered += bits[t];
+    }
+    TEST_ASSERT_EQUAL_INT64(covered, mu_time_range_set_coverage(set));
+}
+
+// *****************************************************************************
+// End of file
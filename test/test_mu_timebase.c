@@ -0,0 +1,146 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_timebase.h"
+#include "unity.h"
+#include <stdio.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+// *****************************************************************************
+// Private (static) storage
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_tb_ms32_rollover(void);
+void test_mu_tb_ms32_conversions(void);
+void test_mu_tb_ns64_conversions(void);
+void test_mu_timebase_unwrap32(void);
+void test_mu_timebase_map_nominal(void);
+void test_mu_timebase_map_drift(void);
+void test_mu_time_posix_nanos(void);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {}    // Called before each test, useful for setup.
+void tearDown(void) {} // Called after each test, useful for cleanup.
+
+void test_mu_tb_ms32_rollover(void) {
+    mu_tb_ms32_abs_t a = 0xfffffff0;
+    mu_tb_ms32_abs_t b = mu_tb_ms32_offset(a, 0x20);  // wraps past zero
+
+    TEST_ASSERT_EQUAL_UINT32(0x10, b);
+    TEST_ASSERT_EQUAL_INT32(0x20, mu_tb_ms32_difference(a, b));
+    TEST_ASSERT_EQUAL_INT32(-0x20, mu_tb_ms32_difference(b, a));
+    TEST_ASSERT_TRUE(mu_tb_ms32_is_before(a, b));
+    TEST_ASSERT_TRUE(mu_tb_ms32_is_after(b, a));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, mu_tb_ms32_rel_max());
+}
+
+void test_mu_tb_ms32_conversions(void) {
+    TEST_ASSERT_EQUAL_INT32(1500, mu_tb_ms32_rel_from_millis(1500));
+    TEST_ASSERT_EQUAL_INT32(1500, mu_tb_ms32_rel_to_millis(1500));
+    TEST_ASSERT_EQUAL_INT32(2, mu_tb_ms32_rel_from_nanos(2999999));
+    TEST_ASSERT_EQUAL_INT64(3000000, mu_tb_ms32_rel_to_nanos(3));
+    TEST_ASSERT_EQUAL_INT32(1500, mu_tb_ms32_rel_from_seconds(1.5f));
+}
+
+void test_mu_tb_ns64_conversions(void) {
+    TEST_ASSERT_EQUAL_INT64(1500000000, mu_tb_ns64_rel_from_millis(1500));
+    TEST_ASSERT_EQUAL_INT32(-1500, mu_tb_ns64_rel_to_millis(-1500000000));
+    TEST_ASSERT_EQUAL_INT64(INT64_MAX, mu_tb_ns64_rel_max());
+    TEST_ASSERT_TRUE(mu_tb_ns64_is_before(UINT64_MAX, 0));
+}
+
+void test_mu_timebase_unwrap32(void) {
+    uint64_t last = 0xfffffff0;
+
+    TEST_ASSERT_EQUAL_UINT64(0xfffffff8, mu_timebase_unwrap32(&last, 0xfffffff8));
+    TEST_ASSERT_EQUAL_UINT64(0x100000004, mu_timebase_unwrap32(&last, 0x4));
+    // A slightly older sample must not advance the extended count
+    TEST_ASSERT_EQUAL_UINT64(0xfffffffe, mu_timebase_unwrap32(&last, 0xfffffffe));
+}
+
+void test_mu_timebase_map_nominal(void) {
+    mu_timebase_map_t map;
+
+    // device ms ticks 1000 correspond to host ns 5e9
+    mu_timebase_map_init(&map, 1000, 1000000000, 1000, 5000000000);
+    TEST_ASSERT_EQUAL_UINT64(5000000000, mu_timebase_map_apply(&map, 1000));
+    TEST_ASSERT_EQUAL_UINT64(6500000000, mu_timebase_map_apply(&map, 2500));
+    TEST_ASSERT_EQUAL_UINT64(4000000000, mu_timebase_map_apply(&map, 0));
+
+    // and back again, ns -> ms
+    mu_timebase_map_init(&map, 1000000000, 1000, 5000000000, 1000);
+    TEST_ASSERT_EQUAL_UINT64(2500, mu_timebase_map_apply(&map, 6500000000));
+}
+
+void test_mu_timebase_map_drift(void) {
+    mu_timebase_map_t map;
+
+    // A device clock running 100 ppm fast: 10000 of its ms ticks are only
+    // 9.999 seconds of host time.
+    mu_timebase_map_init(&map, 1000, 1000000000, 0, 0);
+    mu_timebase_map_set_drift_ppb(&map, 100000);
+    uint64_t host = mu_timebase_map_apply(&map, 10000);
+    TEST_ASSERT_UINT64_WITHIN(2, 9999000100, host);
+}
+
+void test_mu_time_posix_nanos(void) {
+    mu_time_abs_t t = {1000, 500000000};
+    TEST_ASSERT_EQUAL_INT64(1000500000000, mu_time_posix_to_nanos(t));
+
+    mu_time_abs_t u = mu_time_posix_from_nanos(-1500000000);
+    TEST_ASSERT_EQUAL_INT64(-2, u.seconds);
+    TEST_ASSERT_EQUAL_INT64(500000000, u.nanoseconds);
+
+    // native difference agrees with the ns64 family
+    mu_time_abs_t v = mu_time_offset(t, 2500000000);
+    TEST_ASSERT_EQUAL_INT64(
+        mu_time_difference(t, v),
+        mu_tb_ns64_difference((uint64_t)mu_time_posix_to_nanos(t),
+                              (uint64_t)mu_time_posix_to_nanos(v)));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_tb_ms32_rollover);
+    RUN_TEST(test_mu_tb_ms32_conversions);
+    RUN_TEST(test_mu_tb_ns64_conversions);
+    RUN_TEST(test_mu_timebase_unwrap32);
+    RUN_TEST(test_mu_timebase_map_nominal);
+    RUN_TEST(test_mu_timebase_map_drift);
+    RUN_TEST(test_mu_time_posix_nanos);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// End of file
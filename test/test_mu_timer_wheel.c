@@ -0,0 +1,344 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_pool.h"
+#include "mu_time.h"
+#include "mu_timer_wheel.h"
+#include "unity.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RESOLUTION 1000000 // 1 mSec ticks
+#define N_RANDOM 2000
+
+typedef struct {
+    mu_timer_t timer;
+    int fired;
+    mu_time_abs_t fired_at;
+} probe_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_timer_wheel_t s_wheel;
+static mu_pool_t s_pool;
+static mu_timer_t s_nodes[16];
+static mu_time_abs_t s_origin = {1000, 0};
+static mu_time_abs_t s_now;
+static probe_t s_probes[N_RANDOM];
+static int s_fire_count;
+static mu_timer_t *s_peers[2];
+static bool s_peer_cancelled;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_timer_wheel_fires_on_time(void);
+void test_mu_timer_wheel_cancel(void);
+void test_mu_timer_wheel_rearm_from_callback(void);
+void test_mu_timer_wheel_peer_from_callback(void);
+void test_mu_timer_wheel_pooled(void);
+void test_mu_timer_wheel_random_deadlines(void);
+void test_mu_timer_wheel_stats(void);
+
+static void on_fire(mu_timer_t *timer, void *arg);
+static void on_periodic(mu_timer_t *timer, void *arg);
+static void on_count(mu_timer_t *timer, void *arg);
+static void on_cancel_peer(mu_timer_t *timer, void *arg);
+static void on_rearm_peer(mu_timer_t *timer, void *arg);
+static mu_time_abs_t at_millis(int64_t millis);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    mu_pool_init(&s_pool, sizeof(mu_timer_t), s_nodes, sizeof(s_nodes));
+    mu_timer_wheel_init(&s_wheel, s_origin, RESOLUTION, &s_pool);
+    s_now = s_origin;
+    s_fire_count = 0;
+    s_peer_cancelled = false;
+}
+
+void tearDown(void) {}
+
+void test_mu_timer_wheel_fires_on_time(void) {
+    probe_t p = {0};
+    mu_time_abs_t deadline = mu_time_offset(s_origin, 2500000);  // 2.5 mSec
+
+    mu_timer_init(&p.timer, on_fire, &p);
+    mu_timer_wheel_arm(&s_wheel, &p.timer, deadline);
+    TEST_ASSERT_TRUE(mu_timer_is_pending(&p.timer));
+
+    TEST_ASSERT_EQUAL(0, mu_timer_wheel_advance(&s_wheel, at_millis(2)));
+    TEST_ASSERT_EQUAL(1, mu_timer_wheel_advance(&s_wheel, at_millis(3)));
+    TEST_ASSERT_EQUAL(1, p.fired);
+    TEST_ASSERT_FALSE(mu_timer_is_pending(&p.timer));
+    TEST_ASSERT_EQUAL(0, mu_timer_wheel_pending(&s_wheel));
+}
+
+void test_mu_timer_wheel_cancel(void) {
+    probe_t p = {0};
+
+    mu_timer_init(&p.timer, on_fire, &p);
+    mu_timer_wheel_arm(&s_wheel, &p.timer, at_millis(10));
+    TEST_ASSERT_TRUE(mu_timer_wheel_cancel(&s_wheel, &p.timer));
+    TEST_ASSERT_FALSE(mu_timer_wheel_cancel(&s_wheel, &p.timer));
+    mu_timer_wheel_advance(&s_wheel, at_millis(20));
+    TEST_ASSERT_EQUAL(0, p.fired);
+}
+
+void test_mu_timer_wheel_rearm_from_callback(void) {
+    probe_t p = {0};
+
+    mu_timer_init(&p.timer, on_periodic, &p);
+    mu_timer_wheel_arm(&s_wheel, &p.timer, at_millis(10));
+    mu_timer_wheel_advance(&s_wheel, at_millis(100));
+    // fires at 10, then re-arms every 10 mSec relative to its deadline
+    TEST_ASSERT_EQUAL(10, p.fired);
+    TEST_ASSERT_TRUE(mu_timer_is_pending(&p.timer));
+}
+
+void test_mu_timer_wheel_peer_from_callback(void) {
+    mu_timer_t a, b;
+    mu_timer_wheel_stats_t stats;
+    mu_pool_stats_t pool_stats;
+
+    // Whichever fires first cancels the other, due on the same tick.
+    s_peers[0] = &a;
+    s_peers[1] = &b;
+    mu_timer_init(&a, on_cancel_peer, NULL);
+    mu_timer_init(&b, on_cancel_peer, NULL);
+    mu_timer_wheel_arm(&s_wheel, &a, at_millis(10));
+    mu_timer_wheel_arm(&s_wheel, &b, at_millis(10));
+    TEST_ASSERT_EQUAL(1, mu_timer_wheel_advance(&s_wheel, at_millis(10)));
+    TEST_ASSERT_EQUAL(1, s_fire_count);
+    TEST_ASSERT_TRUE(s_peer_cancelled);
+    TEST_ASSERT_EQUAL(0, mu_timer_wheel_pending(&s_wheel));
+    mu_timer_wheel_get_stats(&s_wheel, &stats);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.pending);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.cancelled);
+
+    // Or re-arms it for later.
+    mu_timer_init(&a, on_rearm_peer, NULL);
+    mu_timer_init(&b, on_rearm_peer, NULL);
+    mu_timer_wheel_arm(&s_wheel, &a, at_millis(20));
+    mu_timer_wheel_arm(&s_wheel, &b, at_millis(20));
+    TEST_ASSERT_EQUAL(1, mu_timer_wheel_advance(&s_wheel, at_millis(20)));
+    TEST_ASSERT_EQUAL(1, mu_timer_wheel_pending(&s_wheel));
+    TEST_ASSERT_EQUAL(0, mu_timer_wheel_advance(&s_wheel, at_millis(49)));
+    TEST_ASSERT_EQUAL(1, mu_timer_wheel_advance(&s_wheel, at_millis(50)));
+    TEST_ASSERT_EQUAL(3, s_fire_count);
+    TEST_ASSERT_EQUAL(0, mu_timer_wheel_pending(&s_wheel));
+
+    // Pooled peers go back to the pool exactly once.
+    s_peers[0] = mu_timer_wheel_schedule(&s_wheel, at_millis(60),
+                                         on_cancel_peer, NULL);
+    s_peers[1] = mu_timer_wheel_schedule(&s_wheel, at_millis(60),
+                                         on_cancel_peer, NULL);
+    TEST_ASSERT_EQUAL(1, mu_timer_wheel_advance(&s_wheel, at_millis(60)));
+    mu_pool_get_stats(&s_pool, &pool_stats);
+    TEST_ASSERT_EQUAL(0, pool_stats.in_use);
+    mu_timer_wheel_get_stats(&s_wheel, &stats);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.pending);
+    TEST_ASSERT_EQUAL_UINT64(2, stats.cancelled);
+}
+
+void test_mu_timer_wheel_pooled(void) {
+    mu_pool_stats_t stats;
+    mu_timer_t *handles[16];
+
+    for (int i = 0; i < 16; i++) {
+        handles[i] = mu_timer_wheel_schedule(&s_wheel, at_millis(5 + i), on_count,
+                                             NULL);
+        TEST_ASSERT_NOT_NULL(handles[i]);
+    }
+    TEST_ASSERT_NULL(mu_timer_wheel_schedule(&s_wheel, at_millis(5), on_count,
+                                             NULL));
+    TEST_ASSERT_TRUE(mu_timer_wheel_cancel(&s_wheel, handles[0]));
+    mu_timer_wheel_advance(&s_wheel, at_millis(100));
+    TEST_ASSERT_EQUAL(15, s_fire_count);
+
+    mu_pool_get_stats(&s_pool, &stats);
+    TEST_ASSERT_EQUAL(0, stats.in_use);
+    TEST_ASSERT_EQUAL(16, stats.high_water);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.alloc_failures);
+}
+
+void test_mu_timer_wheel_random_deadlines(void) {
+    uint32_t seed = 7;
+    mu_time_abs_t next;
+    int64_t step = 0;
+
+    // Deadlines spread over all levels, fired by irregular advances.
+    for (int i = 0; i < N_RANDOM; i++) {
+        seed = seed * 1103515245 + 12345;
+        int64_t nanos = (int64_t)(seed % 20000000) * 1000;  // up to 20000 s
+        s_probes[i].fired = 0;
+        mu_timer_init(&s_probes[i].timer, on_fire, &s_probes[i]);
+        mu_timer_wheel_arm(&s_wheel, &s_probes[i].timer,
+                           mu_time_offset(s_origin, nanos));
+    }
+    while (mu_timer_wheel_pending(&s_wheel) > 0) {
+        mu_time_abs_t earliest = s_probes[0].timer.deadline;
+        int found = 0;
+        for (int i = 0; i < N_RANDOM; i++) {
+            if (!s_probes[i].fired &&
+                (!found || mu_time_is_before(s_probes[i].timer.deadline, earliest))) {
+                earliest = s_probes[i].timer.deadline;
+                found = 1;
+            }
+        }
+        TEST_ASSERT_TRUE(mu_timer_wheel_next_deadline(&s_wheel, &next));
+        TEST_ASSERT_EQUAL_INT64(0, mu_time_difference(earliest, next));
+
+        step = (step * 7 + 123457) % 997;
+        s_now = mu_time_offset(s_now, (step + 1) * 7919 * 1000);
+        mu_timer_wheel_advance(&s_wheel, s_now);
+    }
+    for (int i = 0; i < N_RANDOM; i++) {
+        mu_time_rel_t lag = mu_time_difference(s_probes[i].timer.deadline,
+                                               s_probes[i].fired_at);
+        TEST_ASSERT_EQUAL(1, s_probes[i].fired);
+        TEST_ASSERT_TRUE(lag >= 0);
+    }
+    TEST_ASSERT_FALSE(mu_timer_wheel_next_deadline(&s_wheel, &next));
+}
+
+void test_mu_timer_wheel_stats(void) {
+    mu_timer_wheel_stats_t stats;
+    mu_timer_wheel_stats_t total = {0};
+    mu_duration_sketch_t lag;
+    uint32_t lag_bins[128];
+    uint32_t occupancy[MU_TIMER_WHEEL_SLOTS];
+    probe_t p[4] = {0};
+
+    mu_duration_sketch_init(&lag, lag_bins, 128);
+    mu_timer_wheel_set_lag_sketch(&s_wheel, &lag);
+    for (int i = 0; i < 4; i++) {
+        mu_timer_init(&p[i].timer, on_fire, &p[i]);
+    }
+    mu_timer_wheel_arm(&s_wheel, &p[0].timer, at_millis(10));     // level 0
+    mu_timer_wheel_arm(&s_wheel, &p[1].timer, at_millis(100));    // level 1
+    mu_timer_wheel_arm(&s_wheel, &p[2].timer, at_millis(5000));   // level 2
+    mu_timer_wheel_arm(&s_wheel, &p[3].timer, at_millis(5001));
+    mu_timer_wheel_arm(&s_wheel, &p[3].timer, at_millis(20));     // re-arm
+    s_now = s_origin;
+
+    mu_timer_wheel_get_stats(&s_wheel, &stats);
+    TEST_ASSERT_EQUAL_UINT64(5, stats.armed);
+    TEST_ASSERT_EQUAL_UINT64(4, stats.pending);
+    TEST_ASSERT_EQUAL_UINT64(2, stats.level_pending[0]);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.level_pending[1]);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.level_pending[2]);
+    mu_timer_wheel_slot_occupancy(&s_wheel, 0, occupancy);
+    TEST_ASSERT_EQUAL_UINT32(1, occupancy[10]);
+    TEST_ASSERT_EQUAL_UINT32(1, occupancy[20]);
+
+    mu_timer_wheel_cancel(&s_wheel, &p[2].timer);
+    // advance in one late step: everything due fires 150 mSec late or more
+    mu_timer_wheel_advance(&s_wheel, at_millis(160));
+    mu_timer_wheel_get_stats(&s_wheel, &stats);
+    TEST_ASSERT_EQUAL_UINT64(3, stats.fired);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.cancelled);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.pending);
+    TEST_ASSERT_TRUE(stats.cascades >= 1);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.cascaded);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, mu_timer_wheel_stats_cancel_ratio(&stats));
+
+    TEST_ASSERT_EQUAL_UINT64(3, mu_duration_sketch_count(&lag));
+    TEST_ASSERT_EQUAL_INT64(60000000, mu_duration_sketch_min(&lag));
+    TEST_ASSERT_EQUAL_INT64(150000000, mu_duration_sketch_max(&lag));
+
+    mu_timer_wheel_stats_add(&total, &stats);
+    mu_timer_wheel_stats_add(&total, &stats);
+    TEST_ASSERT_EQUAL_UINT64(6, total.fired);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_timer_wheel_fires_on_time);
+    RUN_TEST(test_mu_timer_wheel_cancel);
+    RUN_TEST(test_mu_timer_wheel_rearm_from_callback);
+    RUN_TEST(test_mu_timer_wheel_peer_from_callback);
+    RUN_TEST(test_mu_timer_wheel_pooled);
+    RUN_TEST(test_mu_timer_wheel_random_deadlines);
+    RUN_TEST(test_mu_timer_wheel_stats);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void on_fire(mu_timer_t *timer, void *arg) {
+    probe_t *p = (probe_t *)arg;
+    (void)timer;
+    p->fired += 1;
+    p->fired_at = s_now;
+}
+
+static void on_periodic(mu_timer_t *timer, void *arg) {
+    probe_t *p = (probe_t *)arg;
+    p->fired += 1;
+    mu_timer_wheel_arm(&s_wheel, timer,
+                       mu_time_offset(mu_timer_deadline(timer), 10000000));
+}
+
+static void on_count(mu_timer_t *timer, void *arg) {
+    (void)timer;
+    (void)arg;
+    s_fire_count += 1;
+}
+
+static void on_cancel_peer(mu_timer_t *timer, void *arg) {
+    (void)arg;
+    s_fire_count += 1;
+    s_peer_cancelled = mu_timer_wheel_cancel(
+        &s_wheel, s_peers[0] == timer ? s_peers[1] : s_peers[0]);
+}
+
+static void on_rearm_peer(mu_timer_t *timer, void *arg) {
+    mu_timer_t *peer = s_peers[0] == timer ? s_peers[1] : s_peers[0];
+    (void)arg;
+    s_fire_count += 1;
+    // Only the first to fire moves its peer, still due on the same tick.
+    if (mu_time_difference(mu_timer_deadline(timer), mu_timer_deadline(peer)) ==
+        0) {
+        mu_timer_wheel_arm(&s_wheel, peer, mu_time_offset(s_origin, 50000000));
+    }
+}
+
+static mu_time_abs_t at_millis(int64_t millis) {
+    s_now = mu_time_offset(s_origin, millis * 1000000);
+    return s_now;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,299 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_tso.h"
+#include "unity.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define N_THREADS 4
+#define N_PER_THREAD 50000
+#define SECOND 1000000000LL
+
+typedef struct {
+    mu_tso_t *tso;
+    uint64_t *out;
+    bool batched;
+    bool ok;
+} worker_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static char s_path[64];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_tso_strictly_increasing(void);
+void test_mu_tso_ranges(void);
+void test_mu_tso_batches(void);
+void test_mu_tso_concurrent_unique(void);
+void test_mu_tso_infrequent_persist(void);
+void test_mu_tso_recovery_above_mark(void);
+void test_mu_tso_torn_slot(void);
+void test_mu_tso_open_failure(void);
+void test_mu_tso_create_relative(void);
+
+static void *worker(void *arg);
+static int compare_u64(const void *a, const void *b);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    snprintf(s_path, sizeof(s_path), "/tmp/test_mu_tso_%d.hwm", (int)getpid());
+    unlink(s_path);
+}
+
+void tearDown(void) {
+    unlink(s_path);
+}
+
+void test_mu_tso_strictly_increasing(void) {
+    mu_tso_t tso;
+    uint64_t prev = 0, ts;
+
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, NULL, 0));
+    mu_time_abs_t before = mu_time_now();
+    for (int i = 0; i < 100000; i++) {
+        TEST_ASSERT_TRUE(mu_tso_next(&tso, &ts));
+        TEST_ASSERT_TRUE(ts > prev);
+        prev = ts;
+    }
+    // Timestamps track the clock
+    mu_time_abs_t issued = mu_tso_to_time(ts);
+    TEST_ASSERT_FALSE(mu_time_is_before(issued, before));
+    TEST_ASSERT_TRUE(mu_time_difference(mu_time_now(), issued) < SECOND);
+    mu_tso_close(&tso);
+}
+
+void test_mu_tso_ranges(void) {
+    mu_tso_t tso;
+    uint64_t a, b;
+
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, NULL, 0));
+    TEST_ASSERT_TRUE(mu_tso_alloc(&tso, 1000, &a));
+    TEST_ASSERT_TRUE(mu_tso_alloc(&tso, 1000, &b));
+    TEST_ASSERT_TRUE(b >= a + 1000);
+    TEST_ASSERT_TRUE(mu_tso_high_water(&tso) >= b + 1000);
+    mu_tso_close(&tso);
+}
+
+void test_mu_tso_batches(void) {
+    mu_tso_t tso;
+    mu_tso_batch_t batch;
+    uint64_t prev = 0, ts, single;
+
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, NULL, 0));
+    mu_tso_batch_init(&batch);
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_TRUE(mu_tso_batch_next(&tso, &batch, 64, &ts));
+        TEST_ASSERT_TRUE(ts > prev);
+        prev = ts;
+    }
+    // A single timestamp issued now lies above the whole reserved block
+    TEST_ASSERT_TRUE(mu_tso_next(&tso, &single));
+    TEST_ASSERT_TRUE(single >= batch.end);
+    mu_tso_close(&tso);
+}
+
+void test_mu_tso_concurrent_unique(void) {
+    mu_tso_t tso;
+    pthread_t threads[N_THREADS];
+    worker_t workers[N_THREADS];
+    uint64_t *all = malloc(N_THREADS * N_PER_THREAD * sizeof(uint64_t));
+
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, s_path, 100000000));
+    for (int i = 0; i < N_THREADS; i++) {
+        workers[i] = (worker_t){&tso, all + i * N_PER_THREAD, i % 2 == 1,
+                                false};
+        pthread_create(&threads[i], NULL, worker, &workers[i]);
+    }
+    for (int i = 0; i < N_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        TEST_ASSERT_TRUE(workers[i].ok);
+    }
+    qsort(all, N_THREADS * N_PER_THREAD, sizeof(uint64_t), compare_u64);
+    for (int i = 1; i < N_THREADS * N_PER_THREAD; i++) {
+        TEST_ASSERT_TRUE(all[i] > all[i - 1]);
+    }
+    TEST_ASSERT_TRUE(all[N_THREADS * N_PER_THREAD - 1] <
+                     mu_tso_high_water(&tso));
+    mu_tso_close(&tso);
+    free(all);
+}
+
+void test_mu_tso_infrequent_persist(void) {
+    mu_tso_t tso;
+    uint64_t ts;
+
+    // With a 10 s window, a burst of allocations syncs once
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, s_path, 10 * SECOND));
+    for (int i = 0; i < 200000; i++) {
+        TEST_ASSERT_TRUE(mu_tso_next(&tso, &ts));
+    }
+    TEST_ASSERT_EQUAL_UINT64(1, mu_tso_persists(&tso));
+    TEST_ASSERT_TRUE(mu_tso_high_water(&tso) > ts);
+    mu_tso_close(&tso);
+}
+
+void test_mu_tso_recovery_above_mark(void) {
+    mu_tso_t tso;
+    uint64_t ts, last;
+
+    // An hour-long window stands in for a clock that later steps back: the
+    // mark is far ahead of the clock when the process dies.
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, s_path, 3600 * SECOND));
+    TEST_ASSERT_TRUE(mu_tso_next(&tso, &last));
+    uint64_t mark = mu_tso_high_water(&tso);
+    mu_tso_close(&tso);
+
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, s_path, SECOND));
+    TEST_ASSERT_TRUE(mu_tso_next(&tso, &ts));
+    TEST_ASSERT_TRUE(ts > last);
+    TEST_ASSERT_TRUE(ts >= mark);
+    mu_tso_close(&tso);
+
+    // And again: each restart resumes above the previous run
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, s_path, SECOND));
+    uint64_t again;
+    TEST_ASSERT_TRUE(mu_tso_next(&tso, &again));
+    TEST_ASSERT_TRUE(again > ts);
+    mu_tso_close(&tso);
+}
+
+void test_mu_tso_torn_slot(void) {
+    mu_tso_t tso;
+    uint64_t ts;
+
+    // Two raises fill both slots
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, s_path, 1000));
+    TEST_ASSERT_TRUE(mu_tso_next(&tso, &ts));
+    uint64_t first_mark = mu_tso_high_water(&tso);
+    usleep(1000);
+    TEST_ASSERT_TRUE(mu_tso_next(&tso, &ts));
+    TEST_ASSERT_TRUE(mu_tso_persists(&tso) >= 2);
+    uint64_t last_mark = mu_tso_high_water(&tso);
+    uint64_t seq = tso.seq;
+    mu_tso_close(&tso);
+
+    // Tear the newest slot: recovery falls back to the older mark
+    int fd = open(s_path, O_RDWR);
+    TEST_ASSERT_TRUE(pwrite(fd, "garbage", 7, (off_t)(seq & 1) * 32 + 16) == 7);
+    close(fd);
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, s_path, 1000));
+    TEST_ASSERT_TRUE(mu_tso_high_water(&tso) >= first_mark);
+    TEST_ASSERT_TRUE(mu_tso_high_water(&tso) < last_mark);
+    mu_tso_close(&tso);
+}
+
+void test_mu_tso_open_failure(void) {
+    mu_tso_t tso;
+    TEST_ASSERT_FALSE(mu_tso_open(&tso, "/nonexistent/dir/tso.hwm", 0));
+
+    // A file without a single valid slot is not silently a mark of 0.
+    int fd = open(s_path, O_RDWR | O_CREAT, 0644);
+    TEST_ASSERT_TRUE(pwrite(fd, "not a mark file", 15, 0) == 15);
+    close(fd);
+    TEST_ASSERT_FALSE(mu_tso_open(&tso, s_path, 0));
+    TEST_ASSERT_EQUAL_INT(EINVAL, errno);
+
+    // An empty one is a fresh oracle.
+    TEST_ASSERT_EQUAL_INT(0, truncate(s_path, 0));
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, s_path, 0));
+    mu_tso_close(&tso);
+}
+
+void test_mu_tso_create_relative(void) {
+    mu_tso_t tso;
+    uint64_t ts;
+    char name[64];
+
+    // The new file's directory is "." and must still be synced.
+    snprintf(name, sizeof(name), "test_mu_tso_%d.hwm", (int)getpid());
+    unlink(name);
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, name, 0));
+    TEST_ASSERT_TRUE(mu_tso_next(&tso, &ts));
+    mu_tso_close(&tso);
+    TEST_ASSERT_TRUE(mu_tso_open(&tso, name, 0));
+    TEST_ASSERT_TRUE(mu_tso_high_water(&tso) > ts);
+    mu_tso_close(&tso);
+    unlink(name);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_tso_strictly_increasing);
+    RUN_TEST(test_mu_tso_ranges);
+    RUN_TEST(test_mu_tso_batches);
+    RUN_TEST(test_mu_tso_concurrent_unique);
+    RUN_TEST(test_mu_tso_infrequent_persist);
+    RUN_TEST(test_mu_tso_recovery_above_mark);
+    RUN_TEST(test_mu_tso_torn_slot);
+    RUN_TEST(test_mu_tso_open_failure);
+    RUN_TEST(test_mu_tso_create_relative);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void *worker(void *arg) {
+    worker_t *w = arg;
+    mu_tso_batch_t batch;
+    uint64_t prev = 0;
+
+    mu_tso_batch_init(&batch);
+    w->ok = true;
+    for (int i = 0; i < N_PER_THREAD; i++) {
+        bool ok = w->batched ? mu_tso_batch_next(w->tso, &batch, 32, &w->out[i])
+                             : mu_tso_next(w->tso, &w->out[i]);
+        // Each thread sees its own timestamps increase
+        if (!ok || w->out[i] <= prev) {
+            w->ok = false;
+        }
+        prev = w->out[i];
+    }
+    return NULL;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// *****************************************************************************
+// End of file
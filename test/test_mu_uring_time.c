@@ -0,0 +1,382 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_uring_time.h"
+#include "unity.h"
+#include <errno.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define RING_ENTRIES 64
+#define N_TIMERS 100
+#define TAG_TIMERS 1000
+
+/**
+ * @brief Just enough of an io_uring to drive the tests, without liburing.
+ */
+typedef struct {
+    int fd;
+    void *sq_ring;
+    void *cq_ring;
+    size_t sq_ring_size;
+    size_t cq_ring_size;
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_cqe *cqes;
+    unsigned to_submit;
+} ring_t;
+
+typedef struct {
+    mu_time_abs_t fired_at;
+    bool fired;
+} record_t;
+
+// *****************************************************************************
+// Private (static) storage
+
+static ring_t s_ring;
+static record_t s_records[N_TIMERS];
+static mu_timer_t s_timers[N_TIMERS];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_uring_timespec(void);
+void test_mu_uring_prep_timeout_absolute(void);
+void test_mu_uring_link_timeout(void);
+void test_mu_uring_timeout_update(void);
+void test_mu_uring_timers_multiplex(void);
+
+static bool ring_open(ring_t *ring);
+static void ring_close(ring_t *ring);
+static struct io_uring_sqe *ring_get_sqe(ring_t *ring);
+static int ring_submit_and_wait(ring_t *ring, unsigned wait_nr);
+static bool ring_pop(ring_t *ring, struct io_uring_cqe *cqe);
+static void record_fn(mu_timer_t *timer, void *arg);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    if (!ring_open(&s_ring)) {
+        TEST_IGNORE_MESSAGE("io_uring unavailable");
+    }
+}
+
+void tearDown(void) {
+    ring_close(&s_ring);
+}
+
+void test_mu_uring_timespec(void) {
+    struct __kernel_timespec ts;
+
+    mu_uring_timespec(&ts, (mu_time_abs_t){1700000000, 250000000});
+    TEST_ASSERT_EQUAL_INT64(1700000000, ts.tv_sec);
+    TEST_ASSERT_EQUAL_INT64(250000000, ts.tv_nsec);
+
+    struct io_uring_sqe sqe;
+    mu_uring_prep_timeout(&sqe, &ts, (mu_time_abs_t){5, 1}, 3, 42);
+    TEST_ASSERT_EQUAL_UINT8(IORING_OP_TIMEOUT, sqe.opcode);
+    TEST_ASSERT_EQUAL_UINT64((uintptr_t)&ts, sqe.addr);
+    TEST_ASSERT_EQUAL_UINT32(1, sqe.len);
+    TEST_ASSERT_EQUAL_UINT64(3, sqe.off);
+    TEST_ASSERT_EQUAL_UINT32(IORING_TIMEOUT_ABS | IORING_TIMEOUT_REALTIME,
+                             sqe.timeout_flags);
+    TEST_ASSERT_EQUAL_UINT64(42, sqe.user_data);
+}
+
+void test_mu_uring_prep_timeout_absolute(void) {
+    struct __kernel_timespec ts;
+    struct io_uring_cqe cqe;
+    mu_time_abs_t deadline = mu_time_offset(mu_time_now(), 20000000);
+
+    mu_uring_prep_timeout(ring_get_sqe(&s_ring), &ts, deadline, 0, 7);
+    TEST_ASSERT_EQUAL_INT(1, ring_submit_and_wait(&s_ring, 1));
+    mu_time_abs_t done = mu_time_now();
+
+    TEST_ASSERT_TRUE(ring_pop(&s_ring, &cqe));
+    TEST_ASSERT_EQUAL_UINT64(7, cqe.user_data);
+    TEST_ASSERT_EQUAL_INT(-ETIME, cqe.res);
+    TEST_ASSERT_FALSE(mu_time_is_before(done, deadline));
+
+    // A deadline already in the past completes at once
+    mu_uring_prep_timeout(ring_get_sqe(&s_ring), &ts,
+                          mu_time_offset(done, -1000000000), 0, 8);
+    TEST_ASSERT_EQUAL_INT(1, ring_submit_and_wait(&s_ring, 1));
+    TEST_ASSERT_TRUE(ring_pop(&s_ring, &cqe));
+    TEST_ASSERT_EQUAL_INT(-ETIME, cqe.res);
+    TEST_ASSERT_TRUE(mu_time_difference(done, mu_time_now()) < 1000000000);
+}
+
+void test_mu_uring_link_timeout(void) {
+    struct __kernel_timespec ts;
+    struct io_uring_cqe cqe;
+    char buf[8];
+    int fds[2];
+    int read_res = 1, timeout_res = 1;
+
+    TEST_ASSERT_EQUAL_INT(0, pipe(fds));
+    mu_time_abs_t deadline = mu_time_offset(mu_time_now(), 20000000);
+
+    // A read from an empty pipe blocks until the linked timeout cancels it
+    struct io_uring_sqe *sqe = ring_get_sqe(&s_ring);
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fds[0];
+    sqe->addr = (uint64_t)(uintptr_t)buf;
+    sqe->len = sizeof(buf);
+    sqe->flags = IOSQE_IO_LINK;
+    sqe->user_data = 1;
+    mu_uring_prep_link_timeout(ring_get_sqe(&s_ring), &ts, deadline, 2);
+
+    TEST_ASSERT_EQUAL_INT(2, ring_submit_and_wait(&s_ring, 2));
+    mu_time_abs_t done = mu_time_now();
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE(ring_pop(&s_ring, &cqe));
+        if (cqe.user_data == 1) {
+            read_res = cqe.res;
+        } else {
+            timeout_res = cqe.res;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(-ECANCELED, read_res);
+    TEST_ASSERT_EQUAL_INT(-ETIME, timeout_res);
+    TEST_ASSERT_FALSE(mu_time_is_before(done, deadline));
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void test_mu_uring_timeout_update(void) {
+    struct __kernel_timespec ts, ts_update;
+    struct io_uring_cqe cqe;
+    mu_time_abs_t start = mu_time_now();
+
+    // Pull a 10 s timeout in to 20 ms
+    mu_uring_prep_timeout(ring_get_sqe(&s_ring), &ts,
+                          mu_time_offset(start, 10000000000), 0, 1);
+    mu_time_abs_t deadline = mu_time_offset(start, 20000000);
+    mu_uring_prep_timeout_update(ring_get_sqe(&s_ring), &ts_update, 1,
+                                 deadline, 2);
+    TEST_ASSERT_EQUAL_INT(2, ring_submit_and_wait(&s_ring, 2));
+    while (ring_pop(&s_ring, &cqe)) {
+        if (cqe.user_data == 2) {
+            TEST_ASSERT_EQUAL_INT(0, cqe.res);
+        } else {
+            TEST_ASSERT_EQUAL_INT(-ETIME, cqe.res);
+        }
+    }
+    if (cqe.user_data == 2) {
+        ring_submit_and_wait(&s_ring, 1);
+        TEST_ASSERT_TRUE(ring_pop(&s_ring, &cqe));
+        TEST_ASSERT_EQUAL_INT(-ETIME, cqe.res);
+    }
+    mu_time_abs_t done = mu_time_now();
+    TEST_ASSERT_FALSE(mu_time_is_before(done, deadline));
+    TEST_ASSERT_TRUE(mu_time_difference(start, done) < 5000000000);
+
+    // Removing a pending timeout completes it with -ECANCELED
+    mu_uring_prep_timeout(ring_get_sqe(&s_ring), &ts,
+                          mu_time_offset(done, 10000000000), 0, 3);
+    mu_uring_prep_timeout_remove(ring_get_sqe(&s_ring), 3, 4);
+    TEST_ASSERT_EQUAL_INT(2, ring_submit_and_wait(&s_ring, 2));
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE(ring_pop(&s_ring, &cqe));
+        TEST_ASSERT_EQUAL_INT(cqe.user_data == 3 ? -ECANCELED : 0, cqe.res);
+    }
+}
+
+void test_mu_uring_timers_multiplex(void) {
+    mu_uring_timers_t t;
+    struct io_uring_cqe cqe;
+    mu_time_rel_t resolution = 1000000; // 1 mSec
+    mu_time_abs_t start = mu_time_now();
+
+    mu_uring_timers_init(&t, start, resolution, 2 * resolution, NULL,
+                         TAG_TIMERS);
+    mu_timer_wheel_t *wheel = mu_uring_timers_wheel(&t);
+    TEST_ASSERT_FALSE(mu_uring_timers_needs_sqe(&t));
+
+    // 100 deadlines spread over 20..119 mSec, armed latest first so that
+    // each new one is the earliest
+    memset(s_records, 0, sizeof(s_records));
+    for (int i = N_TIMERS - 1; i >= 0; i--) {
+        mu_timer_init(&s_timers[i], record_fn, &s_records[i]);
+        mu_timer_wheel_arm(wheel, &s_timers[i],
+                           mu_time_offset(start, (20 + i) * resolution));
+        if (mu_uring_timers_needs_sqe(&t)) {
+            mu_uring_timers_prep(&t, ring_get_sqe(&s_ring));
+        }
+    }
+    // Slack folds successive earlier deadlines into one update in three
+    TEST_ASSERT_EQUAL_UINT64(1, t.kernel_arms);
+    TEST_ASSERT_TRUE(t.kernel_updates <= N_TIMERS / 3 + 1);
+
+    int fired = 0;
+    while (fired < N_TIMERS) {
+        TEST_ASSERT_TRUE(ring_submit_and_wait(&s_ring, 1) >= 0);
+        while (ring_pop(&s_ring, &cqe)) {
+            int n = mu_uring_timers_complete(&t, cqe.user_data, cqe.res,
+                                             mu_time_now());
+            TEST_ASSERT_TRUE(n >= 0);
+            fired += n;
+        }
+        if (mu_uring_timers_needs_sqe(&t)) {
+            mu_uring_timers_prep(&t, ring_get_sqe(&s_ring));
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(N_TIMERS, fired);
+    for (int i = 0; i < N_TIMERS; i++) {
+        TEST_ASSERT_TRUE(s_records[i].fired);
+        TEST_ASSERT_FALSE(mu_time_is_before(s_records[i].fired_at,
+                                            mu_timer_deadline(&s_timers[i])));
+    }
+    // Far fewer kernel timeouts than timers
+    TEST_ASSERT_TRUE(t.kernel_arms < N_TIMERS / 2);
+    TEST_ASSERT_FALSE(mu_uring_timers_needs_sqe(&t));
+    TEST_ASSERT_EQUAL_INT(-1, mu_uring_timers_complete(&t, 5, 0, start));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_uring_timespec);
+    RUN_TEST(test_mu_uring_prep_timeout_absolute);
+    RUN_TEST(test_mu_uring_link_timeout);
+    RUN_TEST(test_mu_uring_timeout_update);
+    RUN_TEST(test_mu_uring_timers_multiplex);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static bool ring_open(ring_t *ring) {
+    struct io_uring_params p;
+
+    memset(ring, 0, sizeof(*ring));
+    memset(&p, 0, sizeof(p));
+    ring->fd = (int)syscall(__NR_io_uring_setup, RING_ENTRIES, &p);
+    if (ring->fd < 0) {
+        return false;
+    }
+    ring->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size =
+        p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring->fd,
+                         IORING_OFF_SQ_RING);
+    ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring->fd,
+                         IORING_OFF_CQ_RING);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sq_ring == MAP_FAILED || ring->cq_ring == MAP_FAILED ||
+        ring->sqes == MAP_FAILED) {
+        close(ring->fd);
+        ring->fd = -1;
+        return false;
+    }
+    char *sq = ring->sq_ring, *cq = ring->cq_ring;
+    ring->sq_head = (unsigned *)(sq + p.sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    ring->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)(sq + p.sq_off.array);
+    ring->cq_head = (unsigned *)(cq + p.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    ring->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    return true;
+}
+
+static void ring_close(ring_t *ring) {
+    if (ring->fd < 0) {
+        return;
+    }
+    munmap(ring->sqes, ring->sqes_size);
+    munmap(ring->cq_ring, ring->cq_ring_size);
+    munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+    ring->fd = -1;
+}
+
+static struct io_uring_sqe *ring_get_sqe(ring_t *ring) {
+    unsigned tail = *ring->sq_tail + ring->to_submit;
+    unsigned index = tail & *ring->sq_mask;
+
+    ring->sq_array[index] = index;
+    ring->to_submit += 1;
+    return &ring->sqes[index];
+}
+
+static int ring_submit_and_wait(ring_t *ring, unsigned wait_nr) {
+    unsigned submit = ring->to_submit;
+
+    atomic_store_explicit((_Atomic unsigned *)ring->sq_tail,
+                          *ring->sq_tail + submit, memory_order_release);
+    ring->to_submit = 0;
+    int res;
+    do {
+        res = (int)syscall(__NR_io_uring_enter, ring->fd, submit, wait_nr,
+                           IORING_ENTER_GETEVENTS, NULL, 0);
+    } while (res < 0 && errno == EINTR);
+    return res;
+}
+
+static bool ring_pop(ring_t *ring, struct io_uring_cqe *cqe) {
+    unsigned head = *ring->cq_head;
+    unsigned tail =
+        atomic_load_explicit((_Atomic unsigned *)ring->cq_tail,
+                             memory_order_acquire);
+
+    if (head == tail) {
+        return false;
+    }
+    *cqe = ring->cqes[head & *ring->cq_mask];
+    atomic_store_explicit((_Atomic unsigned *)ring->cq_head, head + 1,
+                          memory_order_release);
+    return true;
+}
+
+static void record_fn(mu_timer_t *timer, void *arg) {
+    record_t *record = arg;
+
+    (void)timer;
+    record->fired_at = mu_time_now();
+    record->fired = true;
+}
+
+// *****************************************************************************
+// End of file
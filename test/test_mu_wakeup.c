@@ -0,0 +1,253 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_calendar_queue.h"
+#include "mu_time.h"
+#include "mu_timer_wheel.h"
+#include "mu_wakeup.h"
+#include "unity.h"
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define MSEC 1000000LL
+
+// *****************************************************************************
+// Private (static) storage
+
+static const mu_time_abs_t s_t0 = {1000, 0};
+static mu_wakeup_registry_t s_reg;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_wakeup_empty(void);
+void test_mu_wakeup_min_tracks_reports(void);
+void test_mu_wakeup_clear(void);
+void test_mu_wakeup_capacity(void);
+void test_mu_wakeup_random_against_scan(void);
+void test_mu_wakeup_wheel_and_calendar(void);
+void test_mu_wakeup_default_registry(void);
+
+static mu_time_abs_t at(int64_t millis);
+static void noop_fn(mu_timer_t *timer, void *arg);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    mu_wakeup_init(&s_reg);
+}
+
+void tearDown(void) {}
+
+void test_mu_wakeup_empty(void) {
+    mu_time_abs_t deadline;
+
+    TEST_ASSERT_FALSE(mu_wakeup_next(&s_reg, &deadline));
+    TEST_ASSERT_NULL(mu_wakeup_next_source(&s_reg));
+    TEST_ASSERT_EQUAL_INT64(mu_time_rel_max(), mu_wakeup_idle_for(&s_reg, s_t0));
+}
+
+void test_mu_wakeup_min_tracks_reports(void) {
+    mu_wakeup_source_t radio, sensor, ui;
+    mu_time_abs_t deadline;
+
+    mu_wakeup_source_init(&radio, "radio");
+    mu_wakeup_source_init(&sensor, "sensor");
+    mu_wakeup_source_init(&ui, "ui");
+    TEST_ASSERT_FALSE(mu_wakeup_source_is_set(&radio));
+
+    TEST_ASSERT_TRUE(mu_wakeup_report(&s_reg, &radio, at(500)));
+    TEST_ASSERT_TRUE(mu_wakeup_report(&s_reg, &sensor, at(200)));
+    TEST_ASSERT_TRUE(mu_wakeup_report(&s_reg, &ui, at(900)));
+    TEST_ASSERT_TRUE(mu_wakeup_next(&s_reg, &deadline));
+    TEST_ASSERT_EQUAL_INT64(200 * MSEC, mu_time_difference(s_t0, deadline));
+    TEST_ASSERT_EQUAL_PTR(&sensor, mu_wakeup_next_source(&s_reg));
+    TEST_ASSERT_EQUAL_INT64(150 * MSEC, mu_wakeup_idle_for(&s_reg, at(50)));
+    TEST_ASSERT_EQUAL_INT64(0, mu_wakeup_idle_for(&s_reg, at(300)));
+
+    // The sensor's deadline moves out; the radio is now first
+    mu_wakeup_report(&s_reg, &sensor, at(700));
+    TEST_ASSERT_EQUAL_PTR(&radio, mu_wakeup_next_source(&s_reg));
+    // The ui's deadline moves in past everyone
+    mu_wakeup_report(&s_reg, &ui, at(100));
+    TEST_ASSERT_EQUAL_PTR(&ui, mu_wakeup_next_source(&s_reg));
+    TEST_ASSERT_TRUE(mu_wakeup_next(&s_reg, &deadline));
+    TEST_ASSERT_EQUAL_INT64(100 * MSEC, mu_time_difference(s_t0, deadline));
+}
+
+void test_mu_wakeup_clear(void) {
+    mu_wakeup_source_t a, b, c;
+
+    mu_wakeup_source_init(&a, NULL);
+    mu_wakeup_source_init(&b, NULL);
+    mu_wakeup_source_init(&c, NULL);
+    mu_wakeup_report(&s_reg, &a, at(10));
+    mu_wakeup_report(&s_reg, &b, at(20));
+    mu_wakeup_report(&s_reg, &c, at(30));
+
+    mu_wakeup_clear(&s_reg, &a);
+    TEST_ASSERT_FALSE(mu_wakeup_source_is_set(&a));
+    TEST_ASSERT_EQUAL_PTR(&b, mu_wakeup_next_source(&s_reg));
+    mu_wakeup_clear(&s_reg, &a); // already clear: no effect
+    mu_wakeup_clear(&s_reg, &c);
+    TEST_ASSERT_EQUAL_PTR(&b, mu_wakeup_next_source(&s_reg));
+    mu_wakeup_clear(&s_reg, &b);
+    TEST_ASSERT_NULL(mu_wakeup_next_source(&s_reg));
+}
+
+void test_mu_wakeup_capacity(void) {
+    static mu_wakeup_source_t srcs[MU_WAKEUP_CAPACITY + 1];
+
+    for (int i = 0; i <= MU_WAKEUP_CAPACITY; i++) {
+        mu_wakeup_source_init(&srcs[i], NULL);
+    }
+    for (int i = 0; i < MU_WAKEUP_CAPACITY; i++) {
+        TEST_ASSERT_TRUE(mu_wakeup_report(&s_reg, &srcs[i], at(i)));
+    }
+    TEST_ASSERT_FALSE(
+        mu_wakeup_report(&s_reg, &srcs[MU_WAKEUP_CAPACITY], at(-1)));
+    // Re-reporting a source already counted still succeeds
+    TEST_ASSERT_TRUE(mu_wakeup_report(&s_reg, &srcs[3], at(-2)));
+    TEST_ASSERT_EQUAL_PTR(&srcs[3], mu_wakeup_next_source(&s_reg));
+}
+
+void test_mu_wakeup_random_against_scan(void) {
+    mu_wakeup_source_t srcs[MU_WAKEUP_CAPACITY];
+    bool set[MU_WAKEUP_CAPACITY] = {false};
+    int64_t when[MU_WAKEUP_CAPACITY];
+
+    srand(89);
+    for (int i = 0; i < MU_WAKEUP_CAPACITY; i++) {
+        mu_wakeup_source_init(&srcs[i], NULL);
+    }
+    for (int step = 0; step < 20000; step++) {
+        int i = rand() % MU_WAKEUP_CAPACITY;
+        if (rand() % 4 == 0) {
+            mu_wakeup_clear(&s_reg, &srcs[i]);
+            set[i] = false;
+        } else {
+            when[i] = rand() % 100000;
+            mu_wakeup_report(&s_reg, &srcs[i], at(when[i]));
+            set[i] = true;
+        }
+        int64_t best = INT64_MAX;
+        for (int j = 0; j < MU_WAKEUP_CAPACITY; j++) {
+            if (set[j] && when[j] < best) {
+                best = when[j];
+            }
+        }
+        mu_time_abs_t deadline;
+        if (best == INT64_MAX) {
+            TEST_ASSERT_FALSE(mu_wakeup_next(&s_reg, &deadline));
+        } else {
+            TEST_ASSERT_TRUE(mu_wakeup_next(&s_reg, &deadline));
+            TEST_ASSERT_EQUAL_INT64(best * MSEC,
+                                    mu_time_difference(s_t0, deadline));
+        }
+    }
+}
+
+void test_mu_wakeup_wheel_and_calendar(void) {
+    mu_timer_wheel_t wheel;
+    mu_timer_t timer;
+    mu_calendar_queue_t q;
+    mu_calendar_event_t *buckets[8];
+    mu_calendar_event_t ev;
+    mu_wakeup_source_t wheel_src, queue_src;
+    mu_time_abs_t deadline;
+
+    mu_wakeup_source_init(&wheel_src, "wheel");
+    mu_wakeup_source_init(&queue_src, "queue");
+    mu_timer_wheel_init(&wheel, s_t0, MSEC, NULL);
+    mu_calendar_queue_init(&q, buckets, 8, s_t0, 0);
+
+    // Nothing pending anywhere: both sources stay clear
+    mu_wakeup_report_wheel(&s_reg, &wheel_src, &wheel);
+    mu_wakeup_report_calendar(&s_reg, &queue_src, &q);
+    TEST_ASSERT_FALSE(mu_wakeup_next(&s_reg, &deadline));
+
+    mu_timer_init(&timer, noop_fn, NULL);
+    mu_timer_wheel_arm(&wheel, &timer, at(40));
+    mu_calendar_queue_enqueue(&q, &ev, at(25));
+    mu_wakeup_report_wheel(&s_reg, &wheel_src, &wheel);
+    mu_wakeup_report_calendar(&s_reg, &queue_src, &q);
+    TEST_ASSERT_TRUE(mu_wakeup_next(&s_reg, &deadline));
+    TEST_ASSERT_EQUAL_INT64(25 * MSEC, mu_time_difference(s_t0, deadline));
+
+    mu_calendar_queue_dequeue(&q);
+    mu_wakeup_report_calendar(&s_reg, &queue_src, &q);
+    TEST_ASSERT_EQUAL_PTR(&wheel_src, mu_wakeup_next_source(&s_reg));
+
+    mu_timer_wheel_advance(&wheel, at(40));
+    mu_wakeup_report_wheel(&s_reg, &wheel_src, &wheel);
+    TEST_ASSERT_FALSE(mu_wakeup_next(&s_reg, &deadline));
+}
+
+void test_mu_wakeup_default_registry(void) {
+    mu_wakeup_registry_t *reg = mu_wakeup_default();
+    mu_wakeup_source_t src;
+    mu_time_abs_t deadline;
+
+    mu_wakeup_init(reg);
+    TEST_ASSERT_FALSE(mu_time_next_wakeup(&deadline));
+    mu_wakeup_source_init(&src, "periodic");
+    mu_wakeup_report(reg, &src, at(5));
+    TEST_ASSERT_TRUE(mu_time_next_wakeup(&deadline));
+    TEST_ASSERT_EQUAL_INT64(5 * MSEC, mu_time_difference(s_t0, deadline));
+    mu_wakeup_clear(reg, &src);
+    TEST_ASSERT_FALSE(mu_time_next_wakeup(&deadline));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_wakeup_empty);
+    RUN_TEST(test_mu_wakeup_min_tracks_reports);
+    RUN_TEST(test_mu_wakeup_clear);
+    RUN_TEST(test_mu_wakeup_capacity);
+    RUN_TEST(test_mu_wakeup_random_against_scan);
+    RUN_TEST(test_mu_wakeup_wheel_and_calendar);
+    RUN_TEST(test_mu_wakeup_default_registry);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static mu_time_abs_t at(int64_t millis) {
+    return mu_time_offset(s_t0, millis * MSEC);
+}
+
+static void noop_fn(mu_timer_t *timer, void *arg) {
+    (void)timer;
+    (void)arg;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,178 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_wallclock.h"
+#include "unity.h"
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define MSEC 1000000LL
+#define N_READERS 3
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_wallclock_t s_wc;
+static atomic_bool s_stop;
+static atomic_int s_bad;
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_wallclock_agrees_with_system(void);
+void test_mu_wallclock_poll_period(void);
+void test_mu_wallclock_step_detection(void);
+void test_mu_wallclock_step_fd(void);
+void test_mu_wallclock_concurrent_readers(void);
+
+static void *reader(void *arg);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    mu_wallclock_init(&s_wc, 0, 0);
+}
+
+void tearDown(void) {}
+
+void test_mu_wallclock_agrees_with_system(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, mu_wallclock_steps(&s_wc));
+
+    for (int i = 0; i < 100; i++) {
+        mu_time_abs_t before = mu_time_now();
+        mu_time_abs_t derived = mu_wallclock_now(&s_wc);
+        mu_time_abs_t after = mu_time_now();
+        // Within the read bracket, give or take refresh error
+        TEST_ASSERT_TRUE(mu_time_difference(before, derived) > -MSEC);
+        TEST_ASSERT_TRUE(mu_time_difference(derived, after) > -MSEC);
+    }
+}
+
+void test_mu_wallclock_poll_period(void) {
+    mu_wallclock_init(&s_wc, 50 * MSEC, 0);
+    mu_time_abs_t mono = mu_wallclock_mono_now();
+    uint32_t refreshes = s_wc.refreshes;
+
+    TEST_ASSERT_FALSE(mu_wallclock_poll(&s_wc, mono));
+    TEST_ASSERT_EQUAL_UINT32(refreshes, s_wc.refreshes);
+    // A poll after the period refreshes, finding no step
+    mu_wallclock_poll(&s_wc, mu_time_offset(mono, 60 * MSEC));
+    TEST_ASSERT_EQUAL_UINT32(refreshes + 1, s_wc.refreshes);
+    TEST_ASSERT_EQUAL_UINT32(0, mu_wallclock_steps(&s_wc));
+}
+
+void test_mu_wallclock_step_detection(void) {
+    mu_time_abs_t mono = {5000, 0};
+    mu_time_abs_t wall = {1700000000, 0};
+
+    // Small disagreements are jitter, large ones are steps
+    mu_wallclock_set(&s_wc, mono, wall);
+    uint32_t steps = mu_wallclock_steps(&s_wc);
+    TEST_ASSERT_FALSE(
+        mu_wallclock_set(&s_wc, mono, mu_time_offset(wall, 200000)));
+    TEST_ASSERT_EQUAL_UINT32(steps, mu_wallclock_steps(&s_wc));
+    TEST_ASSERT_TRUE(
+        mu_wallclock_set(&s_wc, mono, mu_time_offset(wall, -2000 * MSEC)));
+    TEST_ASSERT_EQUAL_UINT32(steps + 1, mu_wallclock_steps(&s_wc));
+
+    // The mapping follows the stepped clock with a single addition
+    mu_time_abs_t derived =
+        mu_wallclock_to_wall(&s_wc, mu_time_offset(mono, 1500 * MSEC));
+    TEST_ASSERT_EQUAL_INT64(-500 * MSEC, mu_time_difference(wall, derived));
+    TEST_ASSERT_EQUAL_INT64(mu_time_difference(mono, wall) - 2000 * MSEC,
+                            mu_wallclock_offset(&s_wc));
+
+    // Refreshing from the real clocks steps back
+    TEST_ASSERT_TRUE(mu_wallclock_refresh(&s_wc));
+}
+
+void test_mu_wallclock_step_fd(void) {
+    int fd = mu_wallclock_step_fd();
+    TEST_ASSERT_TRUE(fd >= 0);
+
+    // Without a clock set the descriptor stays quiet
+    struct pollfd pfd = {fd, POLLIN, 0};
+    TEST_ASSERT_EQUAL_INT(0, poll(&pfd, 1, 10));
+    // Handling it anyway just refreshes and re-arms
+    TEST_ASSERT_FALSE(mu_wallclock_handle_step_fd(&s_wc, fd));
+    TEST_ASSERT_EQUAL_INT(0, poll(&pfd, 1, 0));
+    close(fd);
+}
+
+void test_mu_wallclock_concurrent_readers(void) {
+    pthread_t threads[N_READERS];
+
+    atomic_init(&s_stop, false);
+    atomic_init(&s_bad, 0);
+    for (int i = 0; i < N_READERS; i++) {
+        TEST_ASSERT_EQUAL_INT(0,
+                              pthread_create(&threads[i], NULL, reader, NULL));
+    }
+    for (int i = 0; i < 2000; i++) {
+        mu_wallclock_refresh(&s_wc);
+    }
+    atomic_store(&s_stop, true);
+    for (int i = 0; i < N_READERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&s_bad));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_wallclock_agrees_with_system);
+    RUN_TEST(test_mu_wallclock_poll_period);
+    RUN_TEST(test_mu_wallclock_step_detection);
+    RUN_TEST(test_mu_wallclock_step_fd);
+    RUN_TEST(test_mu_wallclock_concurrent_readers);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static void *reader(void *arg) {
+    (void)arg;
+    while (!atomic_load(&s_stop)) {
+        mu_time_abs_t derived = mu_wallclock_now(&s_wc);
+        mu_time_rel_t error = mu_time_difference(mu_time_now(), derived);
+        if (error > 50 * MSEC || error < -50 * MSEC) {
+            atomic_fetch_add(&s_bad, 1);
+        }
+    }
+    return NULL;
+}
+
+// *****************************************************************************
+// End of file
@@ -0,0 +1,249 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 R. D. Poor & Assoc <rdpoor @ gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// *****************************************************************************
+// Includes
+
+#include "mu_time.h"
+#include "mu_wfq.h"
+#include "unity.h"
+#include <stdlib.h>
+
+// *****************************************************************************
+// Private types and definitions
+
+#define MSEC 1000000LL
+#define N_JOBS 64
+#define N_MANY 100
+
+// *****************************************************************************
+// Private (static) storage
+
+static mu_wfq_t s_wfq;
+static mu_wfq_slot_t s_heap[N_MANY];
+static mu_wfq_job_t s_jobs[N_MANY][N_JOBS];
+
+// *****************************************************************************
+// Private (forward) declarations
+
+void test_mu_wfq_empty(void);
+void test_mu_wfq_fifo_within_tenant(void);
+void test_mu_wfq_weighted_shares(void);
+void test_mu_wfq_measured_durations(void);
+void test_mu_wfq_no_idle_credit(void);
+void test_mu_wfq_concurrent_dispatch(void);
+void test_mu_wfq_heap_capacity(void);
+void test_mu_wfq_many_tenants(void);
+
+static int tenant_of(mu_wfq_tenant_t *tenants, mu_wfq_job_t *job);
+
+// *****************************************************************************
+// Public code
+
+void setUp(void) {
+    mu_wfq_init(&s_wfq, s_heap, N_MANY);
+}
+
+void tearDown(void) {}
+
+void test_mu_wfq_empty(void) {
+    TEST_ASSERT_NULL(mu_wfq_next(&s_wfq));
+    TEST_ASSERT_EQUAL_size_t(0, mu_wfq_backlogged(&s_wfq));
+}
+
+void test_mu_wfq_fifo_within_tenant(void) {
+    mu_wfq_tenant_t t;
+
+    mu_wfq_tenant_init(&t, MU_WFQ_WEIGHT_ONE, MSEC);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(mu_wfq_enqueue(&s_wfq, &t, &s_jobs[0][i]));
+    }
+    for (int i = 0; i < 4; i++) {
+        mu_wfq_job_t *job = mu_wfq_next(&s_wfq);
+        TEST_ASSERT_EQUAL_PTR(&s_jobs[0][i], job);
+        TEST_ASSERT_EQUAL_PTR(&t, mu_wfq_job_tenant(job));
+        mu_wfq_complete(&s_wfq, job, MSEC);
+    }
+    TEST_ASSERT_NULL(mu_wfq_next(&s_wfq));
+    TEST_ASSERT_EQUAL_INT64(4 * MSEC, mu_wfq_served(&t));
+}
+
+void test_mu_wfq_weighted_shares(void) {
+    mu_wfq_tenant_t tenants[3];
+    int served[3] = {0};
+    uint32_t weights[3] = {1, 2, 4};
+
+    // Always backlogged, equal job costs: dispatches follow the weights
+    for (int i = 0; i < 3; i++) {
+        mu_wfq_tenant_init(&tenants[i], weights[i] * MU_WFQ_WEIGHT_ONE, MSEC);
+        for (int j = 0; j < N_JOBS; j++) {
+            mu_wfq_enqueue(&s_wfq, &tenants[i], &s_jobs[i][j]);
+        }
+    }
+    for (int n = 0; n < 70; n++) {
+        mu_wfq_job_t *job = mu_wfq_next(&s_wfq);
+        served[tenant_of(tenants, job)] += 1;
+        mu_wfq_complete(&s_wfq, job, MSEC);
+    }
+    TEST_ASSERT_INT_WITHIN(1, 10, served[0]);
+    TEST_ASSERT_INT_WITHIN(1, 20, served[1]);
+    TEST_ASSERT_INT_WITHIN(1, 40, served[2]);
+}
+
+void test_mu_wfq_measured_durations(void) {
+    mu_wfq_tenant_t tenants[2];
+
+    // Equal weights, but tenant 0's jobs run 3x longer than its estimate
+    // and tenant 1's: service time, not job count, is shared equally.
+    for (int i = 0; i < 2; i++) {
+        mu_wfq_tenant_init(&tenants[i], MU_WFQ_WEIGHT_ONE, MSEC);
+        for (int j = 0; j < N_JOBS; j++) {
+            mu_wfq_enqueue(&s_wfq, &tenants[i], &s_jobs[i][j]);
+        }
+    }
+    for (int n = 0; n < 60; n++) {
+        mu_wfq_job_t *job = mu_wfq_next(&s_wfq);
+        int i = tenant_of(tenants, job);
+        mu_wfq_complete(&s_wfq, job, i == 0 ? 3 * MSEC : MSEC);
+    }
+    mu_time_rel_t a = mu_wfq_served(&tenants[0]);
+    mu_time_rel_t b = mu_wfq_served(&tenants[1]);
+    TEST_ASSERT_INT64_WITHIN(3 * MSEC, b, a);
+}
+
+void test_mu_wfq_no_idle_credit(void) {
+    mu_wfq_tenant_t busy, late;
+
+    mu_wfq_tenant_init(&busy, MU_WFQ_WEIGHT_ONE, MSEC);
+    mu_wfq_tenant_init(&late, MU_WFQ_WEIGHT_ONE, MSEC);
+    for (int j = 0; j < N_JOBS; j++) {
+        mu_wfq_enqueue(&s_wfq, &busy, &s_jobs[0][j]);
+    }
+    for (int n = 0; n < 30; n++) {
+        mu_wfq_complete(&s_wfq, mu_wfq_next(&s_wfq), MSEC);
+    }
+    // A tenant arriving now shares from here on instead of catching up
+    for (int j = 0; j < 20; j++) {
+        mu_wfq_enqueue(&s_wfq, &late, &s_jobs[1][j]);
+    }
+    int late_count = 0;
+    for (int n = 0; n < 20; n++) {
+        mu_wfq_job_t *job = mu_wfq_next(&s_wfq);
+        late_count += (mu_wfq_job_tenant(job) == &late);
+        mu_wfq_complete(&s_wfq, job, MSEC);
+    }
+    TEST_ASSERT_INT_WITHIN(1, 10, late_count);
+}
+
+void test_mu_wfq_concurrent_dispatch(void) {
+    mu_wfq_tenant_t t, u;
+    mu_wfq_job_t *running[4];
+
+    // With several jobs in flight, each dispatch charges the estimate so
+    // that one tenant cannot take every worker.
+    mu_wfq_tenant_init(&t, MU_WFQ_WEIGHT_ONE, MSEC);
+    mu_wfq_tenant_init(&u, MU_WFQ_WEIGHT_ONE, MSEC);
+    for (int j = 0; j < 8; j++) {
+        mu_wfq_enqueue(&s_wfq, &t, &s_jobs[0][j]);
+        mu_wfq_enqueue(&s_wfq, &u, &s_jobs[1][j]);
+    }
+    int from_t = 0;
+    for (int w = 0; w < 4; w++) {
+        running[w] = mu_wfq_next(&s_wfq);
+        from_t += (mu_wfq_job_tenant(running[w]) == &t);
+    }
+    TEST_ASSERT_EQUAL_INT(2, from_t);
+    for (int w = 0; w < 4; w++) {
+        mu_wfq_complete(&s_wfq, running[w], 2 * MSEC);
+    }
+    // The estimate moves toward the measured durations
+    TEST_ASSERT_TRUE(t.estimate > MSEC && t.estimate < 2 * MSEC);
+    TEST_ASSERT_EQUAL_INT64(4 * MSEC, mu_wfq_served(&u));
+}
+
+void test_mu_wfq_heap_capacity(void) {
+    mu_wfq_t small;
+    mu_wfq_slot_t heap[2];
+    mu_wfq_tenant_t tenants[3];
+
+    mu_wfq_init(&small, heap, 2);
+    for (int i = 0; i < 3; i++) {
+        mu_wfq_tenant_init(&tenants[i], MU_WFQ_WEIGHT_ONE, MSEC);
+    }
+    TEST_ASSERT_TRUE(mu_wfq_enqueue(&small, &tenants[0], &s_jobs[0][0]));
+    TEST_ASSERT_TRUE(mu_wfq_enqueue(&small, &tenants[1], &s_jobs[1][0]));
+    TEST_ASSERT_FALSE(mu_wfq_enqueue(&small, &tenants[2], &s_jobs[2][0]));
+    // A backlogged tenant needs no new slot
+    TEST_ASSERT_TRUE(mu_wfq_enqueue(&small, &tenants[0], &s_jobs[0][1]));
+}
+
+void test_mu_wfq_many_tenants(void) {
+    static mu_wfq_tenant_t tenants[N_MANY];
+
+    srand(91);
+    for (int i = 0; i < N_MANY; i++) {
+        mu_wfq_tenant_init(&tenants[i], (uint32_t)(1 + rand() % 4096), MSEC);
+        for (int j = 0; j < 4; j++) {
+            mu_wfq_enqueue(&s_wfq, &tenants[i], &s_jobs[i][j]);
+        }
+    }
+    // The heap stays ordered and indexed through dispatches and corrections
+    for (mu_wfq_job_t *job; (job = mu_wfq_next(&s_wfq)) != NULL;) {
+        for (size_t k = 0; k < mu_wfq_backlogged(&s_wfq); k++) {
+            TEST_ASSERT_TRUE(s_heap[k].tag >= s_heap[0].tag);
+            TEST_ASSERT_EQUAL_INT32((int32_t)k, s_heap[k].tenant->index);
+            if (k > 0) {
+                TEST_ASSERT_TRUE(s_heap[k].tag >= s_heap[(k - 1) / 4].tag);
+            }
+        }
+        mu_wfq_complete(&s_wfq, job, (mu_time_rel_t)(rand() % 3 + 1) * MSEC);
+    }
+    for (int i = 0; i < N_MANY; i++) {
+        TEST_ASSERT_EQUAL_UINT32(0, tenants[i].queued);
+        TEST_ASSERT_EQUAL_INT32(-1, tenants[i].index);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mu_wfq_empty);
+    RUN_TEST(test_mu_wfq_fifo_within_tenant);
+    RUN_TEST(test_mu_wfq_weighted_shares);
+    RUN_TEST(test_mu_wfq_measured_durations);
+    RUN_TEST(test_mu_wfq_no_idle_credit);
+    RUN_TEST(test_mu_wfq_concurrent_dispatch);
+    RUN_TEST(test_mu_wfq_heap_capacity);
+    RUN_TEST(test_mu_wfq_many_tenants);
+    return UNITY_END();
+}
+
+// *****************************************************************************
+// Private (static) code
+
+static int tenant_of(mu_wfq_tenant_t *tenants, mu_wfq_job_t *job) {
+    return (int)(mu_wfq_job_tenant(job) - tenants);
+}
+
+// *****************************************************************************
+// End of file